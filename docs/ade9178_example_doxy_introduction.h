@@ -127,6 +127,13 @@ Copyright (c) 2024 - 2025 Analog Devices Inc.
         - #adi_metic_ConvertAngle
         - #adi_metic_ConvertPowerFactor
 
+     Outputs of a cycle can be packed into a compact binary frame for streaming to a host. A frame carries the IRQ0
+     count, a timestamp, a mask of the fields present and their values, either converted float values or register
+     codes, and is protected by a length and a CRC-16. The decoder builds on a host.
+
+        - #adi_metic_EncodeOutputFrame
+        - #adi_metic_DecodeOutputFrame
+
 
      Registers can be periodically read by using IRQs from ADE9178. For example application can be read for every cycle,
      if #ADE9178_REG_MASK0 is configured to give interrupt for every RMSONERDY. If application is only interested in energy,
@@ -157,12 +164,74 @@ Copyright (c) 2024 - 2025 Analog Devices Inc.
      Following APIs can be used to configure , start and monitor waveform sample collection.
 
         - #adi_metic_WfsConfigureRx
+        - #adi_metic_WfsGetConfig
         - #adi_metic_WfsStartRx
 
+     Value of REG_WFS_CONFIG with the lowest baud rate sufficient for the enabled channels, and size of buffer
+     for a capture time, can be planned before configuration. Channels which do not fit in the UART are rejected.
+
+        - #adi_metic_WfsPlanBandwidth
+
+     For gap free capture over long durations, samples can be streamed continuously into a ring of blocks. Filled
+     blocks are handed out without copying and to be released once processed.
+
+        - #adi_metic_WfsStartStream
+        - #adi_metic_WfsGetBlock
+        - #adi_metic_WfsReleaseBlock
+        - #adi_metic_WfsGetStreamStatus
+        - #adi_metic_WfsStopStream
+
+     Several consumers can read the same stream. Each consumer has its own cursor over the ring, blocks are not
+     copied and a block is filled again once all consumers released it. A consumer holding the stream back
+     stalls it, skips blocks or is dropped, as chosen when registering. Lag of each consumer is reported.
+
+        - #adi_metic_WfsRegisterConsumer
+        - #adi_metic_WfsGetConsumerBlock
+        - #adi_metic_WfsReleaseConsumerBlock
+        - #adi_metic_WfsGetConsumerStatus
+        - #adi_metic_WfsUnregisterConsumer
+
      As waveform streaming is asynchronous , it is not guaranteed to start with the first enabled channel.  One the waveform samples are collected. Following API can be used to find the offset
      of the the first sample of the channel present in the buffer.
 
         - #adi_metic_FindChannelOffset
+        - #adi_metic_WfsSync
+
+     Synchronised samples can be deinterleaved into a contiguous array per channel as int32, float or scaled
+     values, optionally with a mask of frames having channel ids in sequence.
+
+        - #adi_metic_WfsDeinterleave
+
+     Samples can also be read from the offset found, or across the end of a stream ring, through a view without
+     moving the buffer.
+
+        - #adi_metic_WfsViewInit
+        - #adi_metic_WfsViewRead
+
+     Blocks of samples can be validated as they are received. Channel sequence of every frame is checked,
+     synchronisation is found again after a loss, lost frames are filled in deinterleaved output and quality of
+     each block is reported.
+
+        - #adi_metic_WfsValidatorInit
+        - #adi_metic_WfsValidateBlock
+
+     Synchronised samples can be compressed losslessly for storage or transfer. Channel ids are dropped, each
+     channel is predicted from its previous samples and residuals are Rice coded. The decoder builds on a host.
+
+        - #adi_metic_WfsEncoderInit
+        - #adi_metic_WfsWriteCodecHeader
+        - #adi_metic_WfsEncode
+        - #adi_metic_WfsDecoderInit
+        - #adi_metic_WfsDecode
+
+     Deinterleaved samples can be decimated to a lower rate, or resampled to a fixed number of samples per line
+     cycle following the measured line period, with a polyphase low pass filter. Filtering is in fixed point for
+     int32 arrays and in float otherwise, and history of each channel is kept across blocks.
+
+        - #adi_metic_WfsResamplerInit
+        - #adi_metic_WfsSetResamplerPeriod
+        - #adi_metic_WfsGetResampleNumFrames
+        - #adi_metic_WfsResample
 
 
 
@@ -0,0 +1,70 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file     benchmark.h
+ * @brief    Definitions for on target benchmarks of processing routines.
+ * @{
+ */
+
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/**
+ * @brief Benchmarks waveform synchronisation of #adi_metic_FindChannelOffset against the previous
+ * byte by byte search on synthetic samples and displays throughput in MB/s. Overwrites samples in
+ * waveform buffer.
+ * @param[in] numIterations - number of times each search is run
+ */
+void BenchmarkWfsSync(uint32_t numIterations);
+
+/**
+ * @brief Benchmarks harmonic analysis of a window on synthetic samples and displays time and core
+ * cycles per window. Uses harmonic analysis buffers of the instance, so it is not run while
+ * harmonic analysis is enabled.
+ * @param[in] numIterations - number of windows analysed
+ */
+void BenchmarkHarmonics(uint32_t numIterations);
+
+/**
+ * @brief Benchmarks Goertzel bank with 3rd, 5th, 7th, 11th and 13th harmonic bins on all channels
+ * and displays time per window and load of a second of waveform stream. Replaces bins set in
+ * Goertzel bank, so it is not run while Goertzel bank is enabled.
+ * @param[in] numIterations - number of windows
+ */
+void BenchmarkGoertzel(uint32_t numIterations);
+
+/**
+ * @brief Benchmarks #FormatFloat against snprintf "%f" on values in ranges of metrology outputs
+ * and displays time and core cycles per value. Texts of both are compared.
+ * @param[in] numIterations - number of times each value is formatted
+ */
+void BenchmarkFloatFormat(uint32_t numIterations);
+
+/**
+ * @brief Benchmarks hashed lookup of command names against a linear search of the dispatch table
+ * and displays core cycles per lookup. Indices found by both are compared.
+ * @param[in] numIterations - number of times each command name is looked up
+ */
+void BenchmarkCliLookup(uint32_t numIterations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BENCHMARK_H__ */
+
+/**
+ * @}
+ */
@@ -60,6 +60,27 @@ int32_t CmdVersion(Args *pArgs);
  */
 int32_t CmdSetDisplay(Args *pArgs);
 
+/**
+ * @brief Function for CLI "setformat" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdSetFormat(Args *pArgs);
+
+/**
+ * @brief Function for CLI "setrate" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdSetRate(Args *pArgs);
+
+/**
+ * @brief Function for CLI "setlog" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdSetLog(Args *pArgs);
+
 /**
  * @brief Function for CLI "getdisplay" command.
  * @param[in] pArgs - Pointer to command arguments storage
@@ -102,6 +123,12 @@ int32_t CmdGetRegData(Args *pArgs);
  */
 int32_t CmdDisplayPulseTime(Args *pArgs);
 
+/**
+ * @brief Disables WFS, or starts the waveform stream again with the channels of all analyses,
+ * once a stopped waveform stream has received its last block. Called from the main loop.
+ */
+void ServiceWaveformStream(void);
+
 /**
  * @brief Function for CLI "display" description
  */
@@ -140,6 +167,34 @@ int32_t CmdCaptureWfrm(Args *pArgs);
  */
 int32_t CmdDisplayWfrm(Args *pArgs);
 
+/**
+ * @brief Function for CLI "dumpwfrm" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdDumpWfrm(Args *pArgs);
+
+/**
+ * @brief Function for CLI "getregs" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdGetRegs(Args *pArgs);
+
+/**
+ * @brief Function for CLI "setregs" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdSetRegs(Args *pArgs);
+
+/**
+ * @brief Function for CLI "regscript" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdRegScript(Args *pArgs);
+
 /**
  * @brief Function for CLI Dispalay of Error Status count.
  * @param[in] pArgs - Pointer to command arguments storage
@@ -147,6 +202,147 @@ int32_t CmdDisplayWfrm(Args *pArgs);
  */
 int32_t CmdDisplayErrorStatusCount(Args *pArgs);
 
+/**
+ * @brief Function for CLI getstats command to display running statistics.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdGetStats(Args *pArgs);
+
+/**
+ * @brief Function for CLI resetstats command to reset running statistics.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdResetStats(Args *pArgs);
+
+/**
+ * @brief Function for CLI benchwfssync command to benchmark waveform synchronisation.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdBenchWfsSync(Args *pArgs);
+
+/**
+ * @brief Function for CLI startharmonics command to start harmonic analysis of channels.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdStartHarmonics(Args *pArgs);
+
+/**
+ * @brief Function for CLI getharmonics command to display harmonics of last window.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdGetHarmonics(Args *pArgs);
+
+/**
+ * @brief Function for CLI stopharmonics command to stop harmonic analysis.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdStopHarmonics(Args *pArgs);
+
+/**
+ * @brief Function for CLI benchharmonics command to benchmark harmonic analysis.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdBenchHarmonics(Args *pArgs);
+
+/**
+ * @brief Function for CLI setgoertzel command to set Goertzel bins of a channel.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdSetGoertzel(Args *pArgs);
+
+/**
+ * @brief Function for CLI startgoertzel command to start Goertzel bank.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdStartGoertzel(Args *pArgs);
+
+/**
+ * @brief Function for CLI getgoertzel command to display Goertzel bins of last window.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdGetGoertzel(Args *pArgs);
+
+/**
+ * @brief Function for CLI stopgoertzel command to stop Goertzel bank.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdStopGoertzel(Args *pArgs);
+
+/**
+ * @brief Function for CLI benchgoertzel command to benchmark Goertzel bank.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdBenchGoertzel(Args *pArgs);
+
+/**
+ * @brief Function for CLI benchfloatformat command to benchmark formatting of output values.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdBenchFloatFormat(Args *pArgs);
+
+/**
+ * @brief Function for CLI "benchclilookup" command.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdBenchCliLookup(Args *pArgs);
+
+/**
+ * @brief Function for CLI settrigger command to set sources and levels of triggered capture.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdSetTrigger(Args *pArgs);
+
+/**
+ * @brief Function for CLI armtrigger command to start waveform stream and arm triggered capture.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdArmTrigger(Args *pArgs);
+
+/**
+ * @brief Function for CLI gettrigger command to display state and frames of triggered capture.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdGetTrigger(Args *pArgs);
+
+/**
+ * @brief Function for CLI stoptrigger command to stop triggered capture.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdStopTrigger(Args *pArgs);
+
+/**
+ * @brief Function for CLI getwfsstream command to display waveform stream and its consumers.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdGetWfsStream(Args *pArgs);
+
+/**
+ * @brief Function for CLI planwfrm command to display baud rate and buffer size planned for
+ * waveform channels.
+ * @param[in] pArgs - Pointer to command arguments storage
+ * @return status 0 on Success
+ */
+int32_t CmdPlanWfrm(Args *pArgs);
+
 /**
  * @brief Function for CLI "close" command.
  * @param[in] pArgs       - pointer to command arguments storage
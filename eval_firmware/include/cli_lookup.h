@@ -0,0 +1,89 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        cli_lookup.h
+ * @brief       Hashed lookup of command names and option keywords.
+ * @addtogroup    CLI_COMMANDS
+ * @{
+ */
+
+#ifndef __CLI_LOOKUP_H__
+#define __CLI_LOOKUP_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/** Number of slots of a lookup. Power of 2 */
+#define CLI_LOOKUP_NUM_SLOTS 128
+/** Maximum number of names of a lookup, keeping slots at most half full */
+#define CLI_LOOKUP_MAX_NUM_NAMES (CLI_LOOKUP_NUM_SLOTS / 2)
+
+/**
+ * Open addressing hash table of indices into a table of names. Names are not copied, the table
+ * is to be kept.
+ */
+typedef struct
+{
+    /** Pointer to first name */
+    const uint8_t *pNames;
+    /** Bytes from one name pointer to the next */
+    uint32_t stride;
+    /** Number of names */
+    uint32_t numNames;
+    /** Index of name plus 1 in each slot, 0 for an empty slot */
+    uint8_t slot[CLI_LOOKUP_NUM_SLOTS];
+} CLI_LOOKUP;
+
+/*======= P U B L I C   P R O T O T Y P E S ========*/
+
+/**
+ * @brief Builds lookup of a table of names.
+ * @param[in] pLookup - pointer to lookup.
+ * @param[in] ppFirstName - pointer to name pointer of first entry of table.
+ * @param[in] stride - size of an entry of table, sizeof(char *) for an array of names.
+ * @param[in] numNames - number of entries, at most #CLI_LOOKUP_MAX_NUM_NAMES.
+ * @return 0 on success, 1 if there are too many names
+ */
+int32_t CliLookupInit(CLI_LOOKUP *pLookup, const char *const *ppFirstName, uint32_t stride,
+                      uint32_t numNames);
+
+/**
+ * @brief Finds a name. Only an exact match is found.
+ * @param[in] pLookup - pointer to lookup.
+ * @param[in] pName - pointer to name, need not be terminated.
+ * @param[in] length - number of characters of name.
+ * @return index of name in table, -1 if it is not found
+ */
+int32_t CliLookupFind(CLI_LOOKUP *pLookup, const char *pName, uint32_t length);
+
+/**
+ * @brief Gets index of an option keyword, as GetChoice of CLI. The lookup is built on first use.
+ * Arguments that are not an exact match are passed to GetChoice.
+ * @param[in] pLookup - pointer to lookup of choices, zero initialised before first use.
+ * @param[in] ppChoices - choices.
+ * @param[in] pArg - argument.
+ * @param[in] numChoices - number of choices.
+ * @param[in] pParam - parameter buffer for GetChoice.
+ * @return index of choice, negative if it is not found
+ */
+int32_t CliGetChoice(CLI_LOOKUP *pLookup, char **ppChoices, char *pArg, int32_t numChoices,
+                     char *pParam);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CLI_LOOKUP_H__ */
+
+/**
+ * @}
+ */
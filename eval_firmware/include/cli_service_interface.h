@@ -24,6 +24,10 @@ extern "C" {
 
 /*=============  D E F I N I T I O N S  =============*/
 
+/** Number of chunks in binary transmit queue. Power of 2, so that free running indices wrap
+ * around */
+#define CLI_TX_QUEUE_NUM_CHUNKS 4
+
 /*============= D A T A  T Y P E S =============*/
 
 /**
@@ -43,6 +47,41 @@ typedef struct
     char command[APP_CFG_CLI_MAX_CMD_LENGTH];
 } CLI_INTERFACE_INFO;
 
+/**
+ * Chunk of binary transmit queue
+ */
+typedef struct
+{
+    /** Pointer to bytes, to be kept until the chunk is sent */
+    uint8_t *pData;
+    /** Number of bytes */
+    uint32_t numBytes;
+} CLI_TX_CHUNK;
+
+/**
+ * Binary transmit queue sharing host UART with CLI. Chunks are queued from main loop and sent
+ * one after other from transmit complete callback.
+ */
+typedef struct
+{
+    /** Chunks */
+    CLI_TX_CHUNK chunk[CLI_TX_QUEUE_NUM_CHUNKS];
+    /** Free running index of next chunk to queue. Updated only by main loop */
+    volatile uint32_t writeIndex;
+    /** Free running index of chunk being sent. Updated only when a chunk is sent */
+    volatile uint32_t readIndex;
+    /** Set to 1 when UART is given to binary transfer */
+    volatile uint32_t isBinaryMode;
+    /** Set to 1 while a chunk is being sent */
+    volatile uint32_t isChunkBusy;
+    /** Set to 1 while a transfer of CLI is being sent */
+    volatile uint32_t isCliBusy;
+    /** Handle of host UART given by CLI */
+    void *hUart;
+    /** Transfer of CLI held until binary transfer ends */
+    CLI_TX_CHUNK heldCliChunk;
+} CLI_TX_QUEUE;
+
 /*======= P U B L I C   P R O T O T Y P E S ========*/
 
 /**
@@ -52,6 +91,56 @@ typedef struct
  */
 ADI_CLI_STATUS CliCreateInstance(CLI_INTERFACE_INFO *pInfo);
 
+/**
+ * @brief Dispatches a command. Command name is found through a hashed lookup built when the
+ * instance is created, so that time does not grow with the number of commands.
+ * @param[in]  hCli  - CLI handle
+ * @param[in]  pCommand  - command line
+ * @return  status of CLI dispatch
+ */
+ADI_CLI_STATUS CliDispatch(ADI_CLI_HANDLE hCli, char *pCommand);
+
+/**
+ * @brief Handles transmit complete of host UART. Sends next chunk of binary transfer, or passes
+ * the event to CLI.
+ * @param[in]  pInfo  - User instance Handle
+ */
+void CliTxCallback(CLI_INTERFACE_INFO *pInfo);
+
+/**
+ * @brief Requests UART for binary transfer. Transfers of CLI are held from then on.
+ * @param[in]  hCli  - CLI handle
+ * @return  1 once pending messages of CLI are sent and UART is given to binary transfer,
+ * 0 otherwise. To be called from main loop until it returns 1.
+ */
+int32_t CliBeginBinary(ADI_CLI_HANDLE hCli);
+
+/**
+ * @brief Queues a chunk of binary transfer. Sending starts without waiting.
+ * @param[in]  pData  - Pointer to bytes, to be kept until the chunk is sent
+ * @param[in]  numBytes  - number of bytes
+ * @return  0 if queued, 1 if queue is full
+ */
+int32_t CliQueueBinary(uint8_t *pData, uint32_t numBytes);
+
+/**
+ * @brief Returns number of chunks that can be queued.
+ * @return  number of free chunks
+ */
+uint32_t CliGetBinaryFreeChunks(void);
+
+/**
+ * @brief Gives UART back to CLI once queued chunks are sent. A held transfer of CLI is started.
+ * @return  1 if UART is given back, 0 if chunks are still being sent
+ */
+int32_t CliEndBinary(void);
+
+/**
+ * @brief Tells whether UART is given to binary transfer.
+ * @return  1 in binary mode, 0 otherwise
+ */
+int32_t CliIsBinaryMode(void);
+
 #ifdef __cplusplus
 }
 #endif
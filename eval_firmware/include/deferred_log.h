@@ -0,0 +1,93 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        deferred_log.h
+ * @brief       Log of messages whose formatting is deferred to the host.
+ * @addtogroup    DISPLAY
+ * @{
+ */
+
+#ifndef __DEFERRED_LOG_H__
+#define __DEFERRED_LOG_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include "deferred_log_table.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/** Logs a message without arguments */
+#define DEFERRED_LOG0(id) DeferredLogWrite(id, 0, 0, 0);
+/** Logs a message with one argument */
+#define DEFERRED_LOG1(id, arg0) DeferredLogWrite(id, 1, (uint32_t)(arg0), 0);
+/** Logs a message with two arguments */
+#define DEFERRED_LOG2(id, arg0, arg1) DeferredLogWrite(id, 2, (uint32_t)(arg0), (uint32_t)(arg1));
+
+/** Expands an entry of #DEFERRED_LOG_TABLE into its id */
+#define DEFERRED_LOG_ENTRY(id, level, format) id,
+/**
+ * Ids of messages of #DEFERRED_LOG_TABLE
+ */
+typedef enum
+{
+    DEFERRED_LOG_TABLE
+    /** Number of messages */
+    LOG_ID_NUM_MESSAGES
+} DEFERRED_LOG_ID;
+#undef DEFERRED_LOG_ENTRY
+
+/**
+ * Mode of the log
+ */
+typedef enum
+{
+    /** Messages are formatted and displayed immediately */
+    DEFERRED_LOG_MODE_TEXT,
+    /** Ids and arguments are queued and sent as L: lines, to be formatted on the host */
+    DEFERRED_LOG_MODE_DEFERRED
+} DEFERRED_LOG_MODE;
+
+/**
+ * @brief Sets mode of the log. Queued messages are kept.
+ * @param[in] mode - mode of the log.
+ */
+void DeferredLogSetMode(DEFERRED_LOG_MODE mode);
+
+/**
+ * @brief Gets mode of the log.
+ * @return mode of the log
+ */
+DEFERRED_LOG_MODE DeferredLogGetMode(void);
+
+/**
+ * @brief Logs a message. In deferred mode, id and arguments are queued without formatting. The
+ * message is dropped if the queue is full. Messages are to be written from one context only.
+ * @param[in] id - id of message.
+ * @param[in] numArgs - number of arguments, at most 2.
+ * @param[in] arg0 - first argument.
+ * @param[in] arg1 - second argument.
+ */
+void DeferredLogWrite(DEFERRED_LOG_ID id, uint32_t numArgs, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Sends queued messages as base64 lines starting with L:. Each line has whole messages.
+ * @param[in] maxNumChars - free message space of CLI. Lines are sent while they fit.
+ */
+void DeferredLogFlush(uint32_t maxNumChars);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEFERRED_LOG_H__ */
+
+/**
+ * @}
+ */
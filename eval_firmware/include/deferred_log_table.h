@@ -0,0 +1,41 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        deferred_log_table.h
+ * @brief       Table of messages of the deferred log. The table is also built into the host
+ * decoder, so that only message ids and arguments are sent by the firmware.
+ * @addtogroup    DISPLAY
+ * @{
+ */
+
+#ifndef __DEFERRED_LOG_TABLE_H__
+#define __DEFERRED_LOG_TABLE_H__
+
+/**
+ * Messages as DEFERRED_LOG_ENTRY(id, level, format). Level is INFO, WARN or ERROR. Arguments are
+ * 32 bit integers, at most 2, converted with %d, %u or %x. Entries are only to be appended, so
+ * that ids of older builds are kept.
+ */
+#define DEFERRED_LOG_TABLE                                                                         \
+    DEFERRED_LOG_ENTRY(LOG_ID_IRQ0_TIMEOUT, ERROR, "Timeout error in IRQ0")                        \
+    DEFERRED_LOG_ENTRY(LOG_ID_OUTPUT_READ_ERROR, ERROR,                                            \
+                       "Errors detected in reading output registers")                              \
+    DEFERRED_LOG_ENTRY(LOG_ID_WFS_STREAM_ERROR, ERROR,                                             \
+                       "Failed to stream samples. Error code from Metrology Service is %d")        \
+    DEFERRED_LOG_ENTRY(LOG_ID_MISSED_COUNT, WARN,                                                  \
+                       "Missed count of sending metrology outputs through UART is %d")             \
+    DEFERRED_LOG_ENTRY(LOG_ID_MISSED_COUNT_HINT, INFO,                                             \
+                       "Try enabling single output parameters to reduce missed count of output "   \
+                       "display. Refer to setdisplay command for list of output parameters to "    \
+                       "select.")                                                                  \
+    DEFERRED_LOG_ENTRY(LOG_ID_TRIGGER_COMPLETE, INFO,                                              \
+                       "Trigger capture complete. Use gettrigger to display")                      \
+    DEFERRED_LOG_ENTRY(LOG_ID_ERROR_STATUS, ERROR, "Error Status :  0x%x")
+
+#endif /* __DEFERRED_LOG_TABLE_H__ */
+
+/**
+ * @}
+ */
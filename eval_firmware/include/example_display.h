@@ -31,6 +31,28 @@ extern "C" {
 
 /*============= D E F I N I T I O N S =============*/
 
+/**
+ * @brief Function to get message space needed to display outputs of a cycle
+ * @param[in] pDisplay -  pointer to display
+ * @return  number of bytes of message space
+ */
+uint32_t GetDisplayMsgSize(ADE_DISPLAY_CONFIG *pDisplay);
+
+/**
+ * @brief Function to display bytes as a base64 line
+ * @param[in] pPrefix -  prefix of line, to tell lines apart on the host
+ * @param[in] pSrc -  pointer to bytes
+ * @param[in] numBytes -  number of bytes, at most 300
+ */
+void DisplayBase64(char *pPrefix, uint8_t *pSrc, uint32_t numBytes);
+
+/**
+ * @brief Function to compile plan of displayed outputs. To be called when display options, format
+ * or scales change.
+ * @param[in] pDisplay -  pointer to display
+ */
+void CompileDisplayPlan(ADE_DISPLAY_CONFIG *pDisplay);
+
 /**
  * @brief Function to display metrology status outputs
  * @param[in] pDisplay -  pointer to display
@@ -39,6 +61,16 @@ extern "C" {
  */
 void DisplayOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount, ADI_METIC_OUTPUT *pOutput);
 
+/**
+ * @brief Function to display a record of aggregated outputs. Text records start with a line
+ * naming the record and number of cycles. CSV lines and frames are sent for the mean record only.
+ * @param[in] pDisplay -  pointer to display
+ * @param[in] pAggregate -  pointer to aggregated outputs.
+ * @param[in] record -  record to display, one of OUTPUT_AGGREGATE_RECORD
+ */
+void DisplayAggregateRecord(ADE_DISPLAY_CONFIG *pDisplay, OUTPUT_AGGREGATE *pAggregate,
+                            uint32_t record);
+
 /**
  * @brief Function to display configuration value
  * @param[in] configChoice -  configuration choice
@@ -56,6 +88,19 @@ void DisplayNvmReg(ADE_CONFIG_REG *pConfig);
  */
 void DisplayWaveformOutput(void);
 
+/**
+ * @brief Displays Waveform Samples for 100ms compressed losslessly, as base64 lines of codec
+ * header followed by packets. Lines are decoded on host with tools/wfs_decode.
+ */
+void DisplayCompressedWaveform(void);
+
+/**
+ * @brief Displays Waveform Samples for 100ms resampled to a lower rate, or to 256 samples per
+ * line cycle following the period of the last register read.
+ * @param[in] outputRate -  output rate in Hz, 0 to resample synchronous to line period
+ */
+void DisplayResampledWaveform(uint32_t outputRate);
+
 /**
  * @brief Function to display burst output registers
  * @param[in] addr -  address of register
@@ -64,6 +109,36 @@ void DisplayWaveformOutput(void);
  */
 void DisplayBurstRegisters(uint32_t addr, uint32_t numRegisters, int32_t *pRegData);
 
+/**
+ * @brief Function to display running statistics of filtered rms, active power and power factor
+ * outputs in real units.
+ * @param[in] pDisplay -  pointer to display configuration with scales.
+ * @param[in] window -  statistics window to display
+ */
+void DisplayStats(ADE_DISPLAY_CONFIG *pDisplay, METIC_STATS_WINDOW window);
+
+/**
+ * @brief Function to display harmonics of last window of each channel analysed in codes, with
+ * magnitude in percent of fundamental and phase relative to fundamental.
+ */
+void DisplayHarmonics(void);
+
+/**
+ * @brief Function to display Goertzel bins of last window of all channels with bins, in codes.
+ */
+void DisplayGoertzel(void);
+
+/**
+ * @brief Function to display state of triggered capture and, once complete, the frozen frames in
+ * codes with times of trigger and of first frame.
+ */
+void DisplayTrigger(void);
+
+/**
+ * @brief Function to display status of waveform stream and read cursor and lag of its consumers.
+ */
+void DisplayWfsStream(void);
+
 /**
  * @brief Function to intialise display configurations
  * @param[in] pConfig -  pointer to display configuration structure.
@@ -0,0 +1,49 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        float_format.h
+ * @brief       Formatting of float values as fixed point text without printf.
+ * @addtogroup    DISPLAY
+ * @{
+ */
+
+#ifndef __FLOAT_FORMAT_H__
+#define __FLOAT_FORMAT_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/** Maximum number of decimals */
+#define FLOAT_FORMAT_MAX_NUM_DECIMALS 6
+/** Size of text of a value, with sign, 20 integer digits, point, decimals and terminating null */
+#define FLOAT_FORMAT_MAX_NUM_CHARS (23 + FLOAT_FORMAT_MAX_NUM_DECIMALS)
+
+/**
+ * @brief Formats a value with a fixed number of decimals. Text is the same as printf
+ * "%.<numDecimals>f", including rounding of ties to even. Digits are generated from bits of the
+ * float with integer arithmetic and a table of digit pairs. Values from 2^64 are written as inf.
+ * @param[out] pDst - pointer to text, at least #FLOAT_FORMAT_MAX_NUM_CHARS.
+ * @param[in] value - value.
+ * @param[in] numDecimals - number of decimals, at most #FLOAT_FORMAT_MAX_NUM_DECIMALS.
+ * @return number of characters written, without terminating null
+ */
+uint32_t FormatFloat(char *pDst, float value, uint32_t numDecimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLOAT_FORMAT_H__ */
+
+/**
+ * @}
+ */
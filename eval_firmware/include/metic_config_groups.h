@@ -193,6 +193,15 @@ typedef struct
 
 extern ADE_REGISTER_UINT configReg[MAX_NUM_REGISTERS];
 
+/**
+ * @brief Gets index of a register in #configReg. A table over the configuration and status
+ * address windows is built on first use, so that lookup of an address in windows is a table read.
+ * Other addresses are searched.
+ * @param[in] address - address of register.
+ * @return index of register, -1 if it is not in #configReg
+ */
+int32_t GetConfigRegIndex(uint32_t address);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@
 #include "metic_output_groups.h"
 #include "metic_service_interface.h"
 #include "nvm_service_interface.h"
+#include "output_aggregate.h"
 #include "pulse_count.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -83,6 +84,36 @@ typedef enum
     METIC_EXAMPLE_CONFIG_AUX_SCALE
 } METIC_EXAMPLE_CONFIG_SCALE;
 
+/**
+ * @brief Format of metrology outputs sent every cycle
+ *
+ */
+typedef enum
+{
+    /** Outputs are displayed as text lines */
+    ADE_DISPLAY_FORMAT_TEXT,
+    /** Outputs are sent as frames of float values */
+    ADE_DISPLAY_FORMAT_FRAME_FLOAT,
+    /** Outputs are sent as frames of register codes */
+    ADE_DISPLAY_FORMAT_FRAME_FIXED,
+    /** Outputs are displayed as a CSV line per cycle */
+    ADE_DISPLAY_FORMAT_CSV
+} ADE_DISPLAY_FORMAT;
+
+/**
+ * @brief Rate of display of metrology outputs
+ *
+ */
+typedef enum
+{
+    /** Outputs of every cycle are displayed */
+    ADE_DISPLAY_RATE_EVERY_CYCLE,
+    /** Outputs are aggregated over a number of cycles */
+    ADE_DISPLAY_RATE_CYCLES,
+    /** Outputs are aggregated over a time in ms */
+    ADE_DISPLAY_RATE_MSEC
+} ADE_DISPLAY_RATE;
+
 /**
  * @brief Display Configurations
  *
@@ -113,12 +144,24 @@ typedef struct
     bool enableStatusOutput;
     /*! Enable Error status output */
     bool enableErrorStatusOutput;
+    /*! Enable mean record of aggregated outputs */
+    bool enableMeanOutput;
+    /*! Enable minimum record of aggregated outputs */
+    bool enableMinOutput;
+    /*! Enable maximum record of aggregated outputs */
+    bool enableMaxOutput;
     /*! voltage scaling factor */
     float voltageScale;
     /*! current scaling factor */
     float currentScale;
     /*! auxiliary scaling factor */
     float auxScale;
+    /*! format of outputs */
+    ADE_DISPLAY_FORMAT format;
+    /*! rate of outputs */
+    ADE_DISPLAY_RATE rate;
+    /*! number of cycles or ms of an aggregated output */
+    uint32_t rateInterval;
 } ADE_DISPLAY_CONFIG;
 
 /**
@@ -333,6 +376,12 @@ typedef struct
     ADE_CONFIG_REG adeConfig;
     /** register output structure */
     ADI_METIC_OUTPUT output;
+    /** Outputs aggregated over current interval */
+    OUTPUT_AGGREGATE aggregate;
+    /** Outputs of last completed interval, displayed one record at a time */
+    OUTPUT_AGGREGATE completedAggregate;
+    /** Next record of completed interval to display, #OUTPUT_AGGREGATE_NUM_RECORDS if none */
+    uint32_t nextAggregateRecord;
     /** Stores to register value with crc into flash*/
     METIC_EXAMPLE_NVM nvm;
     /** SCOMM instance structure*/
@@ -443,6 +492,12 @@ int32_t HandleRunState(void);
  */
 int32_t HandleResetCmd(int32_t device);
 
+/**
+ * @brief Starts a new interval of aggregated outputs. Records of completed interval not yet
+ * displayed are dropped.
+ */
+void ResetOutputAggregate(void);
+
 /**
  * @brief Resets IRQ status and handles start command
  * @return 0 - Success
@@ -0,0 +1,84 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        output_aggregate.h
+ * @brief       Mean, minimum and maximum of metrology outputs over an interval of cycles.
+ * @addtogroup    DISPLAY
+ * @{
+ */
+
+#ifndef __OUTPUT_AGGREGATE_H__
+#define __OUTPUT_AGGREGATE_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include "adi_metic.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/**
+ * Records of an aggregate
+ */
+typedef enum
+{
+    /** Mean of each value */
+    OUTPUT_AGGREGATE_RECORD_MEAN,
+    /** Minimum of each value */
+    OUTPUT_AGGREGATE_RECORD_MIN,
+    /** Maximum of each value */
+    OUTPUT_AGGREGATE_RECORD_MAX,
+    /** Number of records */
+    OUTPUT_AGGREGATE_NUM_RECORDS
+} OUTPUT_AGGREGATE_RECORD;
+
+/**
+ * Outputs aggregated over an interval. Status words of each record are the OR of status words
+ * of all cycles, so that a flag raised in any cycle is seen.
+ */
+typedef struct
+{
+    /** Outputs of each record */
+    ADI_METIC_OUTPUT record[OUTPUT_AGGREGATE_NUM_RECORDS];
+    /** Number of cycles aggregated */
+    uint32_t numCycles;
+    /** Time at start of interval in us */
+    uint32_t startTime;
+    /** IRQ0 count of last cycle aggregated */
+    uint32_t irqCount;
+} OUTPUT_AGGREGATE;
+
+/*======= P U B L I C   P R O T O T Y P E S ========*/
+
+/**
+ * @brief Starts a new interval.
+ * @param[in] pAggregate - pointer to aggregate.
+ * @param[in] startTime - time at start of interval in us.
+ */
+void OutputAggregateReset(OUTPUT_AGGREGATE *pAggregate, uint32_t startTime);
+
+/**
+ * @brief Adds outputs of a cycle. Mean is updated as a running mean, so that it does not lose
+ * precision as a float sum would over long intervals.
+ * @param[in] pAggregate - pointer to aggregate.
+ * @param[in] irqCount - IRQ0 count of cycle.
+ * @param[in] pOutput - pointer to outputs of cycle.
+ */
+void OutputAggregateAdd(OUTPUT_AGGREGATE *pAggregate, uint32_t irqCount,
+                        ADI_METIC_OUTPUT *pOutput);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OUTPUT_AGGREGATE_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,112 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        output_plan.h
+ * @brief       Plan of metrology output values to display, compiled from display configuration.
+ * @addtogroup    DISPLAY
+ * @{
+ */
+
+#ifndef __OUTPUT_PLAN_H__
+#define __OUTPUT_PLAN_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include "adi_metic.h"
+#include "metic_example.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/** Maximum number of values of a plan. All values of ADI_METIC_OUTPUT are 123 */
+#define OUTPUT_PLAN_MAX_NUM_ENTRIES 128
+/** Width of label of a value in text lines, including padding */
+#define OUTPUT_PLAN_LABEL_WIDTH 16
+
+/**
+ * Type of a value
+ */
+typedef enum
+{
+    /** Float value, multiplied by scale */
+    OUTPUT_PLAN_VALUE_FLOAT,
+    /** 32 bit status word, displayed in hexadecimal */
+    OUTPUT_PLAN_VALUE_HEX
+} OUTPUT_PLAN_VALUE;
+
+/**
+ * A value to display
+ */
+typedef struct
+{
+    /** Offset of value in ADI_METIC_OUTPUT in bytes */
+    uint16_t offset;
+    /** Id of label prefix, the channel or phase */
+    uint8_t prefixId;
+    /** Id of label name, the quantity */
+    uint8_t nameId;
+    /** Type of value, one of #OUTPUT_PLAN_VALUE */
+    uint8_t type;
+    /** Number of spaces after label in text lines */
+    uint8_t numPadChars;
+    /** Scale of value */
+    float scale;
+} OUTPUT_PLAN_ENTRY;
+
+/**
+ * Values to display in order, with configuration of frames, so that display of a cycle does not
+ * evaluate display options.
+ */
+typedef struct
+{
+    /** Values in order of display */
+    OUTPUT_PLAN_ENTRY entry[OUTPUT_PLAN_MAX_NUM_ENTRIES];
+    /** Number of values */
+    uint32_t numEntries;
+    /** Configuration of frames */
+    ADI_METIC_OUTPUT_FRAME_CONFIG frameConfig;
+    /** 1 if header of CSV lines is to be written before next line */
+    uint32_t isHeaderPending;
+} OUTPUT_PLAN;
+
+/*======= P U B L I C   P R O T O T Y P E S ========*/
+
+/**
+ * @brief Compiles a plan from display options and scales. To be called each time they change.
+ * @param[out] pPlan - pointer to plan.
+ * @param[in] pDisplay - pointer to display configuration.
+ */
+void OutputPlanCompile(OUTPUT_PLAN *pPlan, ADE_DISPLAY_CONFIG *pDisplay);
+
+/**
+ * @brief Displays values of a cycle as text lines, one value per line.
+ * @param[in] pPlan - pointer to plan.
+ * @param[in] irqCount - irq count
+ * @param[in] pOutput - pointer to outputs.
+ */
+void OutputPlanWriteText(OUTPUT_PLAN *pPlan, uint32_t irqCount, ADI_METIC_OUTPUT *pOutput);
+
+/**
+ * @brief Displays values of a cycle as a CSV line starting with C:. A line of labels is written
+ * first after the plan is compiled.
+ * @param[in] pPlan - pointer to plan.
+ * @param[in] irqCount - irq count
+ * @param[in] pOutput - pointer to outputs.
+ */
+void OutputPlanWriteCsv(OUTPUT_PLAN *pPlan, uint32_t irqCount, ADI_METIC_OUTPUT *pOutput);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OUTPUT_PLAN_H__ */
+
+/**
+ * @}
+ */
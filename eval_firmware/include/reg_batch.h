@@ -0,0 +1,133 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        reg_batch.h
+ * @brief       Batches of register reads and writes run back to back with one response.
+ * @addtogroup ADI_ADE
+ * @{
+ */
+
+#ifndef __REG_BATCH_H__
+#define __REG_BATCH_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include "adi_metic.h"
+#include "adi_metic_status.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/** Maximum number of writes in script */
+#define REG_BATCH_SCRIPT_MAX_WRITES 256
+/** Number of register values displayed in a line */
+#define REG_BATCH_VALUES_PER_LINE 8
+
+/**
+ * Range of registers to read
+ */
+typedef struct
+{
+    /** Address of first register */
+    uint16_t address;
+    /** Number of registers */
+    uint16_t numRegisters;
+} REG_BATCH_RANGE;
+
+/**
+ * Write of a register
+ */
+typedef struct
+{
+    /** Value to write */
+    int32_t value;
+    /** Address of register */
+    uint16_t address;
+    /** Device, as for adi_metic_WriteRegister */
+    uint8_t device;
+} REG_BATCH_WRITE;
+
+/**
+ * Writes uploaded to be applied later by one command
+ */
+typedef struct
+{
+    /** Writes in order of upload */
+    REG_BATCH_WRITE writes[REG_BATCH_SCRIPT_MAX_WRITES];
+    /** Number of writes */
+    uint32_t numWrites;
+} REG_BATCH_SCRIPT;
+
+/*======= P U B L I C   P R O T O T Y P E S ========*/
+
+/**
+ * @brief Parses a range given as <hex address>[:<number of registers>].
+ * @param[in] pText - pointer to text.
+ * @param[out] pRange - pointer to range.
+ * @return 0 on success, 1 if text is invalid
+ */
+int32_t RegBatchParseRange(char *pText, REG_BATCH_RANGE *pRange);
+
+/**
+ * @brief Parses a write given as <hex address>=<hex value>.
+ * @param[in] pText - pointer to text.
+ * @param[in] device - device of register.
+ * @param[out] pWrite - pointer to write.
+ * @return 0 on success, 1 if text is invalid
+ */
+int32_t RegBatchParseWrite(char *pText, uint8_t device, REG_BATCH_WRITE *pWrite);
+
+/**
+ * @brief Reads ranges of registers back to back. ADE9178 ranges are read in bursts, ADC
+ * registers one by one.
+ * @param[in] hAde - handle of MetIC service.
+ * @param[in] device - device, ADE9178 or one ADC.
+ * @param[in] pRanges - pointer to ranges.
+ * @param[in] numRanges - number of ranges.
+ * @param[out] pValues - values of all ranges, one after other.
+ * @param[out] pNumRangesRead - number of ranges read before an error.
+ * @return status of MetIC service
+ */
+ADI_METIC_STATUS RegBatchRead(ADI_METIC_HANDLE hAde, uint8_t device, REG_BATCH_RANGE *pRanges,
+                              uint32_t numRanges, int32_t *pValues, uint32_t *pNumRangesRead);
+
+/**
+ * @brief Applies writes back to back. Writes stop at first error.
+ * @param[in] hAde - handle of MetIC service.
+ * @param[in] pWrites - pointer to writes.
+ * @param[in] numWrites - number of writes.
+ * @param[out] pNumWritten - number of writes applied before an error.
+ * @return status of MetIC service
+ */
+ADI_METIC_STATUS RegBatchWrite(ADI_METIC_HANDLE hAde, REG_BATCH_WRITE *pWrites,
+                               uint32_t numWrites, uint32_t *pNumWritten);
+
+/**
+ * @brief Displays values of ranges as <address>=<value> pairs, in the syntax of writes.
+ * @param[in] pRanges - pointer to ranges.
+ * @param[in] numRanges - number of ranges.
+ * @param[in] pValues - values of all ranges, one after other.
+ */
+void RegBatchDisplay(REG_BATCH_RANGE *pRanges, uint32_t numRanges, int32_t *pValues);
+
+/**
+ * @brief Returns script of writes.
+ * @return pointer to script
+ */
+REG_BATCH_SCRIPT *RegBatchGetScript(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __REG_BATCH_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,65 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        wfs_dump.h
+ * @brief       Binary dump of captured waveform samples over host UART.
+ * @addtogroup    DISPLAY
+ * @{
+ */
+
+#ifndef __WFS_DUMP_H__
+#define __WFS_DUMP_H__
+
+/*=============  I N C L U D E S   =============*/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*============= D E F I N E S =============*/
+
+/**
+ * Format of samples in dump
+ */
+typedef enum
+{
+    /** Samples as captured, 4 bytes per sample */
+    WFS_DUMP_FORMAT_RAW,
+    /** Packets of WFS codec, each preceded by its length */
+    WFS_DUMP_FORMAT_COMPRESSED
+} WFS_DUMP_FORMAT;
+
+/*======= P U B L I C   P R O T O T Y P E S ========*/
+
+/**
+ * @brief Starts dump of captured waveform. A D: line describing the dump is displayed, then
+ * binary data follows once pending messages are sent. Dump is sent by #WfsDumpProcess.
+ * @param[in] format - format of samples.
+ * @return 0 if dump is started, 1 otherwise
+ */
+int32_t WfsDumpStart(WFS_DUMP_FORMAT format);
+
+/**
+ * @brief Queues next chunks of dump without waiting for UART. To be called from main loop.
+ */
+void WfsDumpProcess(void);
+
+/**
+ * @brief Tells whether a dump is in progress. Commands are not to be run during a dump.
+ * @return 1 if a dump is in progress, 0 otherwise
+ */
+int32_t WfsDumpIsBusy(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WFS_DUMP_H__ */
+
+/**
+ * @}
+ */
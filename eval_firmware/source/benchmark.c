@@ -0,0 +1,551 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        benchmark.c
+ * @brief       On target benchmarks of processing routines. Times are measured with EvbGetTime.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "benchmark.h"
+#include "adi_evb.h"
+#include "ade9178.h"
+#include "cli_lookup.h"
+#include "dispatch_table.h"
+#include "adi_metic.h"
+#include "float_format.h"
+#include "message.h"
+#include "metic_example.h"
+#include "metic_service_interface.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/** Number of leading bytes before first valid frame in synthetic WFS samples */
+#define BENCH_WFS_SYNC_NUM_JUNK_BYTES 3
+/** WFS enable bit of WFS_CONFIG */
+#define BENCH_WFS_ENABLE 1
+/** Baudrate code used if WFS is not configured */
+#define BENCH_WFS_DEFAULT_BAUDRATE 5
+/** Core clock in MHz used to convert time to cycles */
+#define BENCH_CORE_CLOCK_MHZ 100
+/** Line frequency of synthetic samples for harmonic analysis in Hz */
+#define BENCH_HARMONICS_FREQUENCY 50.0f
+/** Number of cycles in a harmonic analysis window */
+#define BENCH_HARMONICS_NUM_CYCLES 10
+/** Peak amplitude of fundamental of synthetic samples in codes */
+#define BENCH_HARMONICS_AMPLITUDE 4000000.0f
+/** Number of samples in a line cycle of synthetic samples for Goertzel bank */
+#define BENCH_GOERTZEL_CYCLE_NUM_SAMPLES 80
+
+/** Values formatted by float format benchmark: RMS, power, power factor, period, angle and
+ * energy in units displayed */
+static const float benchFormatValues[] = {230.0412f, 5.001147f,  0.0123f,     1150.312f,
+                                          -845.25f,  0.998765f,  -0.5f,       50.00012f,
+                                          120.0f,    -119.9876f, 1234567.75f, 0.0f};
+
+/**
+ * @brief Returns time elapsed since start time handling wrap around of the timer.
+ * @param[in] startTime - start time in usec
+ * @return elapsed time in usec
+ */
+static uint32_t GetElapsedTime(uint32_t startTime);
+
+/**
+ * @brief Finds a command by comparing its name with each entry of the dispatch table, as CLI
+ * dispatch does. Kept as reference for the benchmark.
+ * @param[in] pName - command name
+ * @return index of command, -1 if it is not found
+ */
+static int32_t FindCommandLinear(const char *pName);
+
+/**
+ * @brief Fills buffer with frames of all enabled channels. First half of the frames has the last
+ * channel id corrupted, so that every search has to reject them.
+ * @param[in] pBuffer - pointer to buffer
+ * @param[in] numBytes - number of bytes in buffer
+ * @param[in] channelSelect - channels enabled
+ */
+static void FillWfsSyncSamples(uint8_t *pBuffer, uint32_t numBytes, uint32_t channelSelect);
+
+/**
+ * @brief Previous implementation of channel offset search. Restarts the check of a full frame
+ * after every mismatch with a linear search for the next channel id. Kept as reference for
+ * the benchmark.
+ * @param[in] pBuffer - pointer to samples
+ * @param[in] numBytes - number of bytes
+ * @param[in] channelSelect - channels enabled
+ * @param[in] channelId - channel id of first sample
+ * @param[out] pByteOffset - offset in bytes
+ * @return 0 if offset is found
+ */
+static int32_t FindChannelOffsetByteSearch(int8_t *pBuffer, int32_t numBytes,
+                                           uint32_t channelSelect, int32_t channelId,
+                                           int32_t *pByteOffset);
+
+/**
+ * @brief Checks one frame of samples for the reference search.
+ * @param[in] pBuffer - pointer to samples
+ * @param[in] pChannelIds - enabled channel ids
+ * @param[in] startChannel - expected channel id of first sample
+ * @param[in] numChannels - number of enabled channels
+ * @return 0 if all channel ids are in sequence
+ */
+static int32_t CheckFrameByteSearch(int8_t *pBuffer, uint8_t *pChannelIds, int32_t startChannel,
+                                    int32_t numChannels);
+
+/**
+ * @brief Fills window of first channel with a fundamental, 10 % third harmonic and 5 % fifth
+ * harmonic.
+ * @param[in] pHarmonics - pointer to harmonic analysis
+ * @param[in] numSamples - number of samples
+ */
+static void FillHarmonicsSamples(METIC_HARMONICS_INFO *pHarmonics, uint32_t numSamples);
+
+/*=============  C O D E  =============*/
+
+void BenchmarkWfsSync(uint32_t numIterations)
+{
+    uint32_t i;
+    uint32_t startTime;
+    uint32_t elapsedTime;
+    uint32_t channelSelect;
+    int32_t channelId = 0;
+    int32_t byteOffset = -1;
+    int32_t refByteOffset = -1;
+    int32_t wfsConfig;
+    int32_t prevWfsConfig = 0;
+    int32_t numBytes = WFS_BUFFER_SIZE * sizeof(int32_t);
+    float numMegaBytes;
+    ADI_METIC_STATUS adeStatus;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
+    int8_t *pBuffer = (int8_t *)&pInfo->wfsBuffer[0];
+
+    wfsConfig = pConfig->wfsConfig;
+    channelSelect = ((uint32_t)wfsConfig >> ADE9178_BITP_WFS_CONFIG_AV_WFS_EN) & 0xFFF;
+    if (((wfsConfig & BENCH_WFS_ENABLE) == 0) || (channelSelect == 0))
+    {
+        channelSelect = 0xFFF;
+        wfsConfig = BENCH_WFS_ENABLE |
+                    (BENCH_WFS_DEFAULT_BAUDRATE << ADE9178_BITP_WFS_CONFIG_BAUD_RATE) |
+                    (channelSelect << ADE9178_BITP_WFS_CONFIG_AV_WFS_EN);
+    }
+    while ((channelSelect & (1u << channelId)) == 0)
+    {
+        channelId++;
+    }
+    // Configuration sets WFS UART baudrate, it is restored once benchmark is done.
+    adi_metic_WfsGetConfig(pInfo->hAde, &prevWfsConfig);
+    adeStatus = adi_metic_WfsConfigureRx(pInfo->hAde, wfsConfig);
+    if ((adeStatus == ADI_METIC_STATUS_SUCCESS) && (numIterations > 0))
+    {
+        FillWfsSyncSamples((uint8_t *)pBuffer, (uint32_t)numBytes, channelSelect);
+        pInfo->isWfsRxComplete = 0;
+        numMegaBytes = (float)numBytes * (float)numIterations / 1000000.0f;
+
+        startTime = EvbGetTime();
+        for (i = 0; i < numIterations; i++)
+        {
+            adi_metic_FindChannelOffset(pInfo->hAde, pBuffer, numBytes, channelId, &byteOffset);
+        }
+        elapsedTime = GetElapsedTime(startTime);
+        INFO_MSG("linear search      : offset = %d, time = %u us, %f MB/s", byteOffset,
+                 elapsedTime, (double)(numMegaBytes * 1000000.0f / (float)(elapsedTime + 1)))
+
+        startTime = EvbGetTime();
+        for (i = 0; i < numIterations; i++)
+        {
+            FindChannelOffsetByteSearch(pBuffer, numBytes, channelSelect, channelId,
+                                        &refByteOffset);
+        }
+        elapsedTime = GetElapsedTime(startTime);
+        INFO_MSG("byte by byte search: offset = %d, time = %u us, %f MB/s", refByteOffset,
+                 elapsedTime, (double)(numMegaBytes * 1000000.0f / (float)(elapsedTime + 1)))
+    }
+    else
+    {
+        WARN_MSG("Unable to configure WFS for benchmark")
+    }
+    if (adi_metic_WfsConfigureRx(pInfo->hAde, prevWfsConfig) != ADI_METIC_STATUS_SUCCESS)
+    {
+        WARN_MSG("Unable to restore WFS configuration")
+    }
+}
+
+void BenchmarkHarmonics(uint32_t numIterations)
+{
+    uint32_t i;
+    uint32_t startTime;
+    uint32_t elapsedTime;
+    uint32_t numSamples;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_HARMONICS_INFO *pHarmonics = &pInfo->harmonics;
+    METIC_HARMONICS_RESULT *pResult = &pHarmonics->result[0];
+
+    if ((pHarmonics->isEnabled == 0) && (numIterations > 0))
+    {
+        pHarmonics->numCycles = BENCH_HARMONICS_NUM_CYCLES;
+        pHarmonics->frequency = BENCH_HARMONICS_FREQUENCY;
+        pHarmonics->windowPhase = 0;
+        numSamples = MetIcIfGetHarmonicsWindowSamples(pHarmonics);
+        FillHarmonicsSamples(pHarmonics, numSamples);
+        // Window is only read by the analysis, so the same window is analysed every iteration.
+        startTime = EvbGetTime();
+        for (i = 0; i < numIterations; i++)
+        {
+            MetIcIfComputeHarmonics(pHarmonics, 0);
+        }
+        elapsedTime = GetElapsedTime(startTime) / numIterations;
+        INFO_MSG("harmonics: %u point FFT, time = %u us, %u cycles per window",
+                 HARMONICS_FFT_SIZE, elapsedTime, elapsedTime * BENCH_CORE_CLOCK_MHZ)
+        INFO_MSG("harmonics: h1 = %f, h3 = %f %%, h5 = %f %%, thd = %f %%",
+                 (double)pResult->magnitude[1],
+                 (double)(pResult->magnitude[3] * 100.0f / pResult->magnitude[1]),
+                 (double)(pResult->magnitude[5] * 100.0f / pResult->magnitude[1]),
+                 (double)pResult->thd)
+    }
+    else
+    {
+        WARN_MSG("Harmonic analysis in progress")
+    }
+}
+
+void BenchmarkGoertzel(uint32_t numIterations)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t startTime;
+    uint32_t elapsedTime;
+    uint32_t numFrames;
+    uint32_t numBins = 0;
+    int32_t cycle[BENCH_GOERTZEL_CYCLE_NUM_SAMPLES];
+    int32_t frame[ADI_METIC_MAX_NUM_CHANNELS];
+    float orders[] = {3, 5, 7, 11, 13};
+    float step = 2.0f * 3.14159265f / BENCH_GOERTZEL_CYCLE_NUM_SAMPLES;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_GOERTZEL_INFO *pGoertzel = &pInfo->goertzel;
+
+    if ((pGoertzel->isEnabled == 0) && (numIterations > 0))
+    {
+        for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+        {
+            MetIcIfSetGoertzelOrders(pInfo, i, &orders[0], sizeof(orders) / sizeof(orders[0]));
+            numBins += pGoertzel->channel[i].numBins;
+        }
+        for (i = 0; i < BENCH_GOERTZEL_CYCLE_NUM_SAMPLES; i++)
+        {
+            cycle[i] = (int32_t)(BENCH_HARMONICS_AMPLITUDE * sinf(step * (float)i));
+        }
+        MetIcIfConfigureGoertzel(pInfo, BENCH_HARMONICS_NUM_CYCLES, BENCH_HARMONICS_FREQUENCY);
+        // Windows start at the first sample, rising zero crossing of the cycle.
+        pGoertzel->lastSample = -1;
+        numFrames = numIterations * pGoertzel->windowNumSamples;
+        startTime = EvbGetTime();
+        for (i = 0; i < numFrames; i++)
+        {
+            for (j = 0; j < ADI_METIC_MAX_NUM_CHANNELS; j++)
+            {
+                frame[j] = cycle[i % BENCH_GOERTZEL_CYCLE_NUM_SAMPLES];
+            }
+            MetIcIfUpdateGoertzel(pGoertzel, &frame[0]);
+        }
+        elapsedTime = GetElapsedTime(startTime);
+        pGoertzel->isEnabled = 0;
+        // Load is the time taken for a second of samples at the waveform sampling rate.
+        INFO_MSG("goertzel: %u bins, time = %u us per window, %f cycles per bin per sample",
+                 numBins, elapsedTime / numIterations,
+                 (double)((float)elapsedTime * BENCH_CORE_CLOCK_MHZ /
+                          ((float)numFrames * (float)numBins)))
+        INFO_MSG("goertzel: load = %f %%, windows = %u",
+                 (double)((float)elapsedTime * HARMONICS_SAMPLING_RATE / (float)numFrames /
+                          10000.0f),
+                 pGoertzel->numWindows)
+    }
+    else
+    {
+        WARN_MSG("Goertzel bank in progress")
+    }
+}
+
+void BenchmarkFloatFormat(uint32_t numIterations)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t startTime;
+    uint32_t formatTime;
+    uint32_t printfTime;
+    uint32_t numMismatches = 0;
+    uint32_t numValues = sizeof(benchFormatValues) / sizeof(benchFormatValues[0]);
+    char text[FLOAT_FORMAT_MAX_NUM_CHARS];
+    char refText[FLOAT_FORMAT_MAX_NUM_CHARS];
+
+    for (j = 0; j < numValues; j++)
+    {
+        FormatFloat(&text[0], benchFormatValues[j], FLOAT_FORMAT_MAX_NUM_DECIMALS);
+        snprintf(&refText[0], sizeof(refText), "%f", (double)benchFormatValues[j]);
+        if (strcmp(&text[0], &refText[0]) != 0)
+        {
+            numMismatches++;
+        }
+    }
+    if (numIterations > 0)
+    {
+        startTime = EvbGetTime();
+        for (i = 0; i < numIterations; i++)
+        {
+            for (j = 0; j < numValues; j++)
+            {
+                FormatFloat(&text[0], benchFormatValues[j], FLOAT_FORMAT_MAX_NUM_DECIMALS);
+            }
+        }
+        formatTime = GetElapsedTime(startTime);
+        startTime = EvbGetTime();
+        for (i = 0; i < numIterations; i++)
+        {
+            for (j = 0; j < numValues; j++)
+            {
+                snprintf(&refText[0], sizeof(refText), "%f", (double)benchFormatValues[j]);
+            }
+        }
+        printfTime = GetElapsedTime(startTime);
+        numValues *= numIterations;
+        INFO_MSG("float format: time = %u us, %u cycles per value", formatTime,
+                 (uint32_t)((uint64_t)formatTime * BENCH_CORE_CLOCK_MHZ / numValues))
+        INFO_MSG("snprintf    : time = %u us, %u cycles per value", printfTime,
+                 (uint32_t)((uint64_t)printfTime * BENCH_CORE_CLOCK_MHZ / numValues))
+    }
+    INFO_MSG("float format: %u mismatches with snprintf", numMismatches)
+}
+
+void BenchmarkCliLookup(uint32_t numIterations)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t startTime;
+    uint32_t lookupTime;
+    uint32_t linearTime;
+    uint32_t numLookups;
+    uint32_t numMismatches = 0;
+    int32_t lookupSum = 0;
+    int32_t linearSum = 0;
+    const char *pName;
+    static CLI_LOOKUP lookup;
+
+    CliLookupInit(&lookup, (const char *const *)&dispatchTable[0].name, sizeof(Command),
+                  NUM_COMMANDS);
+    for (j = 0; j < NUM_COMMANDS; j++)
+    {
+        pName = dispatchTable[j].name;
+        if (CliLookupFind(&lookup, pName, strlen(pName)) != FindCommandLinear(pName))
+        {
+            numMismatches++;
+        }
+    }
+    if (numIterations > 0)
+    {
+        startTime = EvbGetTime();
+        for (i = 0; i < numIterations; i++)
+        {
+            for (j = 0; j < NUM_COMMANDS; j++)
+            {
+                pName = dispatchTable[j].name;
+                lookupSum += CliLookupFind(&lookup, pName, strlen(pName));
+            }
+        }
+        lookupTime = GetElapsedTime(startTime);
+        startTime = EvbGetTime();
+        for (i = 0; i < numIterations; i++)
+        {
+            for (j = 0; j < NUM_COMMANDS; j++)
+            {
+                linearSum += FindCommandLinear(dispatchTable[j].name);
+            }
+        }
+        linearTime = GetElapsedTime(startTime);
+        numLookups = numIterations * NUM_COMMANDS;
+        // Sums of indices are compared, so that timed lookups are not optimised away.
+        if (lookupSum != linearSum)
+        {
+            numMismatches++;
+        }
+        INFO_MSG("hashed lookup : time = %u us, %u cycles per command", lookupTime,
+                 (uint32_t)((uint64_t)lookupTime * BENCH_CORE_CLOCK_MHZ / numLookups))
+        INFO_MSG("linear search : time = %u us, %u cycles per command, %u commands", linearTime,
+                 (uint32_t)((uint64_t)linearTime * BENCH_CORE_CLOCK_MHZ / numLookups),
+                 NUM_COMMANDS)
+    }
+    INFO_MSG("hashed lookup : %u mismatches with linear search", numMismatches)
+}
+
+int32_t FindCommandLinear(const char *pName)
+{
+    int32_t index = -1;
+    uint32_t i;
+
+    for (i = 0; (i < NUM_COMMANDS) && (index < 0); i++)
+    {
+        if (strcmp(dispatchTable[i].name, pName) == 0)
+        {
+            index = (int32_t)i;
+        }
+    }
+    return index;
+}
+
+void FillHarmonicsSamples(METIC_HARMONICS_INFO *pHarmonics, uint32_t numSamples)
+{
+    uint32_t i;
+    float angle;
+    float step = 2.0f * 3.14159265f * BENCH_HARMONICS_FREQUENCY / (float)HARMONICS_SAMPLING_RATE;
+
+    for (i = 0; i < numSamples; i++)
+    {
+        angle = step * (float)i;
+        pHarmonics->window[0][i] =
+            (int32_t)(BENCH_HARMONICS_AMPLITUDE *
+                      (sinf(angle) + 0.1f * sinf(3.0f * angle) + 0.05f * sinf(5.0f * angle)));
+    }
+    pHarmonics->numSamples = numSamples;
+}
+
+void FillWfsSyncSamples(uint8_t *pBuffer, uint32_t numBytes, uint32_t channelSelect)
+{
+    uint32_t pos;
+    uint32_t channel = 0;
+    uint32_t lastChannel = 0;
+    uint32_t sample = 0x123456;
+    uint32_t corruptFrames = 1;
+
+    for (pos = 0; pos < ADI_METIC_MAX_NUM_CHANNELS; pos++)
+    {
+        if ((channelSelect & (1u << pos)) != 0)
+        {
+            lastChannel = pos;
+        }
+    }
+    memset(pBuffer, 0x5A, BENCH_WFS_SYNC_NUM_JUNK_BYTES);
+    pos = BENCH_WFS_SYNC_NUM_JUNK_BYTES;
+    while (pos + 4 <= numBytes)
+    {
+        if ((channelSelect & (1u << channel)) != 0)
+        {
+            // Pseudo random sample data from a linear congruential generator.
+            sample = sample * 1103515245u + 12345u;
+            pBuffer[pos] = (uint8_t)channel;
+            if ((channel == lastChannel) && (corruptFrames == 1))
+            {
+                pBuffer[pos] = (uint8_t)(channel + 1);
+            }
+            pBuffer[pos + 1] = (uint8_t)(sample >> 8);
+            pBuffer[pos + 2] = (uint8_t)(sample >> 16);
+            pBuffer[pos + 3] = (uint8_t)(sample >> 24);
+            pos += 4;
+        }
+        channel++;
+        if (channel >= ADI_METIC_MAX_NUM_CHANNELS)
+        {
+            channel = 0;
+            if (pos > numBytes / 2)
+            {
+                corruptFrames = 0;
+            }
+        }
+    }
+}
+
+int32_t FindChannelOffsetByteSearch(int8_t *pBuffer, int32_t numBytes, uint32_t channelSelect,
+                                    int32_t channelId, int32_t *pByteOffset)
+{
+    int32_t status = 1;
+    int32_t i;
+    int32_t numChannels = 0;
+    int32_t numGoodFrames = 0;
+    int32_t currentPos = 0;
+    int32_t numBytesSkip = 0;
+    int32_t numRemainingBytes = numBytes;
+    uint8_t channelIds[ADI_METIC_MAX_NUM_CHANNELS];
+
+    for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+    {
+        if ((channelSelect & (1u << i)) != 0)
+        {
+            channelIds[numChannels] = (uint8_t)i;
+            numChannels++;
+        }
+    }
+    while ((numChannels > 0) && (numRemainingBytes >= (numChannels * 4)))
+    {
+        if (CheckFrameByteSearch(&pBuffer[currentPos], channelIds, channelId, numChannels) == 0)
+        {
+            numGoodFrames++;
+            if (numGoodFrames >= ADI_METIC_WFS_OFFSET_COUNT)
+            {
+                *pByteOffset = numBytesSkip;
+                status = 0;
+                break;
+            }
+            numRemainingBytes -= (numChannels * 4);
+            currentPos += (numChannels * 4);
+        }
+        else
+        {
+            numRemainingBytes -= 1;
+            currentPos += 1;
+            numGoodFrames = 0;
+            numBytesSkip = currentPos;
+        }
+    }
+    return status;
+}
+
+int32_t CheckFrameByteSearch(int8_t *pBuffer, uint8_t *pChannelIds, int32_t startChannel,
+                             int32_t numChannels)
+{
+    int32_t status = 0;
+    int32_t i;
+    int32_t pos;
+    int32_t expectedChannelId = startChannel;
+
+    for (i = 0; i < numChannels; i++)
+    {
+        if (pBuffer[i * 4] != expectedChannelId)
+        {
+            status = 1;
+            break;
+        }
+        // Linear search for position of the channel to get the next one.
+        for (pos = 0; pos < numChannels; pos++)
+        {
+            if (pChannelIds[pos] == expectedChannelId)
+            {
+                expectedChannelId = pChannelIds[(pos + 1) % numChannels];
+                break;
+            }
+        }
+    }
+    return status;
+}
+
+uint32_t GetElapsedTime(uint32_t startTime)
+{
+    uint32_t elapsedTime;
+    uint32_t currTime = EvbGetTime();
+    if (currTime >= startTime)
+    {
+        elapsedTime = currTime - startTime;
+    }
+    else
+    {
+        elapsedTime = EvbGetMaxTime() - startTime + currTime;
+    }
+    return elapsedTime;
+}
+
+/**
+ * @}
+ */
@@ -6,15 +6,21 @@
 #include "cli_commands.h"
 #include "ade9178.h"
 #include "ade9178_enums.h"
+#include "benchmark.h"
+#include "cli_lookup.h"
+#include "deferred_log.h"
 #include "error_display.h"
 #include "example_display.h"
 #include "example_version.h"
 #include "message.h"
 #include "metic_service_interface.h"
+#include "reg_batch.h"
 #include "status.h"
+#include "wfs_dump.h"
 #include <ctype.h>
 #include <inttypes.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -27,13 +33,77 @@ static char commandParam[APP_CFG_CLI_MAX_PARAM_LENGTH];
 
 #define MAX_ADE9178_REG_LENGTH 256
 
-/** The order should be as  DISPLAY_CONFIG structure */
+#if ENABLE_ALL_CHANNELS == 1
+/** Channels streamed for triggered capture */
+#define TRIGGER_CHANNEL_MASK 0xFFF
+#else
+/** Channels streamed for triggered capture */
+#define TRIGGER_CHANNEL_MASK 0x3F
+#endif
+/** Voltage channels AV, BV and CV monitored for dip and swell triggers */
+#define TRIGGER_VOLTAGE_CHANNEL_MASK 0x15
+
+/** The order should be as displayFlagOffset */
 static char *displayChoices[] = {"all",         "rms",          "rmsone", "rmshalf",
                                  "eventrmsone", "eventrmshalf", "power",  "energy",
-                                 "period",      "angle",        "status", "errorstatus"};
+                                 "period",      "angle",        "status", "errorstatus",
+                                 "mean",        "min",          "max"};
+
+/** Offsets of display flags in ADE_DISPLAY_CONFIG, in order of displayChoices */
+static const uint8_t displayFlagOffset[] = {
+    offsetof(ADE_DISPLAY_CONFIG, enableAll),
+    offsetof(ADE_DISPLAY_CONFIG, enableRmsOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableRmsOneOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableRmsHalfOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableEventRmsOneOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableEventRmsHalfOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enablePowerOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableEnergyOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enablePeriodOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableAngleOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableStatusOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableErrorStatusOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableMeanOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableMinOutput),
+    offsetof(ADE_DISPLAY_CONFIG, enableMaxOutput)};
+
+/** The order should be as ADE_DISPLAY_FORMAT enum */
+static char *formatChoices[] = {"text", "float", "fixed", "csv"};
+
+/** The order should be as ADE_DISPLAY_RATE enum */
+static char *rateChoices[] = {"every", "cycles", "ms"};
+
+/** The order should be as DEFERRED_LOG_MODE enum */
+static char *logModeChoices[] = {"text", "deferred"};
+
+/** The order should be as WFS_DUMP_FORMAT enum */
+static char *dumpFormatChoices[] = {"raw", "compressed"};
 
 static char *deviceChoices[] = {"ADE9178", "ADC0", "ADC1", "ADC2", "ADC3", "ALL_ADC"};
 
+/** The order should be as commands of regscript */
+static char *scriptChoices[] = {"add", "clear"};
+
+/** The order should be as METIC_STATS_WINDOW enum */
+static char *statsWindowChoices[] = {"total", "tumbling", "sliding"};
+
+/** Channels of waveform stream shared by analyses */
+static uint32_t wfsStreamChannelMask;
+/** 1 while WFS waits to be disabled or configured again after the stream stops */
+static int32_t isWfsStopPending;
+/** Channels of waveform stream to start after the stream stops, 0 to disable WFS */
+static uint32_t wfsPendingChannelMask;
+
+/** Lookups of choices, built on first use */
+static CLI_LOOKUP displayLookup;
+static CLI_LOOKUP formatLookup;
+static CLI_LOOKUP rateLookup;
+static CLI_LOOKUP logModeLookup;
+static CLI_LOOKUP dumpFormatLookup;
+static CLI_LOOKUP deviceLookup;
+static CLI_LOOKUP scriptLookup;
+static CLI_LOOKUP statsWindowLookup;
+
 static char *displayDescription[] = {"all parameters",
                                      "all filtered rms output parameters",
                                      "all rmsone output parameters",
@@ -45,7 +115,10 @@ static char *displayDescription[] = {"all parameters",
                                      "all period output parameters",
                                      "all angle output parameters",
                                      "all status output parameters",
-                                     "Enable or disable display of repeated error status messages"
+                                     "Enable or disable display of repeated error status messages",
+                                     "mean record of aggregated outputs, see setrate",
+                                     "minimum record of aggregated outputs, see setrate",
+                                     "maximum record of aggregated outputs, see setrate"
 
 };
 
@@ -55,6 +128,59 @@ static int32_t ResetEvb(Args *pArgs);
 static int32_t ResetEvk(Args *pArgs);
 #endif
 static void GetRegisterValue(uint8_t device, uint16_t address, uint16_t numReg);
+/**
+ * @brief Configures WFS for ADC samples of selected channels and starts continuous streaming.
+ * @param[in] channelMask - bit mask of channel ids to stream
+ * @return status of configuration
+ */
+static ADI_METIC_STATUS StartWaveformStream(uint32_t channelMask);
+/**
+ * @brief Stops continuous streaming. WFS is disabled or configured again by
+ * #ServiceWaveformStream once the block in progress is received.
+ */
+static void StopWaveformStream(void);
+/**
+ * @brief Checks if waveform stream is running or stopping.
+ * @return 1 if stream is running or WFS is not yet disabled after stop
+ */
+static int32_t IsWaveformStreaming(void);
+/**
+ * @brief Checks if waveform capture is in progress, which analyses can not share.
+ * @return 1 if waveform samples are being captured
+ */
+static int32_t IsWaveformBusy(void);
+/**
+ * @brief Updates continuous streaming to the channels of enabled analyses. Analyses share one
+ * stream, started with the first analysis and stopped after the last. Stream is restarted with
+ * more channels if an analysis needs channels not streamed, once the running stream has
+ * stopped, and running analyses start again.
+ * @return status of configuration
+ */
+static ADI_METIC_STATUS UpdateWaveformStream(void);
+/**
+ * @brief Starts windows and captures of enabled analyses again on a restarted stream.
+ */
+static void RestartWaveformAnalyses(void);
+/**
+ * @brief Stops all analyses of waveform stream.
+ */
+static void StopWaveformAnalyses(void);
+/**
+ * @brief Gets channels of enabled analyses.
+ * @return bit mask of channel ids
+ */
+static uint32_t GetAnalysisChannelMask(void);
+/**
+ * @brief Plans WFS configuration of channels at the waveform sampling rate with the lowest
+ * sufficient baud rate. Displays a warning if samples do not fit in WFS UART.
+ * @param[in] channelMask - bit mask of channel ids to stream
+ * @param[in] srcType - waveform source type
+ * @param[in] captureTime - time in msec of samples to hold in buffer
+ * @param[out] pPlan - pointer to planned configuration
+ * @return status of planning
+ */
+static ADI_METIC_STATUS PlanWaveform(uint32_t channelMask, uint32_t srcType,
+                                     uint32_t captureTime, ADI_METIC_WFS_PLAN *pPlan);
 
 int32_t CmdStart(Args *pArgs)
 {
@@ -133,15 +259,18 @@ int32_t CmdVersion(Args *pArgs)
 int32_t CmdCaptureWfrm(Args *pArgs)
 {
     int32_t wfsData;
-    int32_t wfsEnable = 1;
-    int32_t channelEnable;
+    uint32_t channelEnable;
     int32_t wfrmSrcType;
     int32_t cycleDelay;
-    int32_t baudrate = 5;
+    ADI_METIC_WFS_PLAN plan;
     ADI_METIC_STATUS adeStatus = 0;
     METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
     METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
-    if (pArgs->c == 2)
+    if (IsWaveformStreaming() == 1)
+    {
+        WARN_MSG("Waveform stream in progress")
+    }
+    else if (pArgs->c == 2)
     {
         wfrmSrcType = pArgs->v[0].d;
         cycleDelay = pArgs->v[1].d;
@@ -151,30 +280,29 @@ int32_t CmdCaptureWfrm(Args *pArgs)
             {
 #if ENABLE_ALL_CHANNELS == 1
                 channelEnable = 0xFFF;
-                wfsData = wfsEnable | (baudrate << ADE9178_BITP_WFS_CONFIG_BAUD_RATE) |
-                          (channelEnable << ADE9178_BITP_WFS_CONFIG_AV_WFS_EN) |
-                          (wfrmSrcType << ADE9178_BITP_WFS_CONFIG_WF_SRC);
 #else
                 channelEnable = 0x3F;
-                wfsData = wfsEnable | (baudrate << ADE9178_BITP_WFS_CONFIG_BAUD_RATE) |
-                          (channelEnable << ADE9178_BITP_WFS_CONFIG_AV_WFS_EN) |
-                          (wfrmSrcType << ADE9178_BITP_WFS_CONFIG_WF_SRC);
 #endif
-                adeStatus =
-                    adi_metic_WriteRegister(pInfo->hAde, 0, ADE9178_REG_WFS_CONFIG, &wfsData);
+                adeStatus = PlanWaveform(channelEnable, (uint32_t)wfrmSrcType, 0, &plan);
                 if (adeStatus == ADI_METIC_STATUS_SUCCESS)
                 {
-                    INFO_MSG("Wfs Configuration is successful")
-                    // Starts Waveform Rx Capture after completing configured cycle.
-                    pConfig->cyclesToRun = (uint32_t)cycleDelay;
-                    pInfo->enableRegisterRead = 0;
-                    pInfo->enableWfsCapture = 1;
-                    pConfig->wfsConfig = wfsData;
-                    HandleStartCmd();
-                }
-                else
-                {
-                    DisplayErrorCode(ADE9178_REG_WFS_CONFIG, 0, wfsData, adeStatus);
+                    wfsData = plan.config;
+                    adeStatus =
+                        adi_metic_WriteRegister(pInfo->hAde, 0, ADE9178_REG_WFS_CONFIG, &wfsData);
+                    if (adeStatus == ADI_METIC_STATUS_SUCCESS)
+                    {
+                        INFO_MSG("Wfs Configuration is successful")
+                        // Starts Waveform Rx Capture after completing configured cycle.
+                        pConfig->cyclesToRun = (uint32_t)cycleDelay;
+                        pInfo->enableRegisterRead = 0;
+                        pInfo->enableWfsCapture = 1;
+                        pConfig->wfsConfig = wfsData;
+                        HandleStartCmd();
+                    }
+                    else
+                    {
+                        DisplayErrorCode(ADE9178_REG_WFS_CONFIG, 0, wfsData, adeStatus);
+                    }
                 }
             }
             else
@@ -197,11 +325,28 @@ int32_t CmdCaptureWfrm(Args *pArgs)
 
 int32_t CmdDisplayWfrm(Args *pArgs)
 {
+    uint32_t outputRate = 0;
+    if (pArgs->c == 1)
+    {
+        outputRate = (uint32_t)strtoul(pArgs->v[0].pS, NULL, 10);
+    }
     if (pArgs->c == 0)
     {
 
         DisplayWaveformOutput();
     }
+    else if ((pArgs->c == 1) && (strcmp(pArgs->v[0].pS, "compressed") == 0))
+    {
+        DisplayCompressedWaveform();
+    }
+    else if ((pArgs->c == 1) && (strcmp(pArgs->v[0].pS, "sync") == 0))
+    {
+        DisplayResampledWaveform(0);
+    }
+    else if ((outputRate > 0) && (outputRate < ADI_METIC_SAMPLING_RATE))
+    {
+        DisplayResampledWaveform(outputRate);
+    }
     else
     {
         WARN_MSG("Wrong arguments. Use help displaywfrm")
@@ -209,6 +354,31 @@ int32_t CmdDisplayWfrm(Args *pArgs)
     return 0;
 }
 
+int32_t CmdDumpWfrm(Args *pArgs)
+{
+    char *pParam = &commandParam[0];
+    int32_t numChoices = sizeof(dumpFormatChoices) / sizeof(dumpFormatChoices[0]);
+    int32_t choice = -1;
+    if (pArgs->c == 1)
+    {
+        choice = CliGetChoice(&dumpFormatLookup, dumpFormatChoices, pArgs->v[0].pS, numChoices,
+                              pParam);
+    }
+#ifdef ENABLE_RTOS_BUILD
+    WARN_MSG("dumpwfrm is not supported in RTOS build. Use displaywfrm")
+#else
+    if (choice >= 0)
+    {
+        WfsDumpStart((WFS_DUMP_FORMAT)choice);
+    }
+    else
+    {
+        WARN_MSG("Wrong arguments. Use help dumpwfrm")
+    }
+#endif
+    return 0;
+}
+
 int32_t CmdDisplayErrorStatusCount(Args *pArgs)
 {
     if (pArgs->c == 0)
@@ -224,6 +394,508 @@ int32_t CmdDisplayErrorStatusCount(Args *pArgs)
     return 0;
 }
 
+int32_t CmdGetStats(Args *pArgs)
+{
+    METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    char *pParam = &commandParam[0];
+    int32_t numChoices = sizeof(statsWindowChoices) / sizeof(statsWindowChoices[0]);
+    int32_t choice;
+    if ((pArgs->c == 1) || (pArgs->c == 2))
+    {
+        choice = CliGetChoice(&statsWindowLookup, statsWindowChoices, pArgs->v[0].pS, numChoices,
+                              pParam);
+        if (choice >= 0)
+        {
+            DisplayStats(&pConfig->displayConfig, (METIC_STATS_WINDOW)choice);
+            if (pArgs->c == 2)
+            {
+                if (strcmp(pArgs->v[1].pS, "reset") == 0)
+                {
+                    MetIcIfResetStats(pInfo);
+                    INFO_MSG("Statistics reset")
+                }
+                else
+                {
+                    WARN_MSG("Unsupported option %s. Use help getstats", pArgs->v[1].pS)
+                }
+            }
+        }
+        else
+        {
+            WARN_MSG("Unsupported window %s. Use help getstats", pArgs->v[0].pS)
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help getstats")
+    }
+    return 0;
+}
+
+int32_t CmdResetStats(Args *pArgs)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if (pArgs->c == 0)
+    {
+        MetIcIfResetStats(pInfo);
+        INFO_MSG("Statistics reset")
+    }
+    else if (pArgs->c == 2)
+    {
+        if ((pArgs->v[0].d > 0) && (pArgs->v[1].d > 0) &&
+            (pArgs->v[1].d <= STATS_MAX_SLIDING_WINDOW_CYCLES))
+        {
+            MetIcIfConfigureStats(pInfo, (uint32_t)pArgs->v[0].d, (uint32_t)pArgs->v[1].d);
+            INFO_MSG("Statistics reset with tumbling window %d cycles, sliding window %d cycles",
+                     pArgs->v[0].d, pArgs->v[1].d)
+        }
+        else
+        {
+            WARN_MSG("Invalid window length. Sliding window can be 1 to %d cycles",
+                     STATS_MAX_SLIDING_WINDOW_CYCLES)
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help resetstats")
+    }
+    return 0;
+}
+
+int32_t CmdBenchWfsSync(Args *pArgs)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if ((pArgs->c == 1) && (pArgs->v[0].d > 0))
+    {
+        if ((pInfo->enableWfsCapture == 0) && (IsWaveformStreaming() == 0))
+        {
+            BenchmarkWfsSync((uint32_t)pArgs->v[0].d);
+        }
+        else
+        {
+            WARN_MSG("Waveform capture in progress")
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help benchwfssync")
+    }
+    return 0;
+}
+
+int32_t CmdStartHarmonics(Args *pArgs)
+{
+    uint32_t channelMask;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if (pArgs->c == 3)
+    {
+        channelMask = (uint32_t)strtoul(pArgs->v[0].pS, NULL, 16);
+        if (IsWaveformBusy() == 1)
+        {
+            WARN_MSG("Waveform capture in progress")
+        }
+        else if (MetIcIfConfigureHarmonics(pInfo, channelMask, (uint32_t)pArgs->v[1].d,
+                                           (float)pArgs->v[2].d) != 0)
+        {
+            WARN_MSG("Invalid channels, number of cycles or frequency. Use help startharmonics")
+        }
+        else if (UpdateWaveformStream() == ADI_METIC_STATUS_SUCCESS)
+        {
+            INFO_MSG("Harmonic analysis started on channels 0x%x with %d cycle windows at %d Hz",
+                     channelMask, pArgs->v[1].d, pArgs->v[2].d)
+        }
+        else
+        {
+            MetIcIfStopWfsConsumer(pInfo, &pInfo->harmonics.consumerId);
+            pInfo->harmonics.isEnabled = 0;
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help startharmonics")
+    }
+    return 0;
+}
+
+int32_t CmdGetHarmonics(Args *pArgs)
+{
+    if (pArgs->c == 0)
+    {
+        DisplayHarmonics();
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help getharmonics")
+    }
+    return 0;
+}
+
+int32_t CmdStopHarmonics(Args *pArgs)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if ((pArgs->c == 0) && (pInfo->harmonics.isEnabled == 1))
+    {
+        MetIcIfStopWfsConsumer(pInfo, &pInfo->harmonics.consumerId);
+        pInfo->harmonics.isEnabled = 0;
+        UpdateWaveformStream();
+        INFO_MSG("Harmonic analysis stopped")
+    }
+    else
+    {
+        WARN_MSG("Harmonic analysis is not running")
+    }
+    return 0;
+}
+
+int32_t CmdBenchHarmonics(Args *pArgs)
+{
+    if ((pArgs->c == 1) && (pArgs->v[0].d > 0))
+    {
+        BenchmarkHarmonics((uint32_t)pArgs->v[0].d);
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help benchharmonics")
+    }
+    return 0;
+}
+
+int32_t CmdSetGoertzel(Args *pArgs)
+{
+    uint32_t numOrders = 0;
+    uint32_t channelId = ADI_METIC_MAX_NUM_CHANNELS;
+    float orders[GOERTZEL_MAX_NUM_BINS];
+    char *pOrder;
+    char *pEndPtr;
+    int32_t status = 0;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if ((pArgs->c == 2) && (pInfo->goertzel.isEnabled == 0))
+    {
+        sscanf(pArgs->v[0].pS, "%" SCNu32, &channelId);
+        if (strcmp(pArgs->v[1].pS, "off") != 0)
+        {
+            // Orders are separated by commas.
+            pOrder = pArgs->v[1].pS;
+            while ((*pOrder != '\0') && (status == 0))
+            {
+                if (numOrders < GOERTZEL_MAX_NUM_BINS)
+                {
+                    orders[numOrders] = strtof(pOrder, &pEndPtr);
+                }
+                if ((numOrders >= GOERTZEL_MAX_NUM_BINS) || (pEndPtr == pOrder) ||
+                    ((*pEndPtr != ',') && (*pEndPtr != '\0')))
+                {
+                    status = 1;
+                }
+                else
+                {
+                    numOrders++;
+                    pOrder = (*pEndPtr == ',') ? pEndPtr + 1 : pEndPtr;
+                }
+            }
+        }
+        if ((status == 0) &&
+            (MetIcIfSetGoertzelOrders(pInfo, channelId, &orders[0], numOrders) == 0))
+        {
+            INFO_MSG("Goertzel bins of channel %u set to %u orders", channelId, numOrders)
+        }
+        else
+        {
+            WARN_MSG("Invalid channel or orders. Use help setgoertzel")
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments or Goertzel bank running. Use help setgoertzel")
+    }
+    return 0;
+}
+
+int32_t CmdStartGoertzel(Args *pArgs)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if (pArgs->c == 2)
+    {
+        if (IsWaveformBusy() == 1)
+        {
+            WARN_MSG("Waveform capture in progress")
+        }
+        else if (MetIcIfConfigureGoertzel(pInfo, (uint32_t)pArgs->v[0].d,
+                                          (float)pArgs->v[1].d) != 0)
+        {
+            WARN_MSG("No channel with bins or invalid cycles or frequency. Use help startgoertzel")
+        }
+        else if (UpdateWaveformStream() == ADI_METIC_STATUS_SUCCESS)
+        {
+            INFO_MSG("Goertzel bank started with %d cycle windows at %d Hz", pArgs->v[0].d,
+                     pArgs->v[1].d)
+        }
+        else
+        {
+            MetIcIfStopWfsConsumer(pInfo, &pInfo->goertzel.consumerId);
+            pInfo->goertzel.isEnabled = 0;
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help startgoertzel")
+    }
+    return 0;
+}
+
+int32_t CmdGetGoertzel(Args *pArgs)
+{
+    if (pArgs->c == 0)
+    {
+        DisplayGoertzel();
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help getgoertzel")
+    }
+    return 0;
+}
+
+int32_t CmdStopGoertzel(Args *pArgs)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if ((pArgs->c == 0) && (pInfo->goertzel.isEnabled == 1))
+    {
+        MetIcIfStopWfsConsumer(pInfo, &pInfo->goertzel.consumerId);
+        pInfo->goertzel.isEnabled = 0;
+        UpdateWaveformStream();
+        INFO_MSG("Goertzel bank stopped")
+    }
+    else
+    {
+        WARN_MSG("Goertzel bank is not running")
+    }
+    return 0;
+}
+
+int32_t CmdBenchGoertzel(Args *pArgs)
+{
+    if ((pArgs->c == 1) && (pArgs->v[0].d > 0))
+    {
+        BenchmarkGoertzel((uint32_t)pArgs->v[0].d);
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help benchgoertzel")
+    }
+    return 0;
+}
+
+int32_t CmdBenchFloatFormat(Args *pArgs)
+{
+    if ((pArgs->c == 1) && (pArgs->v[0].d > 0))
+    {
+        BenchmarkFloatFormat((uint32_t)pArgs->v[0].d);
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help benchfloatformat")
+    }
+    return 0;
+}
+
+int32_t CmdBenchCliLookup(Args *pArgs)
+{
+    if ((pArgs->c == 1) && (pArgs->v[0].d > 0))
+    {
+        BenchmarkCliLookup((uint32_t)pArgs->v[0].d);
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help benchclilookup")
+    }
+    return 0;
+}
+
+int32_t CmdSetTrigger(Args *pArgs)
+{
+    int32_t status = 0;
+    float value = 0;
+    uint32_t mask = 0;
+    uint32_t sampleChannel = ADI_METIC_MAX_NUM_CHANNELS;
+    int32_t threshold = 0;
+    METIC_EXAMPLE_CONFIG *pExampleConfig = GetExampleConfig();
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_TRIGGER_CONFIG config = pInfo->trigger.config;
+
+    if ((pArgs->c == 1) && (strcmp(pArgs->v[0].pS, "none") == 0))
+    {
+        config.sourceMask = 0;
+    }
+    else if ((pArgs->c == 2) && (strcmp(pArgs->v[0].pS, "dip") == 0))
+    {
+        // Levels are given in volts and compared with outputs before display scaling.
+        value = strtof(pArgs->v[1].pS, NULL);
+        config.dipLevel = value / pExampleConfig->displayConfig.voltageScale;
+        config.rmsChannelMask = TRIGGER_VOLTAGE_CHANNEL_MASK;
+        config.sourceMask |= METIC_TRIGGER_SOURCE_DIP;
+    }
+    else if ((pArgs->c == 2) && (strcmp(pArgs->v[0].pS, "swell") == 0))
+    {
+        value = strtof(pArgs->v[1].pS, NULL);
+        config.swellLevel = value / pExampleConfig->displayConfig.voltageScale;
+        config.rmsChannelMask = TRIGGER_VOLTAGE_CHANNEL_MASK;
+        config.sourceMask |= METIC_TRIGGER_SOURCE_SWELL;
+    }
+    else if ((pArgs->c == 2) && ((strcmp(pArgs->v[0].pS, "status0") == 0) ||
+                                 (strcmp(pArgs->v[0].pS, "status1") == 0)))
+    {
+        mask = (uint32_t)strtoul(pArgs->v[1].pS, NULL, 16);
+        if (pArgs->v[0].pS[6] == '0')
+        {
+            config.status0Mask = mask;
+        }
+        else
+        {
+            config.status1Mask = mask;
+        }
+        config.sourceMask |= METIC_TRIGGER_SOURCE_STATUS;
+    }
+    else if ((pArgs->c == 2) && (strcmp(pArgs->v[0].pS, "cfgap") == 0))
+    {
+        config.cfGapTime = (uint32_t)strtoul(pArgs->v[1].pS, NULL, 10) * 1000;
+        config.sourceMask |= METIC_TRIGGER_SOURCE_CF_GAP;
+    }
+    else if ((pArgs->c == 2) && (strcmp(pArgs->v[0].pS, "sample") == 0) &&
+             (sscanf(pArgs->v[1].pS, "%" SCNu32 ",%" SCNd32, &sampleChannel, &threshold) == 2))
+    {
+        config.sampleChannel = sampleChannel;
+        config.sampleThreshold = threshold;
+        config.sourceMask |= METIC_TRIGGER_SOURCE_SAMPLE;
+    }
+    else
+    {
+        status = 1;
+    }
+    if ((status == 0) && (MetIcIfConfigureTrigger(pInfo, &config) == 0))
+    {
+        INFO_MSG("Trigger sources set to 0x%x", config.sourceMask)
+    }
+    else
+    {
+        WARN_MSG("Invalid source, level or capture armed. Use help settrigger")
+    }
+    return 0;
+}
+
+int32_t CmdArmTrigger(Args *pArgs)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_TRIGGER_INFO *pTrigger = &pInfo->trigger;
+    if ((pArgs->c == 2) && (pArgs->v[0].d >= 0) && (pArgs->v[1].d > 0))
+    {
+        pTrigger->config.preTriggerTime = (uint32_t)pArgs->v[0].d;
+        pTrigger->config.postTriggerTime = (uint32_t)pArgs->v[1].d;
+        if (IsWaveformBusy() == 1)
+        {
+            WARN_MSG("Waveform capture in progress")
+        }
+        else if (MetIcIfArmTrigger(pInfo, TRIGGER_CHANNEL_MASK) != 0)
+        {
+            WARN_MSG("No trigger source or capture too long. Use help armtrigger")
+        }
+        else if (UpdateWaveformStream() == ADI_METIC_STATUS_SUCCESS)
+        {
+            INFO_MSG("Trigger armed with %d ms before and %d ms after trigger", pArgs->v[0].d,
+                     pArgs->v[1].d)
+        }
+        else
+        {
+            MetIcIfStopWfsConsumer(pInfo, &pTrigger->consumerId);
+            pTrigger->isEnabled = 0;
+            pTrigger->state = METIC_TRIGGER_STATE_IDLE;
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help armtrigger")
+    }
+    return 0;
+}
+
+int32_t CmdGetTrigger(Args *pArgs)
+{
+    if (pArgs->c == 0)
+    {
+        DisplayTrigger();
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help gettrigger")
+    }
+    return 0;
+}
+
+int32_t CmdStopTrigger(Args *pArgs)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    if ((pArgs->c == 0) && (pInfo->trigger.isEnabled == 1))
+    {
+        MetIcIfStopWfsConsumer(pInfo, &pInfo->trigger.consumerId);
+        pInfo->trigger.isEnabled = 0;
+        UpdateWaveformStream();
+        // A completed capture is kept for display.
+        if (pInfo->trigger.state != METIC_TRIGGER_STATE_COMPLETE)
+        {
+            pInfo->trigger.state = METIC_TRIGGER_STATE_IDLE;
+        }
+        INFO_MSG("Triggered capture stopped")
+    }
+    else
+    {
+        WARN_MSG("Triggered capture is not running")
+    }
+    return 0;
+}
+
+int32_t CmdGetWfsStream(Args *pArgs)
+{
+    if (pArgs->c == 0)
+    {
+        DisplayWfsStream();
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help getwfsstream")
+    }
+    return 0;
+}
+
+int32_t CmdPlanWfrm(Args *pArgs)
+{
+    uint32_t channelMask;
+    uint32_t captureTime;
+    ADI_METIC_WFS_PLAN plan;
+    if (pArgs->c == 2)
+    {
+        channelMask = (uint32_t)strtoul(pArgs->v[0].pS, NULL, 16);
+        captureTime = (uint32_t)strtoul(pArgs->v[1].pS, NULL, 10);
+        if (PlanWaveform(channelMask, ADE9178_ADC_SAMPLES, captureTime, &plan) ==
+            ADI_METIC_STATUS_SUCCESS)
+        {
+            INFO_MSG("Channels           : %u", plan.numChannels)
+            INFO_MSG("Sample bit rate    : %u bps", plan.sampleBitRate)
+            INFO_MSG("Required baud rate : %u", plan.requiredBaudRate)
+            INFO_MSG("Selected baud rate : %u, baudrate bits %u, %u %% headroom", plan.baudRate,
+                     plan.baudrateBits, plan.headroom)
+            INFO_MSG("WFS_CONFIG         : 0x%x", plan.config)
+            INFO_MSG("Buffer             : %u bytes for %u ms in %d blocks of %u bytes",
+                     plan.bufferNumBytes, captureTime, WFS_STREAM_NUM_BLOCKS, plan.blockNumBytes)
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help planwfrm")
+    }
+    return 0;
+}
+
 int32_t CmdLoadReg(Args *pArgs)
 {
     int32_t status = 0;
@@ -271,38 +943,31 @@ int32_t CmdSaveReg(Args *pArgs)
 int32_t CmdSetDisplay(Args *pArgs)
 {
     METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
-    /* Assumes structure contains only boolean flags*/
     uint8_t *pDisplayConfig = (uint8_t *)&pConfig->displayConfig;
     char *pParam = &commandParam[0];
     int32_t numChoices = sizeof(displayChoices) / sizeof(displayChoices[0]);
     int32_t choice;
+    int32_t i;
+    bool isOn;
     if (pArgs->c > 0)
     {
-        choice = GetChoice(displayChoices, pArgs->v[0].pS, numChoices, pParam);
+        choice = CliGetChoice(&displayLookup, displayChoices, pArgs->v[0].pS, numChoices, pParam);
 
         if (choice >= 0)
         {
             if (pArgs->c > 1)
             {
-                if (strcmp(pArgs->v[1].pS, "on") == 0)
-                {
-                    pDisplayConfig[choice] = true;
-                    INFO_MSG("display %s set to on", pArgs->v[0].pS)
-                }
-                else
+                isOn = (strcmp(pArgs->v[1].pS, "on") == 0);
+                INFO_MSG("display %s set to %s", pArgs->v[0].pS, isOn ? "on" : "off")
+                for (i = 0; i < numChoices; i++)
                 {
-                    INFO_MSG("display %s set to off", pArgs->v[0].pS)
-                    pDisplayConfig[choice] = false;
-                }
-
-                if (choice == 0)
-                {
-                    // Set all configs
-                    for (choice = 0; choice < numChoices; choice++)
+                    // Choice 0 sets all flags.
+                    if ((choice == 0) || (choice == i))
                     {
-                        pDisplayConfig[choice] = pDisplayConfig[0];
+                        *(bool *)&pDisplayConfig[displayFlagOffset[i]] = isOn;
                     }
                 }
+                CompileDisplayPlan(&pConfig->displayConfig);
             }
             else
             {
@@ -321,6 +986,93 @@ int32_t CmdSetDisplay(Args *pArgs)
 
     return 0;
 }
+
+int32_t CmdSetFormat(Args *pArgs)
+{
+    METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
+    char *pParam = &commandParam[0];
+    int32_t numChoices = sizeof(formatChoices) / sizeof(formatChoices[0]);
+    int32_t choice;
+    if (pArgs->c == 1)
+    {
+        choice = CliGetChoice(&formatLookup, formatChoices, pArgs->v[0].pS, numChoices, pParam);
+        if (choice >= 0)
+        {
+            pConfig->displayConfig.format = (ADE_DISPLAY_FORMAT)choice;
+            CompileDisplayPlan(&pConfig->displayConfig);
+            INFO_MSG("output format set to %s", formatChoices[choice])
+        }
+        else
+        {
+            WARN_MSG("Unsupported format %s. Use help setformat", pArgs->v[0].pS)
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help setformat")
+    }
+    return 0;
+}
+
+int32_t CmdSetRate(Args *pArgs)
+{
+    METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
+    char *pParam = &commandParam[0];
+    int32_t numChoices = sizeof(rateChoices) / sizeof(rateChoices[0]);
+    int32_t choice = -1;
+    uint32_t interval = 1;
+    if ((pArgs->c == 1) || (pArgs->c == 2))
+    {
+        choice = CliGetChoice(&rateLookup, rateChoices, pArgs->v[0].pS, numChoices, pParam);
+        if (pArgs->c == 2)
+        {
+            interval = (uint32_t)strtoul(pArgs->v[1].pS, NULL, 10);
+        }
+    }
+    if ((choice == ADE_DISPLAY_RATE_EVERY_CYCLE) && (pArgs->c == 1))
+    {
+        pConfig->displayConfig.rate = ADE_DISPLAY_RATE_EVERY_CYCLE;
+        INFO_MSG("outputs displayed every cycle")
+    }
+    else if ((choice > ADE_DISPLAY_RATE_EVERY_CYCLE) && (pArgs->c == 2) && (interval > 0))
+    {
+        pConfig->displayConfig.rate = (ADE_DISPLAY_RATE)choice;
+        pConfig->displayConfig.rateInterval = interval;
+        ResetOutputAggregate();
+        INFO_MSG("outputs aggregated over %d %s", interval, rateChoices[choice])
+    }
+    else
+    {
+        WARN_MSG("Wrong arguments. Use help setrate")
+    }
+    return 0;
+}
+
+int32_t CmdSetLog(Args *pArgs)
+{
+    char *pParam = &commandParam[0];
+    int32_t numChoices = sizeof(logModeChoices) / sizeof(logModeChoices[0]);
+    int32_t choice;
+    if (pArgs->c == 1)
+    {
+        choice = CliGetChoice(&logModeLookup, logModeChoices, pArgs->v[0].pS, numChoices, pParam);
+        if (choice >= 0)
+        {
+            DeferredLogSetMode((DEFERRED_LOG_MODE)choice);
+            INFO_MSG("log mode set to %s", logModeChoices[choice])
+        }
+        else
+        {
+            WARN_MSG("Unsupported mode %s. Use help setlog", pArgs->v[0].pS)
+        }
+    }
+    else
+    {
+        WARN_MSG("Wrong number of arguments. Use help setlog")
+    }
+    return 0;
+}
+
 int32_t CmdSetConfig(Args *pArgs)
 {
     uint16_t configChoice;
@@ -394,7 +1146,7 @@ int32_t CmdSetRegData(Args *pArgs)
 
     if (pArgs->c == 3)
     {
-        choice = GetChoice(deviceChoices, pArgs->v[0].pS, numChoices, pParam);
+        choice = CliGetChoice(&deviceLookup, deviceChoices, pArgs->v[0].pS, numChoices, pParam);
         if (choice >= 0 && choice <= numChoices)
         {
             device = (uint8_t)choice;
@@ -473,7 +1225,7 @@ int32_t CmdGetRegData(Args *pArgs)
     char *pParam = &commandParam[0];
     if (pArgs->c == 3)
     {
-        choice = GetChoice(deviceChoices, pArgs->v[0].pS, numChoices, pParam);
+        choice = CliGetChoice(&deviceLookup, deviceChoices, pArgs->v[0].pS, numChoices, pParam);
         if (choice >= 0 && choice <= numChoices)
         {
             device = (uint8_t)choice;
@@ -518,6 +1270,176 @@ int32_t CmdGetRegData(Args *pArgs)
     return 0;
 }
 
+int32_t CmdGetRegs(Args *pArgs)
+{
+    int32_t status = 0;
+    int32_t i;
+    int32_t choice = -1;
+    int32_t numChoices = sizeof(deviceChoices) / sizeof(deviceChoices[0]);
+    uint32_t numRanges = 0;
+    uint32_t numRangesRead = 0;
+    uint32_t numRegisters = 0;
+    char *pParam = &commandParam[0];
+    ADI_METIC_STATUS adeStatus;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    static REG_BATCH_RANGE ranges[APP_CFG_CLI_MAX_PARAM_COUNT];
+
+    if (pArgs->c >= 2)
+    {
+        choice = CliGetChoice(&deviceLookup, deviceChoices, pArgs->v[0].pS, numChoices, pParam);
+    }
+    if ((choice < 0) || (choice == READ_ALL_ADC_DEVICE))
+    {
+        WARN_MSG("Wrong arguments. Use help getregs")
+        status = 1;
+    }
+    // Whole line is checked before the first read.
+    for (i = 1; (i < pArgs->c) && (status == 0); i++)
+    {
+        if (RegBatchParseRange(pArgs->v[i].pS, &ranges[numRanges]) != 0)
+        {
+            WARN_MSG("Invalid range %s. Use help getregs", pArgs->v[i].pS)
+            status = 1;
+        }
+        else
+        {
+            numRegisters += ranges[numRanges].numRegisters;
+            numRanges++;
+        }
+    }
+    if ((status == 0) && (numRegisters > ADI_METIC_MAX_NUM_REGISTERS))
+    {
+        WARN_MSG("Ranges have more than %d registers", ADI_METIC_MAX_NUM_REGISTERS)
+        status = 1;
+    }
+    if (status == 0)
+    {
+        adeStatus = RegBatchRead(pInfo->hAde, (uint8_t)choice, &ranges[0], numRanges,
+                                 &pInfo->regBuffer[0], &numRangesRead);
+        RegBatchDisplay(&ranges[0], numRangesRead, &pInfo->regBuffer[0]);
+        if (adeStatus != ADI_METIC_STATUS_SUCCESS)
+        {
+            DisplayErrorCode(ranges[numRangesRead].address, 1, 0, adeStatus);
+        }
+        INFO_MSG("Read %d of %d ranges", numRangesRead, numRanges)
+    }
+    return 0;
+}
+
+int32_t CmdSetRegs(Args *pArgs)
+{
+    int32_t status = 0;
+    int32_t i;
+    int32_t choice = -1;
+    int32_t numChoices = sizeof(deviceChoices) / sizeof(deviceChoices[0]);
+    uint32_t numWrites = 0;
+    uint32_t numWritten = 0;
+    char *pParam = &commandParam[0];
+    REG_BATCH_WRITE *pWrites;
+    REG_BATCH_SCRIPT *pScript = RegBatchGetScript();
+    ADI_METIC_STATUS adeStatus;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    static REG_BATCH_WRITE writes[APP_CFG_CLI_MAX_PARAM_COUNT];
+
+    if ((pArgs->c == 1) && (strcmp(pArgs->v[0].pS, "script") == 0))
+    {
+        pWrites = &pScript->writes[0];
+        numWrites = pScript->numWrites;
+    }
+    else
+    {
+        pWrites = &writes[0];
+        if (pArgs->c >= 2)
+        {
+            choice = CliGetChoice(&deviceLookup, deviceChoices, pArgs->v[0].pS, numChoices, pParam);
+        }
+        if (choice < 0)
+        {
+            WARN_MSG("Wrong arguments. Use help setregs")
+            status = 1;
+        }
+        // Whole line is checked before the first write.
+        for (i = 1; (i < pArgs->c) && (status == 0); i++)
+        {
+            if (RegBatchParseWrite(pArgs->v[i].pS, (uint8_t)choice, &writes[numWrites]) != 0)
+            {
+                WARN_MSG("Invalid write %s. Use help setregs", pArgs->v[i].pS)
+                status = 1;
+            }
+            numWrites++;
+        }
+    }
+    if (status == 0)
+    {
+        adeStatus = RegBatchWrite(pInfo->hAde, pWrites, numWrites, &numWritten);
+        if (adeStatus != ADI_METIC_STATUS_SUCCESS)
+        {
+            DisplayErrorCode(pWrites[numWritten].address, 0, pWrites[numWritten].value,
+                             adeStatus);
+        }
+        INFO_MSG("Wrote %d of %d registers", numWritten, numWrites)
+    }
+    return 0;
+}
+
+int32_t CmdRegScript(Args *pArgs)
+{
+    int32_t status = 0;
+    int32_t i;
+    int32_t choice = -1;
+    int32_t device = -1;
+    int32_t numChoices = sizeof(scriptChoices) / sizeof(scriptChoices[0]);
+    int32_t numDeviceChoices = sizeof(deviceChoices) / sizeof(deviceChoices[0]);
+    uint32_t numWrites;
+    char *pParam = &commandParam[0];
+    REG_BATCH_SCRIPT *pScript = RegBatchGetScript();
+
+    if (pArgs->c >= 1)
+    {
+        choice = CliGetChoice(&scriptLookup, scriptChoices, pArgs->v[0].pS, numChoices, pParam);
+    }
+    if ((choice == 0) && (pArgs->c >= 3))
+    {
+        device = CliGetChoice(&deviceLookup, deviceChoices, pArgs->v[1].pS, numDeviceChoices,
+                              pParam);
+    }
+    if ((choice == 0) && (device >= 0))
+    {
+        // Line is added only if all its writes are valid and fit.
+        numWrites = pScript->numWrites;
+        for (i = 2; (i < pArgs->c) && (status == 0); i++)
+        {
+            if (numWrites >= REG_BATCH_SCRIPT_MAX_WRITES)
+            {
+                WARN_MSG("Script is full with %d writes", REG_BATCH_SCRIPT_MAX_WRITES)
+                status = 1;
+            }
+            else if (RegBatchParseWrite(pArgs->v[i].pS, (uint8_t)device,
+                                        &pScript->writes[numWrites]) != 0)
+            {
+                WARN_MSG("Invalid write %s. Use help regscript", pArgs->v[i].pS)
+                status = 1;
+            }
+            numWrites++;
+        }
+        if (status == 0)
+        {
+            pScript->numWrites = numWrites;
+        }
+        INFO_MSG("Script has %d writes", pScript->numWrites)
+    }
+    else if ((choice == 1) && (pArgs->c == 1))
+    {
+        pScript->numWrites = 0;
+        INFO_MSG("Script has %d writes", pScript->numWrites)
+    }
+    else
+    {
+        WARN_MSG("Wrong arguments. Use help regscript")
+    }
+    return 0;
+}
+
 void GetRegisterValue(uint8_t device, uint16_t address, uint16_t numReg)
 {
     ADI_METIC_STATUS adeStatus;
@@ -612,6 +1534,238 @@ void DescDisplay(void)
     }
 }
 
+ADI_METIC_STATUS StartWaveformStream(uint32_t channelMask)
+{
+    int32_t wfsData;
+    ADI_METIC_WFS_PLAN plan;
+    ADI_METIC_STATUS adeStatus;
+    METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    adeStatus = PlanWaveform(channelMask, ADE9178_ADC_SAMPLES, 0, &plan);
+    if (adeStatus == ADI_METIC_STATUS_SUCCESS)
+    {
+        wfsData = plan.config;
+        adeStatus = adi_metic_WriteRegister(pInfo->hAde, 0, ADE9178_REG_WFS_CONFIG, &wfsData);
+        if (adeStatus == ADI_METIC_STATUS_SUCCESS)
+        {
+            pConfig->wfsConfig = wfsData;
+            adeStatus = MetIcIfStartWfsStream(pInfo, wfsData);
+        }
+        if (adeStatus != ADI_METIC_STATUS_SUCCESS)
+        {
+            DisplayErrorCode(ADE9178_REG_WFS_CONFIG, 0, wfsData, adeStatus);
+        }
+    }
+    return adeStatus;
+}
+
+ADI_METIC_STATUS PlanWaveform(uint32_t channelMask, uint32_t srcType, uint32_t captureTime,
+                              ADI_METIC_WFS_PLAN *pPlan)
+{
+    ADI_METIC_STATUS adeStatus;
+    ADI_METIC_WFS_PLAN_CONFIG planConfig = {0};
+
+    planConfig.channelSelect = channelMask;
+    planConfig.samplingRate = ADI_METIC_SAMPLING_RATE;
+    planConfig.outputType = srcType;
+    planConfig.captureTime = captureTime;
+    planConfig.numBlocks = WFS_STREAM_NUM_BLOCKS;
+    adeStatus = adi_metic_WfsPlanBandwidth(&planConfig, pPlan);
+    if (adeStatus == ADI_METIC_STATUS_WFS_BANDWIDTH_EXCEEDED)
+    {
+        WARN_MSG("Channels 0x%x at %d Hz exceed waveform UART bandwidth", channelMask,
+                 ADI_METIC_SAMPLING_RATE)
+    }
+    else if (adeStatus != ADI_METIC_STATUS_SUCCESS)
+    {
+        WARN_MSG("Invalid waveform configuration")
+    }
+    return adeStatus;
+}
+
+void StopWaveformStream(void)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    // Stream ends when the block in progress is received. Disabling WFS before would leave that
+    // reception pending for good.
+    MetIcIfStopWfsStream(pInfo);
+    isWfsStopPending = 1;
+    ServiceWaveformStream();
+}
+
+void ServiceWaveformStream(void)
+{
+    int32_t wfsData = 0;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    ADI_METIC_WFS_STREAM_STATUS streamStatus = {0};
+
+    if (isWfsStopPending == 1)
+    {
+        adi_metic_WfsGetStreamStatus(pInfo->hAde, &streamStatus);
+        if (streamStatus.isStreaming == 0)
+        {
+            isWfsStopPending = 0;
+            if (wfsPendingChannelMask == 0)
+            {
+                adi_metic_WriteRegister(pInfo->hAde, 0, ADE9178_REG_WFS_CONFIG, &wfsData);
+            }
+            else if (StartWaveformStream(wfsPendingChannelMask) == ADI_METIC_STATUS_SUCCESS)
+            {
+                wfsStreamChannelMask = wfsPendingChannelMask;
+                RestartWaveformAnalyses();
+            }
+            else
+            {
+                // Analyses can not run without their stream.
+                WARN_MSG("Waveform stream not restarted. Analyses stopped")
+                StopWaveformAnalyses();
+                adi_metic_WriteRegister(pInfo->hAde, 0, ADE9178_REG_WFS_CONFIG, &wfsData);
+                wfsStreamChannelMask = 0;
+            }
+            wfsPendingChannelMask = 0;
+        }
+    }
+}
+
+int32_t IsWaveformStreaming(void)
+{
+    int32_t isStreaming = 0;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    ADI_METIC_WFS_STREAM_STATUS streamStatus = {0};
+
+    adi_metic_WfsGetStreamStatus(pInfo->hAde, &streamStatus);
+    if ((streamStatus.isStreaming == 1) || (isWfsStopPending == 1))
+    {
+        isStreaming = 1;
+    }
+    return isStreaming;
+}
+
+int32_t IsWaveformBusy(void)
+{
+    int32_t isBusy = 0;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    if (pInfo->enableWfsCapture == 1)
+    {
+        isBusy = 1;
+    }
+    return isBusy;
+}
+
+ADI_METIC_STATUS UpdateWaveformStream(void)
+{
+    ADI_METIC_STATUS adeStatus = ADI_METIC_STATUS_SUCCESS;
+    uint32_t channelMask = GetAnalysisChannelMask();
+    ADI_METIC_WFS_PLAN plan;
+    ADI_METIC_WFS_STREAM_STATUS streamStatus = {0};
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    adi_metic_WfsGetStreamStatus(pInfo->hAde, &streamStatus);
+    if (channelMask == 0)
+    {
+        wfsPendingChannelMask = 0;
+        // WFS is disabled also if the stream has ended on its own.
+        if (((streamStatus.isStreaming == 1) || (wfsStreamChannelMask != 0)) &&
+            (isWfsStopPending == 0))
+        {
+            StopWaveformStream();
+        }
+        wfsStreamChannelMask = 0;
+    }
+    else if ((isWfsStopPending == 1) || (streamStatus.isStreaming == 0) ||
+             ((channelMask & ~wfsStreamChannelMask) != 0))
+    {
+        // Running stream is kept if channels of all analyses do not fit in WFS UART. Stream is
+        // not restarted with fewer channels when an analysis stops.
+        adeStatus = PlanWaveform(channelMask, ADE9178_ADC_SAMPLES, 0, &plan);
+        if ((adeStatus == ADI_METIC_STATUS_SUCCESS) && (isWfsStopPending == 0) &&
+            (streamStatus.isStreaming == 0))
+        {
+            adeStatus = StartWaveformStream(channelMask);
+            if (adeStatus == ADI_METIC_STATUS_SUCCESS)
+            {
+                wfsStreamChannelMask = channelMask;
+            }
+        }
+        else if (adeStatus == ADI_METIC_STATUS_SUCCESS)
+        {
+            // WFS configuration is written once the running stream has received its last
+            // block, by ServiceWaveformStream.
+            wfsPendingChannelMask = channelMask;
+            if (isWfsStopPending == 0)
+            {
+                StopWaveformStream();
+            }
+            INFO_MSG("Waveform stream restarts with channels 0x%x", channelMask)
+        }
+    }
+    return adeStatus;
+}
+
+void RestartWaveformAnalyses(void)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_HARMONICS_INFO *pHarmonics = &pInfo->harmonics;
+    METIC_GOERTZEL_INFO *pGoertzel = &pInfo->goertzel;
+
+    // Frames of the new stream hold other channels, so validators and windows start again.
+    // Consumers stay registered.
+    if (pHarmonics->isEnabled == 1)
+    {
+        MetIcIfConfigureHarmonics(pInfo, pHarmonics->channelMask, pHarmonics->numCycles,
+                                  pHarmonics->frequency);
+    }
+    if (pGoertzel->isEnabled == 1)
+    {
+        MetIcIfConfigureGoertzel(pInfo, pGoertzel->numCycles, pGoertzel->frequency);
+    }
+    if ((pInfo->trigger.isEnabled == 1) &&
+        ((pInfo->trigger.state == METIC_TRIGGER_STATE_ARMED) ||
+         (pInfo->trigger.state == METIC_TRIGGER_STATE_TRIGGERED)))
+    {
+        MetIcIfArmTrigger(pInfo, TRIGGER_CHANNEL_MASK);
+    }
+}
+
+void StopWaveformAnalyses(void)
+{
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    MetIcIfStopWfsConsumer(pInfo, &pInfo->harmonics.consumerId);
+    pInfo->harmonics.isEnabled = 0;
+    MetIcIfStopWfsConsumer(pInfo, &pInfo->goertzel.consumerId);
+    pInfo->goertzel.isEnabled = 0;
+    MetIcIfStopWfsConsumer(pInfo, &pInfo->trigger.consumerId);
+    pInfo->trigger.isEnabled = 0;
+    if (pInfo->trigger.state != METIC_TRIGGER_STATE_COMPLETE)
+    {
+        pInfo->trigger.state = METIC_TRIGGER_STATE_IDLE;
+    }
+}
+
+uint32_t GetAnalysisChannelMask(void)
+{
+    uint32_t channelMask = 0;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    if (pInfo->harmonics.isEnabled == 1)
+    {
+        channelMask |= pInfo->harmonics.channelMask;
+    }
+    if (pInfo->goertzel.isEnabled == 1)
+    {
+        channelMask |= pInfo->goertzel.channelMask;
+    }
+    if (pInfo->trigger.isEnabled == 1)
+    {
+        channelMask |= TRIGGER_CHANNEL_MASK;
+    }
+    return channelMask;
+}
+
 #if BOARD_CFG_RESET_TYPE == 1
 int32_t ResetEvb(Args *pArgs)
 {
@@ -0,0 +1,142 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        cli_lookup.c
+ * @brief       Hashed lookup of command names and option keywords.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "cli_lookup.h"
+#include "adi_cli.h"
+#include "adi_cli_utility.h"
+#include <stdint.h>
+#include <string.h>
+
+/*============= D E F I N E S =============*/
+
+/** Offset basis of FNV-1a hash */
+#define CLI_LOOKUP_HASH_BASIS 2166136261u
+/** Prime of FNV-1a hash */
+#define CLI_LOOKUP_HASH_PRIME 16777619u
+
+/**
+ * @brief Computes FNV-1a hash of a name.
+ * @param[in] pName - pointer to name.
+ * @param[in] length - number of characters.
+ * @return hash
+ */
+static uint32_t HashName(const char *pName, uint32_t length);
+
+/**
+ * @brief Returns name of an entry of table.
+ * @param[in] pLookup - pointer to lookup.
+ * @param[in] index - index of entry.
+ * @return pointer to name
+ */
+static const char *GetName(CLI_LOOKUP *pLookup, uint32_t index);
+
+/*=============  C O D E  =============*/
+
+int32_t CliLookupInit(CLI_LOOKUP *pLookup, const char *const *ppFirstName, uint32_t stride,
+                      uint32_t numNames)
+{
+    int32_t status = 1;
+    uint32_t i;
+    uint32_t pos;
+    const char *pName;
+
+    memset(&pLookup->slot[0], 0, sizeof(pLookup->slot));
+    pLookup->pNames = (const uint8_t *)ppFirstName;
+    pLookup->stride = stride;
+    pLookup->numNames = 0;
+    if (numNames <= CLI_LOOKUP_MAX_NUM_NAMES)
+    {
+        for (i = 0; i < numNames; i++)
+        {
+            pName = GetName(pLookup, i);
+            pos = HashName(pName, (uint32_t)strlen(pName));
+            // Linear probing. A duplicate name keeps the first entry, as a linear search would.
+            while ((pLookup->slot[pos % CLI_LOOKUP_NUM_SLOTS] != 0) &&
+                   (strcmp(GetName(pLookup, pLookup->slot[pos % CLI_LOOKUP_NUM_SLOTS] - 1u),
+                           pName) != 0))
+            {
+                pos++;
+            }
+            if (pLookup->slot[pos % CLI_LOOKUP_NUM_SLOTS] == 0)
+            {
+                pLookup->slot[pos % CLI_LOOKUP_NUM_SLOTS] = (uint8_t)(i + 1);
+            }
+        }
+        pLookup->numNames = numNames;
+        status = 0;
+    }
+    return status;
+}
+
+int32_t CliLookupFind(CLI_LOOKUP *pLookup, const char *pName, uint32_t length)
+{
+    int32_t index = -1;
+    uint32_t pos = HashName(pName, length);
+    uint32_t entry = pLookup->slot[pos % CLI_LOOKUP_NUM_SLOTS];
+    const char *pEntryName;
+
+    // Slots are at most half full, so that an empty slot ends the probe after a few entries.
+    while ((entry != 0) && (index < 0))
+    {
+        pEntryName = GetName(pLookup, entry - 1);
+        if ((strncmp(pEntryName, pName, length) == 0) && (pEntryName[length] == '\0'))
+        {
+            index = (int32_t)entry - 1;
+        }
+        pos++;
+        entry = pLookup->slot[pos % CLI_LOOKUP_NUM_SLOTS];
+    }
+    return index;
+}
+
+int32_t CliGetChoice(CLI_LOOKUP *pLookup, char **ppChoices, char *pArg, int32_t numChoices,
+                     char *pParam)
+{
+    int32_t choice = -1;
+
+    if ((pLookup->numNames == 0) && (numChoices > 0))
+    {
+        CliLookupInit(pLookup, (const char *const *)ppChoices, sizeof(char *),
+                      (uint32_t)numChoices);
+    }
+    if (pLookup->numNames == (uint32_t)numChoices)
+    {
+        choice = CliLookupFind(pLookup, pArg, (uint32_t)strlen(pArg));
+    }
+    if (choice < 0)
+    {
+        // Anything else GetChoice accepts is still accepted.
+        choice = GetChoice(ppChoices, pArg, numChoices, pParam);
+    }
+    return choice;
+}
+
+uint32_t HashName(const char *pName, uint32_t length)
+{
+    uint32_t i;
+    uint32_t hash = CLI_LOOKUP_HASH_BASIS;
+
+    for (i = 0; i < length; i++)
+    {
+        hash = (hash ^ (uint8_t)pName[i]) * CLI_LOOKUP_HASH_PRIME;
+    }
+    return hash;
+}
+
+const char *GetName(CLI_LOOKUP *pLookup, uint32_t index)
+{
+    return *(const char *const *)(pLookup->pNames + index * pLookup->stride);
+}
+
+/**
+ * @}
+ */
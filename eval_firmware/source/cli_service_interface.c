@@ -11,6 +11,7 @@
 #include "cli_service_interface.h"
 #include "adi_cli.h"
 #include "adi_evb.h"
+#include "cli_lookup.h"
 #include "dispatch_table.h"
 #include <stdlib.h>
 
@@ -19,6 +20,14 @@
 static int32_t CliReceiveAsync(void *pInfo, char *pData, uint32_t numBytes);
 static int32_t CliTransmitAsync(void *pInfo, uint8_t *pData, uint32_t numBytes);
 static void PopulateCliConfig(CLI_INTERFACE_INFO *pInfo);
+static void StartBinaryChunk(void);
+
+/** Binary transmit queue */
+static CLI_TX_QUEUE txQueue;
+/** Lookup of command names of dispatch table */
+static CLI_LOOKUP commandLookup;
+/** Status of building command lookup, 0 if it is built */
+static int32_t commandLookupStatus = 1;
 
 /*============= C O D E =============*/
 
@@ -35,6 +44,44 @@ ADI_CLI_STATUS CliCreateInstance(CLI_INTERFACE_INFO *pInfo)
     {
         status = adi_cli_Init(pInfo->hCli, pConfig);
         adi_cli_SetHandleTerminal(pInfo->hCli);
+        // Size of dispatch table is checked against the lookup at compile time. Commands are
+        // found by walking the table if the lookup is not built.
+        commandLookupStatus = CliLookupInit(&commandLookup,
+                                            (const char *const *)&dispatchTable[0].name,
+                                            sizeof(Command), NUM_COMMANDS);
+    }
+    return status;
+}
+
+ADI_CLI_STATUS CliDispatch(ADI_CLI_HANDLE hCli, char *pCommand)
+{
+    ADI_CLI_STATUS status;
+    uint32_t length = 0;
+    int32_t index = -1;
+    char *pName = pCommand;
+
+    while ((*pName == ' ') || (*pName == '\t'))
+    {
+        pName++;
+    }
+    while ((pName[length] != '\0') && (pName[length] != ' ') && (pName[length] != '\t') &&
+           (pName[length] != '\r') && (pName[length] != '\n'))
+    {
+        length++;
+    }
+    if (commandLookupStatus == 0)
+    {
+        index = CliLookupFind(&commandLookup, pName, length);
+    }
+    if (index >= 0)
+    {
+        // CLI finds the command in a table of one entry instead of walking the table.
+        status = adi_cli_Dispatch(hCli, pCommand, &dispatchTable[index], 1);
+    }
+    else
+    {
+        // Help and unknown commands need the whole table.
+        status = adi_cli_Dispatch(hCli, pCommand, dispatchTable, NUM_COMMANDS);
     }
     return status;
 }
@@ -61,11 +108,117 @@ int32_t CliTransmitAsync(void *pInfo, uint8_t *pData, uint32_t numBytes)
     int32_t status = 0;
     if (pInfo != NULL)
     {
-        status = EvbHostUartTransmitAsync(pInfo, pData, numBytes);
+        txQueue.hUart = pInfo;
+        txQueue.isCliBusy = 1;
+        if (txQueue.isBinaryMode == 1)
+        {
+            // CLI sees a slow UART. Its transfer completes after the binary transfer.
+            txQueue.heldCliChunk.pData = pData;
+            txQueue.heldCliChunk.numBytes = numBytes;
+        }
+        else
+        {
+            status = EvbHostUartTransmitAsync(pInfo, pData, numBytes);
+        }
     }
     return status;
 }
 
+void CliTxCallback(CLI_INTERFACE_INFO *pInfo)
+{
+    CLI_TX_QUEUE *pQueue = &txQueue;
+    if (pQueue->isChunkBusy == 1)
+    {
+        pQueue->isChunkBusy = 0;
+        pQueue->readIndex++;
+        StartBinaryChunk();
+    }
+    else
+    {
+        pQueue->isCliBusy = 0;
+        adi_cli_TxCallback(pInfo->hCli);
+    }
+}
+
+int32_t CliBeginBinary(ADI_CLI_HANDLE hCli)
+{
+    CLI_TX_QUEUE *pQueue = &txQueue;
+    // Header line of the transfer is sent by CLI before UART is taken over.
+    if ((adi_cli_FlushMessages(hCli) == 0) && (pQueue->isCliBusy == 0) &&
+        (pQueue->hUart != NULL))
+    {
+        pQueue->isBinaryMode = 1;
+        StartBinaryChunk();
+    }
+    return (int32_t)pQueue->isBinaryMode;
+}
+
+int32_t CliQueueBinary(uint8_t *pData, uint32_t numBytes)
+{
+    int32_t status = 1;
+    CLI_TX_QUEUE *pQueue = &txQueue;
+    uint32_t writeIndex = pQueue->writeIndex;
+    if (CliGetBinaryFreeChunks() > 0)
+    {
+        pQueue->chunk[writeIndex % CLI_TX_QUEUE_NUM_CHUNKS].pData = pData;
+        pQueue->chunk[writeIndex % CLI_TX_QUEUE_NUM_CHUNKS].numBytes = numBytes;
+        pQueue->writeIndex = writeIndex + 1;
+        // Callback is not pending while no chunk is busy, so the queue is restarted here.
+        if (pQueue->isChunkBusy == 0)
+        {
+            StartBinaryChunk();
+        }
+        status = 0;
+    }
+    return status;
+}
+
+uint32_t CliGetBinaryFreeChunks(void)
+{
+    return CLI_TX_QUEUE_NUM_CHUNKS - (txQueue.writeIndex - txQueue.readIndex);
+}
+
+int32_t CliEndBinary(void)
+{
+    CLI_TX_QUEUE *pQueue = &txQueue;
+    if ((pQueue->isBinaryMode == 1) && (pQueue->isChunkBusy == 0) &&
+        (pQueue->readIndex == pQueue->writeIndex))
+    {
+        pQueue->isBinaryMode = 0;
+        if (pQueue->heldCliChunk.numBytes > 0)
+        {
+            EvbHostUartTransmitAsync(pQueue->hUart, pQueue->heldCliChunk.pData,
+                                     pQueue->heldCliChunk.numBytes);
+            pQueue->heldCliChunk.numBytes = 0;
+        }
+    }
+    return (pQueue->isBinaryMode == 0) ? 1 : 0;
+}
+
+int32_t CliIsBinaryMode(void)
+{
+    return (int32_t)txQueue.isBinaryMode;
+}
+
+void StartBinaryChunk(void)
+{
+    CLI_TX_QUEUE *pQueue = &txQueue;
+    CLI_TX_CHUNK *pChunk;
+    // Chunks which fail to start are dropped rather than stalling the queue. No callback follows
+    // a failed start, so the next chunk is tried here until one starts or the queue is empty.
+    while ((pQueue->isBinaryMode == 1) && (pQueue->isChunkBusy == 0) &&
+           (pQueue->readIndex != pQueue->writeIndex))
+    {
+        pChunk = &pQueue->chunk[pQueue->readIndex % CLI_TX_QUEUE_NUM_CHUNKS];
+        pQueue->isChunkBusy = 1;
+        if (EvbHostUartTransmitAsync(pQueue->hUart, pChunk->pData, pChunk->numBytes) != 0)
+        {
+            pQueue->isChunkBusy = 0;
+            pQueue->readIndex++;
+        }
+    }
+}
+
 /**
  * @}
  */
\ No newline at end of file
@@ -0,0 +1,250 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        deferred_log.c
+ * @brief       Log of messages whose formatting is deferred to the host.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "deferred_log.h"
+#include "example_display.h"
+#include "message.h"
+#include <stdint.h>
+
+/*============= D E F I N E S =============*/
+
+/** Number of words of queue. Power of 2, so that free running indices wrap around */
+#define DEFERRED_LOG_NUM_WORDS 256
+/** Maximum number of bytes of messages in a line */
+#define DEFERRED_LOG_LINE_NUM_BYTES 300
+/** Message space needed for a line, with margin for prefix and end of line */
+#define DEFERRED_LOG_LINE_MSG_SIZE ((DEFERRED_LOG_LINE_NUM_BYTES + 2) / 3 * 4 + 16)
+/** Position of number of arguments in header word of a message */
+#define DEFERRED_LOG_NUM_ARGS_POS 12
+/** Position of sequence number in header word of a message */
+#define DEFERRED_LOG_SEQUENCE_POS 16
+/** Maximum number of characters of a message formatted in text mode, with terminating null */
+#define DEFERRED_LOG_TEXT_NUM_CHARS 200
+/** Maximum number of arguments of a message */
+#define DEFERRED_LOG_MAX_NUM_ARGS 2
+
+/**
+ * Level of a message
+ */
+typedef enum
+{
+    /** Information */
+    DEFERRED_LOG_LEVEL_INFO,
+    /** Warning */
+    DEFERRED_LOG_LEVEL_WARN,
+    /** Error */
+    DEFERRED_LOG_LEVEL_ERROR
+} DEFERRED_LOG_LEVEL;
+
+/**
+ * State of the log
+ */
+typedef struct
+{
+    /** Mode of log */
+    DEFERRED_LOG_MODE mode;
+    /** Free running index of next word to write. Updated only by writer */
+    volatile uint32_t writeIndex;
+    /** Free running index of next word to read. Updated only by flush */
+    volatile uint32_t readIndex;
+    /** Sequence number of next message, including dropped messages */
+    uint32_t sequence;
+    /** Queue of messages. Header word with id, number of arguments and sequence, followed by
+     * arguments */
+    volatile uint32_t buffer[DEFERRED_LOG_NUM_WORDS];
+} DEFERRED_LOG_INFO;
+
+/** Expands an entry of #DEFERRED_LOG_TABLE into its level */
+#define DEFERRED_LOG_ENTRY(id, level, format) DEFERRED_LOG_LEVEL_##level,
+/** Level of messages */
+static const uint8_t deferredLogLevel[LOG_ID_NUM_MESSAGES] = {DEFERRED_LOG_TABLE};
+#undef DEFERRED_LOG_ENTRY
+
+/** Expands an entry of #DEFERRED_LOG_TABLE into its format */
+#define DEFERRED_LOG_ENTRY(id, level, format) format,
+/** Format of messages, used in text mode */
+static const char *const deferredLogFormat[LOG_ID_NUM_MESSAGES] = {DEFERRED_LOG_TABLE};
+#undef DEFERRED_LOG_ENTRY
+
+/** State of the log */
+static DEFERRED_LOG_INFO deferredLog;
+
+/**
+ * @brief Formats a message in text mode. Only %d, %u, %x and %% are converted, as arguments are
+ * 32 bit integers, and other characters are copied. Formats of the table are thus never given to
+ * printf, which would read past the arguments on other conversions.
+ * @param[out] pDst - buffer of #DEFERRED_LOG_TEXT_NUM_CHARS characters.
+ * @param[in] pFormat - format of message.
+ * @param[in] arg0 - first argument.
+ * @param[in] arg1 - second argument.
+ */
+static void FormatMessage(char *pDst, const char *pFormat, uint32_t arg0, uint32_t arg1);
+
+/*=============  C O D E  =============*/
+
+void DeferredLogSetMode(DEFERRED_LOG_MODE mode)
+{
+    deferredLog.mode = mode;
+}
+
+DEFERRED_LOG_MODE DeferredLogGetMode(void)
+{
+    return deferredLog.mode;
+}
+
+void DeferredLogWrite(DEFERRED_LOG_ID id, uint32_t numArgs, uint32_t arg0, uint32_t arg1)
+{
+    DEFERRED_LOG_INFO *pLog = &deferredLog;
+    uint32_t writeIndex = pLog->writeIndex;
+    uint32_t level = deferredLogLevel[id];
+    char text[DEFERRED_LOG_TEXT_NUM_CHARS];
+
+    if (pLog->mode == DEFERRED_LOG_MODE_DEFERRED)
+    {
+        // Dropped messages take a sequence number, so that the host can count them.
+        if (DEFERRED_LOG_NUM_WORDS - (writeIndex - pLog->readIndex) >= numArgs + 1)
+        {
+            pLog->buffer[writeIndex % DEFERRED_LOG_NUM_WORDS] =
+                (uint32_t)id | (numArgs << DEFERRED_LOG_NUM_ARGS_POS) |
+                (pLog->sequence << DEFERRED_LOG_SEQUENCE_POS);
+            if (numArgs > 0)
+            {
+                pLog->buffer[(writeIndex + 1) % DEFERRED_LOG_NUM_WORDS] = arg0;
+            }
+            if (numArgs > 1)
+            {
+                pLog->buffer[(writeIndex + 2) % DEFERRED_LOG_NUM_WORDS] = arg1;
+            }
+            // Message is visible to flush only once complete
+            pLog->writeIndex = writeIndex + numArgs + 1;
+        }
+        pLog->sequence++;
+    }
+    else
+    {
+        FormatMessage(&text[0], deferredLogFormat[id], arg0, arg1);
+        if (level == DEFERRED_LOG_LEVEL_ERROR)
+        {
+            ERROR_MSG("%s", &text[0])
+        }
+        else if (level == DEFERRED_LOG_LEVEL_WARN)
+        {
+            WARN_MSG("%s", &text[0])
+        }
+        else
+        {
+            INFO_MSG("%s", &text[0])
+        }
+    }
+}
+
+void DeferredLogFlush(uint32_t maxNumChars)
+{
+    DEFERRED_LOG_INFO *pLog = &deferredLog;
+    uint32_t writeIndex = pLog->writeIndex;
+    uint32_t readIndex = pLog->readIndex;
+    uint32_t numBytes;
+    uint32_t numWords;
+    uint32_t word;
+    uint32_t i;
+    static uint8_t line[DEFERRED_LOG_LINE_NUM_BYTES];
+
+    while ((readIndex != writeIndex) && (maxNumChars >= DEFERRED_LOG_LINE_MSG_SIZE))
+    {
+        numBytes = 0;
+        numWords = 1 + ((pLog->buffer[readIndex % DEFERRED_LOG_NUM_WORDS] >>
+                         DEFERRED_LOG_NUM_ARGS_POS) &
+                        0xF);
+        // Whole messages per line, so that each line is decoded on its own
+        while ((readIndex != writeIndex) &&
+               (numBytes + 4 * numWords <= DEFERRED_LOG_LINE_NUM_BYTES))
+        {
+            for (i = 0; i < numWords; i++)
+            {
+                word = pLog->buffer[(readIndex + i) % DEFERRED_LOG_NUM_WORDS];
+                line[numBytes] = (uint8_t)word;
+                line[numBytes + 1] = (uint8_t)(word >> 8);
+                line[numBytes + 2] = (uint8_t)(word >> 16);
+                line[numBytes + 3] = (uint8_t)(word >> 24);
+                numBytes += 4;
+            }
+            readIndex += numWords;
+            numWords = 1 + ((pLog->buffer[readIndex % DEFERRED_LOG_NUM_WORDS] >>
+                             DEFERRED_LOG_NUM_ARGS_POS) &
+                            0xF);
+        }
+        pLog->readIndex = readIndex;
+        DisplayBase64("L:", &line[0], numBytes);
+        maxNumChars -= DEFERRED_LOG_LINE_MSG_SIZE;
+    }
+}
+
+void FormatMessage(char *pDst, const char *pFormat, uint32_t arg0, uint32_t arg1)
+{
+    uint32_t numChars = 0;
+    uint32_t numArgs = 0;
+    uint32_t numDigits;
+    uint32_t value;
+    uint32_t base;
+    uint32_t args[DEFERRED_LOG_MAX_NUM_ARGS] = {arg0, arg1};
+    char digits[10];
+    const char *pChar = pFormat;
+
+    while ((*pChar != '\0') && (numChars < DEFERRED_LOG_TEXT_NUM_CHARS - 1))
+    {
+        if ((pChar[0] == '%') && ((pChar[1] == 'd') || (pChar[1] == 'u') || (pChar[1] == 'x')) &&
+            (numArgs < DEFERRED_LOG_MAX_NUM_ARGS))
+        {
+            value = args[numArgs];
+            base = (pChar[1] == 'x') ? 16 : 10;
+            if ((pChar[1] == 'd') && ((int32_t)value < 0))
+            {
+                pDst[numChars] = '-';
+                numChars++;
+                value = 0u - value;
+            }
+            // Digits are found from the least significant and copied in reverse.
+            numDigits = 0;
+            do
+            {
+                digits[numDigits] = "0123456789abcdef"[value % base];
+                value /= base;
+                numDigits++;
+            } while (value > 0);
+            while ((numDigits > 0) && (numChars < DEFERRED_LOG_TEXT_NUM_CHARS - 1))
+            {
+                numDigits--;
+                pDst[numChars] = digits[numDigits];
+                numChars++;
+            }
+            numArgs++;
+            pChar += 2;
+        }
+        else if ((pChar[0] == '%') && (pChar[1] == '%'))
+        {
+            pDst[numChars] = '%';
+            numChars++;
+            pChar += 2;
+        }
+        else
+        {
+            pDst[numChars] = *pChar;
+            numChars++;
+            pChar++;
+        }
+    }
+    pDst[numChars] = '\0';
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,224 @@
+/******************************************************************************
+ Copyright (c) 2023 - 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file     dispatch_table.c
+ * @brief    Command dispatch table of CLI
+ * @{
+ */
+
+/*=============  I N C L U D E S   =============*/
+#include "dispatch_table.h"
+#include "cli_commands.h"
+#include "cli_lookup.h"
+#include <stdint.h>
+
+/*=============  D A T A  =============*/
+
+/**
+ * @brief Command dispatch table
+ * Add commands table here with function description
+ */
+const Command dispatchTable[] = {
+    {"start", "d", CmdStart, NOHIDE, "Starts calculating metrology parameters", "<num_cycles>",
+     NULL, NULL},
+    {"version", "s", CmdVersion, NOHIDE, "Gets Firmware version", "", NULL, NULL},
+    {"setdisplay", "ss", CmdSetDisplay, NOHIDE, "Sets display of a parameter to on or off ",
+     "<option>  <on|off>", NULL, DescDisplay},
+    {"setformat", "s", CmdSetFormat, NOHIDE, "Sets format of metrology outputs", "<format>",
+     "\tChoose format as shown below\r\n"
+     "\ttext for text lines of displayed parameters\r\n"
+     "\tfloat for frames of scaled values on F: lines\r\n"
+     "\tfixed for frames of register codes on F: lines\r\n"
+     "\tcsv for a line of scaled values per cycle on C: lines, after a line of names\r\n"
+     "\tFrames carry parameters selected with setdisplay. Decode with tools/output_decode\n\r",
+     NULL},
+    {"setrate", "ss", CmdSetRate, NOHIDE, "Sets rate of metrology outputs", "<rate> [interval]",
+     "\tChoose rate as shown below\r\n"
+     "\tevery for outputs of every cycle\r\n"
+     "\tcycles <n> for one aggregate of outputs every n cycles\r\n"
+     "\tms <t> for one aggregate of outputs every t milliseconds\r\n"
+     "\tAn aggregate has mean, min and max records, selected with setdisplay.\r\n"
+     "\tCSV lines and frames carry the mean record only\n\r",
+     NULL},
+    {"setlog", "s", CmdSetLog, NOHIDE, "Sets mode of messages of metrology run", "<mode>",
+     "\tChoose mode as shown below\r\n"
+     "\ttext for messages formatted on the board\r\n"
+     "\tdeferred for ids and arguments on L: lines, formatted on the host\r\n"
+     "\tDecode deferred messages with tools/log_decode\n\r",
+     NULL},
+#ifdef ENABLE_X86_BUILD
+    {"close", "", CliClose, HIDE, "Closes all opened files", "", NULL, NULL},
+#endif /* ENABLE_X86_BUILD */
+#if BOARD_CFG_RESET_TYPE == 0
+    {"reset", "s", CmdReset, NOHIDE, "H/W Reset of ADE9178 and ADCs", "", NULL, NULL},
+#else
+    {"reset", "ss", CmdReset, NOHIDE, "H/W Reset of Devices", "<device>",
+     "\tDevice can be ade9178 or adc or all\n\r"
+     "\tade9178 for hardware reset of ADE9178.\n\r"
+     "\tadc for hardware reset of ADC.\n\r"
+     "\tall for hardware reset of both ADE9178 and ADC.\n\r",
+     NULL},
+#endif
+    {"setreg", "sss", CmdSetRegData, NOHIDE, "Writes ADE9178/ADC register",
+     "<device> <register address> <register value>",
+     "\tDevice can be ADE9178, ADC0, ADC1, ADC2, ADC3 or ALL_ADC\n\r"
+     "\tAddress and value should be in hexadecimal e.g. setreg ADE9178 b 3289",
+     NULL},
+    {"getreg", "sss", CmdGetRegData, NOHIDE, "Reads ADE9178 register",
+     "<device> <register address> <number of registers to read>",
+     "\tDevice can be ADE9178, ADC0, ADC1, ADC2, ADC3 or ALL_ADC\n\r"
+     "\tAddress should be in hexadecimal e.g. getreg ADE9178 b 1 \n\r"
+     "\tnumber of register to read can be greater than one.\n\r",
+     NULL},
+    {"getregs", "ssssssssssssssssssssssss", CmdGetRegs, NOHIDE,
+     "Reads ranges of ADE9178/ADC registers", "<device> <address>[:<count>] ...",
+     "\tDevice can be ADE9178, ADC0, ADC1, ADC2 or ADC3\n\r"
+     "\tAddresses are in hexadecimal, counts in decimal e.g. getregs ADE9178 b:4 20c\n\r"
+     "\tRanges are read back to back and shown as <address>=<value> pairs\n\r",
+     NULL},
+    {"setregs", "ssssssssssssssssssssssss", CmdSetRegs, NOHIDE,
+     "Writes list of ADE9178/ADC registers", "<device> <address>=<value> ... | script",
+     "\tAddresses and values are in hexadecimal e.g. setregs ADE9178 b=3289 c=0\n\r"
+     "\tGive script to apply writes added with regscript\n\r"
+     "\tWrites are applied back to back and stop at first error\n\r",
+     NULL},
+    {"regscript", "ssssssssssssssssssssssss", CmdRegScript, NOHIDE,
+     "Builds script of register writes", "add <device> <address>=<value> ... | clear",
+     "\tadd appends writes of a line, if all of them are valid\n\r"
+     "\tclear removes all writes. Apply the script with setregs script\n\r",
+     NULL},
+    {"loadreg", "s", CmdLoadReg, NOHIDE, "Load registers value", NULL,
+     "\tLoad registers value from flash to ADE9178\n\r", NULL},
+    {"savereg", "s", CmdSaveReg, NOHIDE, "save registers value", NULL,
+     "\tSave registers value from ADE9178 into flash\n\r", NULL},
+    {"setconfig", "ss", CmdSetConfig, NOHIDE, "sets configurations",
+     "<config choices> <config value>",
+     "\tChoose config as shown below\r\n"
+     "\t1 for voltage scale\r\n"
+     "\t2 for current scale\r\n"
+     "\t3 for aux scale\r\n",
+     NULL},
+    {"getconfig", "s", CmdGetConfig, NOHIDE, "gets configuration values", "<config choices>",
+     "\tChoose config as shown below\r\n"
+     "\t1 for voltage scale\r\n"
+     "\t2 for current scale\r\n"
+     "\t3 for aux scale\r\n",
+     NULL},
+    {"capturewfrm", "dd", CmdCaptureWfrm, NOHIDE,
+     "Starts Waveform capture with a delay of configured cycles", "<wf src> <delay_num_cycles>",
+     "\tChoose waveform source type to stream as shown below\r\n"
+     "\t0 for ADC\r\n"
+     "\t1 for PCF\r\n"
+     "\tNumber of cycles to delay to start waveform capture\n\r",
+     NULL},
+    {"planwfrm", "ss", CmdPlanWfrm, NOHIDE,
+     "Displays lowest baud rate and buffer size for waveform channels",
+     "<hex_channel_mask> <capture_msec>",
+     "\tChannel mask has a bit per channel id, 0xFFF for all 12 channels\r\n"
+     "\tChannels at 4000 Hz that do not fit in 3.072 Mbaud are rejected\r\n"
+     "\tBuffer is split into blocks of waveform stream\r\n",
+     NULL},
+    {"displaywfrm", "s", CmdDisplayWfrm, NOHIDE,
+     "Displays waveform with 12 channels enabled for 100ms", "[compressed|sync|<rate_hz>]",
+     "\tGive compressed to display samples losslessly compressed as base64 lines\r\n"
+     "\tDecode the lines on host with tools/wfs_decode\r\n"
+     "\tGive sync to display samples resampled to 256 per line cycle\r\n"
+     "\tGive a rate below 4000 Hz to display samples decimated to the rate\r\n",
+     NULL},
+    {"dumpwfrm", "s", CmdDumpWfrm, NOHIDE, "Dumps captured waveform as binary data",
+     "<raw|compressed>",
+     "\tA D: line with format, number of channels and frames is followed by binary data\r\n"
+     "\traw sends samples as captured, compressed sends packets of the WFS codec\r\n"
+     "\tMetrology outputs are still read while the dump is sent\r\n"
+     "\tDecode the terminal log on host with tools/wfs_decode\r\n",
+     NULL},
+    {"getpulsetime", "d", CmdDisplayPulseTime, HIDE, "Displays timestamp of Events", "<src_id>",
+     "\tChoose source ids to display pulse time\r\n"
+     "\t0 for CF1\r\n"
+     "\t1 for CF2\r\n",
+     NULL},
+    {"geterrorcount", "s", CmdDisplayErrorStatusCount, NOHIDE, "Gets errorstatus count occured", "",
+     NULL, NULL},
+    {"getstats", "ss", CmdGetStats, NOHIDE,
+     "Displays min, max, mean and variance of rms, power and power factor", "<window> <reset>",
+     "\tChoose window as shown below\r\n"
+     "\ttotal for all cycles since last reset\r\n"
+     "\ttumbling for last completed tumbling window\r\n"
+     "\tsliding for most recent cycles\r\n"
+     "\tOptional reset clears statistics after display\n\r",
+     NULL},
+    {"resetstats", "dd", CmdResetStats, NOHIDE, "Resets statistics of outputs",
+     "<tumbling_num_cycles> <sliding_num_cycles>",
+     "\tWithout arguments, clears statistics\r\n"
+     "\tWith arguments, also sets number of cycles in tumbling and sliding windows\n\r",
+     NULL},
+    {"benchwfssync", "d", CmdBenchWfsSync, HIDE, "Benchmarks waveform synchronisation",
+     "<num_iterations>", "\tOverwrites samples in waveform buffer\n\r", NULL},
+    {"startharmonics", "sdd", CmdStartHarmonics, NOHIDE,
+     "Starts harmonic analysis of channels of waveform stream",
+     "<hex_channel_mask> <num_cycles> <line_frequency>",
+     "\tChannel mask has a bit per channel id in order AV, AI, BV, BI, CV, CI, AUX0 to AUX5\r\n"
+     "\tUp to 6 channels are analysed together, 0x15 for AV, BV and CV\r\n"
+     "\tChoose 10 cycles for 50 Hz or 12 cycles for 60 Hz systems\r\n"
+     "\tWindows start at line frequency given and follow frequency measured while running\n\r",
+     NULL},
+    {"getharmonics", "", CmdGetHarmonics, NOHIDE,
+     "Displays harmonics up to 50th order and THD of last window of each channel", "", NULL,
+     NULL},
+    {"stopharmonics", "", CmdStopHarmonics, NOHIDE, "Stops harmonic analysis", "", NULL, NULL},
+    {"benchharmonics", "d", CmdBenchHarmonics, HIDE, "Benchmarks harmonic analysis of a window",
+     "<num_iterations>", "\tRuns on synthetic samples when harmonic analysis is stopped\n\r",
+     NULL},
+    {"setgoertzel", "ss", CmdSetGoertzel, NOHIDE,
+     "Sets harmonic orders of Goertzel bins of a channel", "<channel_id> <orders>",
+     "\tChoose channel id from 0 to 11 in order AV, AI, BV, BI, CV, CI, AUX0 to AUX5\r\n"
+     "\tGive up to 8 orders separated by commas, for example 3,5,7,11,13,2.5\r\n"
+     "\tGive off to remove bins of the channel\n\r",
+     NULL},
+    {"startgoertzel", "dd", CmdStartGoertzel, NOHIDE,
+     "Starts Goertzel bank on channels with bins", "<num_cycles> <line_frequency>",
+     "\tChoose 10 cycles for 50 Hz or 12 cycles for 60 Hz systems\r\n"
+     "\tWindows start at line frequency given and follow period measured while running\n\r",
+     NULL},
+    {"getgoertzel", "", CmdGetGoertzel, NOHIDE, "Displays Goertzel bins of last window", "", NULL,
+     NULL},
+    {"stopgoertzel", "", CmdStopGoertzel, NOHIDE, "Stops Goertzel bank", "", NULL, NULL},
+    {"benchgoertzel", "d", CmdBenchGoertzel, HIDE, "Benchmarks Goertzel bank",
+     "<num_iterations>", "\tRuns on synthetic samples when Goertzel bank is stopped\n\r", NULL},
+    {"benchfloatformat", "d", CmdBenchFloatFormat, HIDE,
+     "Benchmarks formatting of output values against snprintf", "<num_iterations>", NULL, NULL},
+    {"benchclilookup", "d", CmdBenchCliLookup, HIDE,
+     "Benchmarks lookup of command names against linear search", "<num_iterations>", NULL, NULL},
+    {"settrigger", "ss", CmdSetTrigger, NOHIDE, "Adds a source of triggered capture",
+     "<source> <level>",
+     "\tdip <volts> triggers when DIPHALF of AV, BV or CV is below level\r\n"
+     "\tswell <volts> triggers when SWELLHALF of AV, BV or CV is above level\r\n"
+     "\tstatus0 <hex_mask> or status1 <hex_mask> triggers when masked bits are set\r\n"
+     "\tcfgap <msec> triggers when no CF pulse is seen for the time\r\n"
+     "\tsample <channel_id>,<code> triggers when a sample is beyond +/- code\r\n"
+     "\tnone removes all sources\r\n"
+     "\tSources other than sample need start command running\n\r",
+     NULL},
+    {"armtrigger", "dd", CmdArmTrigger, NOHIDE,
+     "Arms triggered capture of waveform stream of all channels", "<pre_msec> <post_msec>",
+     "\tCapture holds 100 ms of all channels before and after trigger together\r\n"
+     "\tShares waveform stream with harmonic analysis and Goertzel bank\n\r",
+     NULL},
+    {"gettrigger", "", CmdGetTrigger, NOHIDE, "Displays state and samples of triggered capture",
+     "", NULL, NULL},
+    {"stoptrigger", "", CmdStopTrigger, NOHIDE, "Stops triggered capture", "", NULL, NULL},
+    {"getwfsstream", "", CmdGetWfsStream, NOHIDE,
+     "Displays waveform stream and lag of its consumers", "",
+     "\tHarmonics and goertzel skip blocks if behind, trigger stalls the stream\n\r", NULL}};
+
+const uint32_t numDispatchCommands = sizeof(dispatchTable) / sizeof(Command);
+
+/* Commands are looked up through a hash table, which holds a limited number of names */
+_Static_assert(sizeof(dispatchTable) / sizeof(Command) <= CLI_LOOKUP_MAX_NUM_NAMES,
+               "Dispatch table has more commands than CLI_LOOKUP_MAX_NUM_NAMES");
+
+/**
+ * @}
+ */
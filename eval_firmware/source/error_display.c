@@ -11,6 +11,7 @@
 
 #include "error_display.h"
 #include "adi_metic_status.h"
+#include "deferred_log.h"
 #include "message.h"
 #include "metic_example.h"
 #include "status.h"
@@ -154,7 +155,7 @@ int32_t DisplayErrorStatusMessage(METIC_EXAMPLE *pExample)
     {
         if (errorStatusDisplay == 1)
         {
-            ERROR_MSG("Error Status :  0x%x", errorRegStatus)
+            DEFERRED_LOG1(LOG_ID_ERROR_STATUS, errorRegStatus)
             DisplayErrorStatusCodes(errorRegStatus);
         }
         else
@@ -162,7 +163,7 @@ int32_t DisplayErrorStatusMessage(METIC_EXAMPLE *pExample)
             if (pExample->prevErrorStatus != errorRegStatus)
             {
                 pExample->prevErrorStatus = errorRegStatus;
-                ERROR_MSG("Error Status :  0x%x", errorRegStatus)
+                DEFERRED_LOG1(LOG_ID_ERROR_STATUS, errorRegStatus)
                 DisplayErrorStatusCodes(errorRegStatus);
             }
         }
@@ -176,6 +177,11 @@ void DisplayErrorStatusCodes(int32_t errorStatus)
 {
     uint32_t i;
     uint32_t numErrorStatusBits = 23;
+    // In deferred mode only the register value is logged. Use geterrorcount for descriptions.
+    if (DeferredLogGetMode() == DEFERRED_LOG_MODE_DEFERRED)
+    {
+        numErrorStatusBits = 0;
+    }
     for (i = 0; i < numErrorStatusBits; i++)
     {
         if (((errorStatus >> i) & 0x1) == 1)
@@ -11,6 +11,7 @@
 #include "adi_cli.h"
 #include "adi_metic_status.h"
 #include "metic_service_interface.h"
+#include "output_plan.h"
 #include <string.h>
 
 #define CHANNEL_ID 0
@@ -19,21 +20,42 @@ static void DisplayCalCoeffs(ADE_CONFIG_REG *pConfig);
 static void DisplayPowerCalCoeffs(ADE_CONFIG_REG *pConfig);
 static void DisplayCommReg(ADE_CONFIG_REG *pConfig);
 static void DisplayStatusReg(ADE_CONFIG_REG *pConfig);
-static void DisplayChannelRmsOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount,
-                                    ADI_METIC_RMS_OUTPUT *pOutput);
-static void DisplayPowerAndEnergyOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount,
-                                        ADI_METIC_OUTPUT *pOutput);
-static void DisplayPeriodOutput(uint32_t irqCount, ADI_METIC_PERIOD_OUTPUT *pOutput);
-static void DisplayAngleOutput(uint32_t irqCount, ADI_METIC_ANGLE_OUTPUT *pAngleOutput);
-static void DisplayStatusOutput(uint32_t irqCount, ADI_METIC_STATUS_OUTPUT *pAngleOutput);
-static void DisplayAuxOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount,
-                             ADI_METIC_RMS_OUTPUT *pOutput);
+static float GetStatsScale(ADE_DISPLAY_CONFIG *pDisplay, uint32_t statsChannel);
+static void DisplayOutputFrame(ADI_METIC_OUTPUT_FRAME_FORMAT format, uint32_t irqCount,
+                               ADI_METIC_OUTPUT *pOutput);
 /** List of available channels*/
 static char *channel[] = {"AV",   "AI",   "BV",   "BI",   "CV",   "CI",
                           "AUX0", "AUX1", "AUX2", "AUX3", "AUX4", "AUX5"};
 static char *powerChannel[] = {"A", "B", "C"};
+/** Plan of values displayed each cycle, compiled from display configuration */
+static OUTPUT_PLAN displayPlan;
+/** Names of records of aggregated outputs, in order of OUTPUT_AGGREGATE_RECORD */
+static char *aggregateRecordName[] = {"MEAN", "MIN", "MAX"};
 
 #define MAX_MSG_STORAGE_SIZE_PER_CYCLE 3806
+/** Number of frames in a packet of compressed waveform, sized to keep a line within a message */
+#define WFS_COMPRESS_PACKET_NUM_FRAMES 8
+/** Size of a packet of compressed waveform */
+#define WFS_COMPRESS_PACKET_MAX_NUM_BYTES                                                          \
+    ADI_METIC_WFS_CODEC_PACKET_MAX_NUM_BYTES(WFS_COMPRESS_PACKET_NUM_FRAMES,                       \
+                                             ADI_METIC_MAX_NUM_CHANNELS)
+/** Number of frames resampled at a time for display */
+#define WFS_RESAMPLE_CHUNK_NUM_FRAMES 16
+/** Number of samples per line cycle of waveform resampled synchronous to line period */
+#define WFS_RESAMPLE_SAMPLES_PER_CYCLE 256
+/** Line frequency in Hz used for synchronous resampling if no period is measured */
+#define WFS_RESAMPLE_NOMINAL_FREQUENCY 50.0f
+/** Maximum number of output frames of a chunk. A chunk gives 72 frames at the highest line
+ * frequency accepted, #ADI_METIC_WFS_RESAMPLER_MAX_FREQUENCY */
+#define WFS_RESAMPLE_MAX_OUT_FRAMES 80
+/** Number of bytes of a frame of outputs per line. Multiple of 3, so that lines of a frame are not
+ * padded */
+#define OUTPUT_FRAME_LINE_NUM_BYTES 300
+/** Message space needed for a frame of outputs, with margin for prefix and end of each line */
+#define OUTPUT_FRAME_MAX_MSG_SIZE                                                                  \
+    ((ADI_METIC_OUTPUT_FRAME_MAX_NUM_BYTES + 2) / 3 * 4 +                                          \
+     16 * ((ADI_METIC_OUTPUT_FRAME_MAX_NUM_BYTES + OUTPUT_FRAME_LINE_NUM_BYTES - 1) /              \
+           OUTPUT_FRAME_LINE_NUM_BYTES))
 
 void InitDisplayConfig(ADE_DISPLAY_CONFIG *pConfig)
 {
@@ -49,9 +71,21 @@ void InitDisplayConfig(ADE_DISPLAY_CONFIG *pConfig)
     pConfig->enableEventRmsHalfOutput = false;
     pConfig->enableStatusOutput = true;
     pConfig->enableErrorStatusOutput = false;
+    pConfig->enableMeanOutput = true;
+    pConfig->enableMinOutput = false;
+    pConfig->enableMaxOutput = false;
     pConfig->voltageScale = 707;
     pConfig->currentScale = 44.188f;
     pConfig->auxScale = 707;
+    pConfig->format = ADE_DISPLAY_FORMAT_TEXT;
+    pConfig->rate = ADE_DISPLAY_RATE_EVERY_CYCLE;
+    pConfig->rateInterval = 1;
+    CompileDisplayPlan(pConfig);
+}
+
+void CompileDisplayPlan(ADE_DISPLAY_CONFIG *pDisplay)
+{
+    OutputPlanCompile(&displayPlan, pDisplay);
 }
 
 void DisplayNvmReg(ADE_CONFIG_REG *pConfig)
@@ -166,199 +200,88 @@ void DisplayStatusReg(ADE_CONFIG_REG *pConfig)
              pConfig->statusConfig.errorMask.value)
 }
 
-void DisplayOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount, ADI_METIC_OUTPUT *pOutput)
+uint32_t GetDisplayMsgSize(ADE_DISPLAY_CONFIG *pDisplay)
 {
-    if (pDisplay->enableRmsOutput || pDisplay->enableRmsOneOutput ||
-        pDisplay->enableRmsHalfOutput || pDisplay->enableEventRmsOneOutput ||
-        pDisplay->enableEventRmsHalfOutput)
+    uint32_t msgSize = MAX_MSG_STORAGE_SIZE_PER_CYCLE;
+    if ((pDisplay->format == ADE_DISPLAY_FORMAT_FRAME_FLOAT) ||
+        (pDisplay->format == ADE_DISPLAY_FORMAT_FRAME_FIXED))
     {
-        DisplayChannelRmsOutput(pDisplay, irqCount, &pOutput->rmsOut[0]);
+        msgSize = OUTPUT_FRAME_MAX_MSG_SIZE;
     }
-    if (pDisplay->enablePowerOutput || pDisplay->enableEnergyOutput)
-    {
-        DisplayPowerAndEnergyOutput(pDisplay, irqCount, pOutput);
-    }
-    if (pDisplay->enableAngleOutput)
+    return msgSize;
+}
+
+void DisplayOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount, ADI_METIC_OUTPUT *pOutput)
+{
+    // Values and scales are taken from the plan, compiled when display configuration changed.
+    if (pDisplay->format == ADE_DISPLAY_FORMAT_TEXT)
     {
-        DisplayAngleOutput(irqCount, &pOutput->angleOut);
+        OutputPlanWriteText(&displayPlan, irqCount, pOutput);
     }
-    if (pDisplay->enablePeriodOutput)
+    else if (pDisplay->format == ADE_DISPLAY_FORMAT_CSV)
     {
-        DisplayPeriodOutput(irqCount, &pOutput->periodOut);
+        OutputPlanWriteCsv(&displayPlan, irqCount, pOutput);
     }
-    if (pDisplay->enableStatusOutput)
+    else
     {
-        DisplayStatusOutput(irqCount, &pOutput->statusOut);
+        DisplayOutputFrame((pDisplay->format == ADE_DISPLAY_FORMAT_FRAME_FIXED)
+                               ? ADI_METIC_OUTPUT_FRAME_FIXED
+                               : ADI_METIC_OUTPUT_FRAME_FLOAT,
+                           irqCount, pOutput);
     }
 }
 
-void DisplayChannelRmsOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount,
-                             ADI_METIC_RMS_OUTPUT *pOutput)
+void DisplayAggregateRecord(ADE_DISPLAY_CONFIG *pDisplay, OUTPUT_AGGREGATE *pAggregate,
+                            uint32_t record)
 {
-    int16_t i;
-    float scale;
-
-    for (i = 0; i < 6; i++)
+    if (pDisplay->format == ADE_DISPLAY_FORMAT_TEXT)
     {
-        if (i % 2 == 0)
-        {
-            scale = pDisplay->voltageScale;
-        }
-        else
-        {
-            scale = pDisplay->currentScale;
-        }
-        if (pDisplay->enableRmsOutput)
-        {
-            INFO_MSG("%d, %sRMS           = %f", irqCount, channel[i],
-                     (double)(pOutput[i].filteredRms * scale))
-        }
-        if (pDisplay->enableRmsHalfOutput)
-        {
-            INFO_MSG("%d, %sRMSHALF       = %f", irqCount, channel[i],
-                     (double)(pOutput[i].rmsHalfCycle * scale))
-        }
-        if (pDisplay->enableRmsOneOutput)
-        {
-            INFO_MSG("%d, %sRMSONE        = %f", irqCount, channel[i],
-                     (double)(pOutput[i].rmsOneCycle * scale))
-        }
-        if (pDisplay->enableEventRmsHalfOutput)
-        {
-            INFO_MSG("%d, %sDIPHALF       = %f", irqCount, channel[i],
-                     (double)(pOutput[i].dipHalf * scale))
-        }
-        if (pDisplay->enableEventRmsOneOutput)
-        {
-            INFO_MSG("%d, %sDIPONE        = %f", irqCount, channel[i],
-                     (double)(pOutput[i].dipOne * scale))
-        }
-        if (pDisplay->enableEventRmsHalfOutput)
-        {
-            INFO_MSG("%d, %sSWELLHALF     = %f", irqCount, channel[i],
-                     (double)(pOutput[i].swellHalf * scale))
-        }
-        if (pDisplay->enableEventRmsOneOutput)
-        {
-            INFO_MSG("%d, %sSWELLONE      = %f", irqCount, channel[i],
-                     (double)(pOutput[i].swellOne * scale))
-        }
+        INFO_MSG("%d, %s over %d cycles", pAggregate->irqCount, aggregateRecordName[record],
+                 pAggregate->numCycles)
+        OutputPlanWriteText(&displayPlan, pAggregate->irqCount, &pAggregate->record[record]);
     }
-    DisplayAuxOutput(pDisplay, irqCount, pOutput);
-}
-
-void DisplayAuxOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount,
-                      ADI_METIC_RMS_OUTPUT *pOutput)
-{
-    int16_t i;
-    float scale;
-    scale = pDisplay->auxScale;
-    // For the formatting, seperated the AUX channel display message.
-    for (i = 6; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+    else if (record == OUTPUT_AGGREGATE_RECORD_MEAN)
     {
-        if (pDisplay->enableRmsOutput)
-        {
-            INFO_MSG("%d, %sRMS         = %f", irqCount, channel[i],
-                     (double)(pOutput[i].filteredRms * scale))
-        }
-        if (pDisplay->enableRmsHalfOutput)
-        {
-            INFO_MSG("%d, %sRMSHALF     = %f", irqCount, channel[i],
-                     (double)(pOutput[i].rmsHalfCycle * scale))
-        }
-        if (pDisplay->enableRmsOneOutput)
-        {
-            INFO_MSG("%d, %sRMSONE      = %f", irqCount, channel[i],
-                     (double)(pOutput[i].rmsOneCycle * scale))
-        }
-        if (pDisplay->enableEventRmsHalfOutput)
-        {
-            INFO_MSG("%d, %sDIPHALF     = %f", irqCount, channel[i],
-                     (double)(pOutput[i].dipHalf * scale))
-        }
-        if (pDisplay->enableEventRmsOneOutput)
-        {
-            INFO_MSG("%d, %sDIPONE      = %f", irqCount, channel[i],
-                     (double)(pOutput[i].dipOne * scale))
-        }
-        if (pDisplay->enableEventRmsHalfOutput)
+        // CSV lines and frames have no field for the kind of record, so that they carry the mean
+        // only.
+        if (pDisplay->format == ADE_DISPLAY_FORMAT_CSV)
         {
-            INFO_MSG("%d, %sSWELLHALF   = %f", irqCount, channel[i],
-                     (double)(pOutput[i].swellHalf * scale))
+            OutputPlanWriteCsv(&displayPlan, pAggregate->irqCount, &pAggregate->record[record]);
         }
-        if (pDisplay->enableEventRmsOneOutput)
+        else
         {
-            INFO_MSG("%d, %sSWELLONE    = %f", irqCount, channel[i],
-                     (double)(pOutput[i].swellOne * scale))
+            // Register codes are of the last cycle, so that a mean is always sent as float.
+            DisplayOutputFrame(ADI_METIC_OUTPUT_FRAME_FLOAT, pAggregate->irqCount,
+                               &pAggregate->record[record]);
         }
     }
 }
-void DisplayPowerAndEnergyOutput(ADE_DISPLAY_CONFIG *pDisplay, uint32_t irqCount,
-                                 ADI_METIC_OUTPUT *pOutput)
+
+void DisplayOutputFrame(ADI_METIC_OUTPUT_FRAME_FORMAT format, uint32_t irqCount,
+                        ADI_METIC_OUTPUT *pOutput)
 {
-    int16_t i;
-    float powerScale;
-    powerScale = pDisplay->voltageScale * pDisplay->currentScale;
+    uint32_t i;
+    uint32_t numBytes = 0;
+    uint32_t numLineBytes;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    static uint8_t frame[ADI_METIC_OUTPUT_FRAME_MAX_NUM_BYTES];
 
-    for (i = 0; i < ADI_METIC_MAX_NUM_POWER_CHANNELS; i++)
+    displayPlan.frameConfig.format = format;
+    adi_metic_EncodeOutputFrame(&displayPlan.frameConfig, irqCount, pInfo->irqStatus.lastIrqTime,
+                                pOutput, &pInfo->outputFix, &frame[0], sizeof(frame), &numBytes);
+    // Frame is a byte stream split across lines. The decoder joins lines and finds frames by
+    // sync, length and CRC.
+    for (i = 0; i < numBytes; i += numLineBytes)
     {
-        if (pDisplay->enablePowerOutput)
+        numLineBytes = numBytes - i;
+        if (numLineBytes > OUTPUT_FRAME_LINE_NUM_BYTES)
         {
-
-            INFO_MSG("%d, %sWATT           = %f", irqCount, powerChannel[i],
-                     (double)(pOutput->powerOut[i].activePower * powerScale))
-            INFO_MSG("%d, %sVA             = %f", irqCount, powerChannel[i],
-                     (double)(pOutput->powerOut[i].apparentPower * powerScale))
-            INFO_MSG("%d, %sPF             = %f", irqCount, powerChannel[i],
-                     (double)(pOutput->powerFactor[i]))
-        }
-        if (pDisplay->enableEnergyOutput)
-        {
-            INFO_MSG("%d, %sWATTHR_POS     = %f", irqCount, powerChannel[i],
-                     (double)(pOutput->energyOut[i].posActEgy * powerScale))
-            INFO_MSG("%d, %sWATTHR_NEG     = %f", irqCount, powerChannel[i],
-                     (double)(pOutput->energyOut[i].negActEgy * powerScale))
-            INFO_MSG("%d, %sWATTHR_SIGNED  = %f", irqCount, powerChannel[i],
-                     (double)(pOutput->energyOut[i].signActEgy * powerScale))
-            INFO_MSG("%d, %sVAHR           = %f", irqCount, powerChannel[i],
-                     (double)(pOutput->energyOut[i].apparentEgy * powerScale))
+            numLineBytes = OUTPUT_FRAME_LINE_NUM_BYTES;
         }
+        DisplayBase64("F:", &frame[i], numLineBytes);
     }
 }
 
-void DisplayAngleOutput(uint32_t irqCount, ADI_METIC_ANGLE_OUTPUT *pOutput)
-{
-
-    INFO_MSG("%d, ANGL_AV_BV      = %f", irqCount, (double)pOutput->angl_av_bv)
-    INFO_MSG("%d, ANGL_BV_CV      = %f", irqCount, (double)pOutput->angl_bv_cv)
-    INFO_MSG("%d, ANGL_AV_CV      = %f", irqCount, (double)pOutput->angl_av_cv)
-    INFO_MSG("%d, ANGL_AV_AI      = %f", irqCount, (double)pOutput->angl_av_ai)
-    INFO_MSG("%d, ANGL_BV_BI      = %f", irqCount, (double)pOutput->angl_bv_bi)
-    INFO_MSG("%d, ANGL_CV_CI      = %f", irqCount, (double)pOutput->angl_cv_ci)
-    INFO_MSG("%d, ANGL_AI_BI      = %f", irqCount, (double)pOutput->angl_ai_bi)
-    INFO_MSG("%d, ANGL_BI_CI      = %f", irqCount, (double)pOutput->angl_bi_ci)
-    INFO_MSG("%d, ANGL_AI_CI      = %f", irqCount, (double)pOutput->angl_ai_ci)
-}
-
-void DisplayPeriodOutput(uint32_t irqCount, ADI_METIC_PERIOD_OUTPUT *pOutput)
-{
-
-    INFO_MSG("%d, APERIOD         = %f", irqCount, (double)pOutput->aPeriod)
-    INFO_MSG("%d, BPERIOD         = %f", irqCount, (double)pOutput->bPeriod)
-    INFO_MSG("%d, CPERIOD         = %f", irqCount, (double)pOutput->cPeriod)
-    INFO_MSG("%d, COM_PERIOD      = %f", irqCount, (double)pOutput->comPeriod)
-}
-
-void DisplayStatusOutput(uint32_t irqCount, ADI_METIC_STATUS_OUTPUT *pOutput)
-{
-
-    INFO_MSG("%d, STATUS0         = 0x%x", irqCount, pOutput->status0)
-    INFO_MSG("%d, STATUS1         = 0x%x", irqCount, pOutput->status1)
-    INFO_MSG("%d, STATUS2         = 0x%x", irqCount, pOutput->status2)
-    INFO_MSG("%d, STATUS3         = 0x%x", irqCount, pOutput->status3)
-    INFO_MSG("%d, ERROR_STATUS    = 0x%x", irqCount, pOutput->errorStatus)
-}
-
 void DisplayWaveformOutput(void)
 {
     int32_t i, j;
@@ -372,7 +295,8 @@ void DisplayWaveformOutput(void)
     ADI_CLI_HANDLE hCli;
     METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
     int32_t *pWaveformData = &(pInfo->wfsBuffer[0]);
-    int8_t *pBuffer;
+    int32_t frame[ADI_METIC_MAX_NUM_CHANNELS];
+    ADI_METIC_WFS_VIEW view;
 #if ENABLE_ALL_CHANNELS == 1
     static char *channelOrder[] = {"AV",   "AI",   "BV",   "BI",   "CV",   "CI",
                                    "AUX0", "AUX1", "AUX2", "AUX3", "AUX4", "AUX5"};
@@ -391,8 +315,9 @@ void DisplayWaveformOutput(void)
         numSamples = (numBytes - byteOffset) / 4;
         if (syncStatus == ADI_METIC_STATUS_SUCCESS)
         {
-            pBuffer = (int8_t *)&pWaveformData[0];
-            memcpy(&pBuffer[0], &pBuffer[byteOffset], (uint32_t)(numBytes - byteOffset));
+            // Samples are read from the offset through a view instead of moving the buffer.
+            adi_metic_WfsViewInit(&view, (uint8_t *)pWaveformData, (uint32_t)numBytes,
+                                  (uint32_t)byteOffset, (uint32_t)(numBytes - byteOffset));
             if (numSamples >= WFS_NUM_SAMPLES)
             {
                 numSamples = WFS_NUM_SAMPLES;
@@ -407,9 +332,10 @@ void DisplayWaveformOutput(void)
             {
                 if (i + numChannels <= numSamples)
                 {
+                    adi_metic_WfsViewRead(&view, (uint32_t)i, (uint32_t)numChannels, &frame[0]);
                     for (j = 0; j < numChannels; j++)
                     {
-                        sample = pWaveformData[i + j] >> 8;
+                        sample = frame[j] >> 8;
                         INFO_MSG_RAW("%d,", sample)
                     }
                     INFO_MSG("")
@@ -433,6 +359,419 @@ void DisplayWaveformOutput(void)
     }
 }
 
+void DisplayCompressedWaveform(void)
+{
+    uint32_t i;
+    uint32_t freeSpace;
+    uint32_t numFrames;
+    uint32_t numPacketFrames;
+    uint32_t numFrameBytes;
+    uint32_t numPacketBytes;
+    int32_t byteOffset = 0;
+    int32_t numBytes;
+    ADI_METIC_STATUS status = 0;
+    ADI_CLI_HANDLE hCli;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    uint8_t *pWaveformData = (uint8_t *)&(pInfo->wfsBuffer[0]);
+    static ADI_METIC_WFS_CODEC codec;
+    static uint8_t packet[WFS_COMPRESS_PACKET_MAX_NUM_BYTES];
+
+    if (pInfo->isWfsRxComplete == 1)
+    {
+        numBytes = WFS_BUFFER_SIZE * sizeof(int32_t);
+        // Finds channel offset from where proper data starts.
+        status = adi_metic_FindChannelOffset(pInfo->hAde, (int8_t *)pWaveformData, numBytes,
+                                             CHANNEL_ID, &byteOffset);
+        if (status == ADI_METIC_STATUS_SUCCESS)
+        {
+            status = adi_metic_WfsEncoderInit(pInfo->hAde, &codec, CHANNEL_ID);
+        }
+        if (status == ADI_METIC_STATUS_SUCCESS)
+        {
+            numFrameBytes = codec.numChannels * sizeof(int32_t);
+            numFrames = (uint32_t)(numBytes - byteOffset) / numFrameBytes;
+            if (numFrames > WFS_NUM_SAMPLES / codec.numChannels)
+            {
+                numFrames = WFS_NUM_SAMPLES / codec.numChannels;
+            }
+            numPacketBytes = adi_metic_WfsWriteCodecHeader(&codec, &packet[0]);
+            DisplayBase64("H:", &packet[0], numPacketBytes);
+            for (i = 0; (i < numFrames) && (status == ADI_METIC_STATUS_SUCCESS);
+                 i += WFS_COMPRESS_PACKET_NUM_FRAMES)
+            {
+                numPacketFrames = numFrames - i;
+                if (numPacketFrames > WFS_COMPRESS_PACKET_NUM_FRAMES)
+                {
+                    numPacketFrames = WFS_COMPRESS_PACKET_NUM_FRAMES;
+                }
+                status = adi_metic_WfsEncode(&codec, pWaveformData + byteOffset + i * numFrameBytes,
+                                             numPacketFrames * numFrameBytes, &packet[0],
+                                             sizeof(packet), &numPacketBytes);
+                DisplayBase64("P:", &packet[0], numPacketBytes);
+                do
+                {
+                    hCli = GetCliHandle();
+                    adi_cli_FlushMessages(hCli);
+                    adi_cli_GetFreeMessageSpace(hCli, &freeSpace);
+                } while (freeSpace < MAX_MSG_STORAGE_SIZE_PER_CYCLE);
+            }
+        }
+        if (status != ADI_METIC_STATUS_SUCCESS)
+        {
+            INFO_MSG("waveform samples are not syncronised")
+        }
+    }
+    else
+    {
+        INFO_MSG("wfs buffer is not full")
+    }
+}
+
+void DisplayResampledWaveform(uint32_t outputRate)
+{
+    uint32_t i, j;
+    uint32_t ch;
+    uint32_t freeSpace;
+    uint32_t numChannels;
+    uint32_t numFrames;
+    uint32_t numChunkFrames;
+    uint32_t numOutFrames;
+    uint32_t numFrameBytes;
+    int32_t byteOffset = 0;
+    int32_t numBytes;
+    ADI_METIC_STATUS status = 0;
+    ADI_CLI_HANDLE hCli;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    uint8_t *pWaveformData = (uint8_t *)&(pInfo->wfsBuffer[0]);
+    float period = GetAdeExample()->output.periodOut.comPeriod;
+    ADI_METIC_WFS_UNPACK_CONFIG unpackConfig = {0};
+    ADI_METIC_WFS_RESAMPLER_CONFIG resamplerConfig = {0};
+    void *pSrc[ADI_METIC_MAX_NUM_CHANNELS];
+    void *pDst[ADI_METIC_MAX_NUM_CHANNELS];
+    static ADI_METIC_WFS_RESAMPLER resampler;
+    static int32_t chunk[ADI_METIC_MAX_NUM_CHANNELS][WFS_RESAMPLE_CHUNK_NUM_FRAMES];
+    static int32_t output[ADI_METIC_MAX_NUM_CHANNELS][WFS_RESAMPLE_MAX_OUT_FRAMES];
+
+#if ENABLE_ALL_CHANNELS == 1
+    numChannels = 12;
+#else
+    numChannels = 6;
+#endif
+    if (pInfo->isWfsRxComplete == 1)
+    {
+        numBytes = WFS_BUFFER_SIZE * sizeof(int32_t);
+        // Finds channel offset from where proper data starts.
+        status = adi_metic_FindChannelOffset(pInfo->hAde, (int8_t *)pWaveformData, numBytes,
+                                             CHANNEL_ID, &byteOffset);
+        if (status == ADI_METIC_STATUS_SUCCESS)
+        {
+            resamplerConfig.mode =
+                (outputRate == 0) ? ADI_METIC_WFS_RESAMPLE_SYNC : ADI_METIC_WFS_RESAMPLE_RATE;
+            resamplerConfig.format = ADI_METIC_WFS_FORMAT_INT32;
+            resamplerConfig.numChannels = numChannels;
+            resamplerConfig.inputRate = ADI_METIC_SAMPLING_RATE;
+            resamplerConfig.outputRate = outputRate;
+            resamplerConfig.samplesPerCycle = WFS_RESAMPLE_SAMPLES_PER_CYCLE;
+            resamplerConfig.nominalFrequency = WFS_RESAMPLE_NOMINAL_FREQUENCY;
+            status = adi_metic_WfsResamplerInit(&resampler, &resamplerConfig);
+        }
+        if ((status == ADI_METIC_STATUS_SUCCESS) && (outputRate == 0))
+        {
+            // Period of last register read is used, nominal frequency if none is measured.
+            adi_metic_WfsSetResamplerPeriod(&resampler, period);
+        }
+        if (status == ADI_METIC_STATUS_SUCCESS)
+        {
+            unpackConfig.format = ADI_METIC_WFS_FORMAT_INT32;
+            unpackConfig.maxSamples = WFS_RESAMPLE_CHUNK_NUM_FRAMES;
+            for (ch = 0; ch < numChannels; ch++)
+            {
+                unpackConfig.pDst[ch] = &chunk[ch][0];
+                pSrc[ch] = &chunk[ch][0];
+                pDst[ch] = &output[ch][0];
+            }
+            numFrameBytes = numChannels * sizeof(int32_t);
+            numFrames = (uint32_t)(numBytes - byteOffset) / numFrameBytes;
+            if (numFrames > WFS_NUM_SAMPLES / numChannels)
+            {
+                numFrames = WFS_NUM_SAMPLES / numChannels;
+            }
+            INFO_MSG("")
+            for (ch = 0; ch < numChannels; ch++)
+            {
+                INFO_MSG_RAW("%s,", channel[ch])
+            }
+            INFO_MSG("")
+            for (i = 0; (i < numFrames) && (status == ADI_METIC_STATUS_SUCCESS);
+                 i += WFS_RESAMPLE_CHUNK_NUM_FRAMES)
+            {
+                numChunkFrames = numFrames - i;
+                if (numChunkFrames > WFS_RESAMPLE_CHUNK_NUM_FRAMES)
+                {
+                    numChunkFrames = WFS_RESAMPLE_CHUNK_NUM_FRAMES;
+                }
+                status = adi_metic_WfsDeinterleave(
+                    pInfo->hAde, pWaveformData + byteOffset + i * numFrameBytes,
+                    numChunkFrames * numFrameBytes, CHANNEL_ID, &unpackConfig, &numChunkFrames);
+                if (status == ADI_METIC_STATUS_SUCCESS)
+                {
+                    status = adi_metic_WfsResample(&resampler, &pSrc[0], numChunkFrames, &pDst[0],
+                                                   WFS_RESAMPLE_MAX_OUT_FRAMES, &numOutFrames);
+                }
+                for (j = 0; (j < numOutFrames) && (status == ADI_METIC_STATUS_SUCCESS); j++)
+                {
+                    for (ch = 0; ch < numChannels; ch++)
+                    {
+                        INFO_MSG_RAW("%d,", output[ch][j])
+                    }
+                    INFO_MSG("")
+                    do
+                    {
+                        hCli = GetCliHandle();
+                        adi_cli_FlushMessages(hCli);
+                        adi_cli_GetFreeMessageSpace(hCli, &freeSpace);
+                    } while (freeSpace < MAX_MSG_STORAGE_SIZE_PER_CYCLE);
+                }
+            }
+        }
+        if (status != ADI_METIC_STATUS_SUCCESS)
+        {
+            INFO_MSG("waveform samples are not syncronised")
+        }
+    }
+    else
+    {
+        INFO_MSG("wfs buffer is not full")
+    }
+}
+
+void DisplayBase64(char *pPrefix, uint8_t *pSrc, uint32_t numBytes)
+{
+    uint32_t i;
+    uint32_t value;
+    uint32_t numChars = 0;
+    static const char base64[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static char line[(WFS_COMPRESS_PACKET_MAX_NUM_BYTES + 2) / 3 * 4 + 1];
+
+    for (i = 0; i < numBytes; i += 3)
+    {
+        value = (uint32_t)pSrc[i] << 16;
+        value |= (i + 1 < numBytes) ? (uint32_t)pSrc[i + 1] << 8 : 0;
+        value |= (i + 2 < numBytes) ? pSrc[i + 2] : 0;
+        line[numChars] = base64[(value >> 18) & 0x3F];
+        line[numChars + 1] = base64[(value >> 12) & 0x3F];
+        line[numChars + 2] = (i + 1 < numBytes) ? base64[(value >> 6) & 0x3F] : '=';
+        line[numChars + 3] = (i + 2 < numBytes) ? base64[value & 0x3F] : '=';
+        numChars += 4;
+    }
+    line[numChars] = '\0';
+    INFO_MSG("%s%s", pPrefix, &line[0])
+}
+
+void DisplayStats(ADE_DISPLAY_CONFIG *pDisplay, METIC_STATS_WINDOW window)
+{
+    uint32_t i;
+    float scale;
+    char *pLabel;
+    char *pName;
+    METIC_STATS_SUMMARY summary;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    for (i = 0; i < STATS_NUM_CHANNELS; i++)
+    {
+        if (MetIcIfGetStats(pInfo, window, i, &summary) == 0)
+        {
+            if (i < STATS_POWER_CHANNEL_OFFSET)
+            {
+                pLabel = channel[i];
+                pName = "RMS";
+            }
+            else if (i < STATS_PF_CHANNEL_OFFSET)
+            {
+                pLabel = powerChannel[i - STATS_POWER_CHANNEL_OFFSET];
+                pName = "WATT";
+            }
+            else
+            {
+                pLabel = powerChannel[i - STATS_PF_CHANNEL_OFFSET];
+                pName = "PF";
+            }
+            scale = GetStatsScale(pDisplay, i);
+            INFO_MSG("%s%-6s n = %u, min = %f (%u us), max = %f (%u us), mean = %f, var = %f",
+                     pLabel, pName, summary.count, (double)(summary.min * scale), summary.minTime,
+                     (double)(summary.max * scale), summary.maxTime,
+                     (double)(summary.mean * scale),
+                     (double)(summary.variance * scale * scale))
+        }
+    }
+}
+
+void DisplayHarmonics(void)
+{
+    uint32_t i;
+    uint32_t j;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_HARMONICS_INFO *pHarmonics = &pInfo->harmonics;
+    METIC_HARMONICS_RESULT *pResult;
+
+    if (pHarmonics->numWindows > 0)
+    {
+        for (j = 0; j < pHarmonics->numChannels; j++)
+        {
+            pResult = &pHarmonics->result[j];
+            INFO_MSG("%s harmonics: windows = %u, frequency = %f Hz, thd = %f %%",
+                     channel[pHarmonics->channel[j]], pHarmonics->numWindows,
+                     (double)pResult->frequency, (double)pResult->thd)
+            INFO_MSG("DC       = %f", (double)pResult->magnitude[0])
+            for (i = 1; i <= pResult->numHarmonics; i++)
+            {
+                INFO_MSG("H%-2u      = %f, %f %%, %f deg", i, (double)pResult->magnitude[i],
+                         (double)(pResult->magnitude[i] * 100.0f / pResult->magnitude[1]),
+                         (double)pResult->phase[i])
+            }
+        }
+    }
+    else
+    {
+        INFO_MSG("No harmonic analysis window completed")
+    }
+}
+
+void DisplayGoertzel(void)
+{
+    uint32_t i;
+    uint32_t j;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_GOERTZEL_INFO *pGoertzel = &pInfo->goertzel;
+    METIC_GOERTZEL_CHANNEL *pChannel;
+
+    if (pGoertzel->numWindows > 0)
+    {
+        INFO_MSG("Goertzel bins: windows = %u, frequency = %f Hz, samples = %u",
+                 pGoertzel->numWindows, (double)pGoertzel->windowFrequency,
+                 pGoertzel->windowNumSamples)
+        for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+        {
+            pChannel = &pGoertzel->channel[i];
+            for (j = 0; j < pChannel->numBins; j++)
+            {
+                INFO_MSG("%-4s order %f = %f, %f deg", channel[i], (double)pChannel->order[j],
+                         (double)pChannel->magnitude[j], (double)pChannel->phase[j])
+            }
+        }
+    }
+    else
+    {
+        INFO_MSG("No Goertzel window completed")
+    }
+}
+
+void DisplayTrigger(void)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t freeSpace;
+    uint32_t numChannels;
+    int32_t frame[ADI_METIC_MAX_NUM_CHANNELS];
+    ADI_CLI_HANDLE hCli;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    METIC_TRIGGER_INFO *pTrigger = &pInfo->trigger;
+    static char *stateName[] = {"idle", "armed", "triggered", "complete"};
+
+    INFO_MSG("Trigger: state = %s, sources = 0x%x, gaps = %u", stateName[pTrigger->state],
+             pTrigger->config.sourceMask, pTrigger->numGaps)
+    if (pTrigger->state == METIC_TRIGGER_STATE_COMPLETE)
+    {
+        numChannels = pTrigger->validator.numChannels;
+        INFO_MSG("Fired by 0x%x at %u us, capture starts at %u us, frames = %u, trigger frame = %u",
+                 pTrigger->source, pTrigger->triggerTime, pTrigger->startTime,
+                 pTrigger->numCaptureFrames, pTrigger->triggerFrame)
+        for (j = 0; j < numChannels; j++)
+        {
+            INFO_MSG_RAW("%s,", channel[pTrigger->validator.order[j]])
+        }
+        INFO_MSG("")
+        for (i = 0; i < pTrigger->numCaptureFrames; i++)
+        {
+            MetIcIfReadTriggerCapture(pInfo, i, 1, &frame[0]);
+            for (j = 0; j < numChannels; j++)
+            {
+                INFO_MSG_RAW("%d,", frame[j])
+            }
+            INFO_MSG("")
+            do
+            {
+                hCli = GetCliHandle();
+                adi_cli_FlushMessages(hCli);
+                adi_cli_GetFreeMessageSpace(hCli, &freeSpace);
+            } while (freeSpace < MAX_MSG_STORAGE_SIZE_PER_CYCLE);
+        }
+    }
+}
+
+void DisplayWfsStream(void)
+{
+    uint32_t id;
+    char *pName;
+    ADI_METIC_WFS_STREAM_STATUS streamStatus = {0};
+    ADI_METIC_WFS_CONSUMER_STATUS consumerStatus;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+
+    adi_metic_WfsGetStreamStatus(pInfo->hAde, &streamStatus);
+    INFO_MSG("Stream: running = %u, blocks = %u, pending = %u, overruns = %u",
+             streamStatus.isStreaming, streamStatus.numBlocksReceived,
+             streamStatus.numBlocksPending, streamStatus.numOverruns)
+    for (id = 1; id <= ADI_METIC_WFS_MAX_CONSUMERS; id++)
+    {
+        if (adi_metic_WfsGetConsumerStatus(pInfo->hAde, id, &consumerStatus) ==
+            ADI_METIC_STATUS_SUCCESS)
+        {
+            pName = "other";
+            if (id == pInfo->harmonics.consumerId)
+            {
+                pName = "harmonics";
+            }
+            else if (id == pInfo->goertzel.consumerId)
+            {
+                pName = "goertzel";
+            }
+            else if (id == pInfo->trigger.consumerId)
+            {
+                pName = "trigger";
+            }
+            INFO_MSG("%s: read = %u, lag = %u, max lag = %u, skipped = %u, dropped = %u", pName,
+                     consumerStatus.numBlocksRead, consumerStatus.lag, consumerStatus.maxLag,
+                     consumerStatus.numSkipped, consumerStatus.isDropped)
+        }
+    }
+}
+
+float GetStatsScale(ADE_DISPLAY_CONFIG *pDisplay, uint32_t statsChannel)
+{
+    float scale = 1.0f;
+    if (statsChannel < 6)
+    {
+        if (statsChannel % 2 == 0)
+        {
+            scale = pDisplay->voltageScale;
+        }
+        else
+        {
+            scale = pDisplay->currentScale;
+        }
+    }
+    else if (statsChannel < STATS_POWER_CHANNEL_OFFSET)
+    {
+        scale = pDisplay->auxScale;
+    }
+    else if (statsChannel < STATS_PF_CHANNEL_OFFSET)
+    {
+        scale = pDisplay->voltageScale * pDisplay->currentScale;
+    }
+    return scale;
+}
+
 void DisplayConfigValue(uint16_t configChoice)
 {
     METIC_EXAMPLE_CONFIG *pConfig = GetExampleConfig();
@@ -470,18 +809,22 @@ void DisplayBurstRegisters(uint32_t addr, uint32_t numRegisters, int32_t *pRegDa
         {ADE9178_REG_AVRMS_2, ADE9178_REG_VACRMSONE_2},
     };
 
+    const uint32_t numRanges = sizeof(addrRange) / sizeof(addrRange[0]);
     uint32_t i, nextAddr = addr;
+    uint32_t range = 0;
 
+    // Ranges are in ascending order, so that the range of each address is found by advancing a
+    // cursor instead of searching all ranges.
     for (i = 0; i < numRegisters; i++)
     {
-        // Check if the current address falls within any range
-        for (size_t j = 0; j < sizeof(addrRange) / sizeof(addrRange[0]); j++)
+        while ((range < numRanges - 1) && (nextAddr > addrRange[range].end))
         {
-            if (nextAddr > addrRange[j].end)
-            {
-                nextAddr = addrRange[j].start;
-                break;
-            }
+            range++;
+        }
+        // Registers in gap between ranges are skipped by burst read
+        if (nextAddr < addrRange[range].start)
+        {
+            nextAddr = addrRange[range].start;
         }
 
         INFO_MSG("Address = 0x%x    Value = 0x%x\t", nextAddr, pRegData[i]);
@@ -0,0 +1,229 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        float_format.c
+ * @brief       Formatting of float values as fixed point text without printf.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "float_format.h"
+#include <stdint.h>
+
+/*============= D E F I N E S =============*/
+
+/** Position of exponent in a float */
+#define FLOAT_FORMAT_EXPONENT_POS 23
+/** Mask of mantissa of a float */
+#define FLOAT_FORMAT_MANTISSA_MASK 0x7FFFFFu
+/** Exponent of inf and nan */
+#define FLOAT_FORMAT_EXPONENT_MAX 0xFF
+/** Value of a float is mantissa * 2^(exponent - FLOAT_FORMAT_EXPONENT_BIAS) */
+#define FLOAT_FORMAT_EXPONENT_BIAS 150
+/** Largest left shift of mantissa that fits 64 bits */
+#define FLOAT_FORMAT_MAX_LEFT_SHIFT 40
+/** Value of 9 digits, written from 32 bit chunks for 64 bit values */
+#define FLOAT_FORMAT_CHUNK 1000000000u
+/** Maximum number of chunks of 9 digits in a 64 bit value */
+#define FLOAT_FORMAT_MAX_NUM_CHUNKS 3
+
+/** Text of numbers 00 to 99 */
+static const char digitPairs[201] = "00010203040506070809"
+                                    "10111213141516171819"
+                                    "20212223242526272829"
+                                    "30313233343536373839"
+                                    "40414243444546474849"
+                                    "50515253545556575859"
+                                    "60616263646566676869"
+                                    "70717273747576777879"
+                                    "80818283848586878889"
+                                    "90919293949596979899";
+
+/** Scale of fraction for number of decimals */
+static const uint32_t decimalScale[FLOAT_FORMAT_MAX_NUM_DECIMALS + 1] = {1,     10,     100,
+                                                                          1000,  10000,  100000,
+                                                                          1000000};
+
+/**
+ * @brief Writes digits of a 32 bit value, two at a time.
+ * @param[out] pDst - pointer to text.
+ * @param[in] value - value.
+ * @param[in] numDigits - number of digits, leading digits are zero.
+ */
+static void WriteDigits(char *pDst, uint32_t value, uint32_t numDigits);
+
+/**
+ * @brief Writes digits of a 64 bit value without leading zeros.
+ * @param[out] pDst - pointer to text.
+ * @param[in] value - value.
+ * @return number of digits written
+ */
+static uint32_t WriteInteger(char *pDst, uint64_t value);
+
+/**
+ * @brief Returns number of decimal digits of a 32 bit value.
+ * @param[in] value - value.
+ * @return number of digits, 1 for 0
+ */
+static uint32_t GetNumDigits(uint32_t value);
+
+/*=============  C O D E  =============*/
+
+uint32_t FormatFloat(char *pDst, float value, uint32_t numDecimals)
+{
+    uint32_t numChars = 0;
+    uint32_t bits;
+    uint32_t exponent;
+    uint32_t mantissa;
+    uint32_t fracBits;
+    uint32_t fracPart = 0;
+    uint32_t lastDigit;
+    uint32_t scale;
+    int32_t shift;
+    uint64_t intPart;
+    uint64_t product;
+    uint64_t remainder;
+    uint64_t half;
+    union
+    {
+        float f;
+        uint32_t u;
+    } convert;
+
+    convert.f = value;
+    bits = convert.u;
+    exponent = (bits >> FLOAT_FORMAT_EXPONENT_POS) & FLOAT_FORMAT_EXPONENT_MAX;
+    mantissa = bits & FLOAT_FORMAT_MANTISSA_MASK;
+    if (numDecimals > FLOAT_FORMAT_MAX_NUM_DECIMALS)
+    {
+        numDecimals = FLOAT_FORMAT_MAX_NUM_DECIMALS;
+    }
+    scale = decimalScale[numDecimals];
+    if ((bits >> 31) != 0)
+    {
+        pDst[numChars++] = '-';
+    }
+    // Value is mantissa * 2^-shift. Subnormals have no implicit bit.
+    shift = FLOAT_FORMAT_EXPONENT_BIAS - (int32_t)exponent;
+    if (exponent == 0)
+    {
+        shift = FLOAT_FORMAT_EXPONENT_BIAS - 1;
+    }
+    else
+    {
+        mantissa |= FLOAT_FORMAT_MANTISSA_MASK + 1;
+    }
+    if ((exponent == FLOAT_FORMAT_EXPONENT_MAX) && (mantissa != FLOAT_FORMAT_MANTISSA_MASK + 1))
+    {
+        pDst[numChars++] = 'n';
+        pDst[numChars++] = 'a';
+        pDst[numChars++] = 'n';
+    }
+    else if ((exponent == FLOAT_FORMAT_EXPONENT_MAX) || (-shift > FLOAT_FORMAT_MAX_LEFT_SHIFT))
+    {
+        pDst[numChars++] = 'i';
+        pDst[numChars++] = 'n';
+        pDst[numChars++] = 'f';
+    }
+    else
+    {
+        if (shift <= 0)
+        {
+            intPart = (uint64_t)mantissa << -shift;
+        }
+        else
+        {
+            intPart = (shift < 32) ? (mantissa >> shift) : 0;
+            fracBits = (shift < 32) ? (mantissa & ((1u << shift) - 1)) : mantissa;
+            // Fraction times scale is exact in 64 bits, so rounding is exact. Ties go to even
+            // as in printf.
+            product = (uint64_t)fracBits * scale;
+            if (shift < 64)
+            {
+                fracPart = (uint32_t)(product >> shift);
+                remainder = product & (((uint64_t)1 << shift) - 1);
+                half = (uint64_t)1 << (shift - 1);
+                lastDigit = (numDecimals > 0) ? fracPart : (uint32_t)intPart;
+                if ((remainder > half) || ((remainder == half) && ((lastDigit & 1) != 0)))
+                {
+                    fracPart++;
+                }
+            }
+            if (fracPart >= scale)
+            {
+                fracPart -= scale;
+                intPart++;
+            }
+        }
+        numChars += WriteInteger(&pDst[numChars], intPart);
+        if (numDecimals > 0)
+        {
+            pDst[numChars++] = '.';
+            WriteDigits(&pDst[numChars], fracPart, numDecimals);
+            numChars += numDecimals;
+        }
+    }
+    pDst[numChars] = '\0';
+    return numChars;
+}
+
+uint32_t WriteInteger(char *pDst, uint64_t value)
+{
+    uint32_t numDigits;
+    uint32_t numChunks = 0;
+    uint32_t chunk[FLOAT_FORMAT_MAX_NUM_CHUNKS];
+
+    // 64 bit division only for values beyond 32 bits
+    while (value >= FLOAT_FORMAT_CHUNK)
+    {
+        chunk[numChunks++] = (uint32_t)(value % FLOAT_FORMAT_CHUNK);
+        value /= FLOAT_FORMAT_CHUNK;
+    }
+    numDigits = GetNumDigits((uint32_t)value);
+    WriteDigits(pDst, (uint32_t)value, numDigits);
+    while (numChunks > 0)
+    {
+        numChunks--;
+        WriteDigits(&pDst[numDigits], chunk[numChunks], 9);
+        numDigits += 9;
+    }
+    return numDigits;
+}
+
+void WriteDigits(char *pDst, uint32_t value, uint32_t numDigits)
+{
+    uint32_t pos = numDigits;
+    uint32_t pair;
+
+    while (pos >= 2)
+    {
+        pair = value % 100;
+        value /= 100;
+        pos -= 2;
+        pDst[pos] = digitPairs[2 * pair];
+        pDst[pos + 1] = digitPairs[2 * pair + 1];
+    }
+    if (pos == 1)
+    {
+        pDst[0] = (char)('0' + value % 10);
+    }
+}
+
+uint32_t GetNumDigits(uint32_t value)
+{
+    uint32_t numDigits = 1;
+
+    while ((numDigits < 10) && (value >= 10))
+    {
+        value /= 10;
+        numDigits++;
+    }
+    return numDigits;
+}
+
+/**
+ * @}
+ */
@@ -19,6 +19,21 @@ extern "C" {
 
 /*============= D E F I N E S =============*/
 
+/** Number of addresses of configuration window, AVGAIN to CONFIG_LOCK */
+#define CONFIG_REG_NUM_CONFIG_ADDRESSES (ADE9178_REG_CONFIG_LOCK - ADE9178_REG_AVGAIN + 1)
+
+/**
+ * @brief Gets position of an address in configuration and status windows.
+ * @param[in] address - address of register.
+ * @return position, -1 if address is outside windows
+ */
+static int32_t GetWindowPosition(uint32_t address);
+
+/** Index plus 1 in #configReg of each address of configuration and status windows, 0 if none */
+static uint16_t configRegSlot[MAX_NUM_REGISTERS];
+/** 1 once #configRegSlot is built */
+static uint32_t isConfigRegSlotBuilt;
+
 /** List of channel configuration registers. This is fixed as per ADE9178*/
 ADE_REGISTER_UINT configReg[] = {
     {ADE9178_REG_AVGAIN, ADE9178_REG_AVGAIN_RESET},
@@ -255,6 +270,62 @@ ADE_REGISTER_UINT configReg[] = {
     {ADE9178_REG_ERROR_MASK, ADE9178_REG_ERROR_MASK_RESET},
 };
 
+/*=============  C O D E  =============*/
+
+int32_t GetConfigRegIndex(uint32_t address)
+{
+    int32_t index = -1;
+    int32_t position;
+    uint32_t i;
+
+    if (isConfigRegSlotBuilt == 0)
+    {
+        // Entries after the list are zero filled up to MAX_NUM_REGISTERS, so that first entry of
+        // an address is kept.
+        for (i = 0; i < sizeof(configReg) / sizeof(configReg[0]); i++)
+        {
+            position = GetWindowPosition(configReg[i].address);
+            if ((position >= 0) && (configRegSlot[position] == 0))
+            {
+                configRegSlot[position] = (uint16_t)(i + 1);
+            }
+        }
+        isConfigRegSlotBuilt = 1;
+    }
+    position = GetWindowPosition(address);
+    if (position >= 0)
+    {
+        index = (int32_t)configRegSlot[position] - 1;
+    }
+    else
+    {
+        // Few registers of the list are outside windows, they are searched.
+        for (i = 0; (i < sizeof(configReg) / sizeof(configReg[0])) && (index == -1); i++)
+        {
+            if (configReg[i].address == address)
+            {
+                index = (int32_t)i;
+            }
+        }
+    }
+    return index;
+}
+
+int32_t GetWindowPosition(uint32_t address)
+{
+    int32_t position = -1;
+
+    if (address <= ADE9178_REG_CONFIG_LOCK)
+    {
+        position = (int32_t)(address - ADE9178_REG_AVGAIN);
+    }
+    else if ((address >= ADE9178_REG_STATUS0) && (address <= ADE9178_REG_ERROR_MASK))
+    {
+        position = (int32_t)(CONFIG_REG_NUM_CONFIG_ADDRESSES + address - ADE9178_REG_STATUS0);
+    }
+    return position;
+}
+
 /**
  * @}
  */
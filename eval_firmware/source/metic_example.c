@@ -13,13 +13,15 @@
 #include "adi_cli.h"
 #include "adi_metic.h"
 #include "app_cfg.h"
-#include "dispatch_table.h"
+#include "cli_commands.h"
+#include "deferred_log.h"
 #include "error_display.h"
 #include "example_display.h"
 #include "message.h"
 #include "metic_hal.h"
 #include "metic_service_interface.h"
 #include "status.h"
+#include "wfs_dump.h"
 
 /**
  *  Top level structure for MET application
@@ -33,6 +35,22 @@ static int32_t PopulateAdeExampleStruct(void);
 static void HostUartRxCallback(void);
 static void HostUartTxCallback(void);
 static void HandleWaveformCaptureAndMissedCounts(METIC_EXAMPLE *pExample);
+/**
+ *  Adds outputs of a cycle to aggregate and completes interval when it has elapsed.
+ */
+static void AddOutputAggregate(METIC_EXAMPLE *pExample);
+/**
+ *  Moves aggregate to completed interval to be displayed and starts a new interval.
+ */
+static void CompleteOutputAggregate(METIC_EXAMPLE *pExample);
+/**
+ *  Displays records of completed interval, one record each time there is message space.
+ */
+static void DisplayOutputAggregate(METIC_EXAMPLE *pExample);
+/**
+ *  Checks if display of a record of aggregated outputs is enabled.
+ */
+static bool IsAggregateRecordEnabled(ADE_DISPLAY_CONFIG *pDisplay, uint32_t record);
 
 METIC_EXAMPLE_CONFIG *GetExampleConfig(void)
 {
@@ -77,15 +95,15 @@ void CliExample(int32_t status)
     METIC_EXAMPLE *pExample = &adeExample;
     ADI_CLI_HANDLE hCli = GetCliHandle();
     ADI_CLI_STATUS cliStatus = 0;
-    if (adi_cli_FlushMessages(hCli) == 0)
+    // UART belongs to the dump until it is sent, commands wait.
+    if ((WfsDumpIsBusy() == 0) && (adi_cli_FlushMessages(hCli) == 0))
     {
         if (status != SYS_STATUS_RUNNING)
         {
             cliStatus = adi_cli_GetCmd(hCli, pExample->cliIf.command);
             if (cliStatus == ADI_CLI_STATUS_SUCCESS)
             {
-                cliStatus =
-                    adi_cli_Dispatch(hCli, pExample->cliIf.command, dispatchTable, NUM_COMMANDS);
+                cliStatus = CliDispatch(hCli, pExample->cliIf.command);
             }
         }
     }
@@ -100,7 +118,7 @@ void HostUartRxCallback(void)
 void HostUartTxCallback(void)
 {
     METIC_EXAMPLE *pExample = &adeExample;
-    adi_cli_TxCallback(pExample->cliIf.hCli);
+    CliTxCallback(&pExample->cliIf);
 }
 
 int32_t InitServices(void)
@@ -116,6 +134,8 @@ int32_t InitServices(void)
         if (status == SYS_STATUS_SUCCESS)
         {
             adeStatus = MetIcIfCreateInstance(&pExample->adeInstance);
+            MetIcIfConfigureStats(&pExample->adeInstance, STATS_DEFAULT_TUMBLING_WINDOW_CYCLES,
+                                  STATS_MAX_SLIDING_WINDOW_CYCLES);
             /* This is only to check CF intervals if required*/
             PcntInit(&pExample->pcntInfo, APP_CFG_MAX_NUM_IRQ_TIME, &pExample->pcntBuffer[0]);
             if (adeStatus != ADI_METIC_STATUS_SUCCESS)
@@ -139,7 +159,9 @@ int32_t CollectMetOutputs(void)
     {
         pExample->adeInstance.freeSpaceAvail = 0;
         adi_cli_GetFreeMessageSpace(pExample->cliIf.hCli, &freeSpace);
-        if (freeSpace > MAX_MSG_STORAGE_SIZE_PER_CYCLE)
+        // Aggregated outputs need every cycle. Records wait for message space instead.
+        if ((freeSpace > GetDisplayMsgSize(&pExample->exampleConfig.displayConfig)) ||
+            (pExample->exampleConfig.displayConfig.rate != ADE_DISPLAY_RATE_EVERY_CYCLE))
         {
             pExample->adeInstance.freeSpaceAvail = 1;
         }
@@ -151,18 +173,25 @@ int32_t CollectMetOutputs(void)
         case 0: // Success
             if (pExample->adeInstance.enableRegisterRead)
             {
-                DisplayOutput(&pExample->exampleConfig.displayConfig,
-                              pExample->adeInstance.irqStatus.irq0Count, &pExample->output);
+                if (pExample->exampleConfig.displayConfig.rate != ADE_DISPLAY_RATE_EVERY_CYCLE)
+                {
+                    AddOutputAggregate(pExample);
+                }
+                else
+                {
+                    DisplayOutput(&pExample->exampleConfig.displayConfig,
+                                  pExample->adeInstance.irqStatus.irq0Count, &pExample->output);
+                }
             }
             pExample->processedCycles++;
             break;
 
         case SYS_STATUS_IRQ0_TIME_OUT_ERROR:
-            ERROR_MSG("Timeout error in IRQ0");
+            DEFERRED_LOG0(LOG_ID_IRQ0_TIMEOUT)
             break;
 
         case SYS_STATUS_SPI_COMM_ERROR:
-            ERROR_MSG("Errors detected in reading output registers");
+            DEFERRED_LOG0(LOG_ID_OUTPUT_READ_ERROR)
             pExample->processedCycles = pExample->exampleConfig.cyclesToRun;
             break;
 
@@ -174,6 +203,11 @@ int32_t CollectMetOutputs(void)
     {
         // Handle waveform capture and missed counts
         HandleWaveformCaptureAndMissedCounts(pExample);
+        // Last interval is displayed even if it is shorter.
+        if (pExample->aggregate.numCycles > 0)
+        {
+            CompleteOutputAggregate(pExample);
+        }
         status = SYS_STATUS_NOT_STARTED;
         pExample->state = METIC_EXAMPLE_STATE_WAITING_FOR_START_CMD;
     }
@@ -181,6 +215,94 @@ int32_t CollectMetOutputs(void)
     return status;
 }
 
+void AddOutputAggregate(METIC_EXAMPLE *pExample)
+{
+    uint32_t currTime = EvbGetTime();
+    uint32_t elapsedTime;
+    ADE_DISPLAY_CONFIG *pDisplay = &pExample->exampleConfig.displayConfig;
+    OUTPUT_AGGREGATE *pAggregate = &pExample->aggregate;
+
+    OutputAggregateAdd(pAggregate, pExample->adeInstance.irqStatus.irq0Count, &pExample->output);
+    if (currTime >= pAggregate->startTime)
+    {
+        elapsedTime = currTime - pAggregate->startTime;
+    }
+    else
+    {
+        elapsedTime = EvbGetMaxTime() - pAggregate->startTime + currTime;
+    }
+    if (((pDisplay->rate == ADE_DISPLAY_RATE_CYCLES) &&
+         (pAggregate->numCycles >= pDisplay->rateInterval)) ||
+        ((pDisplay->rate == ADE_DISPLAY_RATE_MSEC) &&
+         (elapsedTime / 1000u >= pDisplay->rateInterval)))
+    {
+        CompleteOutputAggregate(pExample);
+    }
+}
+
+void CompleteOutputAggregate(METIC_EXAMPLE *pExample)
+{
+    // Records of previous interval not yet displayed are replaced.
+    pExample->completedAggregate = pExample->aggregate;
+    pExample->nextAggregateRecord = 0;
+    OutputAggregateReset(&pExample->aggregate, EvbGetTime());
+}
+
+void DisplayOutputAggregate(METIC_EXAMPLE *pExample)
+{
+    uint32_t freeSpace;
+    int32_t isSpaceAvail = 1;
+    ADE_DISPLAY_CONFIG *pDisplay = &pExample->exampleConfig.displayConfig;
+
+    while ((pExample->nextAggregateRecord < OUTPUT_AGGREGATE_NUM_RECORDS) && (isSpaceAvail == 1))
+    {
+        if (IsAggregateRecordEnabled(pDisplay, pExample->nextAggregateRecord) == false)
+        {
+            pExample->nextAggregateRecord++;
+        }
+        else
+        {
+            adi_cli_GetFreeMessageSpace(pExample->cliIf.hCli, &freeSpace);
+            isSpaceAvail = (freeSpace > GetDisplayMsgSize(pDisplay)) ? 1 : 0;
+            if (isSpaceAvail == 1)
+            {
+                DisplayAggregateRecord(pDisplay, &pExample->completedAggregate,
+                                       pExample->nextAggregateRecord);
+                pExample->nextAggregateRecord++;
+            }
+        }
+    }
+}
+
+bool IsAggregateRecordEnabled(ADE_DISPLAY_CONFIG *pDisplay, uint32_t record)
+{
+    bool isEnabled;
+
+    switch (record)
+    {
+    case OUTPUT_AGGREGATE_RECORD_MEAN:
+        isEnabled = pDisplay->enableMeanOutput;
+        break;
+    case OUTPUT_AGGREGATE_RECORD_MIN:
+        isEnabled = pDisplay->enableMinOutput;
+        break;
+    case OUTPUT_AGGREGATE_RECORD_MAX:
+        isEnabled = pDisplay->enableMaxOutput;
+        break;
+    default:
+        isEnabled = false;
+        break;
+    }
+    return isEnabled;
+}
+
+void ResetOutputAggregate(void)
+{
+    METIC_EXAMPLE *pExample = &adeExample;
+    OutputAggregateReset(&pExample->aggregate, EvbGetTime());
+    pExample->nextAggregateRecord = OUTPUT_AGGREGATE_NUM_RECORDS;
+}
+
 void HandleWaveformCaptureAndMissedCounts(METIC_EXAMPLE *pExample)
 {
     // Handle waveform capture
@@ -190,8 +312,7 @@ void HandleWaveformCaptureAndMissedCounts(METIC_EXAMPLE *pExample)
             MetIcIfCollectSamples(&pExample->adeInstance, pExample->exampleConfig.wfsConfig);
         if (adeStatus != 0 && adeStatus != ADI_METIC_STATUS_WFS_TRANSACTION_COMPLETED)
         {
-            ERROR_MSG("Failed to stream samples. Error code from Metrology Service is %d",
-                      adeStatus);
+            DEFERRED_LOG1(LOG_ID_WFS_STREAM_ERROR, adeStatus)
         }
     }
 
@@ -201,10 +322,8 @@ void HandleWaveformCaptureAndMissedCounts(METIC_EXAMPLE *pExample)
         int32_t missedCount = pExample->adeInstance.irqStatus.irq0Count - pExample->processedCycles;
         if (missedCount > 0)
         {
-            WARN_MSG("Missed count of sending metrology outputs through UART is %d", missedCount);
-            INFO_MSG(
-                "Try enabling single output parameters to reduce missed count of output display. "
-                "Refer to setdisplay command for list of output parameters to select.");
+            DEFERRED_LOG1(LOG_ID_MISSED_COUNT, missedCount)
+            DEFERRED_LOG0(LOG_ID_MISSED_COUNT_HINT)
         }
     }
 }
@@ -216,6 +335,7 @@ int32_t InitExampleStates(void)
     METIC_EXAMPLE_CONFIG *pConfig = &pExample->exampleConfig;
     int32_t mask0 = ADE9178_BITM_MASK0_RMSONERDY;
     InitDisplayConfig(&pExample->exampleConfig.displayConfig);
+    ResetOutputAggregate();
 #if BOARD_CFG_RESET_TYPE == 0
     status = HandleResetCmd(RESET_DEVICE_ADE9178);
 #else
@@ -255,6 +375,7 @@ int32_t HandleRunState(void)
 {
     int32_t status = SYS_STATUS_RUNNING;
     METIC_EXAMPLE *pExample = &adeExample;
+    uint32_t freeSpace;
     switch (pExample->state)
     {
     case METIC_EXAMPLE_STATE_WAITING_FOR_START_CMD:
@@ -266,7 +387,19 @@ int32_t HandleRunState(void)
         break;
     }
 
+    // Waveform stream blocks are consumed as they are filled, independent of run state.
+    ServiceWaveformStream();
+    MetIcIfProcessHarmonics(&pExample->adeInstance);
+    MetIcIfProcessGoertzel(&pExample->adeInstance);
+    if (MetIcIfProcessTrigger(&pExample->adeInstance) == 1)
+    {
+        DEFERRED_LOG0(LOG_ID_TRIGGER_COMPLETE)
+    }
     DisplayErrorStatusMessage(pExample);
+    DisplayOutputAggregate(pExample);
+    adi_cli_GetFreeMessageSpace(pExample->cliIf.hCli, &freeSpace);
+    DeferredLogFlush(freeSpace);
+    WfsDumpProcess();
     return status;
 }
 
@@ -326,6 +459,7 @@ int32_t HandleStartCmd(void)
     METIC_EXAMPLE *pExample = &adeExample;
     ADI_METIC_STATUS adeStatus = ADI_METIC_STATUS_SUCCESS;
     pExample->processedCycles = 0;
+    ResetOutputAggregate();
     adeStatus = MetIcIfResetIrqStatus(&pExample->adeInstance);
     pExample->adeInstance.irqStatus.lastIrqTime = EvbGetTime();
     if (adeStatus == ADI_METIC_STATUS_SUCCESS)
@@ -381,6 +515,7 @@ void HandleSetConfigCmd(uint16_t configChoice, float value)
         pConfig->displayConfig.auxScale = value;
         break;
     }
+    CompileDisplayPlan(&pConfig->displayConfig);
     DisplayConfigValue(configChoice);
 }
 
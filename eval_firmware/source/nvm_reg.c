@@ -57,6 +57,26 @@ METIC_REGISTER adeExampleNvmReg[] = {
     {ADE9178_REG_MASK1, 0},         {ADE9178_REG_MASK2, 0},         {ADE9178_REG_MASK3, 0},
     {ADE9178_REG_ERROR_MASK, 0}};
 
+/**
+ * Address window read in bursts for a snapshot of registers
+ */
+typedef struct
+{
+    /** First address of window */
+    uint32_t start;
+    /** Last address of window */
+    uint32_t end;
+} NVM_SNAPSHOT_WINDOW;
+
+/** Windows of contiguous addresses holding registers of #adeExampleNvmReg */
+static const NVM_SNAPSHOT_WINDOW snapshotWindow[] = {
+    {ADE9178_REG_AVGAIN, ADE9178_REG_CONFIG_LOCK},
+    {ADE9178_REG_STATUS0, ADE9178_REG_ERROR_MASK},
+};
+
+/** Values of a burst read */
+static int32_t snapshotBuffer[ADI_METIC_MAX_NUM_REGISTERS];
+
 /**
  * @brief Reads values from flash.
  * @param[out] pNvm   - pointer to nvm.
@@ -84,7 +104,9 @@ static int32_t WriteConfigRegister(METIC_REGISTER *pSrc, int32_t numSrcRegisters
                                    int32_t numDstRegisters, METIC_REGISTER *pDst);
 
 /**
- * @brief Reads register values from Metrology IC, and Copies pSrc to pDst.
+ * @brief Reads register values from Metrology IC, and Copies pSrc to pDst. Registers in
+ * #snapshotWindow are read in bursts of up to #ADI_METIC_MAX_NUM_REGISTERS, from lowest to highest
+ * address of pDst, so that a snapshot takes few transactions. Other registers are read one by one.
  * @param[in] pSrc - pointer to source.
  * @param[in] numSrcRegisters   -  number of registers in pSrc.
  * @param[in] numDstRegisters   -  number of registers in pDst.
@@ -108,6 +130,39 @@ static int32_t WriteToSlave(uint32_t address, int32_t *pValue);
  */
 static int32_t ReadFromSlave(uint32_t address, int32_t *pValue);
 
+/**
+ * @brief Gets next burst of a window to read. Burst starts at lowest address of pDst not below
+ * start, and ends at highest address of pDst that fits in a burst.
+ * @param[in] pDst - pointer to registers to read.
+ * @param[in] numRegisters - number of registers in pDst.
+ * @param[in] start - lowest address of burst.
+ * @param[in] end - last address of window.
+ * @param[out] pAddress - first address of burst.
+ * @returns number of registers of burst, 0 if no register of pDst is left in window
+ */
+static uint32_t GetSnapshotBurst(METIC_REGISTER *pDst, int32_t numRegisters, uint32_t start,
+                                 uint32_t end, uint32_t *pAddress);
+
+/**
+ * @brief Copies values of a burst into pDst and into registers of pSrc at same addresses.
+ * @param[in] address - first address of burst.
+ * @param[in] numBurstRegisters - number of registers of burst.
+ * @param[in] pSrc - pointer to registers laid out as #configReg.
+ * @param[in] numSrcRegisters - number of registers in pSrc.
+ * @param[in] numDstRegisters - number of registers in pDst.
+ * @param[out] pDst - pointer to registers read.
+ */
+static void ScatterSnapshotBurst(uint32_t address, uint32_t numBurstRegisters,
+                                 METIC_REGISTER *pSrc, int32_t numSrcRegisters,
+                                 int32_t numDstRegisters, METIC_REGISTER *pDst);
+
+/**
+ * @brief Checks if an address is in #snapshotWindow.
+ * @param[in] address - address of register.
+ * @returns 1 if address is in a window, 0 otherwise
+ */
+static uint32_t IsInSnapshotWindow(uint32_t address);
+
 /**
  * @brief Copies values from pSrc of type (address, value) into pDst.
  * @param[in] pSrc - pointer to source.
@@ -126,6 +181,13 @@ static void CopyNvmAddressToNvm(METIC_REGISTER *pSrc, int32_t numRegisters, int3
  */
 static void CopyNvmToNvmAddress(int32_t *pSrc, int32_t numRegisters, METIC_REGISTER *pDst);
 
+/**
+ * @brief Gets index of an address in a buffer laid out as #configReg.
+ * @param[in] address - address of register.
+ * @param[in] numRegisters - number of registers in buffer.
+ * @param[in] pDst - pointer to buffer.
+ * @returns index of register, -1 if it is not in buffer
+ */
 static int32_t GetRegIndex(uint32_t address, int32_t numRegisters, METIC_REGISTER *pDst);
 
 int32_t LoadNvmReg(METIC_EXAMPLE *pExample)
@@ -240,43 +302,149 @@ static int32_t ReadConfigRegister(METIC_REGISTER *pSrc, int32_t numSrcRegisters,
     int32_t status = 0;
     int32_t index;
     int32_t i;
-    // Iterates through list of registers in destination buffer (adeExampleNvmReg) and gets index of
-    // the address present in source buffer (ADE_CONFIG_REG) and sends read command to Metrology IC
-    // and updates the value in #adeExampleNvmReg.
-    for (i = 0; i < numDstRegisters; i++)
+    uint32_t w;
+    uint32_t address;
+    uint32_t start;
+    uint32_t numBurstRegisters;
+    ADI_METIC_STATUS adeStatus;
+    METIC_INSTANCE_INFO *pInfo;
+    pInfo = GetAdeInstance();
+    // Reads each window in bursts covering registers of destination buffer (adeExampleNvmReg),
+    // and scatters the values into #adeExampleNvmReg and source buffer (ADE_CONFIG_REG).
+    for (w = 0; (w < sizeof(snapshotWindow) / sizeof(snapshotWindow[0])) && (status == 0); w++)
     {
-        index = GetRegIndex(pDst[i].address, numSrcRegisters, pSrc);
-        if (index != -1)
+        start = snapshotWindow[w].start;
+        numBurstRegisters = 1;
+        while ((numBurstRegisters != 0) && (status == 0))
         {
-            status = ReadFromSlave(pSrc[index].address, &pSrc[index].value);
-            memcpy(&pDst[i].value, &pSrc[index].value, 4);
-            if (status != 0)
+            numBurstRegisters =
+                GetSnapshotBurst(pDst, numDstRegisters, start, snapshotWindow[w].end, &address);
+            if (numBurstRegisters != 0)
             {
-                break;
+                adeStatus = adi_metic_ReadRegister(pInfo->hAde, 0, (uint16_t)address,
+                                                   numBurstRegisters, &snapshotBuffer[0]);
+                if (adeStatus == ADI_METIC_STATUS_SUCCESS)
+                {
+                    ScatterSnapshotBurst(address, numBurstRegisters, pSrc, numSrcRegisters,
+                                         numDstRegisters, pDst);
+                    start = address + numBurstRegisters;
+                }
+                else
+                {
+                    DisplayErrorCode((uint16_t)address, 1, snapshotBuffer[0], adeStatus);
+                    status = -1;
+                }
             }
         }
-        else
+    }
+    // Registers outside windows are read one by one.
+    for (i = 0; (i < numDstRegisters) && (status == 0); i++)
+    {
+        if (IsInSnapshotWindow(pDst[i].address) == 0)
         {
-            WARN_MSG("Address 0x%x is not found in ade configuration structure", pSrc[i].address)
+            index = GetRegIndex(pDst[i].address, numSrcRegisters, pSrc);
+            if (index != -1)
+            {
+                status = ReadFromSlave(pSrc[index].address, &pSrc[index].value);
+                memcpy(&pDst[i].value, &pSrc[index].value, 4);
+            }
+            else
+            {
+                WARN_MSG("Address 0x%x is not found in ade configuration structure",
+                         pDst[i].address)
+            }
         }
     }
     return status;
 }
 
-int32_t GetRegIndex(uint32_t address, int32_t numRegisters, METIC_REGISTER *pDst)
+uint32_t GetSnapshotBurst(METIC_REGISTER *pDst, int32_t numRegisters, uint32_t start, uint32_t end,
+                          uint32_t *pAddress)
 {
-    int32_t index = -1;
-    int32_t j;
-    // Iterating through all the configuration registers in ADE9178, and finds the index of the
-    // matching address.
-    for (j = 0; j < numRegisters; j++)
+    int32_t i;
+    uint32_t first = end + 1;
+    uint32_t last;
+    uint32_t lastInBurst;
+    uint32_t numBurstRegisters = 0;
+
+    for (i = 0; i < numRegisters; i++)
     {
-        if (address == pDst[j].address)
+        if ((pDst[i].address >= start) && (pDst[i].address < first))
         {
-            index = (int32_t)j;
-            break;
+            first = pDst[i].address;
         }
     }
+    if (first <= end)
+    {
+        last = first;
+        lastInBurst = first + ADI_METIC_MAX_NUM_REGISTERS - 1;
+        if (lastInBurst > end)
+        {
+            lastInBurst = end;
+        }
+        for (i = 0; i < numRegisters; i++)
+        {
+            if ((pDst[i].address > last) && (pDst[i].address <= lastInBurst))
+            {
+                last = pDst[i].address;
+            }
+        }
+        *pAddress = first;
+        numBurstRegisters = last - first + 1;
+    }
+    return numBurstRegisters;
+}
+
+void ScatterSnapshotBurst(uint32_t address, uint32_t numBurstRegisters, METIC_REGISTER *pSrc,
+                          int32_t numSrcRegisters, int32_t numDstRegisters, METIC_REGISTER *pDst)
+{
+    int32_t i;
+    int32_t index;
+
+    for (i = 0; i < numDstRegisters; i++)
+    {
+        if ((pDst[i].address >= address) && (pDst[i].address < address + numBurstRegisters))
+        {
+            pDst[i].value = snapshotBuffer[pDst[i].address - address];
+            index = GetRegIndex(pDst[i].address, numSrcRegisters, pSrc);
+            if (index != -1)
+            {
+                pSrc[index].value = pDst[i].value;
+            }
+            else
+            {
+                WARN_MSG("Address 0x%x is not found in ade configuration structure",
+                         pDst[i].address)
+            }
+        }
+    }
+}
+
+uint32_t IsInSnapshotWindow(uint32_t address)
+{
+    uint32_t isInWindow = 0;
+    uint32_t w;
+
+    for (w = 0; w < sizeof(snapshotWindow) / sizeof(snapshotWindow[0]); w++)
+    {
+        if ((address >= snapshotWindow[w].start) && (address <= snapshotWindow[w].end))
+        {
+            isInWindow = 1;
+        }
+    }
+    return isInWindow;
+}
+
+int32_t GetRegIndex(uint32_t address, int32_t numRegisters, METIC_REGISTER *pDst)
+{
+    int32_t index;
+    // Buffer is a copy of #configReg, so that index of address in #configReg is looked up instead
+    // of searching the buffer.
+    index = GetConfigRegIndex(address);
+    if ((index >= numRegisters) || ((index != -1) && (pDst[index].address != address)))
+    {
+        index = -1;
+    }
     return index;
 }
 
@@ -0,0 +1,85 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        output_aggregate.c
+ * @brief       Mean, minimum and maximum of metrology outputs over an interval of cycles.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "output_aggregate.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*============= D E F I N E S =============*/
+
+/** Number of float values of outputs. All members before status are floats */
+#define OUTPUT_AGGREGATE_NUM_VALUES (offsetof(ADI_METIC_OUTPUT, statusOut) / sizeof(float))
+/** Number of status words of outputs */
+#define OUTPUT_AGGREGATE_NUM_STATUS (sizeof(ADI_METIC_STATUS_OUTPUT) / sizeof(uint32_t))
+
+/*=============  C O D E  =============*/
+
+void OutputAggregateReset(OUTPUT_AGGREGATE *pAggregate, uint32_t startTime)
+{
+    memset(&pAggregate->record[0], 0, sizeof(pAggregate->record));
+    pAggregate->numCycles = 0;
+    pAggregate->startTime = startTime;
+    pAggregate->irqCount = 0;
+}
+
+void OutputAggregateAdd(OUTPUT_AGGREGATE *pAggregate, uint32_t irqCount,
+                        ADI_METIC_OUTPUT *pOutput)
+{
+    uint32_t i;
+    uint32_t j;
+    float weight;
+    float *pValue = (float *)pOutput;
+    float *pMean = (float *)&pAggregate->record[OUTPUT_AGGREGATE_RECORD_MEAN];
+    float *pMin = (float *)&pAggregate->record[OUTPUT_AGGREGATE_RECORD_MIN];
+    float *pMax = (float *)&pAggregate->record[OUTPUT_AGGREGATE_RECORD_MAX];
+    uint32_t *pStatus = (uint32_t *)&pOutput->statusOut;
+    uint32_t *pRecordStatus;
+
+    pAggregate->numCycles++;
+    pAggregate->irqCount = irqCount;
+    if (pAggregate->numCycles == 1)
+    {
+        for (i = 0; i < OUTPUT_AGGREGATE_NUM_RECORDS; i++)
+        {
+            pAggregate->record[i] = *pOutput;
+        }
+    }
+    else
+    {
+        weight = 1.0f / (float)pAggregate->numCycles;
+        for (i = 0; i < OUTPUT_AGGREGATE_NUM_VALUES; i++)
+        {
+            pMean[i] += (pValue[i] - pMean[i]) * weight;
+            if (pValue[i] < pMin[i])
+            {
+                pMin[i] = pValue[i];
+            }
+            if (pValue[i] > pMax[i])
+            {
+                pMax[i] = pValue[i];
+            }
+        }
+        for (i = 0; i < OUTPUT_AGGREGATE_NUM_RECORDS; i++)
+        {
+            pRecordStatus = (uint32_t *)&pAggregate->record[i].statusOut;
+            for (j = 0; j < OUTPUT_AGGREGATE_NUM_STATUS; j++)
+            {
+                pRecordStatus[j] |= pStatus[j];
+            }
+        }
+    }
+}
+
+/**
+ * @}
+ */
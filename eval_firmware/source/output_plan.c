@@ -0,0 +1,429 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        output_plan.c
+ * @brief       Plan of metrology output values to display, compiled from display configuration.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "output_plan.h"
+#include "float_format.h"
+#include "message.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*============= D E F I N E S =============*/
+
+/** Number of channels with RMS outputs */
+#define OUTPUT_PLAN_NUM_RMS_CHANNELS ADI_METIC_MAX_NUM_CHANNELS
+/** Number of voltage and current channels. Channels after these are auxiliary */
+#define OUTPUT_PLAN_NUM_PHASE_CHANNELS 6
+
+/** Field of a group of values */
+#define OUTPUT_PLAN_FIELD_OF(member, stride, enable, nameId, scaleType)                            \
+    {offsetof(ADI_METIC_OUTPUT, member), stride, offsetof(ADE_DISPLAY_CONFIG, enable), nameId,   \
+     scaleType}
+/** Field of RMS outputs of a channel */
+#define OUTPUT_PLAN_RMS_FIELD(member, enable, nameId)                                              \
+    OUTPUT_PLAN_FIELD_OF(rmsOut[0].member, sizeof(ADI_METIC_RMS_OUTPUT), enable, nameId,           \
+                         OUTPUT_PLAN_SCALE_RMS)
+
+/**
+ * Scale of a field
+ */
+typedef enum
+{
+    /** Value is not scaled */
+    OUTPUT_PLAN_SCALE_NONE,
+    /** Value is scaled by voltage, current or auxiliary scale of channel */
+    OUTPUT_PLAN_SCALE_RMS,
+    /** Value is scaled by product of voltage and current scales */
+    OUTPUT_PLAN_SCALE_POWER,
+    /** Value is a status word */
+    OUTPUT_PLAN_SCALE_HEX
+} OUTPUT_PLAN_SCALE;
+
+/**
+ * Ids of label names, in order of #outputPlanName
+ */
+typedef enum
+{
+    OUTPUT_PLAN_NAME_RMS,
+    OUTPUT_PLAN_NAME_RMSHALF,
+    OUTPUT_PLAN_NAME_RMSONE,
+    OUTPUT_PLAN_NAME_DIPHALF,
+    OUTPUT_PLAN_NAME_DIPONE,
+    OUTPUT_PLAN_NAME_SWELLHALF,
+    OUTPUT_PLAN_NAME_SWELLONE,
+    OUTPUT_PLAN_NAME_WATT,
+    OUTPUT_PLAN_NAME_VA,
+    OUTPUT_PLAN_NAME_PF,
+    OUTPUT_PLAN_NAME_WATTHR_POS,
+    OUTPUT_PLAN_NAME_WATTHR_NEG,
+    OUTPUT_PLAN_NAME_WATTHR_SIGNED,
+    OUTPUT_PLAN_NAME_VAHR,
+    OUTPUT_PLAN_NAME_ANGL_AV_BV,
+    OUTPUT_PLAN_NAME_ANGL_BV_CV,
+    OUTPUT_PLAN_NAME_ANGL_AV_CV,
+    OUTPUT_PLAN_NAME_ANGL_AV_AI,
+    OUTPUT_PLAN_NAME_ANGL_BV_BI,
+    OUTPUT_PLAN_NAME_ANGL_CV_CI,
+    OUTPUT_PLAN_NAME_ANGL_AI_BI,
+    OUTPUT_PLAN_NAME_ANGL_BI_CI,
+    OUTPUT_PLAN_NAME_ANGL_AI_CI,
+    OUTPUT_PLAN_NAME_APERIOD,
+    OUTPUT_PLAN_NAME_BPERIOD,
+    OUTPUT_PLAN_NAME_CPERIOD,
+    OUTPUT_PLAN_NAME_COM_PERIOD,
+    OUTPUT_PLAN_NAME_STATUS0,
+    OUTPUT_PLAN_NAME_STATUS1,
+    OUTPUT_PLAN_NAME_STATUS2,
+    OUTPUT_PLAN_NAME_STATUS3,
+    OUTPUT_PLAN_NAME_ERROR_STATUS
+} OUTPUT_PLAN_NAME;
+
+/**
+ * A value of a group, repeated for each channel of group
+ */
+typedef struct
+{
+    /** Offset of value of first channel in ADI_METIC_OUTPUT */
+    uint16_t offset;
+    /** Number of bytes from value of a channel to the next */
+    uint16_t stride;
+    /** Offset of enable flag in ADE_DISPLAY_CONFIG */
+    uint8_t enableOffset;
+    /** Id of label name */
+    uint8_t nameId;
+    /** Scale of value, one of #OUTPUT_PLAN_SCALE */
+    uint8_t scaleType;
+} OUTPUT_PLAN_FIELD;
+
+/**
+ * Group of values displayed together, channel by channel
+ */
+typedef struct
+{
+    /** Fields of a channel in order of display */
+    const OUTPUT_PLAN_FIELD *pFields;
+    /** Number of fields */
+    uint8_t numFields;
+    /** Id of label prefix of first channel */
+    uint8_t firstPrefixId;
+    /** Number of channels */
+    uint8_t numChannels;
+} OUTPUT_PLAN_GROUP;
+
+/**
+ * @brief Adds values of a group enabled in display configuration.
+ * @param[in,out] pPlan - pointer to plan.
+ * @param[in] pDisplay - pointer to display configuration.
+ * @param[in] pGroup - pointer to group.
+ */
+static void AddGroup(OUTPUT_PLAN *pPlan, ADE_DISPLAY_CONFIG *pDisplay,
+                     const OUTPUT_PLAN_GROUP *pGroup);
+
+/**
+ * @brief Returns scale of a value.
+ * @param[in] pDisplay - pointer to display configuration.
+ * @param[in] scaleType - scale of field.
+ * @param[in] channel - channel of group.
+ * @return scale
+ */
+static float GetScale(ADE_DISPLAY_CONFIG *pDisplay, uint8_t scaleType, uint32_t channel);
+
+/**
+ * @brief Compiles configuration of frames.
+ * @param[out] pConfig - pointer to configuration of frames.
+ * @param[in] pDisplay - pointer to display configuration.
+ */
+static void CompileFrameConfig(ADI_METIC_OUTPUT_FRAME_CONFIG *pConfig,
+                               ADE_DISPLAY_CONFIG *pDisplay);
+
+/** Label prefixes. None, channels and phases */
+static const char *outputPlanPrefix[] = {"",     "AV",   "AI",   "BV",   "BI",   "CV", "CI",
+                                         "AUX0", "AUX1", "AUX2", "AUX3", "AUX4", "AUX5",
+                                         "A",    "B",    "C"};
+/** Label names, in order of OUTPUT_PLAN_NAME */
+static const char *outputPlanName[] = {
+    "RMS",        "RMSHALF",    "RMSONE",     "DIPHALF",       "DIPONE",     "SWELLHALF",
+    "SWELLONE",   "WATT",       "VA",         "PF",            "WATTHR_POS", "WATTHR_NEG",
+    "WATTHR_SIGNED", "VAHR",    "ANGL_AV_BV", "ANGL_BV_CV",    "ANGL_AV_CV", "ANGL_AV_AI",
+    "ANGL_BV_BI", "ANGL_CV_CI", "ANGL_AI_BI", "ANGL_BI_CI",    "ANGL_AI_CI", "APERIOD",
+    "BPERIOD",    "CPERIOD",    "COM_PERIOD", "STATUS0",       "STATUS1",    "STATUS2",
+    "STATUS3",    "ERROR_STATUS"};
+/** Spaces padding labels of text lines */
+static const char outputPlanPadding[OUTPUT_PLAN_LABEL_WIDTH + 1] = "                ";
+
+/** Fields of RMS outputs of a channel */
+static const OUTPUT_PLAN_FIELD rmsFields[] = {
+    OUTPUT_PLAN_RMS_FIELD(filteredRms, enableRmsOutput, OUTPUT_PLAN_NAME_RMS),
+    OUTPUT_PLAN_RMS_FIELD(rmsHalfCycle, enableRmsHalfOutput, OUTPUT_PLAN_NAME_RMSHALF),
+    OUTPUT_PLAN_RMS_FIELD(rmsOneCycle, enableRmsOneOutput, OUTPUT_PLAN_NAME_RMSONE),
+    OUTPUT_PLAN_RMS_FIELD(dipHalf, enableEventRmsHalfOutput, OUTPUT_PLAN_NAME_DIPHALF),
+    OUTPUT_PLAN_RMS_FIELD(dipOne, enableEventRmsOneOutput, OUTPUT_PLAN_NAME_DIPONE),
+    OUTPUT_PLAN_RMS_FIELD(swellHalf, enableEventRmsHalfOutput, OUTPUT_PLAN_NAME_SWELLHALF),
+    OUTPUT_PLAN_RMS_FIELD(swellOne, enableEventRmsOneOutput, OUTPUT_PLAN_NAME_SWELLONE)};
+
+/** Fields of power and energy outputs of a phase */
+static const OUTPUT_PLAN_FIELD powerFields[] = {
+    OUTPUT_PLAN_FIELD_OF(powerOut[0].activePower, sizeof(ADI_METIC_POWER_OUTPUT),
+                         enablePowerOutput, OUTPUT_PLAN_NAME_WATT, OUTPUT_PLAN_SCALE_POWER),
+    OUTPUT_PLAN_FIELD_OF(powerOut[0].apparentPower, sizeof(ADI_METIC_POWER_OUTPUT),
+                         enablePowerOutput, OUTPUT_PLAN_NAME_VA, OUTPUT_PLAN_SCALE_POWER),
+    OUTPUT_PLAN_FIELD_OF(powerFactor[0], sizeof(float), enablePowerOutput, OUTPUT_PLAN_NAME_PF,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(energyOut[0].posActEgy, sizeof(ADI_METIC_ENERGY_OUTPUT),
+                         enableEnergyOutput, OUTPUT_PLAN_NAME_WATTHR_POS, OUTPUT_PLAN_SCALE_POWER),
+    OUTPUT_PLAN_FIELD_OF(energyOut[0].negActEgy, sizeof(ADI_METIC_ENERGY_OUTPUT),
+                         enableEnergyOutput, OUTPUT_PLAN_NAME_WATTHR_NEG, OUTPUT_PLAN_SCALE_POWER),
+    OUTPUT_PLAN_FIELD_OF(energyOut[0].signActEgy, sizeof(ADI_METIC_ENERGY_OUTPUT),
+                         enableEnergyOutput, OUTPUT_PLAN_NAME_WATTHR_SIGNED,
+                         OUTPUT_PLAN_SCALE_POWER),
+    OUTPUT_PLAN_FIELD_OF(energyOut[0].apparentEgy, sizeof(ADI_METIC_ENERGY_OUTPUT),
+                         enableEnergyOutput, OUTPUT_PLAN_NAME_VAHR, OUTPUT_PLAN_SCALE_POWER)};
+
+/** Fields of angle outputs */
+static const OUTPUT_PLAN_FIELD angleFields[] = {
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_av_bv, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_AV_BV,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_bv_cv, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_BV_CV,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_av_cv, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_AV_CV,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_av_ai, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_AV_AI,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_bv_bi, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_BV_BI,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_cv_ci, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_CV_CI,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_ai_bi, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_AI_BI,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_bi_ci, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_BI_CI,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(angleOut.angl_ai_ci, 0, enableAngleOutput, OUTPUT_PLAN_NAME_ANGL_AI_CI,
+                         OUTPUT_PLAN_SCALE_NONE)};
+
+/** Fields of period outputs */
+static const OUTPUT_PLAN_FIELD periodFields[] = {
+    OUTPUT_PLAN_FIELD_OF(periodOut.aPeriod, 0, enablePeriodOutput, OUTPUT_PLAN_NAME_APERIOD,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(periodOut.bPeriod, 0, enablePeriodOutput, OUTPUT_PLAN_NAME_BPERIOD,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(periodOut.cPeriod, 0, enablePeriodOutput, OUTPUT_PLAN_NAME_CPERIOD,
+                         OUTPUT_PLAN_SCALE_NONE),
+    OUTPUT_PLAN_FIELD_OF(periodOut.comPeriod, 0, enablePeriodOutput, OUTPUT_PLAN_NAME_COM_PERIOD,
+                         OUTPUT_PLAN_SCALE_NONE)};
+
+/** Fields of status outputs */
+static const OUTPUT_PLAN_FIELD statusFields[] = {
+    OUTPUT_PLAN_FIELD_OF(statusOut.status0, 0, enableStatusOutput, OUTPUT_PLAN_NAME_STATUS0,
+                         OUTPUT_PLAN_SCALE_HEX),
+    OUTPUT_PLAN_FIELD_OF(statusOut.status1, 0, enableStatusOutput, OUTPUT_PLAN_NAME_STATUS1,
+                         OUTPUT_PLAN_SCALE_HEX),
+    OUTPUT_PLAN_FIELD_OF(statusOut.status2, 0, enableStatusOutput, OUTPUT_PLAN_NAME_STATUS2,
+                         OUTPUT_PLAN_SCALE_HEX),
+    OUTPUT_PLAN_FIELD_OF(statusOut.status3, 0, enableStatusOutput, OUTPUT_PLAN_NAME_STATUS3,
+                         OUTPUT_PLAN_SCALE_HEX),
+    OUTPUT_PLAN_FIELD_OF(statusOut.errorStatus, 0, enableStatusOutput,
+                         OUTPUT_PLAN_NAME_ERROR_STATUS, OUTPUT_PLAN_SCALE_HEX)};
+
+/** Groups in order of display */
+static const OUTPUT_PLAN_GROUP outputPlanGroups[] = {
+    {rmsFields, sizeof(rmsFields) / sizeof(rmsFields[0]), 1, OUTPUT_PLAN_NUM_RMS_CHANNELS},
+    {powerFields, sizeof(powerFields) / sizeof(powerFields[0]), 1 + OUTPUT_PLAN_NUM_RMS_CHANNELS,
+     ADI_METIC_MAX_NUM_POWER_CHANNELS},
+    {angleFields, sizeof(angleFields) / sizeof(angleFields[0]), 0, 1},
+    {periodFields, sizeof(periodFields) / sizeof(periodFields[0]), 0, 1},
+    {statusFields, sizeof(statusFields) / sizeof(statusFields[0]), 0, 1}};
+
+/*=============  C O D E  =============*/
+
+void OutputPlanCompile(OUTPUT_PLAN *pPlan, ADE_DISPLAY_CONFIG *pDisplay)
+{
+    uint32_t i;
+
+    pPlan->numEntries = 0;
+    for (i = 0; i < sizeof(outputPlanGroups) / sizeof(outputPlanGroups[0]); i++)
+    {
+        AddGroup(pPlan, pDisplay, &outputPlanGroups[i]);
+    }
+    CompileFrameConfig(&pPlan->frameConfig, pDisplay);
+    pPlan->isHeaderPending = 1;
+}
+
+void OutputPlanWriteText(OUTPUT_PLAN *pPlan, uint32_t irqCount, ADI_METIC_OUTPUT *pOutput)
+{
+    uint32_t i;
+    OUTPUT_PLAN_ENTRY *pEntry;
+    uint8_t *pValue;
+    static char text[FLOAT_FORMAT_MAX_NUM_CHARS];
+
+    for (i = 0; i < pPlan->numEntries; i++)
+    {
+        pEntry = &pPlan->entry[i];
+        pValue = (uint8_t *)pOutput + pEntry->offset;
+        if (pEntry->type == OUTPUT_PLAN_VALUE_HEX)
+        {
+            INFO_MSG("%d, %s%s%s= 0x%x", irqCount, outputPlanPrefix[pEntry->prefixId],
+                     outputPlanName[pEntry->nameId],
+                     &outputPlanPadding[OUTPUT_PLAN_LABEL_WIDTH - pEntry->numPadChars],
+                     *(uint32_t *)pValue)
+        }
+        else
+        {
+            FormatFloat(&text[0], *(float *)pValue * pEntry->scale, FLOAT_FORMAT_MAX_NUM_DECIMALS);
+            INFO_MSG("%d, %s%s%s= %s", irqCount, outputPlanPrefix[pEntry->prefixId],
+                     outputPlanName[pEntry->nameId],
+                     &outputPlanPadding[OUTPUT_PLAN_LABEL_WIDTH - pEntry->numPadChars], &text[0])
+        }
+    }
+}
+
+void OutputPlanWriteCsv(OUTPUT_PLAN *pPlan, uint32_t irqCount, ADI_METIC_OUTPUT *pOutput)
+{
+    uint32_t i;
+    OUTPUT_PLAN_ENTRY *pEntry;
+    uint8_t *pValue;
+    static char text[FLOAT_FORMAT_MAX_NUM_CHARS];
+
+    if (pPlan->isHeaderPending == 1)
+    {
+        INFO_MSG_RAW("C:irq_count")
+        for (i = 0; i < pPlan->numEntries; i++)
+        {
+            INFO_MSG_RAW(",%s%s", outputPlanPrefix[pPlan->entry[i].prefixId],
+                         outputPlanName[pPlan->entry[i].nameId])
+        }
+        INFO_MSG("")
+        pPlan->isHeaderPending = 0;
+    }
+    INFO_MSG_RAW("C:%d", irqCount)
+    for (i = 0; i < pPlan->numEntries; i++)
+    {
+        pEntry = &pPlan->entry[i];
+        pValue = (uint8_t *)pOutput + pEntry->offset;
+        if (pEntry->type == OUTPUT_PLAN_VALUE_HEX)
+        {
+            INFO_MSG_RAW(",0x%x", *(uint32_t *)pValue)
+        }
+        else
+        {
+            FormatFloat(&text[0], *(float *)pValue * pEntry->scale, FLOAT_FORMAT_MAX_NUM_DECIMALS);
+            INFO_MSG_RAW(",%s", &text[0])
+        }
+    }
+    INFO_MSG("")
+}
+
+void AddGroup(OUTPUT_PLAN *pPlan, ADE_DISPLAY_CONFIG *pDisplay, const OUTPUT_PLAN_GROUP *pGroup)
+{
+    uint32_t channel;
+    uint32_t i;
+    const OUTPUT_PLAN_FIELD *pField;
+    OUTPUT_PLAN_ENTRY *pEntry;
+    bool isEnabled;
+
+    for (channel = 0; channel < pGroup->numChannels; channel++)
+    {
+        for (i = 0; i < pGroup->numFields; i++)
+        {
+            pField = &pGroup->pFields[i];
+            isEnabled = *(bool *)((uint8_t *)pDisplay + pField->enableOffset);
+            if (isEnabled && (pPlan->numEntries < OUTPUT_PLAN_MAX_NUM_ENTRIES))
+            {
+                pEntry = &pPlan->entry[pPlan->numEntries];
+                pEntry->offset = (uint16_t)(pField->offset + channel * pField->stride);
+                pEntry->prefixId = (uint8_t)(pGroup->firstPrefixId + channel);
+                pEntry->nameId = pField->nameId;
+                pEntry->type = (pField->scaleType == OUTPUT_PLAN_SCALE_HEX)
+                                   ? OUTPUT_PLAN_VALUE_HEX
+                                   : OUTPUT_PLAN_VALUE_FLOAT;
+                pEntry->numPadChars =
+                    (uint8_t)(OUTPUT_PLAN_LABEL_WIDTH -
+                              strlen(outputPlanPrefix[pEntry->prefixId]) -
+                              strlen(outputPlanName[pEntry->nameId]));
+                pEntry->scale = GetScale(pDisplay, pField->scaleType, channel);
+                pPlan->numEntries++;
+            }
+        }
+    }
+}
+
+float GetScale(ADE_DISPLAY_CONFIG *pDisplay, uint8_t scaleType, uint32_t channel)
+{
+    float scale = 1.0f;
+
+    if (scaleType == OUTPUT_PLAN_SCALE_POWER)
+    {
+        scale = pDisplay->voltageScale * pDisplay->currentScale;
+    }
+    else if (scaleType == OUTPUT_PLAN_SCALE_RMS)
+    {
+        if (channel >= OUTPUT_PLAN_NUM_PHASE_CHANNELS)
+        {
+            scale = pDisplay->auxScale;
+        }
+        else if (channel % 2 == 0)
+        {
+            scale = pDisplay->voltageScale;
+        }
+        else
+        {
+            scale = pDisplay->currentScale;
+        }
+    }
+    return scale;
+}
+
+void CompileFrameConfig(ADI_METIC_OUTPUT_FRAME_CONFIG *pConfig, ADE_DISPLAY_CONFIG *pDisplay)
+{
+    uint32_t i;
+
+    // Fields follow the display options, so that a frame carries what text display would show.
+    pConfig->format = (pDisplay->format == ADE_DISPLAY_FORMAT_FRAME_FIXED)
+                          ? ADI_METIC_OUTPUT_FRAME_FIXED
+                          : ADI_METIC_OUTPUT_FRAME_FLOAT;
+    pConfig->fieldMask = 0;
+    pConfig->fieldMask |= pDisplay->enableRmsOutput ? ADI_METIC_OUTPUT_FIELD_RMS : 0;
+    pConfig->fieldMask |= pDisplay->enableRmsHalfOutput ? ADI_METIC_OUTPUT_FIELD_RMS_HALF : 0;
+    pConfig->fieldMask |= pDisplay->enableRmsOneOutput ? ADI_METIC_OUTPUT_FIELD_RMS_ONE : 0;
+    pConfig->fieldMask |=
+        pDisplay->enableEventRmsHalfOutput
+            ? (ADI_METIC_OUTPUT_FIELD_DIP_HALF | ADI_METIC_OUTPUT_FIELD_SWELL_HALF)
+            : 0;
+    pConfig->fieldMask |=
+        pDisplay->enableEventRmsOneOutput
+            ? (ADI_METIC_OUTPUT_FIELD_DIP_ONE | ADI_METIC_OUTPUT_FIELD_SWELL_ONE)
+            : 0;
+    pConfig->fieldMask |= pDisplay->enablePowerOutput
+                              ? (ADI_METIC_OUTPUT_FIELD_WATT | ADI_METIC_OUTPUT_FIELD_VA |
+                                 ADI_METIC_OUTPUT_FIELD_PF)
+                              : 0;
+    pConfig->fieldMask |=
+        pDisplay->enableEnergyOutput
+            ? (ADI_METIC_OUTPUT_FIELD_WATTHR_POS | ADI_METIC_OUTPUT_FIELD_WATTHR_NEG |
+               ADI_METIC_OUTPUT_FIELD_WATTHR_SIGNED | ADI_METIC_OUTPUT_FIELD_VAHR)
+            : 0;
+    pConfig->fieldMask |= pDisplay->enableAngleOutput ? ADI_METIC_OUTPUT_FIELD_ANGLE : 0;
+    pConfig->fieldMask |= pDisplay->enablePeriodOutput ? ADI_METIC_OUTPUT_FIELD_PERIOD : 0;
+    pConfig->fieldMask |= pDisplay->enableStatusOutput ? ADI_METIC_OUTPUT_FIELD_STATUS : 0;
+    for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+    {
+        pConfig->rmsScale[i] = GetScale(pDisplay, OUTPUT_PLAN_SCALE_RMS, i);
+    }
+    for (i = 0; i < ADI_METIC_MAX_NUM_POWER_CHANNELS; i++)
+    {
+        pConfig->powerScale[i] = GetScale(pDisplay, OUTPUT_PLAN_SCALE_POWER, i);
+    }
+}
+
+/**
+ * @}
+ */
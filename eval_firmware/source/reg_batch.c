@@ -0,0 +1,212 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        reg_batch.c
+ * @brief       Batches of register reads and writes run back to back with one response.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "reg_batch.h"
+#include "message.h"
+#include <stdint.h>
+
+/*============= D E F I N E S =============*/
+
+/** Device id of ADE9178, as for adi_metic_ReadRegister */
+#define REG_BATCH_DEVICE_ADE9178 0
+/** Maximum number of hexadecimal digits of an address */
+#define REG_BATCH_ADDRESS_MAX_DIGITS 3
+/** Maximum number of hexadecimal digits of a value */
+#define REG_BATCH_VALUE_MAX_DIGITS 8
+/** Maximum number of decimal digits of number of registers */
+#define REG_BATCH_COUNT_MAX_DIGITS 3
+
+/**
+ * @brief Parses digits of a number.
+ * @param[in,out] ppText - pointer to text, moved past the digits.
+ * @param[in] base - 10 or 16.
+ * @param[in] maxDigits - maximum number of digits.
+ * @param[out] pValue - value.
+ * @return number of digits, 0 if there is none or more than maxDigits
+ */
+static uint32_t ParseNumber(char **ppText, uint32_t base, uint32_t maxDigits, uint32_t *pValue);
+
+/** Script of writes */
+static REG_BATCH_SCRIPT regBatchScript;
+
+/*=============  C O D E  =============*/
+
+int32_t RegBatchParseRange(char *pText, REG_BATCH_RANGE *pRange)
+{
+    int32_t status = 1;
+    uint32_t address = 0;
+    uint32_t numRegisters = 1;
+
+    if (ParseNumber(&pText, 16, REG_BATCH_ADDRESS_MAX_DIGITS, &address) > 0)
+    {
+        if (*pText == ':')
+        {
+            pText++;
+            if (ParseNumber(&pText, 10, REG_BATCH_COUNT_MAX_DIGITS, &numRegisters) == 0)
+            {
+                numRegisters = 0;
+            }
+        }
+        if ((*pText == '\0') && (numRegisters > 0) &&
+            (numRegisters <= ADI_METIC_MAX_NUM_REGISTERS))
+        {
+            pRange->address = (uint16_t)address;
+            pRange->numRegisters = (uint16_t)numRegisters;
+            status = 0;
+        }
+    }
+    return status;
+}
+
+int32_t RegBatchParseWrite(char *pText, uint8_t device, REG_BATCH_WRITE *pWrite)
+{
+    int32_t status = 1;
+    uint32_t address = 0;
+    uint32_t value = 0;
+
+    if ((ParseNumber(&pText, 16, REG_BATCH_ADDRESS_MAX_DIGITS, &address) > 0) && (*pText == '='))
+    {
+        pText++;
+        if ((ParseNumber(&pText, 16, REG_BATCH_VALUE_MAX_DIGITS, &value) > 0) && (*pText == '\0'))
+        {
+            pWrite->device = device;
+            pWrite->address = (uint16_t)address;
+            pWrite->value = (int32_t)value;
+            status = 0;
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS RegBatchRead(ADI_METIC_HANDLE hAde, uint8_t device, REG_BATCH_RANGE *pRanges,
+                              uint32_t numRanges, int32_t *pValues, uint32_t *pNumRangesRead)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t i = 0;
+    uint32_t j;
+    uint32_t numValues = 0;
+
+    while ((i < numRanges) && (status == ADI_METIC_STATUS_SUCCESS))
+    {
+        if (device == REG_BATCH_DEVICE_ADE9178)
+        {
+            status = adi_metic_ReadRegister(hAde, device, pRanges[i].address,
+                                            pRanges[i].numRegisters, &pValues[numValues]);
+        }
+        else
+        {
+            // ADC registers are read one at a time, value is in second byte of response.
+            for (j = 0; (j < pRanges[i].numRegisters) && (status == ADI_METIC_STATUS_SUCCESS);
+                 j++)
+            {
+                status = adi_metic_ReadRegister(hAde, device, pRanges[i].address + j, 1,
+                                                &pValues[numValues + j]);
+                pValues[numValues + j] = (pValues[numValues + j] >> 8) & 0xFF;
+            }
+        }
+        if (status == ADI_METIC_STATUS_SUCCESS)
+        {
+            numValues += pRanges[i].numRegisters;
+            i++;
+        }
+    }
+    *pNumRangesRead = i;
+    return status;
+}
+
+ADI_METIC_STATUS RegBatchWrite(ADI_METIC_HANDLE hAde, REG_BATCH_WRITE *pWrites,
+                               uint32_t numWrites, uint32_t *pNumWritten)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t i = 0;
+
+    while ((i < numWrites) && (status == ADI_METIC_STATUS_SUCCESS))
+    {
+        status = adi_metic_WriteRegister(hAde, pWrites[i].device, pWrites[i].address,
+                                         &pWrites[i].value);
+        if (status == ADI_METIC_STATUS_SUCCESS)
+        {
+            i++;
+        }
+    }
+    *pNumWritten = i;
+    return status;
+}
+
+void RegBatchDisplay(REG_BATCH_RANGE *pRanges, uint32_t numRanges, int32_t *pValues)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t numValues = 0;
+
+    for (i = 0; i < numRanges; i++)
+    {
+        for (j = 0; j < pRanges[i].numRegisters; j++)
+        {
+            INFO_MSG_RAW("%x=%x ", pRanges[i].address + j, pValues[numValues])
+            numValues++;
+            // Lines are kept short and each range starts on a new line
+            if (((j + 1) % REG_BATCH_VALUES_PER_LINE == 0) || (j + 1 == pRanges[i].numRegisters))
+            {
+                INFO_MSG("")
+            }
+        }
+    }
+}
+
+REG_BATCH_SCRIPT *RegBatchGetScript(void)
+{
+    return &regBatchScript;
+}
+
+uint32_t ParseNumber(char **ppText, uint32_t base, uint32_t maxDigits, uint32_t *pValue)
+{
+    uint32_t numDigits = 0;
+    uint32_t value = 0;
+    uint32_t digit = 0;
+    char *pText = *ppText;
+    char c = *pText;
+
+    while (digit < base)
+    {
+        if ((c >= '0') && (c <= '9'))
+        {
+            digit = (uint32_t)(c - '0');
+        }
+        else if ((c >= 'a') && (c <= 'f'))
+        {
+            digit = (uint32_t)(c - 'a' + 10);
+        }
+        else if ((c >= 'A') && (c <= 'F'))
+        {
+            digit = (uint32_t)(c - 'A' + 10);
+        }
+        else
+        {
+            digit = base;
+        }
+        if (digit < base)
+        {
+            value = value * base + digit;
+            numDigits++;
+            pText++;
+            c = *pText;
+        }
+    }
+    *ppText = pText;
+    *pValue = value;
+    return (numDigits <= maxDigits) ? numDigits : 0;
+}
+
+/**
+ * @}
+ */
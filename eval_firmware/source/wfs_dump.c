@@ -0,0 +1,278 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        wfs_dump.c
+ * @brief       Binary dump of captured waveform samples over host UART.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "wfs_dump.h"
+#include "adi_metic.h"
+#include "adi_metic_status.h"
+#include "cli_service_interface.h"
+#include "message.h"
+#include "metic_example.h"
+#include "metic_service_interface.h"
+#include <stdint.h>
+
+/*============= D E F I N E S =============*/
+
+/** Channel from which waveform samples start */
+#define WFS_DUMP_CHANNEL_ID 0
+/** Number of bytes of capture sent in a chunk of raw dump */
+#define WFS_DUMP_RAW_CHUNK_NUM_BYTES 1536
+/** Number of frames in a packet of compressed dump */
+#define WFS_DUMP_PACKET_NUM_FRAMES 16
+/** Size of a slot of compressed dump. Length of packet followed by packet */
+#define WFS_DUMP_SLOT_NUM_BYTES                                                                    \
+    (2 + ADI_METIC_WFS_CODEC_PACKET_MAX_NUM_BYTES(WFS_DUMP_PACKET_NUM_FRAMES,                      \
+                                                  ADI_METIC_MAX_NUM_CHANNELS))
+/** Number of bytes of marker sent before binary data */
+#define WFS_DUMP_MARKER_NUM_BYTES 4
+
+/**
+ * State of dump
+ */
+typedef enum
+{
+    /** No dump in progress */
+    WFS_DUMP_STATE_IDLE,
+    /** Waiting for pending messages of CLI to be sent */
+    WFS_DUMP_STATE_WAIT_UART,
+    /** Queuing chunks of dump */
+    WFS_DUMP_STATE_SENDING,
+    /** Waiting for queued chunks to be sent */
+    WFS_DUMP_STATE_DRAINING
+} WFS_DUMP_STATE;
+
+/**
+ * Information of dump
+ */
+typedef struct
+{
+    /** State of dump */
+    WFS_DUMP_STATE state;
+    /** Format of samples */
+    WFS_DUMP_FORMAT format;
+    /** Pointer to first frame of capture */
+    uint8_t *pFrames;
+    /** Number of bytes of a frame */
+    uint32_t numFrameBytes;
+    /** Number of frames to dump */
+    uint32_t numFrames;
+    /** Number of frames queued */
+    uint32_t frameIndex;
+    /** Number of bytes queued */
+    uint32_t numBytesSent;
+    /** Number of chunks queued. Slot of compressed dump is selected from this */
+    uint32_t numChunks;
+    /** Codec of compressed dump */
+    ADI_METIC_WFS_CODEC codec;
+    /** Slots holding chunks of compressed dump until they are sent. One per chunk of transmit
+     * queue, so that a slot is reused only after its chunk is sent */
+    uint8_t slot[CLI_TX_QUEUE_NUM_CHUNKS][WFS_DUMP_SLOT_NUM_BYTES];
+} WFS_DUMP_INFO;
+
+/**
+ * @brief Queues next chunk of capture as it is.
+ * @param[in] pDump - pointer to dump.
+ * @return  0 if queued, 1 if queue is full
+ */
+static int32_t QueueRawChunk(WFS_DUMP_INFO *pDump);
+
+/**
+ * @brief Encodes next packet into a slot and queues it. Codec header is sent first and a packet
+ * of length 0 marks end of dump.
+ * @param[in] pDump - pointer to dump.
+ * @return  0 if queued, 1 if queue is full
+ */
+static int32_t QueueCompressedChunk(WFS_DUMP_INFO *pDump);
+
+/** Information of dump */
+static WFS_DUMP_INFO wfsDump;
+/** Marker sent before binary data, so that the host finds its start after the D: line */
+static uint8_t wfsDumpMarker[WFS_DUMP_MARKER_NUM_BYTES] = {'W', 'F', 'S', 'D'};
+
+/*=============  C O D E  =============*/
+
+int32_t WfsDumpStart(WFS_DUMP_FORMAT format)
+{
+    int32_t status = 1;
+    int32_t byteOffset = 0;
+    int32_t numBytes = WFS_BUFFER_SIZE * sizeof(int32_t);
+    uint32_t numChannels;
+    ADI_METIC_STATUS adeStatus;
+    WFS_DUMP_INFO *pDump = &wfsDump;
+    METIC_INSTANCE_INFO *pInfo = GetAdeInstance();
+    uint8_t *pWaveformData = (uint8_t *)&(pInfo->wfsBuffer[0]);
+
+#if ENABLE_ALL_CHANNELS == 1
+    numChannels = 12;
+#else
+    numChannels = 6;
+#endif
+    if (pDump->state != WFS_DUMP_STATE_IDLE)
+    {
+        WARN_MSG("Waveform dump is in progress")
+    }
+    else if (pInfo->isWfsRxComplete != 1)
+    {
+        INFO_MSG("wfs buffer is not full")
+    }
+    else
+    {
+        // Finds channel offset from where proper data starts.
+        adeStatus = adi_metic_FindChannelOffset(pInfo->hAde, (int8_t *)pWaveformData, numBytes,
+                                                WFS_DUMP_CHANNEL_ID, &byteOffset);
+        if ((adeStatus == ADI_METIC_STATUS_SUCCESS) && (format == WFS_DUMP_FORMAT_COMPRESSED))
+        {
+            adeStatus =
+                adi_metic_WfsEncoderInit(pInfo->hAde, &pDump->codec, WFS_DUMP_CHANNEL_ID);
+            numChannels = pDump->codec.numChannels;
+        }
+        if (adeStatus == ADI_METIC_STATUS_SUCCESS)
+        {
+            pDump->format = format;
+            pDump->pFrames = pWaveformData + byteOffset;
+            pDump->numFrameBytes = numChannels * sizeof(int32_t);
+            pDump->numFrames = (uint32_t)(numBytes - byteOffset) / pDump->numFrameBytes;
+            if (pDump->numFrames > WFS_NUM_SAMPLES / numChannels)
+            {
+                pDump->numFrames = WFS_NUM_SAMPLES / numChannels;
+            }
+            pDump->frameIndex = 0;
+            pDump->numBytesSent = 0;
+            pDump->numChunks = 0;
+            INFO_MSG("D:%s,%d,%d", (format == WFS_DUMP_FORMAT_RAW) ? "raw" : "compressed",
+                     numChannels, pDump->numFrames)
+            pDump->state = WFS_DUMP_STATE_WAIT_UART;
+            status = 0;
+        }
+        else
+        {
+            INFO_MSG("waveform samples are not syncronised")
+        }
+    }
+    return status;
+}
+
+void WfsDumpProcess(void)
+{
+    int32_t isQueueFull = 0;
+    WFS_DUMP_INFO *pDump = &wfsDump;
+
+    if (pDump->state == WFS_DUMP_STATE_WAIT_UART)
+    {
+        // D: line goes out through CLI before UART is taken over.
+        if (CliBeginBinary(GetCliHandle()) == 1)
+        {
+            CliQueueBinary(&wfsDumpMarker[0], WFS_DUMP_MARKER_NUM_BYTES);
+            pDump->numBytesSent += WFS_DUMP_MARKER_NUM_BYTES;
+            pDump->numChunks++;
+            pDump->state = WFS_DUMP_STATE_SENDING;
+        }
+    }
+    // Only free chunks are filled, so that main loop never waits for UART.
+    while ((pDump->state == WFS_DUMP_STATE_SENDING) && (isQueueFull == 0))
+    {
+        if (pDump->format == WFS_DUMP_FORMAT_RAW)
+        {
+            isQueueFull = QueueRawChunk(pDump);
+        }
+        else
+        {
+            isQueueFull = QueueCompressedChunk(pDump);
+        }
+    }
+    if ((pDump->state == WFS_DUMP_STATE_DRAINING) && (CliEndBinary() == 1))
+    {
+        pDump->state = WFS_DUMP_STATE_IDLE;
+        INFO_MSG("Dumped %d frames in %d bytes", pDump->numFrames, pDump->numBytesSent)
+    }
+}
+
+int32_t WfsDumpIsBusy(void)
+{
+    return (wfsDump.state != WFS_DUMP_STATE_IDLE) ? 1 : 0;
+}
+
+int32_t QueueRawChunk(WFS_DUMP_INFO *pDump)
+{
+    int32_t status = 1;
+    uint32_t numDumpBytes = pDump->numFrames * pDump->numFrameBytes;
+    uint32_t numBytes = numDumpBytes - pDump->frameIndex * pDump->numFrameBytes;
+
+    if (numBytes > WFS_DUMP_RAW_CHUNK_NUM_BYTES / pDump->numFrameBytes * pDump->numFrameBytes)
+    {
+        numBytes = WFS_DUMP_RAW_CHUNK_NUM_BYTES / pDump->numFrameBytes * pDump->numFrameBytes;
+    }
+    // Capture is sent from where it is, without copying.
+    if ((numBytes > 0) &&
+        (CliQueueBinary(pDump->pFrames + pDump->frameIndex * pDump->numFrameBytes, numBytes) == 0))
+    {
+        pDump->frameIndex += numBytes / pDump->numFrameBytes;
+        pDump->numBytesSent += numBytes;
+        pDump->numChunks++;
+        status = 0;
+    }
+    if (pDump->frameIndex >= pDump->numFrames)
+    {
+        pDump->state = WFS_DUMP_STATE_DRAINING;
+    }
+    return status;
+}
+
+int32_t QueueCompressedChunk(WFS_DUMP_INFO *pDump)
+{
+    int32_t status = 1;
+    uint32_t numPacketFrames = pDump->numFrames - pDump->frameIndex;
+    uint32_t numPacketBytes = 0;
+    uint8_t *pSlot = &pDump->slot[pDump->numChunks % CLI_TX_QUEUE_NUM_CHUNKS][0];
+    ADI_METIC_STATUS adeStatus = ADI_METIC_STATUS_SUCCESS;
+
+    if (CliGetBinaryFreeChunks() > 0)
+    {
+        if (pDump->numChunks == 1)
+        {
+            numPacketBytes = adi_metic_WfsWriteCodecHeader(&pDump->codec, pSlot + 2);
+        }
+        else if (numPacketFrames > 0)
+        {
+            if (numPacketFrames > WFS_DUMP_PACKET_NUM_FRAMES)
+            {
+                numPacketFrames = WFS_DUMP_PACKET_NUM_FRAMES;
+            }
+            adeStatus = adi_metic_WfsEncode(
+                &pDump->codec, pDump->pFrames + pDump->frameIndex * pDump->numFrameBytes,
+                numPacketFrames * pDump->numFrameBytes, pSlot + 2, WFS_DUMP_SLOT_NUM_BYTES - 2,
+                &numPacketBytes);
+            pDump->frameIndex += numPacketFrames;
+        }
+        else
+        {
+            // Packet of length 0 ends the dump.
+            pDump->state = WFS_DUMP_STATE_DRAINING;
+        }
+        if (adeStatus != ADI_METIC_STATUS_SUCCESS)
+        {
+            // Remaining frames are dropped, the host sees a short dump.
+            numPacketBytes = 0;
+            pDump->state = WFS_DUMP_STATE_DRAINING;
+        }
+        pSlot[0] = (uint8_t)numPacketBytes;
+        pSlot[1] = (uint8_t)(numPacketBytes >> 8);
+        CliQueueBinary(pSlot, numPacketBytes + 2);
+        pDump->numBytesSent += numPacketBytes + 2;
+        pDump->numChunks++;
+        status = 0;
+    }
+    return status;
+}
+
+/**
+ * @}
+ */
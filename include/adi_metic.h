@@ -61,6 +61,40 @@ extern "C" {
 #define ADI_METIC_ANGLE_SCALE 256
 /** iterations to check for finding channel offset in WFS*/
 #define ADI_METIC_WFS_OFFSET_COUNT 8
+/** Maximum number of blocks in the ring of WFS continuous stream */
+#define ADI_METIC_WFS_MAX_STREAM_BLOCKS 8
+/** Maximum number of consumers sharing blocks of WFS continuous stream */
+#define ADI_METIC_WFS_MAX_CONSUMERS 4
+/** Order of prediction history kept per channel by compression of WFS samples */
+#define ADI_METIC_WFS_CODEC_HISTORY 4
+/** Maximum number of bytes of header of compressed WFS samples */
+#define ADI_METIC_WFS_CODEC_HEADER_NUM_BYTES (4 + ADI_METIC_MAX_NUM_CHANNELS)
+/** Maximum number of bytes of a packet of numFrames compressed frames of numChannels. Residuals
+ * costing more than 24 bits per sample are stored as 24 bit samples */
+#define ADI_METIC_WFS_CODEC_PACKET_MAX_NUM_BYTES(numFrames, numChannels)                          \
+    (3 + (numChannels) * (1 + 3 * (numFrames)))
+/** Maximum number of taps of a phase of WFS resampling filter */
+#define ADI_METIC_WFS_RESAMPLER_MAX_TAPS 48
+/** Number of phases of WFS resampling filter. Delays between phases are interpolated */
+#define ADI_METIC_WFS_RESAMPLER_NUM_PHASES 32
+/** Lowest line frequency in Hz accepted by WFS resampling synchronous to line period */
+#define ADI_METIC_WFS_RESAMPLER_MIN_FREQUENCY 40.0f
+/** Highest line frequency in Hz accepted by WFS resampling synchronous to line period */
+#define ADI_METIC_WFS_RESAMPLER_MAX_FREQUENCY 70.0f
+/** Number of bits on WFS UART for a byte of samples, with start and stop bits */
+#define ADI_METIC_WFS_UART_BITS_PER_BYTE 10
+/** Highest value of baudrate bits of WFS_CONFIG */
+#define ADI_METIC_WFS_MAX_BAUDRATE_BITS 5
+/** First byte of a frame of metrology outputs */
+#define ADI_METIC_OUTPUT_FRAME_SYNC 0xA5
+/** Number of bytes of a frame of metrology outputs without values */
+#define ADI_METIC_OUTPUT_FRAME_HEADER_NUM_BYTES 18
+/** Maximum number of 32 bit words of values of a frame of metrology outputs. Energies take two
+ * words in fixed format */
+#define ADI_METIC_OUTPUT_FRAME_MAX_NUM_WORDS 135
+/** Maximum number of bytes of a frame of metrology outputs */
+#define ADI_METIC_OUTPUT_FRAME_MAX_NUM_BYTES                                                       \
+    (ADI_METIC_OUTPUT_FRAME_HEADER_NUM_BYTES + 4 * ADI_METIC_OUTPUT_FRAME_MAX_NUM_WORDS)
 
 /** Function pointer definition for SPI transmit */
 typedef int32_t (*ADI_METIC_CMD_TRANSFER_FUNC)(void *, uint8_t *, uint32_t);
@@ -158,6 +192,362 @@ typedef struct
 
 } ADI_METIC_WFS_CONFIG;
 
+/**
+ * Requirements of WFS given to #adi_metic_WfsPlanBandwidth.
+ */
+typedef struct
+{
+    /** Channels enabled, in the order of channel enable bits of WFS_CONFIG */
+    uint32_t channelSelect;
+    /** Sampling rate of a channel in Hz */
+    uint32_t samplingRate;
+    /** Source of samples, ADC samples or PCF output, as outputType of WFS_CONFIG */
+    uint32_t outputType;
+    /** Time in msec of samples to be held in buffer. 0 if no buffer is to be sized */
+    uint32_t captureTime;
+    /** Number of blocks the buffer is split into for continuous stream. 0 or 1 for a single
+     * capture */
+    uint32_t numBlocks;
+
+} ADI_METIC_WFS_PLAN_CONFIG;
+
+/**
+ * WFS configuration planned by #adi_metic_WfsPlanBandwidth.
+ */
+typedef struct
+{
+    /** Value of WFS_CONFIG with WFS enabled at the lowest sufficient baud rate */
+    int32_t config;
+    /** Number of channels enabled */
+    uint32_t numChannels;
+    /** Bit rate of samples in bits per second */
+    uint32_t sampleBitRate;
+    /** Baud rate needed on UART including start and stop bits */
+    uint32_t requiredBaudRate;
+    /** Baud rate bits of WFS_CONFIG selected */
+    uint32_t baudrateBits;
+    /** Baud rate selected */
+    uint32_t baudRate;
+    /** Percentage of selected baud rate not used by samples */
+    uint32_t headroom;
+    /** Number of bytes of a frame of all enabled channels */
+    uint32_t frameNumBytes;
+    /** Number of bytes of buffer for capture time, a whole number of blocks of whole frames */
+    uint32_t bufferNumBytes;
+    /** Number of bytes of a block of continuous stream */
+    uint32_t blockNumBytes;
+
+} ADI_METIC_WFS_PLAN;
+
+/**
+ * Output formats of deinterleaved WFS samples.
+ */
+typedef enum
+{
+    /** 24 bit sample sign extended to int32_t */
+    ADI_METIC_WFS_FORMAT_INT32,
+    /** Sample code as float */
+    ADI_METIC_WFS_FORMAT_FLOAT,
+    /** Sample code multiplied by scale of the channel, as float */
+    ADI_METIC_WFS_FORMAT_SCALED
+
+} ADI_METIC_WFS_FORMAT;
+
+/**
+ * Configuration to deinterleave WFS samples into an array per channel.
+ */
+typedef struct
+{
+    /** Output format */
+    ADI_METIC_WFS_FORMAT format;
+    /** Output array of each channel indexed by channel id. Arrays are int32_t for
+     * #ADI_METIC_WFS_FORMAT_INT32 and float otherwise. Channels with NULL are skipped. */
+    void *pDst[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Scale of each channel indexed by channel id, used for #ADI_METIC_WFS_FORMAT_SCALED */
+    float scale[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Number of samples each output array can hold */
+    uint32_t maxSamples;
+    /** Optional mask with a bit per frame, set if channel ids of all samples in the frame are in
+     * sequence. Frame n is bit (n % 32) of word (n / 32). NULL if not required. */
+    uint32_t *pValidMask;
+
+} ADI_METIC_WFS_UNPACK_CONFIG;
+
+/**
+ * View of WFS samples starting at any byte offset of a buffer. Samples past the end of the buffer
+ * wrap to its start, so that a view can span blocks of a continuous stream ring.
+ */
+typedef struct
+{
+    /** Pointer to buffer */
+    uint8_t *pBuffer;
+    /** Number of bytes in buffer */
+    uint32_t bufferNumBytes;
+    /** Offset in bytes of the first sample in buffer */
+    uint32_t byteOffset;
+    /** Number of samples in view */
+    uint32_t numSamples;
+
+} ADI_METIC_WFS_VIEW;
+
+/**
+ * Result of WFS synchronisation.
+ */
+typedef struct
+{
+    /** Offset in bytes of the first sample of the channel id searched */
+    int32_t byteOffset;
+    /** Number of samples from offset to end of buffer */
+    uint32_t numSamples;
+    /** Number of samples in expected channel sequence */
+    uint32_t numValidSamples;
+    /** Number of times synchronisation was lost and found again */
+    uint32_t numResyncs;
+    /** Percentage of samples from offset in expected channel sequence */
+    uint32_t confidence;
+
+} ADI_METIC_WFS_SYNC_RESULT;
+
+/**
+ * Filled block of WFS continuous stream. Samples are not copied, pSamples points into the
+ * stream buffer given to #adi_metic_WfsStartStream.
+ */
+typedef struct
+{
+    /** Pointer to samples of the block */
+    uint8_t *pSamples;
+    /** Number of bytes in the block */
+    uint32_t numBytes;
+    /** Sequence number of the block. Increments by one for every block received */
+    uint32_t sequence;
+    /** Set to 1 if samples were lost before this block due to an overrun */
+    uint32_t isGapBefore;
+
+} ADI_METIC_WFS_BLOCK;
+
+/**
+ * Fill of frames lost in WFS samples.
+ */
+typedef enum
+{
+    /** Lost frames are not filled. Output has only frames received */
+    ADI_METIC_WFS_GAP_FILL_NONE,
+    /** Lost frames are filled with the last sample received of each channel */
+    ADI_METIC_WFS_GAP_FILL_HOLD,
+    /** Lost frames are filled with zero */
+    ADI_METIC_WFS_GAP_FILL_ZERO,
+    /** Lost frames are filled with samples interpolated linearly between the frames around the
+     * gap */
+    ADI_METIC_WFS_GAP_FILL_LINEAR
+
+} ADI_METIC_WFS_GAP_FILL;
+
+/**
+ * State of WFS sample validator. Carries synchronisation and partial frame across blocks.
+ */
+typedef struct
+{
+    /** Enabled channel ids in the order received, starting from channel id of the first sample */
+    uint8_t order[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Number of channels enabled */
+    uint32_t numChannels;
+    /** Fill of lost frames */
+    ADI_METIC_WFS_GAP_FILL gapFill;
+    /** Bytes of incomplete frame at end of previous block */
+    uint8_t partialFrame[ADI_METIC_MAX_NUM_CHANNELS * 4];
+    /** Number of bytes in partialFrame */
+    uint32_t numPartialBytes;
+    /** Set to 1 when samples are in sequence */
+    uint32_t isSynced;
+    /** Set to 1 once a valid frame is received, so that gaps after it can be estimated */
+    uint32_t hasLastFrame;
+    /** Number of bytes skipped since the last valid frame */
+    uint32_t numSkippedBytes;
+    /** Last valid sample of each channel, in order of channels received */
+    int32_t lastFrame[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Total number of valid frames */
+    uint32_t numValidFrames;
+    /** Total number of frames estimated to be lost */
+    uint32_t numLostFrames;
+    /** Total number of times synchronisation was lost and found again */
+    uint32_t numResyncs;
+
+} ADI_METIC_WFS_VALIDATOR;
+
+/**
+ * Quality of a block of WFS samples checked by #adi_metic_WfsValidateBlock.
+ */
+typedef struct
+{
+    /** Number of frames written to output arrays, including filled frames */
+    uint32_t numFrames;
+    /** Number of frames with all channel ids in sequence */
+    uint32_t numValidFrames;
+    /** Number of frames estimated to be lost */
+    uint32_t numLostFrames;
+    /** Number of frames filled in output */
+    uint32_t numFilledFrames;
+    /** Number of valid frames not written as output arrays are full */
+    uint32_t numDroppedFrames;
+    /** Number of gaps not filled as they do not fit in output arrays */
+    uint32_t numDiscontinuities;
+    /** Index in output arrays of first frame after last gap not filled */
+    uint32_t discontinuityFrame;
+    /** Number of times synchronisation was lost and found again */
+    uint32_t numResyncs;
+    /** Number of bytes not part of a valid frame */
+    uint32_t numDiscardedBytes;
+    /** Percentage of valid frames in valid and lost frames */
+    uint32_t quality;
+
+} ADI_METIC_WFS_BLOCK_QUALITY;
+
+/**
+ * State of lossless compression of WFS samples, common to encoder and decoder. Samples of each
+ * channel are predicted from previous samples and residuals are Rice coded.
+ */
+typedef struct
+{
+    /** Enabled channel ids in the order received, starting from channel id of the first sample */
+    uint8_t order[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Number of channels in a frame */
+    uint32_t numChannels;
+    /** Last samples of each channel in order received, most recent first */
+    int32_t history[ADI_METIC_MAX_NUM_CHANNELS][ADI_METIC_WFS_CODEC_HISTORY];
+
+} ADI_METIC_WFS_CODEC;
+
+/**
+ * Status of WFS continuous stream.
+ */
+typedef struct
+{
+    /** Number of blocks received since stream started */
+    uint32_t numBlocksReceived;
+    /** Number of filled blocks not yet released by the consumer */
+    uint32_t numBlocksPending;
+    /** Number of times reception stopped as all blocks were held by the consumer */
+    uint32_t numOverruns;
+    /** Set to 1 while the stream is running */
+    uint32_t isStreaming;
+
+} ADI_METIC_WFS_STREAM_STATUS;
+
+/**
+ * Handling of a consumer of WFS continuous stream that holds the stream back. A consumer holds
+ * the stream back if it has not released the oldest block and reception is stopped by an overrun,
+ * or the last free block is being received while other consumers are ahead.
+ */
+typedef enum
+{
+    /** Stream waits for the consumer. Samples are lost for all consumers if the ring fills */
+    ADI_METIC_WFS_CONSUMER_STALL,
+    /** Oldest block is released for the consumer, which sees a gap before its next block */
+    ADI_METIC_WFS_CONSUMER_SKIP,
+    /** Consumer is dropped and gets no more blocks until it is registered again */
+    ADI_METIC_WFS_CONSUMER_DROP
+
+} ADI_METIC_WFS_CONSUMER_POLICY;
+
+/**
+ * Status of a consumer of WFS continuous stream.
+ */
+typedef struct
+{
+    /** Number of blocks released by the consumer since stream started */
+    uint32_t numBlocksRead;
+    /** Number of blocks received and not yet released by the consumer */
+    uint32_t lag;
+    /** Highest lag seen since stream started */
+    uint32_t maxLag;
+    /** Number of blocks released on behalf of the consumer by #ADI_METIC_WFS_CONSUMER_SKIP */
+    uint32_t numSkipped;
+    /** Set to 1 if the consumer is dropped by #ADI_METIC_WFS_CONSUMER_DROP */
+    uint32_t isDropped;
+
+} ADI_METIC_WFS_CONSUMER_STATUS;
+
+/**
+ * Output rate of WFS resampling.
+ */
+typedef enum
+{
+    /** Samples at a fixed output rate */
+    ADI_METIC_WFS_RESAMPLE_RATE,
+    /** Fixed number of samples per line cycle, following line period given with
+     * #adi_metic_WfsSetResamplerPeriod */
+    ADI_METIC_WFS_RESAMPLE_SYNC
+
+} ADI_METIC_WFS_RESAMPLE_MODE;
+
+/**
+ * Configuration of WFS resampling.
+ */
+typedef struct
+{
+    /** Output rate */
+    ADI_METIC_WFS_RESAMPLE_MODE mode;
+    /** Format of input and output arrays. #ADI_METIC_WFS_FORMAT_INT32 is filtered in fixed point,
+     * others in float */
+    ADI_METIC_WFS_FORMAT format;
+    /** Number of channels */
+    uint32_t numChannels;
+    /** Sampling rate of input in Hz */
+    uint32_t inputRate;
+    /** Output rate in Hz for #ADI_METIC_WFS_RESAMPLE_RATE */
+    uint32_t outputRate;
+    /** Number of output samples per line cycle for #ADI_METIC_WFS_RESAMPLE_SYNC */
+    uint32_t samplesPerCycle;
+    /** Line frequency in Hz for #ADI_METIC_WFS_RESAMPLE_SYNC, used until a period is given */
+    float nominalFrequency;
+
+} ADI_METIC_WFS_RESAMPLER_CONFIG;
+
+/**
+ * State of WFS resampling. Input samples of each channel are filtered with a polyphase low pass
+ * filter at the delay of every output sample. History of each channel is kept across blocks.
+ */
+typedef struct
+{
+    /** Output rate */
+    ADI_METIC_WFS_RESAMPLE_MODE mode;
+    /** Format of input and output arrays */
+    ADI_METIC_WFS_FORMAT format;
+    /** Number of channels */
+    uint32_t numChannels;
+    /** Sampling rate of input in Hz */
+    uint32_t inputRate;
+    /** Number of output samples per line cycle */
+    uint32_t samplesPerCycle;
+    /** Number of taps of a phase, a multiple of 4 */
+    uint32_t numTaps;
+    /** Input samples per output sample in Q32 */
+    uint64_t step;
+    /** Time of next output sample after the delay of the filter, in input samples in Q32 */
+    uint64_t position;
+    /** Index of oldest sample in history of each channel */
+    uint32_t historyIndex;
+    /** Coefficients of phases, Q30 for fixed point */
+    union
+    {
+        float f[ADI_METIC_WFS_RESAMPLER_NUM_PHASES + 1][ADI_METIC_WFS_RESAMPLER_MAX_TAPS];
+        int32_t q[ADI_METIC_WFS_RESAMPLER_NUM_PHASES + 1][ADI_METIC_WFS_RESAMPLER_MAX_TAPS];
+    } coef;
+    /** Last input samples of each channel, stored twice so that a window is contiguous */
+    union
+    {
+        float f[ADI_METIC_MAX_NUM_CHANNELS][2 * ADI_METIC_WFS_RESAMPLER_MAX_TAPS];
+        int32_t q[ADI_METIC_MAX_NUM_CHANNELS][2 * ADI_METIC_WFS_RESAMPLER_MAX_TAPS];
+    } history;
+    /** Coefficients interpolated for the delay of the current output sample */
+    union
+    {
+        float f[ADI_METIC_WFS_RESAMPLER_MAX_TAPS];
+        int32_t q[ADI_METIC_WFS_RESAMPLER_MAX_TAPS];
+    } delayCoef;
+
+} ADI_METIC_WFS_RESAMPLER;
+
 /** @} */
 
 /** @defgroup    METICOUTPUT Output Functions
@@ -217,6 +607,95 @@ typedef struct
 
 } ADI_METIC_OUTPUT_FIX;
 
+/**
+ * Format of values in a frame of metrology outputs
+ */
+typedef enum
+{
+    /** Converted values as float, multiplied by scales of #ADI_METIC_OUTPUT_FRAME_CONFIG */
+    ADI_METIC_OUTPUT_FRAME_FLOAT,
+    /** Register codes as in #ADI_METIC_OUTPUT_FIX. Energies are low and high registers */
+    ADI_METIC_OUTPUT_FRAME_FIXED
+
+} ADI_METIC_OUTPUT_FRAME_FORMAT;
+
+/**
+ * Fields of a frame of metrology outputs. Values of a field are packed for every channel of the
+ * field, in order of bits.
+ */
+typedef enum
+{
+    /** Filtered RMS of 12 channels */
+    ADI_METIC_OUTPUT_FIELD_RMS = 0x1,
+    /** Half cycle RMS of 12 channels */
+    ADI_METIC_OUTPUT_FIELD_RMS_HALF = 0x2,
+    /** One cycle RMS of 12 channels */
+    ADI_METIC_OUTPUT_FIELD_RMS_ONE = 0x4,
+    /** Dip of half cycle RMS of 12 channels */
+    ADI_METIC_OUTPUT_FIELD_DIP_HALF = 0x8,
+    /** Dip of one cycle RMS of 12 channels */
+    ADI_METIC_OUTPUT_FIELD_DIP_ONE = 0x10,
+    /** Swell of half cycle RMS of 12 channels */
+    ADI_METIC_OUTPUT_FIELD_SWELL_HALF = 0x20,
+    /** Swell of one cycle RMS of 12 channels */
+    ADI_METIC_OUTPUT_FIELD_SWELL_ONE = 0x40,
+    /** Active power of 3 phases */
+    ADI_METIC_OUTPUT_FIELD_WATT = 0x80,
+    /** Apparent power of 3 phases */
+    ADI_METIC_OUTPUT_FIELD_VA = 0x100,
+    /** Power factor of 3 phases */
+    ADI_METIC_OUTPUT_FIELD_PF = 0x200,
+    /** Positive active energy of 3 phases */
+    ADI_METIC_OUTPUT_FIELD_WATTHR_POS = 0x400,
+    /** Negative active energy of 3 phases */
+    ADI_METIC_OUTPUT_FIELD_WATTHR_NEG = 0x800,
+    /** Signed active energy of 3 phases */
+    ADI_METIC_OUTPUT_FIELD_WATTHR_SIGNED = 0x1000,
+    /** Apparent energy of 3 phases */
+    ADI_METIC_OUTPUT_FIELD_VAHR = 0x2000,
+    /** 9 angles, in order of #ADI_METIC_ANGLE_OUTPUT */
+    ADI_METIC_OUTPUT_FIELD_ANGLE = 0x4000,
+    /** Period of 3 phases and combined period */
+    ADI_METIC_OUTPUT_FIELD_PERIOD = 0x8000,
+    /** STATUS0 to STATUS3 and ERROR_STATUS, as 32 bit words in both formats */
+    ADI_METIC_OUTPUT_FIELD_STATUS = 0x10000,
+    /** All fields */
+    ADI_METIC_OUTPUT_FIELD_ALL = 0x1FFFF
+
+} ADI_METIC_OUTPUT_FIELD;
+
+/**
+ * Configuration of frames of metrology outputs
+ */
+typedef struct
+{
+    /** Format of values */
+    ADI_METIC_OUTPUT_FRAME_FORMAT format;
+    /** Fields sent, combination of #ADI_METIC_OUTPUT_FIELD */
+    uint32_t fieldMask;
+    /** Scale of RMS of each channel in float format */
+    float rmsScale[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Scale of power and energy of each phase in float format */
+    float powerScale[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+
+} ADI_METIC_OUTPUT_FRAME_CONFIG;
+
+/**
+ * Header of a frame of metrology outputs
+ */
+typedef struct
+{
+    /** Format of values */
+    ADI_METIC_OUTPUT_FRAME_FORMAT format;
+    /** Fields present, combination of #ADI_METIC_OUTPUT_FIELD */
+    uint32_t fieldMask;
+    /** IRQ0 count of the outputs */
+    uint32_t irqCount;
+    /** Time (usec) of the outputs */
+    uint32_t timestamp;
+
+} ADI_METIC_OUTPUT_FRAME;
+
 /** @} */
 
 /** @} */
@@ -319,7 +798,8 @@ ADI_METIC_STATUS adi_metic_Irq0Callback(ADI_METIC_HANDLE hMetIc);
 
 /**
  * Callback for UART Rx completetion. This API sets the RX completion flag
- * internally. It should be called from user callback.
+ * internally. When continuous stream is running, it hands the filled block to the consumer and
+ * starts reception of the next block. It should be called from user callback.
  * @param[in] hMetIc - Metrology Servie handle.
  * @returns #ADI_METIC_STATUS_SUCCESS \n
  * #ADI_METIC_STATUS_NULL_PTR
@@ -410,6 +890,36 @@ ADI_METIC_STATUS adi_metic_Close(ADI_METIC_HANDLE hMetIc);
  */
 ADI_METIC_STATUS adi_metic_WfsConfigureRx(ADI_METIC_HANDLE hMetIc, int32_t config);
 
+/**
+ * @brief Gets configuration of wfs last given to #adi_metic_WfsConfigureRx, so that it can be
+ * restored after a temporary configuration.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[out] pConfig - configuration of wfs.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsGetConfig(ADI_METIC_HANDLE hMetIc, int32_t *pConfig);
+
+/**
+ * @brief Plans WFS configuration for enabled channels and sampling rate. Selects the lowest baud
+ * rate of WFS UART that carries 32 bits of every sample with start and stop bits of each byte.
+ * Lower baud rates reduce interrupt load of the host. Buffer for capture time is sized to whole
+ * frames and split into blocks of continuous stream. Configurations which do not fit in the
+ * highest baud rate are rejected, so that they are not written to WFS_CONFIG or given to
+ * #adi_metic_WfsConfigureRx.
+ * @param[in] pConfig - pointer to requirements of WFS.
+ * @param[out] pPlan - pointer to planned configuration.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_DISABLED \n
+ * #ADI_METIC_STATUS_WFS_INVALID_STREAM_CONFIG \n
+ * #ADI_METIC_STATUS_WFS_BANDWIDTH_EXCEEDED
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsPlanBandwidth(ADI_METIC_WFS_PLAN_CONFIG *pConfig,
+                                            ADI_METIC_WFS_PLAN *pPlan);
+
 /**
  * @brief Configures number of bytes to receive in UART DMA and starts the RX DMA only if
  * ADI_METIC_WFS_ADE9178_REG_CONFIG.enable = 1 and previous transaction is completed. Before calling
@@ -449,6 +959,407 @@ ADI_METIC_STATUS adi_metic_FindChannelOffset(ADI_METIC_HANDLE hMetIc, int8_t *pS
                                              int32_t numBytes, int32_t channelId,
                                              int32_t *pByteOffset);
 
+/**
+ * @brief Finds the offset of the first sample of the channel id given as
+ * #adi_metic_FindChannelOffset does, then verifies the rest of the buffer against the enabled
+ * channel sequence. If a byte is dropped in the middle of the buffer, synchronisation is searched
+ * again from that point. Search is linear in buffer size.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in]  pSamples - Pointer to input samples.
+ * @param[in]  numBytes - number of bytes.
+ * @param[in]  channelId - channel id to find offset of the the first sample in input samples.
+ * @param[out]  pResult - offset, number of samples in sequence, resyncs and confidence.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NO_VALID_SAMPLES \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsSync(ADI_METIC_HANDLE hMetIc, int8_t *pSamples, int32_t numBytes,
+                                   int32_t channelId, ADI_METIC_WFS_SYNC_RESULT *pResult);
+
+/**
+ * @brief Deinterleaves WFS samples into a contiguous array per enabled channel. Samples are
+ * expected to start with channelId, at an offset found with #adi_metic_FindChannelOffset or
+ * #adi_metic_WfsSync. Only complete frames of all enabled channels are converted.
+ * Channel ids are not checked while converting, use ADI_METIC_WFS_UNPACK_CONFIG.pValidMask to
+ * find frames with samples out of sequence.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in]  pSamples - Pointer to input samples. Need not be word aligned.
+ * @param[in]  numBytes - number of bytes.
+ * @param[in]  channelId - channel id of the first sample.
+ * @param[in]  pConfig - output format and arrays.
+ * @param[out]  pNumFrames - number of samples written to each output array.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NO_VALID_SAMPLES \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsDeinterleave(ADI_METIC_HANDLE hMetIc, uint8_t *pSamples,
+                                           uint32_t numBytes, int32_t channelId,
+                                           ADI_METIC_WFS_UNPACK_CONFIG *pConfig,
+                                           uint32_t *pNumFrames);
+
+/**
+ * @brief Initialises a view of WFS samples starting at byteOffset of a buffer, without moving
+ * the samples. Samples past the end of the buffer wrap to its start.
+ * @param[out] pView - Pointer to view.
+ * @param[in]  pBuffer - Pointer to buffer.
+ * @param[in]  bufferNumBytes - number of bytes in buffer.
+ * @param[in]  byteOffset - offset in bytes of the first sample, for example from
+ * #adi_metic_FindChannelOffset.
+ * @param[in]  numBytes - number of bytes in view. Should not be more than bufferNumBytes.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NO_VALID_SAMPLES \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsViewInit(ADI_METIC_WFS_VIEW *pView, uint8_t *pBuffer,
+                                       uint32_t bufferNumBytes, uint32_t byteOffset,
+                                       uint32_t numBytes);
+
+/**
+ * @brief Reads samples of a view into a word aligned array. Samples are copied as received,
+ * data[31:8] | channel_id[7:0]. Samples at a misaligned offset or across the end of the buffer
+ * are handled.
+ * @param[in] pView - Pointer to view.
+ * @param[in]  firstSample - index of the first sample to read in view.
+ * @param[in]  numSamples - number of samples to read.
+ * @param[out]  pDst - Pointer to store samples.
+ * @returns number of samples read. Less than numSamples at the end of view.
+ *
+ */
+uint32_t adi_metic_WfsViewRead(ADI_METIC_WFS_VIEW *pView, uint32_t firstSample,
+                               uint32_t numSamples, int32_t *pDst);
+
+/**
+ * @brief Initialises validator of WFS samples. Validator is to be initialised again if WFS
+ * configuration is changed.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[out] pValidator - Pointer to validator state.
+ * @param[in]  channelId - channel id expected as first sample of a frame.
+ * @param[in]  gapFill - fill of lost frames.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NO_VALID_SAMPLES \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsValidatorInit(ADI_METIC_HANDLE hMetIc,
+                                            ADI_METIC_WFS_VALIDATOR *pValidator,
+                                            int32_t channelId, ADI_METIC_WFS_GAP_FILL gapFill);
+
+/**
+ * @brief Checks channel sequence of every frame of a block of WFS samples and deinterleaves valid
+ * frames into output arrays. When a frame is out of sequence, e.g. a byte dropped by UART,
+ * synchronisation is searched again from that point as #adi_metic_FindChannelOffset does, requiring
+ * fewer frames in sequence once samples were valid. Number
+ * of frames lost is estimated from the bytes skipped and filled in output as configured. Blocks
+ * are to be given in the order received. If ADI_METIC_WFS_BLOCK.isGapBefore is set, samples are
+ * synchronised again without filling, as number of lost frames is unknown. Gaps which do not fit
+ * in output arrays with the frame after them are not filled and are reported as discontinuities.
+ * ADI_METIC_WFS_UNPACK_CONFIG.pValidMask, if given, has the bit of filled frames cleared.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in] pValidator - Pointer to validator state.
+ * @param[in]  pBlock - block of samples, e.g. from #adi_metic_WfsGetBlock.
+ * @param[in]  pConfig - output format and arrays. Output starts at index 0 for every block.
+ * @param[out]  pQuality - quality of the block.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsValidateBlock(ADI_METIC_HANDLE hMetIc,
+                                            ADI_METIC_WFS_VALIDATOR *pValidator,
+                                            ADI_METIC_WFS_BLOCK *pBlock,
+                                            ADI_METIC_WFS_UNPACK_CONFIG *pConfig,
+                                            ADI_METIC_WFS_BLOCK_QUALITY *pQuality);
+
+/**
+ * @brief Initialises encoder of WFS samples from WFS configuration. Encoder is to be initialised
+ * again if WFS configuration is changed.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[out] pCodec - Pointer to codec state.
+ * @param[in]  channelId - channel id of the first sample of a frame.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NO_VALID_SAMPLES \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsEncoderInit(ADI_METIC_HANDLE hMetIc, ADI_METIC_WFS_CODEC *pCodec,
+                                          int32_t channelId);
+
+/**
+ * @brief Writes header of compressed samples with the channel order. Header is sent once before
+ * packets, so that the decoder is initialised with #adi_metic_WfsDecoderInit.
+ * @param[in] pCodec - Pointer to codec state.
+ * @param[out] pDst - Pointer to at least #ADI_METIC_WFS_CODEC_HEADER_NUM_BYTES bytes.
+ * @returns number of bytes written.
+ *
+ */
+uint32_t adi_metic_WfsWriteCodecHeader(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pDst);
+
+/**
+ * @brief Compresses synchronised WFS samples into a packet. Channel id bytes are dropped, each
+ * channel is predicted with the fixed predictor of order 0 to 4 giving the smallest residuals,
+ * and residuals are Rice coded. Prediction continues from the previous packet, so packets are to
+ * be decoded in order. Only whole frames are compressed.
+ * @param[in] pCodec - Pointer to codec state.
+ * @param[in]  pSamples - samples starting with the first channel of a frame, e.g. from
+ * #adi_metic_WfsSync.
+ * @param[in]  numBytes - number of bytes of samples. At most 65535 frames.
+ * @param[out]  pDst - pointer to packet.
+ * @param[in]  dstNumBytes - size of packet buffer. #ADI_METIC_WFS_CODEC_PACKET_MAX_NUM_BYTES
+ * bytes is always enough.
+ * @param[out]  pNumDstBytes - number of bytes of packet.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_NO_VALID_SAMPLES, if codec has no channels \n
+ * #ADI_METIC_STATUS_WFS_INSUFFICIENT_BUFFER
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsEncode(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pSamples,
+                                     uint32_t numBytes, uint8_t *pDst, uint32_t dstNumBytes,
+                                     uint32_t *pNumDstBytes);
+
+/**
+ * @brief Initialises decoder from header of compressed samples. Does not need a Metrology
+ * Service handle, so that it can be built for a host.
+ * @param[out] pCodec - Pointer to codec state.
+ * @param[in]  pSrc - pointer to header.
+ * @param[in]  numBytes - number of bytes available.
+ * @param[out]  pNumSrcBytes - number of bytes of header.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CODEC_DATA
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsDecoderInit(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pSrc,
+                                          uint32_t numBytes, uint32_t *pNumSrcBytes);
+
+/**
+ * @brief Decompresses a packet from #adi_metic_WfsEncode into frames of samples. Samples of a
+ * frame are in the order of ADI_METIC_WFS_CODEC.order, sign extended from 24 bits.
+ * @param[in] pCodec - Pointer to codec state.
+ * @param[in]  pSrc - pointer to packet.
+ * @param[in]  numBytes - number of bytes available.
+ * @param[out]  pDst - pointer to frames of samples.
+ * @param[in]  maxFrames - number of frames pDst can hold.
+ * @param[out]  pNumSrcBytes - number of bytes of packet.
+ * @param[out]  pNumFrames - number of frames decoded.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INSUFFICIENT_BUFFER \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CODEC_DATA
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsDecode(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pSrc,
+                                     uint32_t numBytes, int32_t *pDst, uint32_t maxFrames,
+                                     uint32_t *pNumSrcBytes, uint32_t *pNumFrames);
+
+/**
+ * @brief Initialises resampling of deinterleaved WFS samples, e.g. from
+ * #adi_metic_WfsDeinterleave. Rate is reduced with a polyphase low pass filter cut off below half
+ * of the lower of input and output rates. The filter has more taps for larger decimation, up to
+ * #ADI_METIC_WFS_RESAMPLER_MAX_TAPS. Output is delayed by half of the taps of input samples.
+ * @param[out] pResampler - Pointer to resampler state.
+ * @param[in]  pConfig - Pointer to configuration.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_RESAMPLER_CONFIG
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsResamplerInit(ADI_METIC_WFS_RESAMPLER *pResampler,
+                                            ADI_METIC_WFS_RESAMPLER_CONFIG *pConfig);
+
+/**
+ * @brief Sets line period followed by resampling with #ADI_METIC_WFS_RESAMPLE_SYNC, e.g.
+ * ADI_METIC_PERIOD_OUTPUT.comPeriod. Periods of frequencies out of
+ * #ADI_METIC_WFS_RESAMPLER_MIN_FREQUENCY to #ADI_METIC_WFS_RESAMPLER_MAX_FREQUENCY are ignored.
+ * @param[in] pResampler - Pointer to resampler state.
+ * @param[in]  period - line period in seconds.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_RESAMPLER_CONFIG
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsSetResamplerPeriod(ADI_METIC_WFS_RESAMPLER *pResampler,
+                                                 float period);
+
+/**
+ * @brief Returns number of output samples produced for given number of input samples, to size
+ * output arrays of #adi_metic_WfsResample.
+ * @param[in] pResampler - Pointer to resampler state.
+ * @param[in]  numFrames - number of input samples of each channel.
+ * @returns number of output samples of each channel.
+ *
+ */
+uint32_t adi_metic_WfsGetResampleNumFrames(ADI_METIC_WFS_RESAMPLER *pResampler,
+                                           uint32_t numFrames);
+
+/**
+ * @brief Resamples a block of samples of every channel. Arrays are int32_t for
+ * #ADI_METIC_WFS_FORMAT_INT32 and float otherwise. Blocks of any length can be given, output is
+ * continuous across blocks.
+ * @param[in] pResampler - Pointer to resampler state.
+ * @param[in]  ppSrc - input array of each channel.
+ * @param[in]  numFrames - number of input samples of each channel.
+ * @param[out]  ppDst - output array of each channel.
+ * @param[in]  maxFrames - number of samples each output array can hold.
+ * @param[out]  pNumFrames - number of samples written to each output array.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INSUFFICIENT_BUFFER
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsResample(ADI_METIC_WFS_RESAMPLER *pResampler, void **ppSrc,
+                                       uint32_t numFrames, void **ppDst, uint32_t maxFrames,
+                                       uint32_t *pNumFrames);
+
+/**
+ * @brief Starts continuous reception of WFS samples into a ring of blocks. The buffer is split
+ * into numBlocks blocks of blockNumBytes each. When a block is filled,
+ * #adi_metic_WfsUartRxCallback starts reception of the next block if it is released by the
+ * consumer. Otherwise reception stops, an overrun is counted and reception restarts on the next
+ * #adi_metic_WfsReleaseBlock with the first block received after it flagged with
+ * ADI_METIC_WFS_BLOCK.isGapBefore. Before calling this API, #adi_metic_WfsConfigureRx to be called
+ * to set configurations.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in] pBuffer - Pointer to stream buffer of numBlocks * blockNumBytes bytes.
+ * @param[in] blockNumBytes - number of bytes in a block.
+ * @param[in] numBlocks - number of blocks. Should be 2 to #ADI_METIC_WFS_MAX_STREAM_BLOCKS.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_STREAM_CONFIG \n
+ * #ADI_METIC_STATUS_WFS_UART_COMM_ERROR \n
+ * #ADI_METIC_STATUS_WFS_PREV_TRANSACTION_IN_PROGRESS \n
+ * #ADI_METIC_STATUS_WFS_DISABLED
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsStartStream(ADI_METIC_HANDLE hMetIc, uint8_t *pBuffer,
+                                          uint32_t blockNumBytes, uint32_t numBlocks);
+
+/**
+ * @brief Stops continuous reception of WFS samples. Block being received is completed and can
+ * still be read with #adi_metic_WfsGetBlock.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsStopStream(ADI_METIC_HANDLE hMetIc);
+
+/**
+ * @brief Gets oldest filled block of WFS continuous stream without copying. Same block is returned
+ * until it is released with #adi_metic_WfsReleaseBlock. Used only while no consumer is registered
+ * with #adi_metic_WfsRegisterConsumer.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[out] pBlock - Pointer to store block details.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsGetBlock(ADI_METIC_HANDLE hMetIc, ADI_METIC_WFS_BLOCK *pBlock);
+
+/**
+ * @brief Releases oldest filled block of WFS continuous stream so that it can be filled again.
+ * Restarts reception if it was stopped due to an overrun.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE \n
+ * #ADI_METIC_STATUS_WFS_UART_COMM_ERROR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsReleaseBlock(ADI_METIC_HANDLE hMetIc);
+
+/**
+ * @brief Gets status of WFS continuous stream.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[out] pStatus - Pointer to store stream status.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsGetStreamStatus(ADI_METIC_HANDLE hMetIc,
+                                              ADI_METIC_WFS_STREAM_STATUS *pStatus);
+
+/**
+ * @brief Registers a consumer of WFS continuous stream. Every consumer reads all blocks through
+ * its own cursor without copying, and a block is filled again only after all consumers released
+ * it. A consumer registered while streaming starts with the next block received. While any
+ * consumer is registered, #adi_metic_WfsGetBlock and #adi_metic_WfsReleaseBlock are not used.
+ * Consumers are to be called from the same context.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in] policy - handling of the consumer if it holds the stream back.
+ * @param[out] pConsumerId - Pointer to store consumer id, 1 to #ADI_METIC_WFS_MAX_CONSUMERS.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CONSUMER
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsRegisterConsumer(ADI_METIC_HANDLE hMetIc,
+                                               ADI_METIC_WFS_CONSUMER_POLICY policy,
+                                               uint32_t *pConsumerId);
+
+/**
+ * @brief Unregisters a consumer of WFS continuous stream. Blocks held by the consumer are
+ * released.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in] consumerId - consumer id.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CONSUMER \n
+ * #ADI_METIC_STATUS_WFS_UART_COMM_ERROR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsUnregisterConsumer(ADI_METIC_HANDLE hMetIc, uint32_t consumerId);
+
+/**
+ * @brief Gets the next block of WFS continuous stream for a consumer without copying. Same block
+ * is returned until it is released with #adi_metic_WfsReleaseConsumerBlock.
+ * ADI_METIC_WFS_BLOCK.isGapBefore is also set after blocks skipped for the consumer.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in] consumerId - consumer id.
+ * @param[out] pBlock - Pointer to store block details.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CONSUMER \n
+ * #ADI_METIC_STATUS_WFS_CONSUMER_DROPPED \n
+ * #ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE \n
+ * #ADI_METIC_STATUS_WFS_UART_COMM_ERROR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsGetConsumerBlock(ADI_METIC_HANDLE hMetIc, uint32_t consumerId,
+                                               ADI_METIC_WFS_BLOCK *pBlock);
+
+/**
+ * @brief Releases the block of a consumer got with #adi_metic_WfsGetConsumerBlock. Block is
+ * filled again once released by all consumers. Restarts reception if it was stopped due to an
+ * overrun.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in] consumerId - consumer id.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CONSUMER \n
+ * #ADI_METIC_STATUS_WFS_CONSUMER_DROPPED \n
+ * #ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE \n
+ * #ADI_METIC_STATUS_WFS_UART_COMM_ERROR
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsReleaseConsumerBlock(ADI_METIC_HANDLE hMetIc, uint32_t consumerId);
+
+/**
+ * @brief Gets read cursor and lag of a consumer of WFS continuous stream.
+ * @param[in] hMetIc - Metrology Servie handle.
+ * @param[in] consumerId - consumer id.
+ * @param[out] pStatus - Pointer to store consumer status.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CONSUMER
+ *
+ */
+ADI_METIC_STATUS adi_metic_WfsGetConsumerStatus(ADI_METIC_HANDLE hMetIc, uint32_t consumerId,
+                                                ADI_METIC_WFS_CONSUMER_STATUS *pStatus);
+
 /**
  * Checks integrity errors and startup errors, and then starts ADC and ADE9178 by enabling RUN and
  * INIT Bit of #ADE9178_REG_ADC_CONTROL. It's recommended to call
@@ -581,6 +1492,54 @@ void adi_metic_ConvertPeriod(ADI_METIC_PERIOD_OUTPUT_FIX *pSrc, uint32_t numRegi
 void adi_metic_ConvertAngle(ADI_METIC_ANGLE_OUTPUT_FIX *pAngleSrc, int32_t *pPeriodSrc,
                             uint32_t numRegisters, ADI_METIC_ANGLE_OUTPUT *pDst);
 
+/**
+ * @brief Packs outputs into a frame for streaming. Frame starts with
+ * #ADI_METIC_OUTPUT_FRAME_SYNC and a 16 bit length of the bytes that follow up to a CRC-16
+ * (CCITT) of the frame. Header and values are little endian.
+ * @param[in]  pConfig - Pointer to configuration of frame.
+ * @param[in]  irqCount - IRQ0 count of the outputs.
+ * @param[in]  timestamp - time (usec) of the outputs.
+ * @param[in]  pOutput - Pointer to converted outputs. Status is always taken from here.
+ * @param[in]  pOutputFix - Pointer to register codes, used in fixed format.
+ * @param[out] pDst - Pointer to frame.
+ * @param[in]  maxNumBytes - size of frame buffer. #ADI_METIC_OUTPUT_FRAME_MAX_NUM_BYTES is
+ * sufficient.
+ * @param[out] pNumBytes - number of bytes of frame.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_INVALID_OUTPUT_FRAME \n
+ * #ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER
+ *
+ */
+ADI_METIC_STATUS adi_metic_EncodeOutputFrame(ADI_METIC_OUTPUT_FRAME_CONFIG *pConfig,
+                                             uint32_t irqCount, uint32_t timestamp,
+                                             ADI_METIC_OUTPUT *pOutput,
+                                             ADI_METIC_OUTPUT_FIX *pOutputFix, uint8_t *pDst,
+                                             uint32_t maxNumBytes, uint32_t *pNumBytes);
+
+/**
+ * @brief Unpacks a frame from #adi_metic_EncodeOutputFrame. Values of fields present are
+ * written to pOutput in float format and to pOutputFix in fixed format. Status is written to
+ * pOutput in both formats.
+ * @param[in]  pSrc - Pointer to frame, starting with #ADI_METIC_OUTPUT_FRAME_SYNC.
+ * @param[in]  numBytes - number of bytes available.
+ * @param[out] pFrame - Pointer to store header of frame.
+ * @param[out] pOutput - Pointer to converted outputs.
+ * @param[out] pOutputFix - Pointer to register codes.
+ * @param[out] pNumSrcBytes - number of bytes of frame. Set to 0 if more bytes are needed.
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_INVALID_OUTPUT_FRAME \n
+ * #ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER \n
+ * #ADI_METIC_STATUS_FRAME_CRC_ERROR
+ *
+ */
+ADI_METIC_STATUS adi_metic_DecodeOutputFrame(uint8_t *pSrc, uint32_t numBytes,
+                                             ADI_METIC_OUTPUT_FRAME *pFrame,
+                                             ADI_METIC_OUTPUT *pOutput,
+                                             ADI_METIC_OUTPUT_FIX *pOutputFix,
+                                             uint32_t *pNumSrcBytes);
+
 /** @} */
 
 /** @} */
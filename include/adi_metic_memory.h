@@ -21,7 +21,7 @@ extern "C" {
 
 /** State memory required in bytes for the library. Allocate a buffer aligned
  * to 32 bit boundary */
-#define ADI_METIC_STATE_MEM_NUM_BYTES 760
+#define ADI_METIC_STATE_MEM_NUM_BYTES 960
 
 /** @} */
 #ifdef __cplusplus
@@ -21,6 +21,69 @@
 extern "C" {
 #endif
 
+/** Channel id used in next channel id table for channels that are not enabled */
+#define ADI_METIC_WFS_INVALID_CHANNEL_ID 0xFF
+
+/**
+ * Ring of blocks for WFS continuous stream. numBlocksReceived is only written from the UART
+ * callback and numBlocksReleased only by the consumer.
+ */
+typedef struct
+{
+    /** stream buffer */
+    uint8_t *pBuffer;
+    /** number of bytes in a block */
+    uint32_t blockNumBytes;
+    /** number of blocks in the ring */
+    uint32_t numBlocks;
+    /** index of block being received */
+    uint32_t writeIndex;
+    /** index of oldest filled block */
+    uint32_t readIndex;
+    /** number of blocks received */
+    volatile uint32_t numBlocksReceived;
+    /** number of blocks released by the consumer */
+    volatile uint32_t numBlocksReleased;
+    /** number of overruns */
+    volatile uint32_t numOverruns;
+    /** stream is running */
+    volatile uint8_t isActive;
+    /** stop requested by the consumer */
+    volatile uint8_t isStopRequested;
+    /** reception stopped as no free block is available */
+    volatile uint8_t isStalled;
+    /** samples lost before the block being received */
+    volatile uint8_t isGapPending;
+    /** sequence number of each block */
+    uint32_t blockSequence[ADI_METIC_WFS_MAX_STREAM_BLOCKS];
+    /** gap flag of each block */
+    uint8_t isBlockAfterGap[ADI_METIC_WFS_MAX_STREAM_BLOCKS];
+} ADI_METIC_WFS_STREAM_INFO;
+
+/**
+ * Consumer of WFS continuous stream. numBlocksRead is the cursor of the consumer in blocks
+ * received. A block is held while the cursor of any active consumer has not passed it.
+ */
+typedef struct
+{
+    /** consumer is registered */
+    uint8_t isRegistered;
+    /** consumer is dropped by its policy */
+    uint8_t isDropped;
+    /** consumer got its block and did not release it yet */
+    uint8_t isHolding;
+    /** blocks were skipped before the next block of the consumer */
+    uint8_t isGapPending;
+    /** policy when the consumer holds the stream back */
+    ADI_METIC_WFS_CONSUMER_POLICY policy;
+    /** number of blocks released by the consumer */
+    uint32_t numBlocksRead;
+    /** highest lag seen */
+    uint32_t maxLag;
+    /** number of blocks skipped */
+    uint32_t numSkipped;
+} ADI_METIC_WFS_CONSUMER_INFO;
+
 /**
  * Waveform Stream Configuration register
  */
@@ -30,8 +93,14 @@ typedef struct
     ADI_METIC_WFS_CONFIG config;
     /** WFS RX completion flag */
     uint32_t isWfsRxComplete;
-    /** buffer to store channels enabled in WFS */
-    uint8_t channelIdEnabledBuff[ADI_METIC_MAX_NUM_CHANNELS];
+    /** next enabled channel id for every channel id */
+    uint8_t nextChannelId[ADI_METIC_MAX_NUM_CHANNELS];
+    /** continuous stream data */
+    ADI_METIC_WFS_STREAM_INFO stream;
+    /** consumers of continuous stream */
+    ADI_METIC_WFS_CONSUMER_INFO consumer[ADI_METIC_WFS_MAX_CONSUMERS];
+    /** number of registered consumers */
+    uint32_t numConsumers;
 } ADI_METIC_WFS_INFO;
 
 /**
@@ -89,6 +158,32 @@ ADI_METIC_STATUS adi_metic_SendCmdGetResponse(ADI_METIC_HANDLE hMetIc, uint8_t d
                                               int32_t *pData, int32_t *pReceivedData,
                                               uint32_t *pNumReceivedBytes);
 
+/**
+ * Finds the first byte offset where requiredSamples consecutive samples follow the enabled
+ * channel sequence starting with channelId. All four byte alignments are tracked in a single pass,
+ * comparing channel id bytes of four alignments together in a 32 bit word.
+ * @param[in]  pNextChannelId - pointer to next channel id table.
+ * @param[in]  pBuffer - pointer to input buffer.
+ * @param[in]  numBytes - number of bytes in buffer.
+ * @param[in]  channelId - channel id of the first sample.
+ * @param[in]  requiredSamples - number of consecutive samples to be in sequence.
+ * @param[out]  pByteOffset - offset in bytes.
+ * @return 0 if offset is found
+ */
+int32_t adi_metic_WfsFindSyncOffset(uint8_t *pNextChannelId, uint8_t *pBuffer, uint32_t numBytes,
+                                    uint32_t channelId, uint32_t requiredSamples,
+                                    uint32_t *pByteOffset);
+
+/**
+ * Stores enabled channel ids in the order they are received starting from channelId.
+ * @param[in]  pNextChannelId - pointer to next channel id table.
+ * @param[in]  channelId - channel id of the first sample.
+ * @param[out]  pOrder - pointer to store channel ids.
+ * @return number of channels enabled. 0 if channelId is not enabled.
+ */
+uint32_t adi_metic_WfsGetChannelOrder(uint8_t *pNextChannelId, uint32_t channelId,
+                                      uint8_t *pOrder);
+
 #ifdef __cplusplus
 }
 #endif
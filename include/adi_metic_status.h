@@ -95,6 +95,26 @@ typedef enum
     /** Configuration of WFS is disabled. Check the bitfields of enable and channelEn of WFS
        Register. */
     ADI_METIC_STATUS_WFS_DISABLED,
+    /** Buffer, block size or number of blocks given for WFS continuous stream is invalid */
+    ADI_METIC_STATUS_WFS_INVALID_STREAM_CONFIG,
+    /** No filled block is available in WFS continuous stream */
+    ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE,
+    /** Buffer given for compressed or decompressed WFS samples is too small */
+    ADI_METIC_STATUS_WFS_INSUFFICIENT_BUFFER,
+    /** Compressed WFS samples are corrupted or have an unknown header */
+    ADI_METIC_STATUS_WFS_INVALID_CODEC_DATA,
+    /** Samples of enabled channels at the sampling rate do not fit in the highest WFS baud rate */
+    ADI_METIC_STATUS_WFS_BANDWIDTH_EXCEEDED,
+    /** Rates, format or number of channels given for resampling of WFS samples are invalid */
+    ADI_METIC_STATUS_WFS_INVALID_RESAMPLER_CONFIG,
+    /** Consumer of WFS continuous stream is not registered, or no consumer can be registered */
+    ADI_METIC_STATUS_WFS_INVALID_CONSUMER,
+    /** Consumer of WFS continuous stream was dropped as it held the stream back */
+    ADI_METIC_STATUS_WFS_CONSUMER_DROPPED,
+    /** Frame of metrology outputs or its configuration is invalid */
+    ADI_METIC_STATUS_INVALID_OUTPUT_FRAME,
+    /** Buffer is too small for frame of metrology outputs */
+    ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER,
     /** Dummy code to decide end of the enums.
      *  Add all error codes above this*/
     ADI_METIC_STATUS_LAST_ERROR
@@ -51,6 +51,67 @@ extern "C" {
 /** Size of WFS buffer */
 #define WFS_BUFFER_SIZE 16000
 #endif
+/** Number of blocks the WFS buffer is split into for continuous streaming */
+#define WFS_STREAM_NUM_BLOCKS 4
+/** Size of a WFS stream block in bytes */
+#define WFS_STREAM_BLOCK_NUM_BYTES ((WFS_BUFFER_SIZE / WFS_STREAM_NUM_BLOCKS) * 4)
+/** Maximum number of cycles held in the sliding statistics window */
+#define STATS_MAX_SLIDING_WINDOW_CYCLES 32
+/** Default number of cycles in the tumbling statistics window */
+#define STATS_DEFAULT_TUMBLING_WINDOW_CYCLES 50
+/** Index of first active power channel in running statistics */
+#define STATS_POWER_CHANNEL_OFFSET ADI_METIC_MAX_NUM_CHANNELS
+/** Index of first power factor channel in running statistics */
+#define STATS_PF_CHANNEL_OFFSET (STATS_POWER_CHANNEL_OFFSET + ADI_METIC_MAX_NUM_POWER_CHANNELS)
+/** Number of channels tracked by running statistics. Filtered rms of all channels, followed by
+ * active power and power factor of each phase */
+#define STATS_NUM_CHANNELS (STATS_PF_CHANNEL_OFFSET + ADI_METIC_MAX_NUM_POWER_CHANNELS)
+#ifndef HARMONICS_FIXED_POINT
+/** Set to 1 to compute harmonics with fixed point FFT, 0 for floating point FFT */
+#define HARMONICS_FIXED_POINT 0
+#endif
+/** Number of points of real FFT for harmonic analysis. A window is resampled to this size */
+#define HARMONICS_FFT_SIZE 1024
+/** Highest harmonic order computed */
+#define HARMONICS_MAX_ORDER 50
+/** Sampling rate of waveform samples in Hz */
+#define HARMONICS_SAMPLING_RATE ADI_METIC_SAMPLING_RATE
+/** Lowest line frequency in Hz for harmonic analysis */
+#define HARMONICS_MIN_FREQUENCY 42
+/** Highest line frequency in Hz for harmonic analysis */
+#define HARMONICS_MAX_FREQUENCY 69
+/** Maximum number of cycles in a harmonic analysis window */
+#define HARMONICS_MAX_NUM_CYCLES 12
+#ifndef HARMONICS_MAX_WINDOW_MS
+/** Longest harmonic analysis window in ms. 200 ms window of 10 cycles at 50 Hz or 12 cycles at
+ * 60 Hz, with 10 % for line frequency to drift */
+#define HARMONICS_MAX_WINDOW_MS 220
+#endif
+/** Number of samples held for a window. Enough for longest window, with samples for
+ * interpolation at the end */
+#define HARMONICS_MAX_WINDOW_SAMPLES                                                               \
+    ((HARMONICS_MAX_WINDOW_MS * HARMONICS_SAMPLING_RATE + 999) / 1000 + 4)
+#ifndef HARMONICS_MAX_NUM_CHANNELS
+/** Maximum number of channels analysed together. Each channel holds a window of
+ * #HARMONICS_MAX_WINDOW_SAMPLES samples */
+#define HARMONICS_MAX_NUM_CHANNELS 6
+#endif
+/** Maximum number of Goertzel bins of a channel */
+#define GOERTZEL_MAX_NUM_BINS 8
+/** Number of frames of waveform stream validated at a time for Goertzel bank */
+#define GOERTZEL_CHUNK_NUM_FRAMES 16
+/** Number of frames held after validation. Extra frames hold frames filled after a loss, longer
+ * losses restart the window */
+#define GOERTZEL_MAX_CHUNK_FRAMES (2 * GOERTZEL_CHUNK_NUM_FRAMES)
+/** Number of samples held by triggered capture, 100 ms with all channels enabled */
+#define TRIGGER_MAX_CAPTURE_SAMPLES 4800
+/** Number of frames of waveform stream validated at a time for triggered capture */
+#define TRIGGER_CHUNK_NUM_FRAMES 16
+/** Number of frames held after validation. Extra frames hold frames filled after a loss, longer
+ * losses are left as gaps in capture */
+#define TRIGGER_MAX_CHUNK_FRAMES (2 * TRIGGER_CHUNK_NUM_FRAMES)
+/** Time between frames of waveform stream in usec */
+#define TRIGGER_FRAME_PERIOD_US (1000000 / ADI_METIC_SAMPLING_RATE)
 
 /** @} */
 /** @} */
@@ -81,6 +142,339 @@ typedef struct
 
 } ADE_IRQ_STATUS;
 
+/**
+ * Windows over which running statistics are reported.
+ */
+typedef enum
+{
+    /** All cycles since the last reset */
+    METIC_STATS_WINDOW_TOTAL,
+    /** Last completed tumbling window */
+    METIC_STATS_WINDOW_TUMBLING,
+    /** Most recent cycles of the sliding window */
+    METIC_STATS_WINDOW_SLIDING
+} METIC_STATS_WINDOW;
+
+/**
+ * Sources of triggered capture, combined as a bit mask.
+ */
+typedef enum
+{
+    /** DIPHALF of a monitored channel below dip level */
+    METIC_TRIGGER_SOURCE_DIP = 0x1,
+    /** SWELLHALF of a monitored channel above swell level */
+    METIC_TRIGGER_SOURCE_SWELL = 0x2,
+    /** Bits of STATUS0 or STATUS1 set */
+    METIC_TRIGGER_SOURCE_STATUS = 0x4,
+    /** No CF pulse for longer than CF gap time */
+    METIC_TRIGGER_SOURCE_CF_GAP = 0x8,
+    /** Waveform sample of a channel beyond sample threshold */
+    METIC_TRIGGER_SOURCE_SAMPLE = 0x10
+} METIC_TRIGGER_SOURCE;
+
+/**
+ * States of triggered capture.
+ */
+typedef enum
+{
+    /** Not armed */
+    METIC_TRIGGER_STATE_IDLE,
+    /** Pre-trigger history is kept while waiting for a trigger */
+    METIC_TRIGGER_STATE_ARMED,
+    /** Collecting samples after trigger */
+    METIC_TRIGGER_STATE_TRIGGERED,
+    /** Capture is frozen until armed again */
+    METIC_TRIGGER_STATE_COMPLETE
+} METIC_TRIGGER_STATE;
+
+/**
+ * Structure to hold running statistics of one channel. Mean and variance are updated with
+ * Welford's method.
+ */
+typedef struct
+{
+    /** minimum value */
+    float min;
+    /** maximum value */
+    float max;
+    /** running mean */
+    float mean;
+    /** sum of squares of differences from the mean */
+    float m2;
+    /** time of IRQ0 (usec) at which minimum occurred */
+    uint32_t minTime;
+    /** time of IRQ0 (usec) at which maximum occurred */
+    uint32_t maxTime;
+    /** number of cycles accumulated */
+    uint32_t count;
+} METIC_STATS_ACCUM;
+
+/**
+ * Structure to hold running statistics of one channel over all windows.
+ */
+typedef struct
+{
+    /** statistics since last reset */
+    METIC_STATS_ACCUM total;
+    /** statistics of the tumbling window in progress */
+    METIC_STATS_ACCUM tumbling;
+    /** statistics of the last completed tumbling window */
+    METIC_STATS_ACCUM lastTumbling;
+    /** statistics of the sliding window */
+    METIC_STATS_ACCUM sliding;
+    /** values in the sliding window */
+    float slidingValue[STATS_MAX_SLIDING_WINDOW_CYCLES];
+    /** time of IRQ0 (usec) of values in the sliding window */
+    uint32_t slidingTime[STATS_MAX_SLIDING_WINDOW_CYCLES];
+} METIC_STATS_CHANNEL;
+
+/**
+ * Structure to hold running statistics of rms, power and power factor outputs.
+ */
+typedef struct
+{
+    /** number of cycles in a tumbling window */
+    uint32_t tumblingCycles;
+    /** number of cycles in the sliding window */
+    uint32_t slidingCycles;
+    /** index in sliding window to be written next */
+    uint32_t slidingIndex;
+    /** number of tumbling windows completed since reset */
+    uint32_t numWindows;
+    /** statistics of each channel */
+    METIC_STATS_CHANNEL channel[STATS_NUM_CHANNELS];
+} METIC_STATS_INFO;
+
+/**
+ * Structure to report statistics of a channel over a window.
+ */
+typedef struct
+{
+    /** minimum value */
+    float min;
+    /** maximum value */
+    float max;
+    /** mean value */
+    float mean;
+    /** sample variance */
+    float variance;
+    /** time of IRQ0 (usec) at which minimum occurred */
+    uint32_t minTime;
+    /** time of IRQ0 (usec) at which maximum occurred */
+    uint32_t maxTime;
+    /** number of cycles in the window */
+    uint32_t count;
+} METIC_STATS_SUMMARY;
+
+/**
+ * Harmonics of a window of waveform samples.
+ */
+typedef struct
+{
+    /** Rms of harmonics in codes, indexed by harmonic order. Index 0 is dc */
+    float magnitude[HARMONICS_MAX_ORDER + 1];
+    /** Phase of harmonics in degrees relative to fundamental, indexed by harmonic order */
+    float phase[HARMONICS_MAX_ORDER + 1];
+    /** Highest harmonic order computed. Limited by sampling rate and FFT size */
+    uint32_t numHarmonics;
+    /** Total harmonic distortion in percent of fundamental */
+    float thd;
+    /** Line frequency of the window in Hz */
+    float frequency;
+
+} METIC_HARMONICS_RESULT;
+
+/**
+ * Structure to hold harmonic analysis of channels of waveform stream.
+ */
+typedef struct
+{
+    /** FFT buffer. Resampled window is transformed in place */
+#if HARMONICS_FIXED_POINT == 1
+    int32_t fft[HARMONICS_FFT_SIZE];
+#else
+    float fft[HARMONICS_FFT_SIZE];
+#endif
+    /** Samples of the windows being collected, indexed by position of channel in channel list */
+    int32_t window[HARMONICS_MAX_NUM_CHANNELS][HARMONICS_MAX_WINDOW_SAMPLES];
+    /** Number of samples in window. Windows of all channels are collected from the same frames */
+    uint32_t numSamples;
+    /** Fraction of a sample by which window starts after first sample in window. Carried from
+     * window to window, so that windows of fractional length do not drift against line cycles */
+    float windowPhase;
+    /** Channel ids analysed in ascending order */
+    uint32_t channel[HARMONICS_MAX_NUM_CHANNELS];
+    /** Number of channels analysed */
+    uint32_t numChannels;
+    /** Mask of channel ids analysed */
+    uint32_t channelMask;
+    /** Number of line cycles in a window */
+    uint32_t numCycles;
+    /** Line frequency in Hz used to size windows */
+    float frequency;
+    /** Consumer id of waveform stream, 0 if not registered */
+    uint32_t consumerId;
+    /** Validator of waveform stream */
+    ADI_METIC_WFS_VALIDATOR validator;
+    /** Harmonics of last window, indexed by position of channel in channel list */
+    METIC_HARMONICS_RESULT result[HARMONICS_MAX_NUM_CHANNELS];
+    /** Number of windows analysed */
+    uint32_t numWindows;
+    /** Set to 1 when harmonic analysis is running */
+    uint32_t isEnabled;
+
+} METIC_HARMONICS_INFO;
+
+/**
+ * Goertzel bins of a channel of waveform stream.
+ */
+typedef struct
+{
+    /** Harmonic orders of bins. Fractional orders select interharmonic bins */
+    float order[GOERTZEL_MAX_NUM_BINS];
+    /** Number of bins */
+    uint32_t numBins;
+    /** Goertzel coefficient of bins, 2 * cos(w) */
+    float coeff[GOERTZEL_MAX_NUM_BINS];
+    /** Cosine of angle of bins per sample */
+    float cosine[GOERTZEL_MAX_NUM_BINS];
+    /** Sine of angle of bins per sample */
+    float sine[GOERTZEL_MAX_NUM_BINS];
+    /** Last output of Goertzel filter of bins */
+    float s1[GOERTZEL_MAX_NUM_BINS];
+    /** Output before last of Goertzel filter of bins */
+    float s2[GOERTZEL_MAX_NUM_BINS];
+    /** Rms of bins in codes for last window */
+    float magnitude[GOERTZEL_MAX_NUM_BINS];
+    /** Phase of bins in degrees for last window, relative to start of window */
+    float phase[GOERTZEL_MAX_NUM_BINS];
+
+} METIC_GOERTZEL_CHANNEL;
+
+/**
+ * Structure to hold Goertzel bank of waveform stream. Windows hold an integer number of line
+ * cycles, sized with the measured period and starting at a zero crossing of the first channel.
+ */
+typedef struct
+{
+    /** Bins of channels indexed by channel id */
+    METIC_GOERTZEL_CHANNEL channel[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Bit mask of channel ids with bins */
+    uint32_t channelMask;
+    /** Number of line cycles in a window */
+    uint32_t numCycles;
+    /** Line frequency in Hz used to size next window */
+    float frequency;
+    /** Line frequency in Hz of last window */
+    float windowFrequency;
+    /** Number of samples in current window */
+    uint32_t windowNumSamples;
+    /** Number of samples added to current window */
+    uint32_t sampleIndex;
+    /** Set to 1 once windows are aligned to a zero crossing */
+    uint32_t isAligned;
+    /** Last sample of first channel, to detect zero crossing */
+    int32_t lastSample;
+    /** Consumer id of waveform stream, 0 if not registered */
+    uint32_t consumerId;
+    /** Validator of waveform stream */
+    ADI_METIC_WFS_VALIDATOR validator;
+    /** Validated samples of channels, indexed by channel id */
+    int32_t chunk[ADI_METIC_MAX_NUM_CHANNELS][GOERTZEL_MAX_CHUNK_FRAMES];
+    /** Number of windows completed */
+    uint32_t numWindows;
+    /** Set to 1 when Goertzel bank is running */
+    uint32_t isEnabled;
+
+} METIC_GOERTZEL_INFO;
+
+/**
+ * Configuration of triggered capture.
+ */
+typedef struct
+{
+    /** Enabled sources, bit mask of #METIC_TRIGGER_SOURCE */
+    uint32_t sourceMask;
+    /** Bit mask of channel ids whose DIPHALF and SWELLHALF are monitored */
+    uint32_t rmsChannelMask;
+    /** Dip level in units of #ADI_METIC_OUTPUT */
+    float dipLevel;
+    /** Swell level in units of #ADI_METIC_OUTPUT */
+    float swellLevel;
+    /** Bits of STATUS0 that trigger */
+    uint32_t status0Mask;
+    /** Bits of STATUS1 that trigger */
+    uint32_t status1Mask;
+    /** Time without CF pulse that triggers, in usec */
+    uint32_t cfGapTime;
+    /** Channel id of sample threshold */
+    uint32_t sampleChannel;
+    /** Sample threshold in codes. Triggers when absolute value of sample exceeds it */
+    int32_t sampleThreshold;
+    /** Time of capture before trigger in msec */
+    uint32_t preTriggerTime;
+    /** Time of capture after trigger in msec */
+    uint32_t postTriggerTime;
+
+} METIC_TRIGGER_CONFIG;
+
+/**
+ * Structure to hold triggered capture of waveform stream. Frames are kept in a circular buffer
+ * while armed, so that history before the trigger is captured.
+ */
+typedef struct
+{
+    /** Configuration */
+    METIC_TRIGGER_CONFIG config;
+    /** State of capture */
+    METIC_TRIGGER_STATE state;
+    /** Register sources fired at cycle rate, waiting to be placed in waveform stream */
+    volatile uint32_t pendingSource;
+    /** Time (usec) of IRQ0 at which register sources fired */
+    uint32_t pendingTime;
+    /** Time (usec) at which capture was armed */
+    uint32_t armTime;
+    /** Time (usec) of last CF pulse */
+    volatile uint32_t lastCfTime;
+    /** Sources that fired the capture */
+    uint32_t source;
+    /** Time (usec) of trigger */
+    uint32_t triggerTime;
+    /** Time (usec) of first frame of capture */
+    uint32_t startTime;
+    /** Number of frames the buffer holds for the channels streamed */
+    uint32_t maxFrames;
+    /** Number of frames to keep before trigger */
+    uint32_t numPreFrames;
+    /** Number of frames to capture after trigger */
+    uint32_t numPostFrames;
+    /** Index in buffer of next frame written */
+    uint32_t writeIndex;
+    /** Number of frames of history in buffer, up to maxFrames */
+    uint32_t numHistoryFrames;
+    /** Number of frames left to capture after trigger */
+    uint32_t numPostRemaining;
+    /** Index in buffer of first frame of capture */
+    uint32_t startIndex;
+    /** Index of frame of trigger from start of capture */
+    uint32_t triggerFrame;
+    /** Number of frames in capture */
+    uint32_t numCaptureFrames;
+    /** Number of gaps in waveform stream during capture */
+    uint32_t numGaps;
+    /** Frames of capture, channels in order of validator */
+    int32_t samples[TRIGGER_MAX_CAPTURE_SAMPLES];
+    /** Consumer id of waveform stream, 0 if not registered */
+    uint32_t consumerId;
+    /** Validator of waveform stream */
+    ADI_METIC_WFS_VALIDATOR validator;
+    /** Validated samples of channels, indexed by channel id */
+    int32_t chunk[ADI_METIC_MAX_NUM_CHANNELS][TRIGGER_MAX_CHUNK_FRAMES];
+    /** Set to 1 when triggered capture is running */
+    uint32_t isEnabled;
+
+} METIC_TRIGGER_INFO;
+
 /**
  * Structure to hold data for user handle.
  */
@@ -120,6 +514,17 @@ typedef struct
     int32_t wfsBuffer[WFS_BUFFER_SIZE];
     /** stores error status count */
     int32_t errorStatusCount[ERROR_COUNT_BUFFER_SIZE];
+    /** running statistics of outputs */
+    METIC_STATS_INFO stats;
+    /** harmonic analysis of waveform stream */
+    METIC_HARMONICS_INFO harmonics;
+    /** Goertzel bank of waveform stream */
+    METIC_GOERTZEL_INFO goertzel;
+    /** Time (usec) at which blocks of waveform stream were received, indexed by sequence modulo
+     * #WFS_STREAM_NUM_BLOCKS */
+    volatile uint32_t wfsBlockTime[WFS_STREAM_NUM_BLOCKS];
+    /** Triggered capture of waveform stream */
+    METIC_TRIGGER_INFO trigger;
 
 } METIC_INSTANCE_INFO;
 
@@ -254,6 +659,247 @@ ADI_METIC_STATUS MetIcIfClearAdcStatusError(METIC_INSTANCE_INFO *pInfo, int32_t
  */
 ADI_METIC_STATUS MetIcIfCollectSamples(METIC_INSTANCE_INFO *pInfo, int32_t config);
 
+/**
+ * @brief Function to configure Rx and start continuous streaming of WFS samples into wfsBuffer,
+ * split into #WFS_STREAM_NUM_BLOCKS blocks. Filled blocks are read by every consumer registered
+ * with #adi_metic_WfsRegisterConsumer, using #adi_metic_WfsGetConsumerBlock and
+ * #adi_metic_WfsReleaseConsumerBlock.
+ * @param[in] pInfo 		- User instance
+ * @param[in] config 		- configuration of WFS
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR \n
+ * #ADI_METIC_STATUS_WFS_UART_BAUDRATE_ERROR \n
+ * #ADI_METIC_STATUS_WFS_INVALID_STREAM_CONFIG \n
+ * #ADI_METIC_STATUS_WFS_UART_COMM_ERROR \n
+ * #ADI_METIC_STATUS_WFS_PREV_TRANSACTION_IN_PROGRESS \n
+ * #ADI_METIC_STATUS_WFS_DISABLED
+ *
+ */
+ADI_METIC_STATUS MetIcIfStartWfsStream(METIC_INSTANCE_INFO *pInfo, int32_t config);
+
+/**
+ * @brief Function to stop continuous streaming of WFS samples.
+ * @param[in] pInfo 		- User instance
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_NULL_PTR
+ *
+ */
+ADI_METIC_STATUS MetIcIfStopWfsStream(METIC_INSTANCE_INFO *pInfo);
+
+/**
+ * @brief Function to unregister a consumer of WFS continuous stream, so that it no longer holds
+ * blocks. Consumer id is cleared. Nothing is done if the id is 0.
+ * @param[in] pInfo 		- User instance
+ * @param[in,out] pConsumerId 	- Pointer to consumer id
+ * @returns #ADI_METIC_STATUS_SUCCESS \n
+ * #ADI_METIC_STATUS_WFS_INVALID_CONSUMER \n
+ * #ADI_METIC_STATUS_WFS_UART_COMM_ERROR
+ *
+ */
+ADI_METIC_STATUS MetIcIfStopWfsConsumer(METIC_INSTANCE_INFO *pInfo, uint32_t *pConsumerId);
+
+/**
+ * @brief Function to configure window lengths of running statistics and reset them.
+ * @param[in] pInfo 		- User instance
+ * @param[in] tumblingCycles 		- number of cycles in a tumbling window
+ * @param[in] slidingCycles 		- number of cycles in the sliding window. Limited to
+ * #STATS_MAX_SLIDING_WINDOW_CYCLES
+ *
+ */
+void MetIcIfConfigureStats(METIC_INSTANCE_INFO *pInfo, uint32_t tumblingCycles,
+                           uint32_t slidingCycles);
+
+/**
+ * @brief Function to clear running statistics of all channels. Window lengths are retained.
+ * @param[in] pInfo 		- User instance
+ *
+ */
+void MetIcIfResetStats(METIC_INSTANCE_INFO *pInfo);
+
+/**
+ * @brief Function to update running statistics with filtered rms, active power and power factor
+ * outputs of a cycle.
+ * @param[in] pInfo 		- User instance
+ * @param[in] pOutput 		- pointer to converted outputs of the cycle
+ * @param[in] timeStamp 		- time of IRQ0 (usec) of the cycle
+ *
+ */
+void MetIcIfUpdateStats(METIC_INSTANCE_INFO *pInfo, ADI_METIC_OUTPUT *pOutput,
+                        uint32_t timeStamp);
+
+/**
+ * @brief Function to get statistics of a channel over a window. If no tumbling window is
+ * completed yet, the tumbling window in progress is reported.
+ * @param[in] pInfo 		- User instance
+ * @param[in] window 		- window to report
+ * @param[in] channel 		- channel index. See #STATS_NUM_CHANNELS for the order.
+ * @param[out] pSummary 		- pointer to store statistics
+ * @returns 0 on success, 1 if window or channel is invalid
+ *
+ */
+int32_t MetIcIfGetStats(METIC_INSTANCE_INFO *pInfo, METIC_STATS_WINDOW window, uint32_t channel,
+                        METIC_STATS_SUMMARY *pSummary);
+
+/**
+ * @brief Function to configure harmonic analysis of channels of waveform stream. Windows of
+ * all channels are collected from the same frames. Waveform stream is to be started with
+ * #MetIcIfStartWfsStream after configuring.
+ * @param[in] pInfo 		- User instance
+ * @param[in] channelMask 		- mask of channel ids to analyse, up to
+ * #HARMONICS_MAX_NUM_CHANNELS channels
+ * @param[in] numCycles 		- number of line cycles in a window, 10 for 50 Hz and 12 for 60 Hz
+ * @param[in] frequency 		- nominal line frequency in Hz
+ * @returns 0 on success, 1 if channels, number of cycles or frequency is invalid
+ *
+ */
+int32_t MetIcIfConfigureHarmonics(METIC_INSTANCE_INFO *pInfo, uint32_t channelMask,
+                                  uint32_t numCycles, float frequency);
+
+/**
+ * @brief Function to update line frequency used to size harmonic analysis windows, so that a
+ * window holds an integer number of cycles. Frequencies out of range are ignored.
+ * @param[in] pInfo 		- User instance
+ * @param[in] frequency 		- measured line frequency in Hz
+ *
+ */
+void MetIcIfSetHarmonicsFrequency(METIC_INSTANCE_INFO *pInfo, float frequency);
+
+/**
+ * @brief Function to feed filled blocks of waveform stream to harmonic analysis. Blocks are
+ * validated, samples of the channels analysed are collected and harmonics of each channel are
+ * computed for every completed window. Blocks are released after processing.
+ * @param[in] pInfo 		- User instance
+ * @returns number of windows completed
+ *
+ */
+uint32_t MetIcIfProcessHarmonics(METIC_INSTANCE_INFO *pInfo);
+
+/**
+ * @brief Function to get number of samples needed in window for harmonic analysis at the
+ * configured cycles and frequency.
+ * @param[in] pHarmonics 		- pointer to harmonic analysis
+ * @returns number of samples
+ *
+ */
+uint32_t MetIcIfGetHarmonicsWindowSamples(METIC_HARMONICS_INFO *pHarmonics);
+
+/**
+ * @brief Function to compute harmonics of the samples in window of a channel. Window is
+ * resampled to #HARMONICS_FFT_SIZE points over the configured number of cycles, so that
+ * harmonic n falls on FFT bin n * numCycles, and transformed with an in place real FFT.
+ * Window should hold #MetIcIfGetHarmonicsWindowSamples samples.
+ * @param[in] pHarmonics 		- pointer to harmonic analysis
+ * @param[in] channelIndex 		- position of channel in channel list
+ *
+ */
+void MetIcIfComputeHarmonics(METIC_HARMONICS_INFO *pHarmonics, uint32_t channelIndex);
+
+/**
+ * @brief Function to set harmonic orders of Goertzel bins of a channel. Bins of other channels are
+ * kept. Takes effect at start of next window.
+ * @param[in] pInfo 		- User instance
+ * @param[in] channel 		- channel id
+ * @param[in] pOrders 		- harmonic orders of bins, fractional for interharmonics
+ * @param[in] numOrders 		- number of orders, 0 to remove bins of the channel
+ * @returns 0 on success, 1 if channel or an order is invalid
+ *
+ */
+int32_t MetIcIfSetGoertzelOrders(METIC_INSTANCE_INFO *pInfo, uint32_t channel, float *pOrders,
+                                 uint32_t numOrders);
+
+/**
+ * @brief Function to start Goertzel bank on channels with bins. Waveform stream is to be started
+ * with #MetIcIfStartWfsStream after configuring.
+ * @param[in] pInfo 		- User instance
+ * @param[in] numCycles 		- number of line cycles in a window
+ * @param[in] frequency 		- nominal line frequency in Hz
+ * @returns 0 on success, 1 if no channel has bins or number of cycles or frequency is invalid
+ *
+ */
+int32_t MetIcIfConfigureGoertzel(METIC_INSTANCE_INFO *pInfo, uint32_t numCycles,
+                                 float frequency);
+
+/**
+ * @brief Function to update line frequency used to size Goertzel windows from the measured
+ * period. Periods out of range are ignored.
+ * @param[in] pInfo 		- User instance
+ * @param[in] period 		- measured line period in seconds
+ *
+ */
+void MetIcIfSetGoertzelPeriod(METIC_INSTANCE_INFO *pInfo, float period);
+
+/**
+ * @brief Function to add a frame of samples to Goertzel bank. Cost is one multiply and two adds
+ * per bin of every sample.
+ * @param[in] pGoertzel 		- pointer to Goertzel bank
+ * @param[in] pFrame 		- samples indexed by channel id
+ * @returns 1 if a window was completed, 0 otherwise
+ *
+ */
+uint32_t MetIcIfUpdateGoertzel(METIC_GOERTZEL_INFO *pGoertzel, int32_t *pFrame);
+
+/**
+ * @brief Function to feed filled blocks of waveform stream to Goertzel bank. Blocks are validated
+ * #GOERTZEL_CHUNK_NUM_FRAMES frames at a time and released after processing.
+ * @param[in] pInfo 		- User instance
+ * @returns number of windows completed
+ *
+ */
+uint32_t MetIcIfProcessGoertzel(METIC_INSTANCE_INFO *pInfo);
+
+/**
+ * @brief Function to configure sources, levels and capture length of triggered capture.
+ * @param[in] pInfo 		- User instance
+ * @param[in] pConfig 		- pointer to configuration
+ * @returns 0 on success, 1 if capture is armed or sample channel is invalid
+ *
+ */
+int32_t MetIcIfConfigureTrigger(METIC_INSTANCE_INFO *pInfo, METIC_TRIGGER_CONFIG *pConfig);
+
+/**
+ * @brief Function to arm triggered capture. Pre-trigger history is collected from waveform stream
+ * and capture freezes once post-trigger frames are collected. Waveform stream of the channels is
+ * to be started with #MetIcIfStartWfsStream. Can be called again to re-arm while streaming.
+ * @param[in] pInfo 		- User instance
+ * @param[in] channelMask 		- bit mask of channel ids streamed
+ * @returns 0 on success, 1 if capture does not fit #TRIGGER_MAX_CAPTURE_SAMPLES
+ *
+ */
+int32_t MetIcIfArmTrigger(METIC_INSTANCE_INFO *pInfo, uint32_t channelMask);
+
+/**
+ * @brief Function to evaluate register sources of triggered capture at cycle rate. Fired sources
+ * are placed in waveform stream at the time of IRQ0 by #MetIcIfProcessTrigger.
+ * @param[in] pInfo 		- User instance
+ * @param[in] pOutput 		- pointer to converted outputs of the cycle
+ * @param[in] timeStamp 		- time of IRQ0 (usec) of the cycle
+ *
+ */
+void MetIcIfUpdateTrigger(METIC_INSTANCE_INFO *pInfo, ADI_METIC_OUTPUT *pOutput,
+                          uint32_t timeStamp);
+
+/**
+ * @brief Function to feed filled blocks of waveform stream to triggered capture. Blocks are
+ * validated #TRIGGER_CHUNK_NUM_FRAMES frames at a time, sample threshold is checked on every frame
+ * and blocks are released after processing.
+ * @param[in] pInfo 		- User instance
+ * @returns 1 if capture completed, 0 otherwise
+ *
+ */
+uint32_t MetIcIfProcessTrigger(METIC_INSTANCE_INFO *pInfo);
+
+/**
+ * @brief Function to read frames of a completed triggered capture.
+ * @param[in] pInfo 		- User instance
+ * @param[in] firstFrame 		- index of first frame from start of capture
+ * @param[in] numFrames 		- number of frames to read
+ * @param[out] pDst 		- pointer to store frames, channels in order of validator
+ * @returns number of frames read
+ *
+ */
+uint32_t MetIcIfReadTriggerCapture(METIC_INSTANCE_INFO *pInfo, uint32_t firstFrame,
+                                   uint32_t numFrames, int32_t *pDst);
+
 /**
  * @brief Suspends the (non os) thread by going into a wait state.
  * Times out if suspend state has not changed within timeout metioned in app_cfg.h file.
@@ -0,0 +1,343 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        metic_service_goertzel_interface.c
+ * @brief       Interface file for Goertzel bank of selected harmonics of waveform stream.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_metic.h"
+#include "metic_service_interface.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Converts radians to degrees */
+#define RAD_TO_DEG (180.0f / 3.14159265f)
+
+/**
+ * @brief Function to start a window. Window length is set from the line frequency and bins are
+ * tuned to an integer number of cycles in the window, so that harmonics do not leak into each
+ * other.
+ * @param[in] pGoertzel 		- pointer to Goertzel bank
+ *
+ */
+static void StartWindow(METIC_GOERTZEL_INFO *pGoertzel);
+
+/**
+ * @brief Function to compute magnitude and phase of bins of a channel at the end of a window.
+ * @param[in] pChannel 		- pointer to bins of channel
+ * @param[in] numSamples 		- number of samples in window
+ *
+ */
+static void EndWindow(METIC_GOERTZEL_CHANNEL *pChannel, uint32_t numSamples);
+
+/**
+ * @brief Function to get lowest channel id with bins. Windows are aligned to zero crossings of
+ * this channel.
+ * @param[in] pGoertzel 		- pointer to Goertzel bank
+ * @returns channel id
+ *
+ */
+static uint32_t GetReferenceChannel(METIC_GOERTZEL_INFO *pGoertzel);
+
+/*=============  C O D E  =============*/
+
+int32_t MetIcIfSetGoertzelOrders(METIC_INSTANCE_INFO *pInfo, uint32_t channel, float *pOrders,
+                                 uint32_t numOrders)
+{
+    int32_t status = 0;
+    uint32_t i;
+    METIC_GOERTZEL_INFO *pGoertzel = &pInfo->goertzel;
+
+    if ((channel >= ADI_METIC_MAX_NUM_CHANNELS) || (numOrders > GOERTZEL_MAX_NUM_BINS))
+    {
+        status = 1;
+    }
+    for (i = 0; (i < numOrders) && (status == 0); i++)
+    {
+        // Bins are to stay below half of the sampling rate at the highest line frequency.
+        if ((pOrders[i] <= 0) ||
+            (pOrders[i] * HARMONICS_MAX_FREQUENCY * 2.0f >= (float)HARMONICS_SAMPLING_RATE))
+        {
+            status = 1;
+        }
+    }
+    if (status == 0)
+    {
+        memcpy(&pGoertzel->channel[channel].order[0], pOrders, numOrders * sizeof(float));
+        pGoertzel->channel[channel].numBins = numOrders;
+        if (numOrders > 0)
+        {
+            pGoertzel->channelMask |= (1u << channel);
+        }
+        else
+        {
+            pGoertzel->channelMask &= ~(1u << channel);
+        }
+    }
+    return status;
+}
+
+int32_t MetIcIfConfigureGoertzel(METIC_INSTANCE_INFO *pInfo, uint32_t numCycles,
+                                 float frequency)
+{
+    int32_t status = 1;
+    uint32_t i;
+    METIC_GOERTZEL_INFO *pGoertzel = &pInfo->goertzel;
+
+    if ((pGoertzel->channelMask != 0) && (numCycles > 0) &&
+        (numCycles <= HARMONICS_MAX_NUM_CYCLES) && (frequency >= HARMONICS_MIN_FREQUENCY) &&
+        (frequency <= HARMONICS_MAX_FREQUENCY))
+    {
+        // Validator is initialised on first block, after waveform stream is configured.
+        memset(&pGoertzel->validator, 0, sizeof(ADI_METIC_WFS_VALIDATOR));
+        for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+        {
+            memset(&pGoertzel->channel[i].magnitude[0], 0, sizeof(pGoertzel->channel[i].magnitude));
+            memset(&pGoertzel->channel[i].phase[0], 0, sizeof(pGoertzel->channel[i].phase));
+        }
+        pGoertzel->numCycles = numCycles;
+        pGoertzel->frequency = frequency;
+        pGoertzel->windowFrequency = frequency;
+        pGoertzel->isAligned = 0;
+        pGoertzel->lastSample = 0;
+        pGoertzel->numWindows = 0;
+        StartWindow(pGoertzel);
+        pGoertzel->isEnabled = 1;
+        status = 0;
+    }
+    return status;
+}
+
+void MetIcIfSetGoertzelPeriod(METIC_INSTANCE_INFO *pInfo, float period)
+{
+    float frequency;
+
+    if (period > 0)
+    {
+        frequency = 1.0f / period;
+        if ((frequency >= HARMONICS_MIN_FREQUENCY) && (frequency <= HARMONICS_MAX_FREQUENCY))
+        {
+            pInfo->goertzel.frequency = frequency;
+        }
+    }
+}
+
+uint32_t MetIcIfUpdateGoertzel(METIC_GOERTZEL_INFO *pGoertzel, int32_t *pFrame)
+{
+    uint32_t isWindowComplete = 0;
+    uint32_t i;
+    uint32_t channel;
+    uint32_t referenceChannel = GetReferenceChannel(pGoertzel);
+    int32_t sample = pFrame[referenceChannel];
+    float x;
+    float s0;
+    METIC_GOERTZEL_CHANNEL *pChannel;
+
+    if (pGoertzel->isAligned == 0)
+    {
+        // First window starts at a rising zero crossing, so that phases are relative to the
+        // line cycle. Starts anyway if there is no crossing within a window.
+        if (((pGoertzel->lastSample < 0) && (sample >= 0)) ||
+            (pGoertzel->sampleIndex >= pGoertzel->windowNumSamples))
+        {
+            pGoertzel->isAligned = 1;
+            pGoertzel->sampleIndex = 0;
+        }
+        else
+        {
+            pGoertzel->sampleIndex++;
+        }
+        pGoertzel->lastSample = sample;
+    }
+    if (pGoertzel->isAligned == 1)
+    {
+        for (channel = referenceChannel; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+        {
+            pChannel = &pGoertzel->channel[channel];
+            if ((pGoertzel->channelMask & (1u << channel)) != 0)
+            {
+                x = (float)pFrame[channel];
+                for (i = 0; i < pChannel->numBins; i++)
+                {
+                    s0 = x + pChannel->coeff[i] * pChannel->s1[i] - pChannel->s2[i];
+                    pChannel->s2[i] = pChannel->s1[i];
+                    pChannel->s1[i] = s0;
+                }
+            }
+        }
+        pGoertzel->sampleIndex++;
+        if (pGoertzel->sampleIndex >= pGoertzel->windowNumSamples)
+        {
+            for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+            {
+                if ((pGoertzel->channelMask & (1u << channel)) != 0)
+                {
+                    EndWindow(&pGoertzel->channel[channel], pGoertzel->windowNumSamples);
+                }
+            }
+            pGoertzel->numWindows++;
+            StartWindow(pGoertzel);
+            isWindowComplete = 1;
+        }
+    }
+    return isWindowComplete;
+}
+
+uint32_t MetIcIfProcessGoertzel(METIC_INSTANCE_INFO *pInfo)
+{
+    uint32_t numWindows = 0;
+    uint32_t i;
+    uint32_t channel;
+    uint32_t pos;
+    uint32_t numChunkBytes;
+    int32_t frame[ADI_METIC_MAX_NUM_CHANNELS] = {0};
+    ADI_METIC_STATUS adeStatus = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_BLOCK block;
+    ADI_METIC_WFS_BLOCK chunk;
+    ADI_METIC_WFS_UNPACK_CONFIG unpackConfig;
+    ADI_METIC_WFS_BLOCK_QUALITY quality;
+    METIC_GOERTZEL_INFO *pGoertzel = &pInfo->goertzel;
+
+    if ((pGoertzel->isEnabled == 1) && (pGoertzel->consumerId == 0))
+    {
+        // Blocks are skipped if the bank falls behind, as windows restart after a gap.
+        adeStatus = adi_metic_WfsRegisterConsumer(pInfo->hAde, ADI_METIC_WFS_CONSUMER_SKIP,
+                                                  &pGoertzel->consumerId);
+    }
+    if ((pGoertzel->isEnabled == 1) && (adeStatus == ADI_METIC_STATUS_SUCCESS) &&
+        (pGoertzel->validator.numChannels == 0))
+    {
+        // Stream starts with lowest channel enabled.
+        adeStatus = adi_metic_WfsValidatorInit(pInfo->hAde, &pGoertzel->validator,
+                                               (int32_t)GetReferenceChannel(pGoertzel),
+                                               ADI_METIC_WFS_GAP_FILL_LINEAR);
+    }
+    memset(&unpackConfig, 0, sizeof(ADI_METIC_WFS_UNPACK_CONFIG));
+    unpackConfig.format = ADI_METIC_WFS_FORMAT_INT32;
+    unpackConfig.maxSamples = GOERTZEL_MAX_CHUNK_FRAMES;
+    for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+    {
+        if ((pGoertzel->channelMask & (1u << channel)) != 0)
+        {
+            unpackConfig.pDst[channel] = &pGoertzel->chunk[channel][0];
+        }
+    }
+    numChunkBytes = GOERTZEL_CHUNK_NUM_FRAMES * pGoertzel->validator.numChannels * sizeof(int32_t);
+    while ((pGoertzel->isEnabled == 1) && (adeStatus == ADI_METIC_STATUS_SUCCESS) &&
+           (adi_metic_WfsGetConsumerBlock(pInfo->hAde, pGoertzel->consumerId, &block) ==
+            ADI_METIC_STATUS_SUCCESS))
+    {
+        // Block is validated in chunks, so that samples of channels fit in a small buffer.
+        // Validator carries partial frames from one chunk to the next.
+        chunk = block;
+        if (block.isGapBefore == 1)
+        {
+            // Samples were lost, window restarts at next zero crossing.
+            pGoertzel->isAligned = 0;
+            StartWindow(pGoertzel);
+        }
+        for (pos = 0; pos < block.numBytes; pos += numChunkBytes)
+        {
+            chunk.pSamples = block.pSamples + pos;
+            chunk.numBytes = block.numBytes - pos;
+            if (chunk.numBytes > numChunkBytes)
+            {
+                chunk.numBytes = numChunkBytes;
+            }
+            chunk.isGapBefore = (pos == 0) ? block.isGapBefore : 0;
+            adi_metic_WfsValidateBlock(pInfo->hAde, &pGoertzel->validator, &chunk, &unpackConfig,
+                                       &quality);
+            for (i = 0; i < quality.numFrames; i++)
+            {
+                if ((quality.numDiscontinuities > 0) && (i == quality.discontinuityFrame))
+                {
+                    // Loss too long to fill, window restarts at next zero crossing.
+                    pGoertzel->isAligned = 0;
+                    StartWindow(pGoertzel);
+                }
+                for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+                {
+                    frame[channel] = pGoertzel->chunk[channel][i];
+                }
+                numWindows += MetIcIfUpdateGoertzel(pGoertzel, &frame[0]);
+            }
+        }
+        adeStatus = adi_metic_WfsReleaseConsumerBlock(pInfo->hAde, pGoertzel->consumerId);
+    }
+    return numWindows;
+}
+
+void StartWindow(METIC_GOERTZEL_INFO *pGoertzel)
+{
+    uint32_t i;
+    uint32_t channel;
+    uint32_t bin;
+    float angle;
+    METIC_GOERTZEL_CHANNEL *pChannel;
+
+    pGoertzel->windowFrequency = pGoertzel->frequency;
+    pGoertzel->windowNumSamples = (uint32_t)((float)pGoertzel->numCycles *
+                                                 (float)HARMONICS_SAMPLING_RATE /
+                                                 pGoertzel->frequency +
+                                             0.5f);
+    pGoertzel->sampleIndex = 0;
+    for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+    {
+        pChannel = &pGoertzel->channel[channel];
+        for (i = 0; i < pChannel->numBins; i++)
+        {
+            // Bins are spaced by 1 / window length. Harmonic n is at bin n * numCycles.
+            bin = (uint32_t)(pChannel->order[i] * (float)pGoertzel->numCycles + 0.5f);
+            angle = 2.0f * 3.14159265f * (float)bin / (float)pGoertzel->windowNumSamples;
+            pChannel->cosine[i] = cosf(angle);
+            pChannel->sine[i] = sinf(angle);
+            pChannel->coeff[i] = 2.0f * pChannel->cosine[i];
+            pChannel->s1[i] = 0;
+            pChannel->s2[i] = 0;
+        }
+    }
+}
+
+void EndWindow(METIC_GOERTZEL_CHANNEL *pChannel, uint32_t numSamples)
+{
+    uint32_t i;
+    float real;
+    float imag;
+
+    for (i = 0; i < pChannel->numBins; i++)
+    {
+        // DFT of bin with an integer number of cycles in window.
+        real = pChannel->cosine[i] * pChannel->s1[i] - pChannel->s2[i];
+        imag = pChannel->sine[i] * pChannel->s1[i];
+        pChannel->magnitude[i] =
+            sqrtf(real * real + imag * imag) * 1.41421356f / (float)numSamples;
+        // Phase of sine component.
+        pChannel->phase[i] = atan2f(imag, real) * RAD_TO_DEG + 90.0f;
+        if (pChannel->phase[i] > 180.0f)
+        {
+            pChannel->phase[i] -= 360.0f;
+        }
+    }
+}
+
+uint32_t GetReferenceChannel(METIC_GOERTZEL_INFO *pGoertzel)
+{
+    uint32_t channel = 0;
+
+    while ((channel < ADI_METIC_MAX_NUM_CHANNELS - 1) &&
+           ((pGoertzel->channelMask & (1u << channel)) == 0))
+    {
+        channel++;
+    }
+    return channel;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,750 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        metic_service_harmonics_interface.c
+ * @brief       Interface file for harmonic analysis of waveform stream with a real FFT.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_metic.h"
+#include "metic_service_interface.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Number of points of complex FFT. Real FFT is computed with a complex FFT of half size */
+#define HARMONICS_NUM_COMPLEX (HARMONICS_FFT_SIZE / 2)
+/** Number of entries in a quarter wave of sine table */
+#define QUARTER_WAVE_SIZE (HARMONICS_FFT_SIZE / 4)
+/** Number of samples needed after the window for cubic interpolation */
+#define INTERPOLATION_NUM_SAMPLES 3
+/** Converts radians to degrees */
+#define RAD_TO_DEG (180.0f / 3.14159265f)
+#if HARMONICS_FIXED_POINT == 1
+/** Fractional bits of sine table */
+#define TWIDDLE_FRAC_BITS 30
+/** Left shift of 24 bit samples into FFT buffer. Leaves headroom for interpolation overshoot */
+#define SAMPLE_SHIFT 5
+/** Fractional bits of resampling position */
+#define POSITION_FRAC_BITS 16
+
+/** FFT data type */
+typedef int32_t FFT_DATA;
+#else
+/** FFT data type */
+typedef float FFT_DATA;
+#endif
+
+/**
+ * Sine of a quarter wave, sin(2 * pi * i / #HARMONICS_FFT_SIZE). Twiddles of all angles are
+ * derived from it by symmetry.
+ */
+#if HARMONICS_FIXED_POINT == 1
+static const int32_t sineTable[QUARTER_WAVE_SIZE + 1] = {
+    0, 6588356, 13176464, 19764076, 26350943, 32936819, 39521455, 46104602, 52686014, 59265442,
+    65842639, 72417357, 78989349, 85558366, 92124163, 98686491, 105245103, 111799753, 118350194,
+    124896179, 131437462, 137973796, 144504935, 151030634, 157550647, 164064728, 170572633,
+    177074115, 183568930, 190056834, 196537583, 203010932, 209476638, 215934457, 222384147,
+    228825464, 235258165, 241682010, 248096755, 254502159, 260897982, 267283981, 273659918,
+    280025552, 286380643, 292724951, 299058239, 305380268, 311690799, 317989595, 324276419,
+    330551034, 336813204, 343062693, 349299266, 355522689, 361732726, 367929144, 374111709,
+    380280190, 386434353, 392573967, 398698801, 404808624, 410903207, 416982319, 423045732,
+    429093217, 435124548, 441139496, 447137835, 453119340, 459083786, 465030947, 470960600,
+    476872522, 482766489, 488642281, 494499676, 500338453, 506158392, 511959275, 517740883,
+    523502998, 529245404, 534967884, 540670223, 546352205, 552013618, 557654248, 563273883,
+    568872310, 574449320, 580004702, 585538248, 591049748, 596538995, 602005783, 607449906,
+    612871159, 618269338, 623644239, 628995660, 634323400, 639627258, 644907034, 650162530,
+    655393548, 660599890, 665781362, 670937767, 676068911, 681174602, 686254647, 691308855,
+    696337036, 701339000, 706314559, 711263525, 716185713, 721080937, 725949013, 730789757,
+    735602987, 740388522, 745146182, 749875788, 754577161, 759250125, 763894504, 768510122,
+    773096806, 777654384, 782182683, 786681534, 791150767, 795590213, 799999706, 804379079,
+    808728167, 813046808, 817334838, 821592095, 825818421, 830013654, 834177638, 838310216,
+    842411232, 846480531, 850517961, 854523370, 858496606, 862437520, 866345964, 870221790,
+    874064853, 877875009, 881652112, 885396022, 889106597, 892783698, 896427186, 900036924,
+    903612776, 907154608, 910662286, 914135678, 917574653, 920979082, 924348837, 927683790,
+    930983817, 934248793, 937478595, 940673101, 943832191, 946955747, 950043650, 953095785,
+    956112036, 959092290, 962036435, 964944360, 967815955, 970651112, 973449725, 976211688,
+    978936898, 981625251, 984276646, 986890984, 989468165, 992008094, 994510675, 996975812,
+    999403415, 1001793390, 1004145648, 1006460100, 1008736660, 1010975242, 1013175761, 1015338134,
+    1017462281, 1019548121, 1021595575, 1023604567, 1025575020, 1027506862, 1029400018, 1031254418,
+    1033069992, 1034846671, 1036584389, 1038283080, 1039942680, 1041563127, 1043144360, 1044686319,
+    1046188946, 1047652185, 1049075980, 1050460278, 1051805027, 1053110176, 1054375676, 1055601479,
+    1056787540, 1057933813, 1059040255, 1060106826, 1061133483, 1062120190, 1063066909, 1063973603,
+    1064840240, 1065666786, 1066453210, 1067199483, 1067905576, 1068571464, 1069197120, 1069782521,
+    1070327646, 1070832474, 1071296985, 1071721163, 1072104991, 1072448455, 1072751542, 1073014240,
+    1073236540, 1073418433, 1073559913, 1073660973, 1073721611, 1073741824
+};
+#else
+static const float sineTable[QUARTER_WAVE_SIZE + 1] = {
+    0.000000000f, 0.006135885f, 0.012271538f, 0.018406730f, 0.024541229f, 0.030674803f,
+    0.036807223f, 0.042938257f, 0.049067674f, 0.055195244f, 0.061320736f, 0.067443920f,
+    0.073564564f, 0.079682438f, 0.085797312f, 0.091908956f, 0.098017140f, 0.104121634f,
+    0.110222207f, 0.116318631f, 0.122410675f, 0.128498111f, 0.134580709f, 0.140658239f,
+    0.146730474f, 0.152797185f, 0.158858143f, 0.164913120f, 0.170961889f, 0.177004220f,
+    0.183039888f, 0.189068664f, 0.195090322f, 0.201104635f, 0.207111376f, 0.213110320f,
+    0.219101240f, 0.225083911f, 0.231058108f, 0.237023606f, 0.242980180f, 0.248927606f,
+    0.254865660f, 0.260794118f, 0.266712757f, 0.272621355f, 0.278519689f, 0.284407537f,
+    0.290284677f, 0.296150888f, 0.302005949f, 0.307849640f, 0.313681740f, 0.319502031f,
+    0.325310292f, 0.331106306f, 0.336889853f, 0.342660717f, 0.348418680f, 0.354163525f,
+    0.359895037f, 0.365612998f, 0.371317194f, 0.377007410f, 0.382683432f, 0.388345047f,
+    0.393992040f, 0.399624200f, 0.405241314f, 0.410843171f, 0.416429560f, 0.422000271f,
+    0.427555093f, 0.433093819f, 0.438616239f, 0.444122145f, 0.449611330f, 0.455083587f,
+    0.460538711f, 0.465976496f, 0.471396737f, 0.476799230f, 0.482183772f, 0.487550160f,
+    0.492898192f, 0.498227667f, 0.503538384f, 0.508830143f, 0.514102744f, 0.519355990f,
+    0.524589683f, 0.529803625f, 0.534997620f, 0.540171473f, 0.545324988f, 0.550457973f,
+    0.555570233f, 0.560661576f, 0.565731811f, 0.570780746f, 0.575808191f, 0.580813958f,
+    0.585797857f, 0.590759702f, 0.595699304f, 0.600616479f, 0.605511041f, 0.610382806f,
+    0.615231591f, 0.620057212f, 0.624859488f, 0.629638239f, 0.634393284f, 0.639124445f,
+    0.643831543f, 0.648514401f, 0.653172843f, 0.657806693f, 0.662415778f, 0.666999922f,
+    0.671558955f, 0.676092704f, 0.680600998f, 0.685083668f, 0.689540545f, 0.693971461f,
+    0.698376249f, 0.702754744f, 0.707106781f, 0.711432196f, 0.715730825f, 0.720002508f,
+    0.724247083f, 0.728464390f, 0.732654272f, 0.736816569f, 0.740951125f, 0.745057785f,
+    0.749136395f, 0.753186799f, 0.757208847f, 0.761202385f, 0.765167266f, 0.769103338f,
+    0.773010453f, 0.776888466f, 0.780737229f, 0.784556597f, 0.788346428f, 0.792106577f,
+    0.795836905f, 0.799537269f, 0.803207531f, 0.806847554f, 0.810457198f, 0.814036330f,
+    0.817584813f, 0.821102515f, 0.824589303f, 0.828045045f, 0.831469612f, 0.834862875f,
+    0.838224706f, 0.841554977f, 0.844853565f, 0.848120345f, 0.851355193f, 0.854557988f,
+    0.857728610f, 0.860866939f, 0.863972856f, 0.867046246f, 0.870086991f, 0.873094978f,
+    0.876070094f, 0.879012226f, 0.881921264f, 0.884797098f, 0.887639620f, 0.890448723f,
+    0.893224301f, 0.895966250f, 0.898674466f, 0.901348847f, 0.903989293f, 0.906595705f,
+    0.909167983f, 0.911706032f, 0.914209756f, 0.916679060f, 0.919113852f, 0.921514039f,
+    0.923879533f, 0.926210242f, 0.928506080f, 0.930766961f, 0.932992799f, 0.935183510f,
+    0.937339012f, 0.939459224f, 0.941544065f, 0.943593458f, 0.945607325f, 0.947585591f,
+    0.949528181f, 0.951435021f, 0.953306040f, 0.955141168f, 0.956940336f, 0.958703475f,
+    0.960430519f, 0.962121404f, 0.963776066f, 0.965394442f, 0.966976471f, 0.968522094f,
+    0.970031253f, 0.971503891f, 0.972939952f, 0.974339383f, 0.975702130f, 0.977028143f,
+    0.978317371f, 0.979569766f, 0.980785280f, 0.981963869f, 0.983105487f, 0.984210092f,
+    0.985277642f, 0.986308097f, 0.987301418f, 0.988257568f, 0.989176510f, 0.990058210f,
+    0.990902635f, 0.991709754f, 0.992479535f, 0.993211949f, 0.993906970f, 0.994564571f,
+    0.995184727f, 0.995767414f, 0.996312612f, 0.996820299f, 0.997290457f, 0.997723067f,
+    0.998118113f, 0.998475581f, 0.998795456f, 0.999077728f, 0.999322385f, 0.999529418f,
+    0.999698819f, 0.999830582f, 0.999924702f, 0.999981175f, 1.000000000f
+};
+#endif
+
+/**
+ * @brief Function to get sine of an angle from the quarter wave table.
+ * @param[in] index 		- angle in units of 2 * pi / #HARMONICS_FFT_SIZE
+ * @returns sine of angle
+ *
+ */
+static FFT_DATA GetSine(uint32_t index);
+
+/**
+ * @brief Function to get cosine of an angle from the quarter wave table.
+ * @param[in] index 		- angle in units of 2 * pi / #HARMONICS_FFT_SIZE
+ * @returns cosine of angle
+ *
+ */
+static FFT_DATA GetCosine(uint32_t index);
+
+/**
+ * @brief Function to resample a window of length samples to #HARMONICS_FFT_SIZE points in FFT
+ * buffer with cubic interpolation. Window starts at phase of window after first sample.
+ * @param[in] pHarmonics 		- pointer to harmonic analysis
+ * @param[in] pWindow 		- pointer to samples of window of a channel
+ * @param[in] length 		- length of window in samples, may be fractional
+ *
+ */
+static void ResampleWindow(METIC_HARMONICS_INFO *pHarmonics, const int32_t *pWindow,
+                           float length);
+
+/**
+ * @brief Function to compute in place complex FFT of #HARMONICS_NUM_COMPLEX interleaved points.
+ * Pairs of radix-2 stages are merged into radix-4 butterflies.
+ * @param[in] pData 		- pointer to interleaved real and imaginary parts
+ *
+ */
+static void ComputeComplexFft(FFT_DATA *pData);
+
+/**
+ * @brief Function to reorder points of complex FFT in bit reversed order.
+ * @param[in] pData 		- pointer to interleaved real and imaginary parts
+ *
+ */
+static void ReorderBitReversed(FFT_DATA *pData);
+
+/**
+ * @brief Function to get a bin of the real FFT from the half size complex FFT.
+ * @param[in] pData 		- pointer to complex FFT output
+ * @param[in] bin 		- bin index, less than #HARMONICS_NUM_COMPLEX
+ * @param[out] pReal 		- real part of bin
+ * @param[out] pImag 		- imaginary part of bin
+ *
+ */
+static void GetRealFftBin(FFT_DATA *pData, uint32_t bin, float *pReal, float *pImag);
+
+/**
+ * @brief Function to get gain of cubic interpolation at a frequency. Interpolation attenuates
+ * harmonics close to half of the sampling rate, magnitudes are corrected with this gain.
+ * @param[in] frequency 		- frequency in Hz
+ * @returns gain of interpolation
+ *
+ */
+static float GetInterpolationGain(float frequency);
+
+/**
+ * @brief Function to get length of window in samples for configured cycles and frequency.
+ * @param[in] pHarmonics 		- pointer to harmonic analysis
+ * @returns length of window in samples
+ *
+ */
+static float GetWindowLength(METIC_HARMONICS_INFO *pHarmonics);
+
+/**
+ * @brief Function to check if a window of any phase fits in window buffer.
+ * @param[in] numCycles 		- number of cycles in a window
+ * @param[in] frequency 		- line frequency in Hz
+ * @returns 1 if window fits
+ *
+ */
+static uint32_t IsWindowFitting(uint32_t numCycles, float frequency);
+
+/*=============  C O D E  =============*/
+
+int32_t MetIcIfConfigureHarmonics(METIC_INSTANCE_INFO *pInfo, uint32_t channelMask,
+                                  uint32_t numCycles, float frequency)
+{
+    int32_t status = 1;
+    uint32_t channel;
+    uint32_t numChannels = 0;
+    METIC_HARMONICS_INFO *pHarmonics = &pInfo->harmonics;
+
+    for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+    {
+        if ((channelMask & (1u << channel)) != 0)
+        {
+            numChannels++;
+        }
+    }
+    if ((numChannels > 0) && (numChannels <= HARMONICS_MAX_NUM_CHANNELS) &&
+        ((channelMask >> ADI_METIC_MAX_NUM_CHANNELS) == 0) && (numCycles > 0) &&
+        (numCycles <= HARMONICS_MAX_NUM_CYCLES) && (frequency >= HARMONICS_MIN_FREQUENCY) &&
+        (frequency <= HARMONICS_MAX_FREQUENCY) && (IsWindowFitting(numCycles, frequency) == 1))
+    {
+        // Validator is initialised on first block, after waveform stream is configured.
+        memset(&pHarmonics->validator, 0, sizeof(ADI_METIC_WFS_VALIDATOR));
+        memset(&pHarmonics->result[0], 0, sizeof(pHarmonics->result));
+        pHarmonics->numChannels = 0;
+        for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+        {
+            if ((channelMask & (1u << channel)) != 0)
+            {
+                pHarmonics->channel[pHarmonics->numChannels] = channel;
+                pHarmonics->numChannels++;
+            }
+        }
+        pHarmonics->channelMask = channelMask;
+        pHarmonics->numCycles = numCycles;
+        pHarmonics->frequency = frequency;
+        pHarmonics->numSamples = 0;
+        pHarmonics->windowPhase = 0;
+        pHarmonics->numWindows = 0;
+        pHarmonics->isEnabled = 1;
+        status = 0;
+    }
+    return status;
+}
+
+void MetIcIfSetHarmonicsFrequency(METIC_INSTANCE_INFO *pInfo, float frequency)
+{
+    // Frequency which makes windows longer than window buffer is not followed.
+    if ((frequency >= HARMONICS_MIN_FREQUENCY) && (frequency <= HARMONICS_MAX_FREQUENCY) &&
+        (IsWindowFitting(pInfo->harmonics.numCycles, frequency) == 1))
+    {
+        pInfo->harmonics.frequency = frequency;
+    }
+}
+
+uint32_t MetIcIfProcessHarmonics(METIC_INSTANCE_INFO *pInfo)
+{
+    uint32_t i;
+    uint32_t numWindows = 0;
+    uint32_t numWindowSamples;
+    uint32_t numConsumed;
+    float windowEnd;
+    ADI_METIC_STATUS adeStatus = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_BLOCK block;
+    ADI_METIC_WFS_UNPACK_CONFIG unpackConfig;
+    ADI_METIC_WFS_BLOCK_QUALITY quality;
+    METIC_HARMONICS_INFO *pHarmonics = &pInfo->harmonics;
+
+    if ((pHarmonics->isEnabled == 1) && (pHarmonics->consumerId == 0))
+    {
+        // Blocks are skipped if analysis falls behind, as windows restart after a gap.
+        adeStatus = adi_metic_WfsRegisterConsumer(pInfo->hAde, ADI_METIC_WFS_CONSUMER_SKIP,
+                                                  &pHarmonics->consumerId);
+    }
+    if ((pHarmonics->isEnabled == 1) && (adeStatus == ADI_METIC_STATUS_SUCCESS) &&
+        (pHarmonics->validator.numChannels == 0))
+    {
+        // Frames are validated starting from the lowest channel analysed.
+        adeStatus = adi_metic_WfsValidatorInit(pInfo->hAde, &pHarmonics->validator,
+                                               (int32_t)pHarmonics->channel[0],
+                                               ADI_METIC_WFS_GAP_FILL_LINEAR);
+    }
+    while ((pHarmonics->isEnabled == 1) && (adeStatus == ADI_METIC_STATUS_SUCCESS) &&
+           (adi_metic_WfsGetConsumerBlock(pInfo->hAde, pHarmonics->consumerId, &block) ==
+            ADI_METIC_STATUS_SUCCESS))
+    {
+        // Samples of the channels are written after the samples collected. Frames which do not
+        // fit are dropped, so next window starts after a gap.
+        memset(&unpackConfig, 0, sizeof(ADI_METIC_WFS_UNPACK_CONFIG));
+        unpackConfig.format = ADI_METIC_WFS_FORMAT_INT32;
+        for (i = 0; i < pHarmonics->numChannels; i++)
+        {
+            unpackConfig.pDst[pHarmonics->channel[i]] =
+                &pHarmonics->window[i][pHarmonics->numSamples];
+        }
+        unpackConfig.maxSamples = HARMONICS_MAX_WINDOW_SAMPLES - pHarmonics->numSamples;
+        adi_metic_WfsValidateBlock(pInfo->hAde, &pHarmonics->validator, &block, &unpackConfig,
+                                   &quality);
+        adeStatus = adi_metic_WfsReleaseConsumerBlock(pInfo->hAde, pHarmonics->consumerId);
+        pHarmonics->numSamples += quality.numFrames;
+
+        numWindowSamples = MetIcIfGetHarmonicsWindowSamples(pHarmonics);
+        while (pHarmonics->numSamples >= numWindowSamples)
+        {
+            // Next window starts where this one ends, fraction of a sample is carried as phase.
+            windowEnd = pHarmonics->windowPhase + GetWindowLength(pHarmonics);
+            numConsumed = (uint32_t)windowEnd;
+            pHarmonics->numSamples -= numConsumed;
+            for (i = 0; i < pHarmonics->numChannels; i++)
+            {
+                MetIcIfComputeHarmonics(pHarmonics, i);
+                memmove(&pHarmonics->window[i][0], &pHarmonics->window[i][numConsumed],
+                        pHarmonics->numSamples * sizeof(int32_t));
+            }
+            pHarmonics->windowPhase = windowEnd - (float)numConsumed;
+            pHarmonics->numWindows++;
+            numWindows++;
+            numWindowSamples = MetIcIfGetHarmonicsWindowSamples(pHarmonics);
+        }
+    }
+    return numWindows;
+}
+
+uint32_t MetIcIfGetHarmonicsWindowSamples(METIC_HARMONICS_INFO *pHarmonics)
+{
+    return (uint32_t)(pHarmonics->windowPhase + GetWindowLength(pHarmonics)) +
+           INTERPOLATION_NUM_SAMPLES;
+}
+
+void MetIcIfComputeHarmonics(METIC_HARMONICS_INFO *pHarmonics, uint32_t channelIndex)
+{
+    uint32_t i;
+    uint32_t numHarmonics;
+    float real;
+    float imag;
+    float phase;
+    float fundamentalPhase = 0;
+    float distortion = 0;
+    float length = GetWindowLength(pHarmonics);
+    METIC_HARMONICS_RESULT *pResult = &pHarmonics->result[channelIndex];
+
+    ResampleWindow(pHarmonics, &pHarmonics->window[channelIndex][0], length);
+    ComputeComplexFft(&pHarmonics->fft[0]);
+
+    // Harmonic n is at bin n * numCycles. Bins above half of the sampling rate carry no signal.
+    numHarmonics = (HARMONICS_NUM_COMPLEX - 1) / pHarmonics->numCycles;
+    if (numHarmonics > HARMONICS_MAX_ORDER)
+    {
+        numHarmonics = HARMONICS_MAX_ORDER;
+    }
+    while ((float)numHarmonics * pHarmonics->frequency * 2.0f >= (float)HARMONICS_SAMPLING_RATE)
+    {
+        numHarmonics--;
+    }
+    memset(pResult, 0, sizeof(METIC_HARMONICS_RESULT));
+    pResult->numHarmonics = numHarmonics;
+    pResult->frequency = pHarmonics->frequency;
+
+    GetRealFftBin(&pHarmonics->fft[0], 0, &real, &imag);
+    pResult->magnitude[0] = real / (float)HARMONICS_FFT_SIZE;
+    for (i = 1; i <= numHarmonics; i++)
+    {
+        GetRealFftBin(&pHarmonics->fft[0], i * pHarmonics->numCycles, &real, &imag);
+        // Rms of a sine of peak amplitude A is A / sqrt(2), bin holds A * N / 2.
+        pResult->magnitude[i] = sqrtf(real * real + imag * imag) * 1.41421356f /
+                                ((float)HARMONICS_FFT_SIZE *
+                                 GetInterpolationGain((float)i * pHarmonics->frequency));
+        // Phase of sine component, bin holds phase of cosine component.
+        phase = atan2f(imag, real) * RAD_TO_DEG + 90.0f;
+        if (i == 1)
+        {
+            fundamentalPhase = phase;
+        }
+        else
+        {
+            distortion += pResult->magnitude[i] * pResult->magnitude[i];
+        }
+        phase = fmodf(phase - (float)i * fundamentalPhase, 360.0f);
+        if (phase > 180.0f)
+        {
+            phase -= 360.0f;
+        }
+        else if (phase <= -180.0f)
+        {
+            phase += 360.0f;
+        }
+        pResult->phase[i] = phase;
+    }
+    if (pResult->magnitude[1] > 0)
+    {
+        pResult->thd = sqrtf(distortion) * 100.0f / pResult->magnitude[1];
+    }
+}
+
+float GetWindowLength(METIC_HARMONICS_INFO *pHarmonics)
+{
+    return (float)pHarmonics->numCycles * (float)HARMONICS_SAMPLING_RATE / pHarmonics->frequency;
+}
+
+uint32_t IsWindowFitting(uint32_t numCycles, float frequency)
+{
+    uint32_t isFitting = 0;
+    float length = (float)numCycles * (float)HARMONICS_SAMPLING_RATE / frequency;
+
+    // Phase adds up to a sample to the window.
+    if ((uint32_t)length + 1 + INTERPOLATION_NUM_SAMPLES <= HARMONICS_MAX_WINDOW_SAMPLES)
+    {
+        isFitting = 1;
+    }
+    return isFitting;
+}
+
+float GetInterpolationGain(float frequency)
+{
+    float halfAngle = 3.14159265f * frequency / (float)HARMONICS_SAMPLING_RATE;
+    float sinc = sinf(halfAngle) / halfAngle;
+
+    // Fourier transform of Catmull-Rom kernel.
+    return sinc * sinc * sinc * (3.0f * sinc - 2.0f * cosf(halfAngle));
+}
+
+FFT_DATA GetSine(uint32_t index)
+{
+    FFT_DATA value;
+    uint32_t position = index % QUARTER_WAVE_SIZE;
+
+    switch ((index / QUARTER_WAVE_SIZE) & 3)
+    {
+    case 0:
+        value = sineTable[position];
+        break;
+    case 1:
+        value = sineTable[QUARTER_WAVE_SIZE - position];
+        break;
+    case 2:
+        value = -sineTable[position];
+        break;
+    default:
+        value = -sineTable[QUARTER_WAVE_SIZE - position];
+        break;
+    }
+    return value;
+}
+
+FFT_DATA GetCosine(uint32_t index)
+{
+    return GetSine(index + QUARTER_WAVE_SIZE);
+}
+
+void ReorderBitReversed(FFT_DATA *pData)
+{
+    uint32_t i;
+    uint32_t j = 0;
+    uint32_t k;
+    FFT_DATA temp;
+
+    for (i = 0; i < HARMONICS_NUM_COMPLEX - 1; i++)
+    {
+        if (i < j)
+        {
+            temp = pData[2 * i];
+            pData[2 * i] = pData[2 * j];
+            pData[2 * j] = temp;
+            temp = pData[2 * i + 1];
+            pData[2 * i + 1] = pData[2 * j + 1];
+            pData[2 * j + 1] = temp;
+        }
+        k = HARMONICS_NUM_COMPLEX >> 1;
+        while (k <= j)
+        {
+            j -= k;
+            k >>= 1;
+        }
+        j += k;
+    }
+}
+
+#if HARMONICS_FIXED_POINT == 1
+
+void ResampleWindow(METIC_HARMONICS_INFO *pHarmonics, const int32_t *pWindow, float length)
+{
+    uint32_t n;
+    uint32_t index;
+    int64_t mu;
+    int64_t y0;
+    int64_t y1;
+    int64_t y2;
+    int64_t y3;
+    int64_t a;
+    int64_t b;
+    int64_t c;
+    uint32_t position = (uint32_t)(pHarmonics->windowPhase * (float)(1 << POSITION_FRAC_BITS));
+    uint32_t step = (uint32_t)(length * (float)(1 << POSITION_FRAC_BITS) / HARMONICS_FFT_SIZE);
+
+    for (n = 0; n < HARMONICS_FFT_SIZE; n++)
+    {
+        index = position >> POSITION_FRAC_BITS;
+        mu = position & ((1 << POSITION_FRAC_BITS) - 1);
+        y0 = (index == 0) ? pWindow[0] : pWindow[index - 1];
+        y1 = pWindow[index];
+        y2 = pWindow[index + 1];
+        y3 = pWindow[index + 2];
+        // Catmull-Rom spline with coefficients doubled to stay in integers.
+        a = -y0 + 3 * y1 - 3 * y2 + y3;
+        b = 2 * y0 - 5 * y1 + 4 * y2 - y3;
+        c = y2 - y0;
+        b += (a * mu) >> POSITION_FRAC_BITS;
+        c += (b * mu) >> POSITION_FRAC_BITS;
+        c = (c * mu) << SAMPLE_SHIFT;
+        pHarmonics->fft[n] = (int32_t)((y1 << SAMPLE_SHIFT) + (c >> (POSITION_FRAC_BITS + 1)));
+        position += step;
+    }
+}
+
+void ComputeComplexFft(FFT_DATA *pData)
+{
+    uint32_t half = 1;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    int64_t w1Real;
+    int64_t w1Imag;
+    int64_t w2Real;
+    int64_t w2Imag;
+    int32_t *p0;
+    int32_t *p1;
+    int32_t *p2;
+    int32_t *p3;
+    int32_t tReal;
+    int32_t tImag;
+    int32_t b0Real, b0Imag, b1Real, b1Imag, b2Real, b2Imag, b3Real, b3Imag;
+
+    ReorderBitReversed(pData);
+    // Every butterfly halves its outputs, so that FFT of N points is scaled by 1 / N.
+    if ((HARMONICS_NUM_COMPLEX & 0xAAAAAAAAu) != 0)
+    {
+        // Odd number of radix-2 stages, first stage is done alone.
+        for (i = 0; i < 2 * HARMONICS_NUM_COMPLEX; i += 4)
+        {
+            tReal = pData[i + 2];
+            tImag = pData[i + 3];
+            pData[i + 2] = (pData[i] - tReal) >> 1;
+            pData[i + 3] = (pData[i + 1] - tImag) >> 1;
+            pData[i] = (pData[i] + tReal) >> 1;
+            pData[i + 1] = (pData[i + 1] + tImag) >> 1;
+        }
+        half = 2;
+    }
+    for (; half < HARMONICS_NUM_COMPLEX; half *= 4)
+    {
+        for (j = 0; j < half; j++)
+        {
+            // Twiddles of stages of size 2 * half and 4 * half.
+            w1Real = GetCosine(j * (HARMONICS_FFT_SIZE / (2 * half)));
+            w1Imag = -GetSine(j * (HARMONICS_FFT_SIZE / (2 * half)));
+            w2Real = GetCosine(j * (HARMONICS_FFT_SIZE / (4 * half)));
+            w2Imag = -GetSine(j * (HARMONICS_FFT_SIZE / (4 * half)));
+            for (k = j; k < HARMONICS_NUM_COMPLEX; k += 4 * half)
+            {
+                p0 = &pData[2 * k];
+                p1 = &pData[2 * (k + half)];
+                p2 = &pData[2 * (k + 2 * half)];
+                p3 = &pData[2 * (k + 3 * half)];
+
+                tReal = (int32_t)((w1Real * p1[0] - w1Imag * p1[1]) >> TWIDDLE_FRAC_BITS);
+                tImag = (int32_t)((w1Real * p1[1] + w1Imag * p1[0]) >> TWIDDLE_FRAC_BITS);
+                b0Real = (p0[0] + tReal) >> 1;
+                b0Imag = (p0[1] + tImag) >> 1;
+                b1Real = (p0[0] - tReal) >> 1;
+                b1Imag = (p0[1] - tImag) >> 1;
+                tReal = (int32_t)((w1Real * p3[0] - w1Imag * p3[1]) >> TWIDDLE_FRAC_BITS);
+                tImag = (int32_t)((w1Real * p3[1] + w1Imag * p3[0]) >> TWIDDLE_FRAC_BITS);
+                b2Real = (p2[0] + tReal) >> 1;
+                b2Imag = (p2[1] + tImag) >> 1;
+                b3Real = (p2[0] - tReal) >> 1;
+                b3Imag = (p2[1] - tImag) >> 1;
+
+                tReal = (int32_t)((w2Real * b2Real - w2Imag * b2Imag) >> TWIDDLE_FRAC_BITS);
+                tImag = (int32_t)((w2Real * b2Imag + w2Imag * b2Real) >> TWIDDLE_FRAC_BITS);
+                p0[0] = (b0Real + tReal) >> 1;
+                p0[1] = (b0Imag + tImag) >> 1;
+                p2[0] = (b0Real - tReal) >> 1;
+                p2[1] = (b0Imag - tImag) >> 1;
+                // Twiddle of second half is -i times twiddle of first half.
+                tReal = (int32_t)((w2Imag * b3Real + w2Real * b3Imag) >> TWIDDLE_FRAC_BITS);
+                tImag = (int32_t)((w2Imag * b3Imag - w2Real * b3Real) >> TWIDDLE_FRAC_BITS);
+                p1[0] = (b1Real + tReal) >> 1;
+                p1[1] = (b1Imag + tImag) >> 1;
+                p3[0] = (b1Real - tReal) >> 1;
+                p3[1] = (b1Imag - tImag) >> 1;
+            }
+        }
+    }
+}
+
+void GetRealFftBin(FFT_DATA *pData, uint32_t bin, float *pReal, float *pImag)
+{
+    uint32_t mirror = (HARMONICS_NUM_COMPLEX - bin) % HARMONICS_NUM_COMPLEX;
+    int64_t evenReal = (int64_t)pData[2 * bin] + pData[2 * mirror];
+    int64_t evenImag = (int64_t)pData[2 * bin + 1] - pData[2 * mirror + 1];
+    int64_t oddReal = (int64_t)pData[2 * bin + 1] + pData[2 * mirror + 1];
+    int64_t oddImag = (int64_t)pData[2 * mirror] - pData[2 * bin];
+    int64_t wReal = GetCosine(bin);
+    int64_t wImag = -GetSine(bin);
+    // FFT output is scaled by 1 / (N / 2) and samples by 2 ^ SAMPLE_SHIFT. Even and odd parts
+    // are doubled.
+    float scale = (float)HARMONICS_NUM_COMPLEX / (float)(2 << SAMPLE_SHIFT);
+
+    *pReal = (float)(evenReal + ((wReal * oddReal - wImag * oddImag) >> TWIDDLE_FRAC_BITS)) * scale;
+    *pImag = (float)(evenImag + ((wReal * oddImag + wImag * oddReal) >> TWIDDLE_FRAC_BITS)) * scale;
+}
+
+#else
+
+void ResampleWindow(METIC_HARMONICS_INFO *pHarmonics, const int32_t *pWindow, float length)
+{
+    uint32_t n;
+    uint32_t index;
+    float position;
+    float mu;
+    float y0;
+    float y1;
+    float y2;
+    float y3;
+    float step = length / (float)HARMONICS_FFT_SIZE;
+
+    for (n = 0; n < HARMONICS_FFT_SIZE; n++)
+    {
+        position = pHarmonics->windowPhase + (float)n * step;
+        index = (uint32_t)position;
+        mu = position - (float)index;
+        y0 = (float)((index == 0) ? pWindow[0] : pWindow[index - 1]);
+        y1 = (float)pWindow[index];
+        y2 = (float)pWindow[index + 1];
+        y3 = (float)pWindow[index + 2];
+        // Catmull-Rom spline through y1 and y2.
+        pHarmonics->fft[n] =
+            y1 + 0.5f * mu *
+                     ((y2 - y0) + mu * ((2.0f * y0 - 5.0f * y1 + 4.0f * y2 - y3) +
+                                        mu * (3.0f * (y1 - y2) + y3 - y0)));
+    }
+}
+
+void ComputeComplexFft(FFT_DATA *pData)
+{
+    uint32_t half = 1;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    float w1Real;
+    float w1Imag;
+    float w2Real;
+    float w2Imag;
+    float *p0;
+    float *p1;
+    float *p2;
+    float *p3;
+    float tReal;
+    float tImag;
+    float b0Real, b0Imag, b1Real, b1Imag, b2Real, b2Imag, b3Real, b3Imag;
+
+    ReorderBitReversed(pData);
+    if ((HARMONICS_NUM_COMPLEX & 0xAAAAAAAAu) != 0)
+    {
+        // Odd number of radix-2 stages, first stage is done alone.
+        for (i = 0; i < 2 * HARMONICS_NUM_COMPLEX; i += 4)
+        {
+            tReal = pData[i + 2];
+            tImag = pData[i + 3];
+            pData[i + 2] = pData[i] - tReal;
+            pData[i + 3] = pData[i + 1] - tImag;
+            pData[i] += tReal;
+            pData[i + 1] += tImag;
+        }
+        half = 2;
+    }
+    for (; half < HARMONICS_NUM_COMPLEX; half *= 4)
+    {
+        for (j = 0; j < half; j++)
+        {
+            // Twiddles of stages of size 2 * half and 4 * half.
+            w1Real = GetCosine(j * (HARMONICS_FFT_SIZE / (2 * half)));
+            w1Imag = -GetSine(j * (HARMONICS_FFT_SIZE / (2 * half)));
+            w2Real = GetCosine(j * (HARMONICS_FFT_SIZE / (4 * half)));
+            w2Imag = -GetSine(j * (HARMONICS_FFT_SIZE / (4 * half)));
+            for (k = j; k < HARMONICS_NUM_COMPLEX; k += 4 * half)
+            {
+                p0 = &pData[2 * k];
+                p1 = &pData[2 * (k + half)];
+                p2 = &pData[2 * (k + 2 * half)];
+                p3 = &pData[2 * (k + 3 * half)];
+
+                tReal = w1Real * p1[0] - w1Imag * p1[1];
+                tImag = w1Real * p1[1] + w1Imag * p1[0];
+                b0Real = p0[0] + tReal;
+                b0Imag = p0[1] + tImag;
+                b1Real = p0[0] - tReal;
+                b1Imag = p0[1] - tImag;
+                tReal = w1Real * p3[0] - w1Imag * p3[1];
+                tImag = w1Real * p3[1] + w1Imag * p3[0];
+                b2Real = p2[0] + tReal;
+                b2Imag = p2[1] + tImag;
+                b3Real = p2[0] - tReal;
+                b3Imag = p2[1] - tImag;
+
+                tReal = w2Real * b2Real - w2Imag * b2Imag;
+                tImag = w2Real * b2Imag + w2Imag * b2Real;
+                p0[0] = b0Real + tReal;
+                p0[1] = b0Imag + tImag;
+                p2[0] = b0Real - tReal;
+                p2[1] = b0Imag - tImag;
+                // Twiddle of second half is -i times twiddle of first half.
+                tReal = w2Imag * b3Real + w2Real * b3Imag;
+                tImag = w2Imag * b3Imag - w2Real * b3Real;
+                p1[0] = b1Real + tReal;
+                p1[1] = b1Imag + tImag;
+                p3[0] = b1Real - tReal;
+                p3[1] = b1Imag - tImag;
+            }
+        }
+    }
+}
+
+void GetRealFftBin(FFT_DATA *pData, uint32_t bin, float *pReal, float *pImag)
+{
+    uint32_t mirror = (HARMONICS_NUM_COMPLEX - bin) % HARMONICS_NUM_COMPLEX;
+    // Even and odd parts of input, each doubled.
+    float evenReal = pData[2 * bin] + pData[2 * mirror];
+    float evenImag = pData[2 * bin + 1] - pData[2 * mirror + 1];
+    float oddReal = pData[2 * bin + 1] + pData[2 * mirror + 1];
+    float oddImag = pData[2 * mirror] - pData[2 * bin];
+    float wReal = GetCosine(bin);
+    float wImag = -GetSine(bin);
+
+    *pReal = 0.5f * (evenReal + wReal * oddReal - wImag * oddImag);
+    *pImag = 0.5f * (evenImag + wReal * oddImag + wImag * oddReal);
+}
+
+#endif
+
+/**
+ * @}
+ */
@@ -136,6 +136,7 @@ void MetIcIfUpdateIrqStatus(uint32_t flag)
         time = EvbGetTime();
         pAdeInstance->cfTime[pAdeInstance->cfIndex] = time;
         pAdeInstance->cfFlag[pAdeInstance->cfIndex] = flag;
+        pAdeInstance->trigger.lastCfTime = time;
         if (pAdeInstance->cfIndex >= APP_CFG_MAX_NUM_IRQ_TIME)
         {
             pAdeInstance->cfIndex = 0;
@@ -158,8 +159,21 @@ void MetIcIfGPIOCallback(uint32_t port, uint32_t flag)
 
 void MetIcIfWfsUartCallBack(void)
 {
+    ADI_METIC_WFS_STREAM_STATUS streamStatus;
     adi_metic_WfsUartRxCallback(pAdeInstance->hAde);
-    pAdeInstance->isWfsRxComplete = 1;
+    adi_metic_WfsGetStreamStatus(pAdeInstance->hAde, &streamStatus);
+    // In continuous streaming, buffer is never complete as blocks are handed out one by one.
+    if (streamStatus.isStreaming == 0)
+    {
+        pAdeInstance->isWfsRxComplete = 1;
+    }
+    else if (streamStatus.numBlocksReceived > 0)
+    {
+        // Time of reception is the time of the last sample of the block, used to place triggers
+        // evaluated at cycle rate in the stream.
+        pAdeInstance->wfsBlockTime[(streamStatus.numBlocksReceived - 1) % WFS_STREAM_NUM_BLOCKS] =
+            EvbGetTime();
+    }
 }
 
 void MetIcIfClose(METIC_INSTANCE_INFO *pInfo)
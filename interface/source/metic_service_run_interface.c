@@ -200,6 +200,36 @@ ADI_METIC_STATUS MetIcIfCollectSamples(METIC_INSTANCE_INFO *pInfo, int32_t confi
     return status;
 }
 
+ADI_METIC_STATUS MetIcIfStartWfsStream(METIC_INSTANCE_INFO *pInfo, int32_t config)
+{
+    ADI_METIC_STATUS status = 0;
+    pInfo->isWfsRxComplete = 0;
+    status = adi_metic_WfsConfigureRx(pInfo->hAde, config);
+    if (status == 0)
+    {
+        status = adi_metic_WfsStartStream(pInfo->hAde, (uint8_t *)&pInfo->wfsBuffer[0],
+                                          WFS_STREAM_BLOCK_NUM_BYTES, WFS_STREAM_NUM_BLOCKS);
+    }
+
+    return status;
+}
+
+ADI_METIC_STATUS MetIcIfStopWfsStream(METIC_INSTANCE_INFO *pInfo)
+{
+    return adi_metic_WfsStopStream(pInfo->hAde);
+}
+
+ADI_METIC_STATUS MetIcIfStopWfsConsumer(METIC_INSTANCE_INFO *pInfo, uint32_t *pConsumerId)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    if (*pConsumerId != 0)
+    {
+        status = adi_metic_WfsUnregisterConsumer(pInfo->hAde, *pConsumerId);
+        *pConsumerId = 0;
+    }
+    return status;
+}
+
 ADI_METIC_STATUS MetIcIfClearAdcStatusError(METIC_INSTANCE_INFO *pInfo, int32_t errorRegStatus)
 {
     ADI_METIC_STATUS adeStatus = 0;
@@ -306,6 +336,20 @@ int32_t ReadOutputRegisters(METIC_INSTANCE_INFO *pInfo, ADI_METIC_OUTPUT *pOutpu
     {
         ExtractAndConvertOutputs(pRegOutput, &pInfo->outputFix, pOutput);
         ExtractStatusOutput(pRegStatusOutput, &pOutput->statusOut);
+        MetIcIfUpdateStats(pInfo, pOutput, pInfo->irqStatus.lastIrqTime);
+        if ((pInfo->harmonics.isEnabled == 1) && (pOutput->periodOut.comPeriod > 0))
+        {
+            // Harmonic analysis windows follow the measured line frequency.
+            MetIcIfSetHarmonicsFrequency(pInfo, 1.0f / pOutput->periodOut.comPeriod);
+        }
+        if (pInfo->goertzel.isEnabled == 1)
+        {
+            MetIcIfSetGoertzelPeriod(pInfo, pOutput->periodOut.comPeriod);
+        }
+        if (pInfo->trigger.state == METIC_TRIGGER_STATE_ARMED)
+        {
+            MetIcIfUpdateTrigger(pInfo, pOutput, pInfo->irqStatus.lastIrqTime);
+        }
     }
 
     return status;
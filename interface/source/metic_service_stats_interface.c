@@ -0,0 +1,335 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        metic_service_stats_interface.c
+ * @brief       Interface file for running statistics of rms, power and power factor outputs.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_metic.h"
+#include "metic_service_interface.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Function to clear statistics accumulator.
+ * @param[in] pAccum 		- pointer to accumulator
+ *
+ */
+static void ClearAccum(METIC_STATS_ACCUM *pAccum);
+
+/**
+ * @brief Function to add a value to mean and variance of accumulator.
+ * @param[in] pAccum 		- pointer to accumulator
+ * @param[in] value 		- value to add
+ *
+ */
+static void AddMeanVariance(METIC_STATS_ACCUM *pAccum, float value);
+
+/**
+ * @brief Function to remove a value from mean and variance of accumulator.
+ * @param[in] pAccum 		- pointer to accumulator
+ * @param[in] value 		- value to remove
+ *
+ */
+static void RemoveMeanVariance(METIC_STATS_ACCUM *pAccum, float value);
+
+/**
+ * @brief Function to update minimum and maximum of accumulator with a new value.
+ * @param[in] pAccum 		- pointer to accumulator
+ * @param[in] value 		- new value
+ * @param[in] timeStamp 		- time of the value
+ *
+ */
+static void UpdateExtrema(METIC_STATS_ACCUM *pAccum, float value, uint32_t timeStamp);
+
+/**
+ * @brief Function to add a value to all windows of a channel.
+ * @param[in] pStats 		- pointer to statistics
+ * @param[in] pChannel 		- pointer to channel statistics
+ * @param[in] value 		- new value
+ * @param[in] timeStamp 		- time of the value
+ *
+ */
+static void UpdateChannel(METIC_STATS_INFO *pStats, METIC_STATS_CHANNEL *pChannel, float value,
+                          uint32_t timeStamp);
+
+/**
+ * @brief Function to recompute sliding window statistics from the values held in the window.
+ * Used when an extremum leaves the window and to remove rounding drift of mean and variance.
+ * @param[in] pChannel 		- pointer to channel statistics
+ * @param[in] numValues 		- number of valid values in the window
+ * @param[in] recomputeMeanVariance 		- recompute mean and variance along with extrema
+ *
+ */
+static void RescanSlidingWindow(METIC_STATS_CHANNEL *pChannel, uint32_t numValues,
+                                uint8_t recomputeMeanVariance);
+
+/*=============  C O D E  =============*/
+
+void MetIcIfConfigureStats(METIC_INSTANCE_INFO *pInfo, uint32_t tumblingCycles,
+                           uint32_t slidingCycles)
+{
+    METIC_STATS_INFO *pStats = &pInfo->stats;
+
+    if (tumblingCycles == 0)
+    {
+        tumblingCycles = 1;
+    }
+    if ((slidingCycles == 0) || (slidingCycles > STATS_MAX_SLIDING_WINDOW_CYCLES))
+    {
+        slidingCycles = STATS_MAX_SLIDING_WINDOW_CYCLES;
+    }
+    pStats->tumblingCycles = tumblingCycles;
+    pStats->slidingCycles = slidingCycles;
+    MetIcIfResetStats(pInfo);
+}
+
+void MetIcIfResetStats(METIC_INSTANCE_INFO *pInfo)
+{
+    uint32_t i;
+    METIC_STATS_INFO *pStats = &pInfo->stats;
+
+    pStats->slidingIndex = 0;
+    pStats->numWindows = 0;
+    for (i = 0; i < STATS_NUM_CHANNELS; i++)
+    {
+        ClearAccum(&pStats->channel[i].total);
+        ClearAccum(&pStats->channel[i].tumbling);
+        ClearAccum(&pStats->channel[i].lastTumbling);
+        ClearAccum(&pStats->channel[i].sliding);
+    }
+}
+
+void MetIcIfUpdateStats(METIC_INSTANCE_INFO *pInfo, ADI_METIC_OUTPUT *pOutput, uint32_t timeStamp)
+{
+    uint32_t i;
+    METIC_STATS_INFO *pStats = &pInfo->stats;
+    METIC_STATS_CHANNEL *pChannel = &pStats->channel[0];
+
+    if (pStats->slidingCycles != 0)
+    {
+        for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+        {
+            UpdateChannel(pStats, &pChannel[i], pOutput->rmsOut[i].filteredRms, timeStamp);
+        }
+        for (i = 0; i < ADI_METIC_MAX_NUM_POWER_CHANNELS; i++)
+        {
+            UpdateChannel(pStats, &pChannel[STATS_POWER_CHANNEL_OFFSET + i],
+                          pOutput->powerOut[i].activePower, timeStamp);
+            UpdateChannel(pStats, &pChannel[STATS_PF_CHANNEL_OFFSET + i], pOutput->powerFactor[i],
+                          timeStamp);
+        }
+
+        pStats->slidingIndex++;
+        if (pStats->slidingIndex >= pStats->slidingCycles)
+        {
+            pStats->slidingIndex = 0;
+        }
+        if (pChannel[0].tumbling.count >= pStats->tumblingCycles)
+        {
+            for (i = 0; i < STATS_NUM_CHANNELS; i++)
+            {
+                pChannel[i].lastTumbling = pChannel[i].tumbling;
+                ClearAccum(&pChannel[i].tumbling);
+            }
+            pStats->numWindows++;
+        }
+    }
+}
+
+int32_t MetIcIfGetStats(METIC_INSTANCE_INFO *pInfo, METIC_STATS_WINDOW window, uint32_t channel,
+                        METIC_STATS_SUMMARY *pSummary)
+{
+    int32_t status = 0;
+    METIC_STATS_ACCUM *pAccum = NULL;
+    METIC_STATS_INFO *pStats = &pInfo->stats;
+
+    if (channel < STATS_NUM_CHANNELS)
+    {
+        switch (window)
+        {
+        case METIC_STATS_WINDOW_TOTAL:
+            pAccum = &pStats->channel[channel].total;
+            break;
+        case METIC_STATS_WINDOW_TUMBLING:
+            if (pStats->numWindows > 0)
+            {
+                pAccum = &pStats->channel[channel].lastTumbling;
+            }
+            else
+            {
+                pAccum = &pStats->channel[channel].tumbling;
+            }
+            break;
+        case METIC_STATS_WINDOW_SLIDING:
+            pAccum = &pStats->channel[channel].sliding;
+            break;
+        default:
+            status = 1;
+            break;
+        }
+    }
+    else
+    {
+        status = 1;
+    }
+
+    if (status == 0)
+    {
+        pSummary->min = pAccum->min;
+        pSummary->max = pAccum->max;
+        pSummary->mean = pAccum->mean;
+        pSummary->minTime = pAccum->minTime;
+        pSummary->maxTime = pAccum->maxTime;
+        pSummary->count = pAccum->count;
+        pSummary->variance = 0;
+        if (pAccum->count > 1)
+        {
+            pSummary->variance = pAccum->m2 / (float)(pAccum->count - 1);
+        }
+    }
+
+    return status;
+}
+
+void UpdateChannel(METIC_STATS_INFO *pStats, METIC_STATS_CHANNEL *pChannel, float value,
+                   uint32_t timeStamp)
+{
+    uint32_t index = pStats->slidingIndex;
+    float oldValue;
+    uint8_t rescan = 0;
+
+    AddMeanVariance(&pChannel->total, value);
+    UpdateExtrema(&pChannel->total, value, timeStamp);
+    AddMeanVariance(&pChannel->tumbling, value);
+    UpdateExtrema(&pChannel->tumbling, value, timeStamp);
+
+    if (pChannel->sliding.count >= pStats->slidingCycles)
+    {
+        // Window is full, oldest value at index leaves the window.
+        oldValue = pChannel->slidingValue[index];
+        RemoveMeanVariance(&pChannel->sliding, oldValue);
+        if ((oldValue <= pChannel->sliding.min) || (oldValue >= pChannel->sliding.max))
+        {
+            rescan = 1;
+        }
+    }
+    pChannel->slidingValue[index] = value;
+    pChannel->slidingTime[index] = timeStamp;
+    AddMeanVariance(&pChannel->sliding, value);
+
+    if (index == pStats->slidingCycles - 1)
+    {
+        RescanSlidingWindow(pChannel, pChannel->sliding.count, 1);
+    }
+    else if (rescan == 1)
+    {
+        RescanSlidingWindow(pChannel, pChannel->sliding.count, 0);
+    }
+    else
+    {
+        UpdateExtrema(&pChannel->sliding, value, timeStamp);
+    }
+}
+
+void RescanSlidingWindow(METIC_STATS_CHANNEL *pChannel, uint32_t numValues,
+                         uint8_t recomputeMeanVariance)
+{
+    uint32_t i;
+    float delta;
+    float sum = 0;
+    float m2 = 0;
+    float mean;
+    METIC_STATS_ACCUM *pAccum = &pChannel->sliding;
+
+    pAccum->min = pChannel->slidingValue[0];
+    pAccum->max = pChannel->slidingValue[0];
+    pAccum->minTime = pChannel->slidingTime[0];
+    pAccum->maxTime = pChannel->slidingTime[0];
+    for (i = 0; i < numValues; i++)
+    {
+        if (pChannel->slidingValue[i] < pAccum->min)
+        {
+            pAccum->min = pChannel->slidingValue[i];
+            pAccum->minTime = pChannel->slidingTime[i];
+        }
+        if (pChannel->slidingValue[i] > pAccum->max)
+        {
+            pAccum->max = pChannel->slidingValue[i];
+            pAccum->maxTime = pChannel->slidingTime[i];
+        }
+        sum += pChannel->slidingValue[i];
+    }
+    if ((recomputeMeanVariance == 1) && (numValues > 0))
+    {
+        mean = sum / (float)numValues;
+        for (i = 0; i < numValues; i++)
+        {
+            delta = pChannel->slidingValue[i] - mean;
+            m2 += delta * delta;
+        }
+        pAccum->mean = mean;
+        pAccum->m2 = m2;
+    }
+}
+
+void AddMeanVariance(METIC_STATS_ACCUM *pAccum, float value)
+{
+    float delta;
+
+    pAccum->count++;
+    delta = value - pAccum->mean;
+    pAccum->mean += delta / (float)pAccum->count;
+    pAccum->m2 += delta * (value - pAccum->mean);
+}
+
+void RemoveMeanVariance(METIC_STATS_ACCUM *pAccum, float value)
+{
+    float delta;
+
+    if (pAccum->count <= 1)
+    {
+        pAccum->count = 0;
+        pAccum->mean = 0;
+        pAccum->m2 = 0;
+    }
+    else
+    {
+        delta = value - pAccum->mean;
+        pAccum->count--;
+        pAccum->mean -= delta / (float)pAccum->count;
+        pAccum->m2 -= delta * (value - pAccum->mean);
+        if (pAccum->m2 < 0)
+        {
+            pAccum->m2 = 0;
+        }
+    }
+}
+
+void UpdateExtrema(METIC_STATS_ACCUM *pAccum, float value, uint32_t timeStamp)
+{
+    if ((pAccum->count == 1) || (value < pAccum->min))
+    {
+        pAccum->min = value;
+        pAccum->minTime = timeStamp;
+    }
+    if ((pAccum->count == 1) || (value > pAccum->max))
+    {
+        pAccum->max = value;
+        pAccum->maxTime = timeStamp;
+    }
+}
+
+void ClearAccum(METIC_STATS_ACCUM *pAccum)
+{
+    memset(pAccum, 0, sizeof(METIC_STATS_ACCUM));
+}
+
+/**
+ * @}
+ */
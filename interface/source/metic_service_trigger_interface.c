@@ -0,0 +1,453 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        metic_service_trigger_interface.c
+ * @brief       Interface file for event triggered capture of waveform stream with pre-trigger
+ * history.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_evb.h"
+#include "adi_metic.h"
+#include "metic_service_interface.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Function to get time elapsed between two times of EvbGetTime, handling wrap of timer.
+ * @param[in] startTime 		- start time (usec)
+ * @param[in] endTime 		- end time (usec)
+ * @returns elapsed time (usec). Close to maximum time if endTime is before startTime.
+ *
+ */
+static uint32_t GetElapsedTime(uint32_t startTime, uint32_t endTime);
+
+/**
+ * @brief Function to get time a duration before a time of EvbGetTime, handling wrap of timer.
+ * @param[in] time 		- time (usec)
+ * @param[in] duration 		- duration (usec)
+ * @returns time (usec)
+ *
+ */
+static uint32_t SubtractTime(uint32_t time, uint32_t duration);
+
+/**
+ * @brief Function to get index of frame in a block at which a pending register trigger is
+ * placed. Block is received at the time of its last frame and frames are
+ * #TRIGGER_FRAME_PERIOD_US apart.
+ * @param[in] pTrigger 		- pointer to triggered capture
+ * @param[in] blockTime 		- time (usec) at which block was received
+ * @param[in] numBlockFrames 		- number of frames in block
+ * @returns index of frame, UINT32_MAX if no trigger is pending or it is after the block
+ *
+ */
+static uint32_t GetPendingFrame(METIC_TRIGGER_INFO *pTrigger, uint32_t blockTime,
+                                uint32_t numBlockFrames);
+
+/**
+ * @brief Function to add a validated frame to triggered capture.
+ * @param[in] pTrigger 		- pointer to triggered capture
+ * @param[in] frameIndex 		- index of frame in chunk
+ * @param[in] source 		- sources firing at this frame, 0 if none
+ * @param[in] frameTime 		- estimated time (usec) of frame
+ *
+ */
+static void AddFrame(METIC_TRIGGER_INFO *pTrigger, uint32_t frameIndex, uint32_t source,
+                     uint32_t frameTime);
+
+/*=============  C O D E  =============*/
+
+int32_t MetIcIfConfigureTrigger(METIC_INSTANCE_INFO *pInfo, METIC_TRIGGER_CONFIG *pConfig)
+{
+    int32_t status = 1;
+    METIC_TRIGGER_INFO *pTrigger = &pInfo->trigger;
+
+    if ((pConfig->sampleChannel < ADI_METIC_MAX_NUM_CHANNELS) &&
+        (pTrigger->state != METIC_TRIGGER_STATE_ARMED) &&
+        (pTrigger->state != METIC_TRIGGER_STATE_TRIGGERED))
+    {
+        pTrigger->config = *pConfig;
+        status = 0;
+    }
+    return status;
+}
+
+int32_t MetIcIfArmTrigger(METIC_INSTANCE_INFO *pInfo, uint32_t channelMask)
+{
+    int32_t status = 0;
+    uint32_t numChannels = 0;
+    uint32_t channel;
+    uint32_t referenceChannel = ADI_METIC_MAX_NUM_CHANNELS;
+    uint32_t maxFrames;
+    uint32_t numPreFrames;
+    uint32_t numPostFrames;
+    METIC_TRIGGER_INFO *pTrigger = &pInfo->trigger;
+
+    for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+    {
+        if ((channelMask & (1u << channel)) != 0)
+        {
+            numChannels++;
+            if (referenceChannel == ADI_METIC_MAX_NUM_CHANNELS)
+            {
+                referenceChannel = channel;
+            }
+        }
+    }
+    if ((numChannels == 0) || (pTrigger->config.sourceMask == 0))
+    {
+        status = 1;
+    }
+    if ((status == 0) && ((pTrigger->config.sourceMask & METIC_TRIGGER_SOURCE_SAMPLE) != 0) &&
+        ((channelMask & (1u << pTrigger->config.sampleChannel)) == 0))
+    {
+        status = 1;
+    }
+    if (status == 0)
+    {
+        maxFrames = TRIGGER_MAX_CAPTURE_SAMPLES / numChannels;
+        numPreFrames = pTrigger->config.preTriggerTime * ADI_METIC_SAMPLING_RATE / 1000;
+        numPostFrames = pTrigger->config.postTriggerTime * ADI_METIC_SAMPLING_RATE / 1000;
+        // Frames of history are not overwritten before post-trigger frames are collected.
+        if ((numPostFrames == 0) || (numPreFrames + numPostFrames > maxFrames))
+        {
+            status = 1;
+        }
+    }
+    if (status == 0)
+    {
+        // Waveform stream is left running between captures, so that history is kept. Validator
+        // starts again on the next block.
+        pTrigger->state = METIC_TRIGGER_STATE_IDLE;
+        pTrigger->isEnabled = 1;
+        memset(&pTrigger->validator, 0, sizeof(ADI_METIC_WFS_VALIDATOR));
+        pTrigger->validator.order[0] = (uint8_t)referenceChannel;
+        pTrigger->maxFrames = maxFrames;
+        pTrigger->numPreFrames = numPreFrames;
+        pTrigger->numPostFrames = numPostFrames;
+        pTrigger->writeIndex = 0;
+        pTrigger->numHistoryFrames = 0;
+        pTrigger->numCaptureFrames = 0;
+        pTrigger->numGaps = 0;
+        pTrigger->source = 0;
+        pTrigger->pendingSource = 0;
+        pTrigger->armTime = EvbGetTime();
+        // CF gap is measured from arming until the first pulse.
+        pTrigger->lastCfTime = pTrigger->armTime;
+        pTrigger->state = METIC_TRIGGER_STATE_ARMED;
+    }
+    return status;
+}
+
+void MetIcIfUpdateTrigger(METIC_INSTANCE_INFO *pInfo, ADI_METIC_OUTPUT *pOutput,
+                          uint32_t timeStamp)
+{
+    uint32_t source = 0;
+    uint32_t channel;
+    uint32_t lastCfTime;
+    uint32_t cfGap;
+    METIC_TRIGGER_INFO *pTrigger = &pInfo->trigger;
+    METIC_TRIGGER_CONFIG *pConfig = &pTrigger->config;
+
+    for (channel = 0; channel < ADI_METIC_MAX_NUM_CHANNELS; channel++)
+    {
+        if ((pConfig->rmsChannelMask & (1u << channel)) != 0)
+        {
+            if (((pConfig->sourceMask & METIC_TRIGGER_SOURCE_DIP) != 0) &&
+                (pOutput->rmsOut[channel].dipHalf < pConfig->dipLevel))
+            {
+                source |= METIC_TRIGGER_SOURCE_DIP;
+            }
+            if (((pConfig->sourceMask & METIC_TRIGGER_SOURCE_SWELL) != 0) &&
+                (pOutput->rmsOut[channel].swellHalf > pConfig->swellLevel))
+            {
+                source |= METIC_TRIGGER_SOURCE_SWELL;
+            }
+        }
+    }
+    if (((pConfig->sourceMask & METIC_TRIGGER_SOURCE_STATUS) != 0) &&
+        (((pOutput->statusOut.status0 & pConfig->status0Mask) != 0) ||
+         ((pOutput->statusOut.status1 & pConfig->status1Mask) != 0)))
+    {
+        source |= METIC_TRIGGER_SOURCE_STATUS;
+    }
+    if ((pConfig->sourceMask & METIC_TRIGGER_SOURCE_CF_GAP) != 0)
+    {
+        // CF pulse interrupt may update the time after IRQ0 time was taken. Elapsed time is then
+        // close to maximum time and is not a gap.
+        lastCfTime = pTrigger->lastCfTime;
+        cfGap = GetElapsedTime(lastCfTime, timeStamp);
+        if ((cfGap > pConfig->cfGapTime) && (cfGap < EvbGetMaxTime() / 2))
+        {
+            source |= METIC_TRIGGER_SOURCE_CF_GAP;
+        }
+    }
+    if ((source != 0) && (pTrigger->pendingSource == 0))
+    {
+        pTrigger->pendingTime = timeStamp;
+        pTrigger->pendingSource = source;
+    }
+}
+
+uint32_t MetIcIfProcessTrigger(METIC_INSTANCE_INFO *pInfo)
+{
+    uint32_t isComplete = 0;
+    uint32_t i;
+    uint32_t channel;
+    uint32_t pos;
+    uint32_t source;
+    uint32_t numChunkBytes;
+    uint32_t numBlockFrames;
+    uint32_t blockFrame;
+    uint32_t pendingFrame;
+    uint32_t blockTime;
+    uint32_t frameTime;
+    int32_t sample;
+    ADI_METIC_STATUS adeStatus = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_BLOCK block;
+    ADI_METIC_WFS_BLOCK chunk;
+    ADI_METIC_WFS_UNPACK_CONFIG unpackConfig;
+    ADI_METIC_WFS_BLOCK_QUALITY quality;
+    METIC_TRIGGER_INFO *pTrigger = &pInfo->trigger;
+    METIC_TRIGGER_CONFIG *pConfig = &pTrigger->config;
+
+    if ((pTrigger->isEnabled == 1) && (pTrigger->consumerId == 0))
+    {
+        // History is not skipped, so that gaps in a capture are only due to overruns.
+        adeStatus = adi_metic_WfsRegisterConsumer(pInfo->hAde, ADI_METIC_WFS_CONSUMER_STALL,
+                                                  &pTrigger->consumerId);
+    }
+    if ((pTrigger->isEnabled == 1) && (adeStatus == ADI_METIC_STATUS_SUCCESS) &&
+        (pTrigger->validator.numChannels == 0))
+    {
+        // Stream starts with lowest channel enabled, kept in order[0] when armed.
+        adeStatus = adi_metic_WfsValidatorInit(pInfo->hAde, &pTrigger->validator,
+                                               (int32_t)pTrigger->validator.order[0],
+                                               ADI_METIC_WFS_GAP_FILL_LINEAR);
+    }
+    memset(&unpackConfig, 0, sizeof(ADI_METIC_WFS_UNPACK_CONFIG));
+    unpackConfig.format = ADI_METIC_WFS_FORMAT_INT32;
+    unpackConfig.maxSamples = TRIGGER_MAX_CHUNK_FRAMES;
+    for (i = 0; i < pTrigger->validator.numChannels; i++)
+    {
+        channel = pTrigger->validator.order[i];
+        unpackConfig.pDst[channel] = &pTrigger->chunk[channel][0];
+    }
+    numChunkBytes = TRIGGER_CHUNK_NUM_FRAMES * pTrigger->validator.numChannels * sizeof(int32_t);
+    while ((pTrigger->isEnabled == 1) && (adeStatus == ADI_METIC_STATUS_SUCCESS) &&
+           (adi_metic_WfsGetConsumerBlock(pInfo->hAde, pTrigger->consumerId, &block) ==
+            ADI_METIC_STATUS_SUCCESS))
+    {
+        // Blocks are released without processing once capture is frozen, so that the stream
+        // keeps running until armed again.
+        if ((pTrigger->state == METIC_TRIGGER_STATE_ARMED) ||
+            (pTrigger->state == METIC_TRIGGER_STATE_TRIGGERED))
+        {
+            blockTime = pInfo->wfsBlockTime[block.sequence % WFS_STREAM_NUM_BLOCKS];
+            numBlockFrames = block.numBytes / (numChunkBytes / TRIGGER_CHUNK_NUM_FRAMES);
+            blockFrame = 0;
+            // Register sources fired at cycle rate are placed at the frame of IRQ0 time, once
+            // the block holding that time is received.
+            pendingFrame = GetPendingFrame(pTrigger, blockTime, numBlockFrames);
+            if (block.isGapBefore == 1)
+            {
+                pTrigger->numGaps++;
+            }
+            chunk = block;
+            for (pos = 0; pos < block.numBytes; pos += numChunkBytes)
+            {
+                chunk.pSamples = block.pSamples + pos;
+                chunk.numBytes = block.numBytes - pos;
+                if (chunk.numBytes > numChunkBytes)
+                {
+                    chunk.numBytes = numChunkBytes;
+                }
+                chunk.isGapBefore = (pos == 0) ? block.isGapBefore : 0;
+                adi_metic_WfsValidateBlock(pInfo->hAde, &pTrigger->validator, &chunk,
+                                           &unpackConfig, &quality);
+                if ((block.isGapBefore == 0) && (quality.numLostFrames > 0))
+                {
+                    pTrigger->numGaps++;
+                }
+                for (i = 0; i < quality.numFrames; i++)
+                {
+                    if ((quality.numDiscontinuities > 0) && (i == quality.discontinuityFrame))
+                    {
+                        // Frames lost and not filled still take time in the block.
+                        blockFrame += quality.numLostFrames - quality.numFilledFrames;
+                    }
+                    source = 0;
+                    if (pTrigger->state == METIC_TRIGGER_STATE_ARMED)
+                    {
+                        if ((pTrigger->pendingSource != 0) && (blockFrame >= pendingFrame))
+                        {
+                            source = pTrigger->pendingSource;
+                        }
+                        if ((pConfig->sourceMask & METIC_TRIGGER_SOURCE_SAMPLE) != 0)
+                        {
+                            sample = pTrigger->chunk[pConfig->sampleChannel][i];
+                            if ((sample > pConfig->sampleThreshold) ||
+                                (sample < -pConfig->sampleThreshold))
+                            {
+                                source |= METIC_TRIGGER_SOURCE_SAMPLE;
+                            }
+                        }
+                    }
+                    // Frames after the capture completes in this block are dropped.
+                    if (pTrigger->state != METIC_TRIGGER_STATE_COMPLETE)
+                    {
+                        frameTime = blockTime;
+                        if (blockFrame + 1 < numBlockFrames)
+                        {
+                            frameTime =
+                                SubtractTime(blockTime, (numBlockFrames - 1 - blockFrame) *
+                                                            TRIGGER_FRAME_PERIOD_US);
+                        }
+                        AddFrame(pTrigger, i, source, frameTime);
+                    }
+                    blockFrame++;
+                }
+            }
+            if (pTrigger->state == METIC_TRIGGER_STATE_COMPLETE)
+            {
+                isComplete = 1;
+            }
+        }
+        adeStatus = adi_metic_WfsReleaseConsumerBlock(pInfo->hAde, pTrigger->consumerId);
+    }
+    return isComplete;
+}
+
+uint32_t MetIcIfReadTriggerCapture(METIC_INSTANCE_INFO *pInfo, uint32_t firstFrame,
+                                   uint32_t numFrames, int32_t *pDst)
+{
+    uint32_t numRead = 0;
+    uint32_t index;
+    uint32_t numChannels;
+    METIC_TRIGGER_INFO *pTrigger = &pInfo->trigger;
+
+    if (pTrigger->state == METIC_TRIGGER_STATE_COMPLETE)
+    {
+        numChannels = pTrigger->validator.numChannels;
+        index = (pTrigger->startIndex + firstFrame) % pTrigger->maxFrames;
+        while ((numRead < numFrames) && (firstFrame + numRead < pTrigger->numCaptureFrames))
+        {
+            memcpy(pDst, &pTrigger->samples[index * numChannels], numChannels * sizeof(int32_t));
+            pDst += numChannels;
+            index++;
+            if (index >= pTrigger->maxFrames)
+            {
+                index = 0;
+            }
+            numRead++;
+        }
+    }
+    return numRead;
+}
+
+uint32_t GetElapsedTime(uint32_t startTime, uint32_t endTime)
+{
+    uint32_t elapsedTime;
+    if (endTime >= startTime)
+    {
+        elapsedTime = endTime - startTime;
+    }
+    else
+    {
+        elapsedTime = EvbGetMaxTime() - startTime + endTime;
+    }
+    return elapsedTime;
+}
+
+uint32_t SubtractTime(uint32_t time, uint32_t duration)
+{
+    uint32_t result;
+    if (time >= duration)
+    {
+        result = time - duration;
+    }
+    else
+    {
+        result = EvbGetMaxTime() - duration + time;
+    }
+    return result;
+}
+
+uint32_t GetPendingFrame(METIC_TRIGGER_INFO *pTrigger, uint32_t blockTime,
+                         uint32_t numBlockFrames)
+{
+    uint32_t pendingFrame = UINT32_MAX;
+    uint32_t elapsedTime = GetElapsedTime(pTrigger->pendingTime, blockTime);
+    uint32_t numFramesBefore;
+
+    // Trigger after the block gives elapsed time close to maximum time.
+    if ((pTrigger->pendingSource != 0) && (elapsedTime < EvbGetMaxTime() / 2))
+    {
+        numFramesBefore = elapsedTime / TRIGGER_FRAME_PERIOD_US;
+        pendingFrame = 0;
+        if (numFramesBefore < numBlockFrames)
+        {
+            pendingFrame = numBlockFrames - 1 - numFramesBefore;
+        }
+    }
+    return pendingFrame;
+}
+
+void AddFrame(METIC_TRIGGER_INFO *pTrigger, uint32_t frameIndex, uint32_t source,
+              uint32_t frameTime)
+{
+    uint32_t i;
+    uint32_t numChannels = pTrigger->validator.numChannels;
+    uint32_t numPreFrames;
+    int32_t *pFrame = &pTrigger->samples[pTrigger->writeIndex * numChannels];
+
+    for (i = 0; i < numChannels; i++)
+    {
+        pFrame[i] = pTrigger->chunk[pTrigger->validator.order[i]][frameIndex];
+    }
+    if (source != 0)
+    {
+        // Capture starts up to numPreFrames before the frame of trigger.
+        numPreFrames = pTrigger->numPreFrames;
+        if (numPreFrames > pTrigger->numHistoryFrames)
+        {
+            numPreFrames = pTrigger->numHistoryFrames;
+        }
+        pTrigger->startIndex =
+            (pTrigger->writeIndex + pTrigger->maxFrames - numPreFrames) % pTrigger->maxFrames;
+        pTrigger->triggerFrame = numPreFrames;
+        pTrigger->numCaptureFrames = numPreFrames;
+        pTrigger->numPostRemaining = pTrigger->numPostFrames;
+        pTrigger->source = source;
+        pTrigger->triggerTime = frameTime;
+        pTrigger->startTime = SubtractTime(frameTime, numPreFrames * TRIGGER_FRAME_PERIOD_US);
+        pTrigger->pendingSource = 0;
+        pTrigger->state = METIC_TRIGGER_STATE_TRIGGERED;
+    }
+    if (pTrigger->state == METIC_TRIGGER_STATE_TRIGGERED)
+    {
+        pTrigger->numCaptureFrames++;
+        pTrigger->numPostRemaining--;
+        if (pTrigger->numPostRemaining == 0)
+        {
+            pTrigger->state = METIC_TRIGGER_STATE_COMPLETE;
+        }
+    }
+    else if (pTrigger->numHistoryFrames < pTrigger->maxFrames)
+    {
+        pTrigger->numHistoryFrames++;
+    }
+    pTrigger->writeIndex++;
+    if (pTrigger->writeIndex >= pTrigger->maxFrames)
+    {
+        pTrigger->writeIndex = 0;
+    }
+}
+
+/**
+ * @}
+ */
@@ -11,6 +11,7 @@
 
 #include "adi_metic.h"
 #include "ade9178_default.h"
+#include "adi_metic_memory.h"
 #include "adi_metic_private.h"
 #include "adi_metic_status.h"
 #include <stdint.h>
@@ -31,6 +32,10 @@ static ADI_METIC_STATUS CheckIntegrityError(ADI_METIC_INFO *pInfo);
 static ADI_METIC_STATUS CheckStartupError(ADI_METIC_INFO *pInfo);
 static void MeticCallBack(ADI_METIC_MASTER_EVENT_TYPE eventType, void *pData);
 
+/* State memory advertised to applications must hold the library state */
+_Static_assert(sizeof(ADI_METIC_INFO) <= ADI_METIC_STATE_MEM_NUM_BYTES,
+               "ADI_METIC_STATE_MEM_NUM_BYTES is less than size of ADI_METIC_INFO");
+
 /*=============  C O D E  =============*/
 
 ADI_METIC_STATUS adi_metic_Create(ADI_METIC_HANDLE *phAde, void *pStateMemory,
@@ -92,6 +97,9 @@ ADI_METIC_STATUS adi_metic_Init(ADI_METIC_HANDLE hAde, ADI_METIC_CONFIG *pConfig
         pInfo->meticConfig = *pConfig;
         pInfo->wfsData.isWfsRxComplete = 1;
         pInfo->wfsData.config.offsetCount = ADI_METIC_WFS_OFFSET_COUNT;
+        memset(&pInfo->wfsData.stream, 0, sizeof(ADI_METIC_WFS_STREAM_INFO));
+        memset(&pInfo->wfsData.consumer[0], 0, sizeof(pInfo->wfsData.consumer));
+        pInfo->wfsData.numConsumers = 0;
     }
 
     return status;
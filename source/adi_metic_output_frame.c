@@ -0,0 +1,432 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        adi_metic_output_frame.c
+ * @brief       Packing of metrology outputs into compact binary frames for streaming, and
+ * unpacking on the host.
+ * @{
+ */
+
+/*=============  I N C L U D E S   =============*/
+
+#include "adi_metic.h"
+#include "adi_metic_status.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Number of fields of a frame */
+#define OUTPUT_FRAME_NUM_FIELDS 17
+/** Number of bytes before values: sync, length, format, IRQ0 count, timestamp and field mask */
+#define OUTPUT_FRAME_VALUE_OFFSET 16
+/** Number of bytes before the bytes counted by length: sync and length */
+#define OUTPUT_FRAME_LENGTH_OFFSET 3
+/** Number of bytes of CRC */
+#define OUTPUT_FRAME_CRC_NUM_BYTES 2
+/** Initial value of CRC-16 (CCITT) */
+#define OUTPUT_FRAME_CRC_INIT 0xFFFF
+
+/**
+ * Scale applied to a field in float format
+ */
+typedef enum
+{
+    /** Value is not scaled */
+    OUTPUT_FIELD_SCALE_NONE,
+    /** Value is scaled by RMS scale of its channel */
+    OUTPUT_FIELD_SCALE_RMS,
+    /** Value is scaled by power scale of its phase */
+    OUTPUT_FIELD_SCALE_POWER
+} OUTPUT_FIELD_SCALE;
+
+/**
+ * Location of values of a field in output structures
+ */
+typedef struct
+{
+    /** Number of values */
+    uint8_t numValues;
+    /** Number of 32 bit words of a value in fixed format */
+    uint8_t numFixWords;
+    /** Scale in float format */
+    uint8_t scale;
+    /** Set to 1 if fixed format also takes the value from ADI_METIC_OUTPUT */
+    uint8_t isFixInOutput;
+    /** Offset of first value in ADI_METIC_OUTPUT */
+    uint16_t offset;
+    /** Bytes between values in ADI_METIC_OUTPUT */
+    uint16_t stride;
+    /** Offset of first value in ADI_METIC_OUTPUT_FIX */
+    uint16_t fixOffset;
+    /** Bytes between values in ADI_METIC_OUTPUT_FIX */
+    uint16_t fixStride;
+} OUTPUT_FIELD_INFO;
+
+/** Fields in order of bits of #ADI_METIC_OUTPUT_FIELD */
+static const OUTPUT_FIELD_INFO fieldInfo[OUTPUT_FRAME_NUM_FIELDS] = {
+    {ADI_METIC_MAX_NUM_CHANNELS, 1, OUTPUT_FIELD_SCALE_RMS, 0,
+     offsetof(ADI_METIC_OUTPUT, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT, filteredRms),
+     sizeof(ADI_METIC_RMS_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT_FIX, filteredRms),
+     sizeof(ADI_METIC_RMS_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_CHANNELS, 1, OUTPUT_FIELD_SCALE_RMS, 0,
+     offsetof(ADI_METIC_OUTPUT, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT, rmsHalfCycle),
+     sizeof(ADI_METIC_RMS_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT_FIX, rmsHalfCycle),
+     sizeof(ADI_METIC_RMS_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_CHANNELS, 1, OUTPUT_FIELD_SCALE_RMS, 0,
+     offsetof(ADI_METIC_OUTPUT, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT, rmsOneCycle),
+     sizeof(ADI_METIC_RMS_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT_FIX, rmsOneCycle),
+     sizeof(ADI_METIC_RMS_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_CHANNELS, 1, OUTPUT_FIELD_SCALE_RMS, 0,
+     offsetof(ADI_METIC_OUTPUT, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT, dipHalf),
+     sizeof(ADI_METIC_RMS_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT_FIX, dipHalf),
+     sizeof(ADI_METIC_RMS_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_CHANNELS, 1, OUTPUT_FIELD_SCALE_RMS, 0,
+     offsetof(ADI_METIC_OUTPUT, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT, dipOne),
+     sizeof(ADI_METIC_RMS_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT_FIX, dipOne),
+     sizeof(ADI_METIC_RMS_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_CHANNELS, 1, OUTPUT_FIELD_SCALE_RMS, 0,
+     offsetof(ADI_METIC_OUTPUT, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT, swellHalf),
+     sizeof(ADI_METIC_RMS_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT_FIX, swellHalf),
+     sizeof(ADI_METIC_RMS_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_CHANNELS, 1, OUTPUT_FIELD_SCALE_RMS, 0,
+     offsetof(ADI_METIC_OUTPUT, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT, swellOne),
+     sizeof(ADI_METIC_RMS_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, rmsOut) + offsetof(ADI_METIC_RMS_OUTPUT_FIX, swellOne),
+     sizeof(ADI_METIC_RMS_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, 1, OUTPUT_FIELD_SCALE_POWER, 0,
+     offsetof(ADI_METIC_OUTPUT, powerOut) + offsetof(ADI_METIC_POWER_OUTPUT, activePower),
+     sizeof(ADI_METIC_POWER_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, powerOut) + offsetof(ADI_METIC_POWER_OUTPUT_FIX, activePower),
+     sizeof(ADI_METIC_POWER_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, 1, OUTPUT_FIELD_SCALE_POWER, 0,
+     offsetof(ADI_METIC_OUTPUT, powerOut) + offsetof(ADI_METIC_POWER_OUTPUT, apparentPower),
+     sizeof(ADI_METIC_POWER_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, powerOut) +
+         offsetof(ADI_METIC_POWER_OUTPUT_FIX, apparentPower),
+     sizeof(ADI_METIC_POWER_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, 1, OUTPUT_FIELD_SCALE_NONE, 0,
+     offsetof(ADI_METIC_OUTPUT, powerFactor), sizeof(float),
+     offsetof(ADI_METIC_OUTPUT_FIX, powerFactor), sizeof(int32_t)},
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, 2, OUTPUT_FIELD_SCALE_POWER, 0,
+     offsetof(ADI_METIC_OUTPUT, energyOut) + offsetof(ADI_METIC_ENERGY_OUTPUT, posActEgy),
+     sizeof(ADI_METIC_ENERGY_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, energyOut) + offsetof(ADI_METIC_ENERGY_OUTPUT_FIX, posActEgyLo),
+     sizeof(ADI_METIC_ENERGY_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, 2, OUTPUT_FIELD_SCALE_POWER, 0,
+     offsetof(ADI_METIC_OUTPUT, energyOut) + offsetof(ADI_METIC_ENERGY_OUTPUT, negActEgy),
+     sizeof(ADI_METIC_ENERGY_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, energyOut) + offsetof(ADI_METIC_ENERGY_OUTPUT_FIX, negActEgyLo),
+     sizeof(ADI_METIC_ENERGY_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, 2, OUTPUT_FIELD_SCALE_POWER, 0,
+     offsetof(ADI_METIC_OUTPUT, energyOut) + offsetof(ADI_METIC_ENERGY_OUTPUT, signActEgy),
+     sizeof(ADI_METIC_ENERGY_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, energyOut) +
+         offsetof(ADI_METIC_ENERGY_OUTPUT_FIX, signActEgyLo),
+     sizeof(ADI_METIC_ENERGY_OUTPUT_FIX)},
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, 2, OUTPUT_FIELD_SCALE_POWER, 0,
+     offsetof(ADI_METIC_OUTPUT, energyOut) + offsetof(ADI_METIC_ENERGY_OUTPUT, apparentEgy),
+     sizeof(ADI_METIC_ENERGY_OUTPUT),
+     offsetof(ADI_METIC_OUTPUT_FIX, energyOut) +
+         offsetof(ADI_METIC_ENERGY_OUTPUT_FIX, apparentEgyLo),
+     sizeof(ADI_METIC_ENERGY_OUTPUT_FIX)},
+    {9, 1, OUTPUT_FIELD_SCALE_NONE, 0, offsetof(ADI_METIC_OUTPUT, angleOut), sizeof(float),
+     offsetof(ADI_METIC_OUTPUT_FIX, angleOut), sizeof(int32_t)},
+    {4, 1, OUTPUT_FIELD_SCALE_NONE, 0, offsetof(ADI_METIC_OUTPUT, periodOut), sizeof(float),
+     offsetof(ADI_METIC_OUTPUT_FIX, periodOut), sizeof(int32_t)},
+    {5, 1, OUTPUT_FIELD_SCALE_NONE, 1, offsetof(ADI_METIC_OUTPUT, statusOut), sizeof(uint32_t),
+     offsetof(ADI_METIC_OUTPUT, statusOut), sizeof(uint32_t)}};
+
+/** CRC-16 (CCITT) of a nibble, to update CRC 4 bits at a time */
+static const uint16_t crcNibble[16] = {0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5,
+                                       0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B,
+                                       0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+/**
+ * Returns number of bytes of values of fields in a format.
+ * @param[in]  format - format of values.
+ * @param[in]  fieldMask - fields present.
+ */
+static uint32_t GetValuesNumBytes(ADI_METIC_OUTPUT_FRAME_FORMAT format, uint32_t fieldMask);
+
+/**
+ * Updates CRC-16 (CCITT) with bytes.
+ * @param[in]  crc - CRC so far.
+ * @param[in]  pSrc - pointer to bytes.
+ * @param[in]  numBytes - number of bytes.
+ * @return updated CRC
+ */
+static uint16_t UpdateCrc(uint16_t crc, uint8_t *pSrc, uint32_t numBytes);
+
+/**
+ * Writes a 32 bit word little endian.
+ * @param[out]  pDst - pointer to output.
+ * @param[in]  value - word.
+ */
+static void WriteWord(uint8_t *pDst, uint32_t value);
+
+/**
+ * Reads a 32 bit word little endian.
+ * @param[in]  pSrc - pointer to input.
+ * @return word
+ */
+static uint32_t ReadWord(uint8_t *pSrc);
+
+/*=============  C O D E  =============*/
+
+ADI_METIC_STATUS adi_metic_EncodeOutputFrame(ADI_METIC_OUTPUT_FRAME_CONFIG *pConfig,
+                                             uint32_t irqCount, uint32_t timestamp,
+                                             ADI_METIC_OUTPUT *pOutput,
+                                             ADI_METIC_OUTPUT_FIX *pOutputFix, uint8_t *pDst,
+                                             uint32_t maxNumBytes, uint32_t *pNumBytes)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t numBytes = 0;
+    uint32_t field;
+    uint32_t i;
+    uint32_t j;
+    uint32_t word;
+    uint16_t crc;
+    float value;
+    float scale = 1.0f;
+    uint8_t *pValue;
+    uint8_t *pSrc;
+    const OUTPUT_FIELD_INFO *pField;
+
+    if ((pConfig == NULL) || (pOutput == NULL) || (pOutputFix == NULL) || (pDst == NULL) ||
+        (pNumBytes == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if ((pConfig->format > ADI_METIC_OUTPUT_FRAME_FIXED) ||
+             ((pConfig->fieldMask & ~(uint32_t)ADI_METIC_OUTPUT_FIELD_ALL) != 0))
+    {
+        status = ADI_METIC_STATUS_INVALID_OUTPUT_FRAME;
+    }
+    else
+    {
+        numBytes = ADI_METIC_OUTPUT_FRAME_HEADER_NUM_BYTES +
+                   GetValuesNumBytes(pConfig->format, pConfig->fieldMask);
+        if (numBytes > maxNumBytes)
+        {
+            status = ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER;
+        }
+    }
+    if (status == ADI_METIC_STATUS_SUCCESS)
+    {
+        pDst[0] = ADI_METIC_OUTPUT_FRAME_SYNC;
+        pDst[1] = (uint8_t)(numBytes - OUTPUT_FRAME_LENGTH_OFFSET - OUTPUT_FRAME_CRC_NUM_BYTES);
+        pDst[2] = (uint8_t)((numBytes - OUTPUT_FRAME_LENGTH_OFFSET - OUTPUT_FRAME_CRC_NUM_BYTES) >>
+                            8);
+        pDst[3] = (uint8_t)pConfig->format;
+        WriteWord(&pDst[4], irqCount);
+        WriteWord(&pDst[8], timestamp);
+        WriteWord(&pDst[12], pConfig->fieldMask);
+        pValue = &pDst[OUTPUT_FRAME_VALUE_OFFSET];
+        for (field = 0; field < OUTPUT_FRAME_NUM_FIELDS; field++)
+        {
+            pField = &fieldInfo[field];
+            if ((pConfig->fieldMask & (1u << field)) != 0)
+            {
+                for (i = 0; i < pField->numValues; i++)
+                {
+                    if ((pConfig->format == ADI_METIC_OUTPUT_FRAME_FIXED) &&
+                        (pField->isFixInOutput == 0))
+                    {
+                        pSrc = (uint8_t *)pOutputFix + pField->fixOffset + i * pField->fixStride;
+                        for (j = 0; j < pField->numFixWords; j++)
+                        {
+                            memcpy(&word, pSrc + j * sizeof(uint32_t), sizeof(uint32_t));
+                            WriteWord(pValue, word);
+                            pValue += sizeof(uint32_t);
+                        }
+                    }
+                    else
+                    {
+                        pSrc = (uint8_t *)pOutput + pField->offset + i * pField->stride;
+                        memcpy(&word, pSrc, sizeof(uint32_t));
+                        if (pField->scale != OUTPUT_FIELD_SCALE_NONE)
+                        {
+                            scale = (pField->scale == OUTPUT_FIELD_SCALE_RMS)
+                                        ? pConfig->rmsScale[i]
+                                        : pConfig->powerScale[i];
+                            memcpy(&value, pSrc, sizeof(float));
+                            value *= scale;
+                            memcpy(&word, &value, sizeof(uint32_t));
+                        }
+                        WriteWord(pValue, word);
+                        pValue += sizeof(uint32_t);
+                    }
+                }
+            }
+        }
+        crc = UpdateCrc(OUTPUT_FRAME_CRC_INIT, &pDst[1],
+                        numBytes - 1 - OUTPUT_FRAME_CRC_NUM_BYTES);
+        pValue[0] = (uint8_t)crc;
+        pValue[1] = (uint8_t)(crc >> 8);
+        *pNumBytes = numBytes;
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_DecodeOutputFrame(uint8_t *pSrc, uint32_t numBytes,
+                                             ADI_METIC_OUTPUT_FRAME *pFrame,
+                                             ADI_METIC_OUTPUT *pOutput,
+                                             ADI_METIC_OUTPUT_FIX *pOutputFix,
+                                             uint32_t *pNumSrcBytes)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t frameNumBytes = 0;
+    uint32_t field;
+    uint32_t i;
+    uint32_t j;
+    uint32_t word;
+    uint32_t fieldMask;
+    uint16_t crc;
+    uint8_t *pValue;
+    uint8_t *pDst;
+    const OUTPUT_FIELD_INFO *pField;
+
+    if ((pSrc == NULL) || (pFrame == NULL) || (pOutput == NULL) || (pOutputFix == NULL) ||
+        (pNumSrcBytes == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if (numBytes < OUTPUT_FRAME_VALUE_OFFSET)
+    {
+        status = ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER;
+    }
+    else
+    {
+        frameNumBytes = ((uint32_t)pSrc[1] | ((uint32_t)pSrc[2] << 8)) +
+                        OUTPUT_FRAME_LENGTH_OFFSET + OUTPUT_FRAME_CRC_NUM_BYTES;
+        fieldMask = ReadWord(&pSrc[12]);
+        // Length is checked against header before CRC, so that a corrupted length does not wait
+        // for bytes that never come.
+        if ((pSrc[0] != ADI_METIC_OUTPUT_FRAME_SYNC) ||
+            (pSrc[3] > ADI_METIC_OUTPUT_FRAME_FIXED) ||
+            ((fieldMask & ~(uint32_t)ADI_METIC_OUTPUT_FIELD_ALL) != 0) ||
+            (frameNumBytes != ADI_METIC_OUTPUT_FRAME_HEADER_NUM_BYTES +
+                                  GetValuesNumBytes((ADI_METIC_OUTPUT_FRAME_FORMAT)pSrc[3],
+                                                    fieldMask)))
+        {
+            status = ADI_METIC_STATUS_INVALID_OUTPUT_FRAME;
+        }
+        else if (frameNumBytes > numBytes)
+        {
+            status = ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER;
+        }
+        else
+        {
+            crc = UpdateCrc(OUTPUT_FRAME_CRC_INIT, &pSrc[1],
+                            frameNumBytes - 1 - OUTPUT_FRAME_CRC_NUM_BYTES);
+            if ((pSrc[frameNumBytes - 2] != (uint8_t)crc) ||
+                (pSrc[frameNumBytes - 1] != (uint8_t)(crc >> 8)))
+            {
+                status = ADI_METIC_STATUS_FRAME_CRC_ERROR;
+            }
+        }
+    }
+    if (status == ADI_METIC_STATUS_SUCCESS)
+    {
+        pFrame->format = (ADI_METIC_OUTPUT_FRAME_FORMAT)pSrc[3];
+        pFrame->irqCount = ReadWord(&pSrc[4]);
+        pFrame->timestamp = ReadWord(&pSrc[8]);
+        pFrame->fieldMask = fieldMask;
+        pValue = &pSrc[OUTPUT_FRAME_VALUE_OFFSET];
+        for (field = 0; field < OUTPUT_FRAME_NUM_FIELDS; field++)
+        {
+            pField = &fieldInfo[field];
+            if ((fieldMask & (1u << field)) != 0)
+            {
+                for (i = 0; i < pField->numValues; i++)
+                {
+                    if ((pFrame->format == ADI_METIC_OUTPUT_FRAME_FIXED) &&
+                        (pField->isFixInOutput == 0))
+                    {
+                        pDst = (uint8_t *)pOutputFix + pField->fixOffset + i * pField->fixStride;
+                        for (j = 0; j < pField->numFixWords; j++)
+                        {
+                            word = ReadWord(pValue);
+                            memcpy(pDst + j * sizeof(uint32_t), &word, sizeof(uint32_t));
+                            pValue += sizeof(uint32_t);
+                        }
+                    }
+                    else
+                    {
+                        pDst = (uint8_t *)pOutput + pField->offset + i * pField->stride;
+                        word = ReadWord(pValue);
+                        memcpy(pDst, &word, sizeof(uint32_t));
+                        pValue += sizeof(uint32_t);
+                    }
+                }
+            }
+        }
+    }
+    if (pNumSrcBytes != NULL)
+    {
+        *pNumSrcBytes = (status == ADI_METIC_STATUS_SUCCESS) ? frameNumBytes : 0;
+    }
+    return status;
+}
+
+uint32_t GetValuesNumBytes(ADI_METIC_OUTPUT_FRAME_FORMAT format, uint32_t fieldMask)
+{
+    uint32_t field;
+    uint32_t numWords = 0;
+    const OUTPUT_FIELD_INFO *pField;
+
+    for (field = 0; field < OUTPUT_FRAME_NUM_FIELDS; field++)
+    {
+        pField = &fieldInfo[field];
+        if ((fieldMask & (1u << field)) != 0)
+        {
+            if ((format == ADI_METIC_OUTPUT_FRAME_FIXED) && (pField->isFixInOutput == 0))
+            {
+                numWords += pField->numValues * pField->numFixWords;
+            }
+            else
+            {
+                numWords += pField->numValues;
+            }
+        }
+    }
+    return numWords * sizeof(uint32_t);
+}
+
+uint16_t UpdateCrc(uint16_t crc, uint8_t *pSrc, uint32_t numBytes)
+{
+    uint32_t i;
+
+    for (i = 0; i < numBytes; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ crcNibble[((crc >> 12) ^ (pSrc[i] >> 4)) & 0xF]);
+        crc = (uint16_t)((crc << 4) ^ crcNibble[((crc >> 12) ^ pSrc[i]) & 0xF]);
+    }
+    return crc;
+}
+
+void WriteWord(uint8_t *pDst, uint32_t value)
+{
+    pDst[0] = (uint8_t)value;
+    pDst[1] = (uint8_t)(value >> 8);
+    pDst[2] = (uint8_t)(value >> 16);
+    pDst[3] = (uint8_t)(value >> 24);
+}
+
+uint32_t ReadWord(uint8_t *pSrc)
+{
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) | ((uint32_t)pSrc[2] << 16) |
+           ((uint32_t)pSrc[3] << 24);
+}
+
+/**
+ * @}
+ */
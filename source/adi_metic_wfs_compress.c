@@ -0,0 +1,635 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        adi_metic_wfs_compress.c
+ * @brief       Lossless compression of WFS samples for storage and transfer. Samples are
+ * predicted from previous samples of the channel and residuals are Rice coded.
+ * @{
+ */
+
+/*=============  I N C L U D E S   =============*/
+
+#include "adi_metic.h"
+#include "adi_metic_private.h"
+#include "adi_metic_status.h"
+#include <stdint.h>
+#include <string.h>
+
+/** Number of bytes in a WFS sample */
+#define WFS_SAMPLE_NUM_BYTES 4
+/** First byte of header of compressed samples */
+#define WFS_CODEC_MAGIC0 'W'
+/** Second byte of header of compressed samples */
+#define WFS_CODEC_MAGIC1 'C'
+/** Version of format of compressed samples */
+#define WFS_CODEC_VERSION 1
+/** Number of bits of coding mode of a channel in a packet */
+#define WFS_CODEC_MODE_NUM_BITS 3
+/** Coding mode for samples stored as 24 bits. Modes 0 to 4 are predictor orders */
+#define WFS_CODEC_MODE_VERBATIM 7
+/** Highest predictor order */
+#define WFS_CODEC_MAX_ORDER 4
+/** Number of bits of Rice parameter */
+#define WFS_CODEC_RICE_NUM_BITS 5
+/** Quotient from which residual is stored as 32 bits after an escape */
+#define WFS_CODEC_ESCAPE 24
+/** Number of bits of a sample */
+#define WFS_CODEC_SAMPLE_NUM_BITS 24
+/** Maximum number of frames in a packet */
+#define WFS_CODEC_MAX_PACKET_FRAMES 0xFFFF
+
+/** Number of leading ones of a byte, to read unary quotients a byte at a time */
+static const uint8_t leadingOnes[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 7, 8,
+};
+
+/**
+ * Writer of a bit stream, most significant bit first.
+ */
+typedef struct
+{
+    /** Pointer to output */
+    uint8_t *pDst;
+    /** Size of output in bytes */
+    uint32_t maxNumBytes;
+    /** Number of bytes written */
+    uint32_t numBytes;
+    /** Bits not yet written */
+    uint32_t acc;
+    /** Number of bits in acc */
+    uint32_t numBits;
+    /** Set to 1 if output is full */
+    uint32_t isOverflow;
+
+} WFS_BIT_WRITER;
+
+/**
+ * Reader of a bit stream, most significant bit first.
+ */
+typedef struct
+{
+    /** Pointer to input */
+    uint8_t *pSrc;
+    /** Size of input in bytes */
+    uint32_t maxNumBytes;
+    /** Number of bytes read */
+    uint32_t numBytes;
+    /** Bits not yet consumed */
+    uint32_t acc;
+    /** Number of bits in acc */
+    uint32_t numBits;
+    /** Set to 1 if input ended */
+    uint32_t isOverflow;
+
+} WFS_BIT_READER;
+
+/**
+ * Writes bits to bit stream.
+ * @param[in]  pWriter - pointer to writer.
+ * @param[in]  value - bits to write in least significant bits.
+ * @param[in]  numBits - number of bits, at most 24.
+ */
+static void PutBits(WFS_BIT_WRITER *pWriter, uint32_t value, uint32_t numBits);
+
+/**
+ * Writes remaining bits padded with zeros to a byte.
+ * @param[in]  pWriter - pointer to writer.
+ */
+static void FlushBits(WFS_BIT_WRITER *pWriter);
+
+/**
+ * Reads bits from bit stream.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  numBits - number of bits, at most 24.
+ * @return bits read.
+ */
+static uint32_t GetBits(WFS_BIT_READER *pReader, uint32_t numBits);
+
+/**
+ * Reads a unary quotient, ones terminated by a zero. Reading stops without terminating zero at
+ * #WFS_CODEC_ESCAPE ones.
+ * @param[in]  pReader - pointer to reader.
+ * @return number of ones read.
+ */
+static uint32_t GetUnary(WFS_BIT_READER *pReader);
+
+/**
+ * Predicts next sample from history with fixed predictor.
+ * @param[in]  pHistory - last samples, most recent first.
+ * @param[in]  order - predictor order, 0 to #WFS_CODEC_MAX_ORDER.
+ * @return predicted sample.
+ */
+static int32_t Predict(int32_t *pHistory, uint32_t order);
+
+/**
+ * Adds a sample to history.
+ * @param[in]  pHistory - last samples, most recent first.
+ * @param[in]  sample - new sample.
+ */
+static void UpdateHistory(int32_t *pHistory, int32_t sample);
+
+/**
+ * Reads a sample of a frame sign extended from 24 bits.
+ * @param[in]  pSamples - pointer to first sample of frames.
+ * @param[in]  index - index of sample.
+ * @return sample.
+ */
+static int32_t ReadSample(uint8_t *pSamples, uint32_t index);
+
+/**
+ * Compresses samples of a channel of a packet.
+ * @param[in]  pWriter - pointer to writer.
+ * @param[in]  pHistory - history of channel.
+ * @param[in]  pSamples - pointer to first sample of channel.
+ * @param[in]  numChannels - number of channels in a frame.
+ * @param[in]  numFrames - number of frames.
+ */
+static void EncodeChannel(WFS_BIT_WRITER *pWriter, int32_t *pHistory, uint8_t *pSamples,
+                          uint32_t numChannels, uint32_t numFrames);
+
+/**
+ * Decompresses samples of a channel of a packet.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  pHistory - history of channel.
+ * @param[out]  pDst - pointer to first sample of channel.
+ * @param[in]  numChannels - number of channels in a frame.
+ * @param[in]  numFrames - number of frames.
+ * @return 0 if data is valid.
+ */
+static int32_t DecodeChannel(WFS_BIT_READER *pReader, int32_t *pHistory, int32_t *pDst,
+                             uint32_t numChannels, uint32_t numFrames);
+
+/*=============  C O D E  =============*/
+
+ADI_METIC_STATUS adi_metic_WfsEncoderInit(ADI_METIC_HANDLE hMetIc, ADI_METIC_WFS_CODEC *pCodec,
+                                          int32_t channelId)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_INFO *pInfo;
+
+    if ((hMetIc == NULL) || (pCodec == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        memset(pCodec, 0, sizeof(ADI_METIC_WFS_CODEC));
+        pInfo = &((ADI_METIC_INFO *)hMetIc)->wfsData;
+        if ((channelId >= 0) && (channelId < ADI_METIC_MAX_NUM_CHANNELS))
+        {
+            pCodec->numChannels = adi_metic_WfsGetChannelOrder(
+                &pInfo->nextChannelId[0], (uint32_t)channelId, &pCodec->order[0]);
+        }
+        if (pCodec->numChannels == 0)
+        {
+            status = ADI_METIC_STATUS_NO_VALID_SAMPLES;
+        }
+    }
+    return status;
+}
+
+uint32_t adi_metic_WfsWriteCodecHeader(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pDst)
+{
+    pDst[0] = WFS_CODEC_MAGIC0;
+    pDst[1] = WFS_CODEC_MAGIC1;
+    pDst[2] = WFS_CODEC_VERSION;
+    pDst[3] = (uint8_t)pCodec->numChannels;
+    memcpy(&pDst[4], &pCodec->order[0], pCodec->numChannels);
+
+    return 4 + pCodec->numChannels;
+}
+
+ADI_METIC_STATUS adi_metic_WfsEncode(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pSamples,
+                                     uint32_t numBytes, uint8_t *pDst, uint32_t dstNumBytes,
+                                     uint32_t *pNumDstBytes)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t i;
+    uint32_t numFrames;
+    uint32_t numFrameBytes;
+    WFS_BIT_WRITER writer = {0};
+
+    if ((pCodec == NULL) || (pSamples == NULL) || (pDst == NULL) || (pNumDstBytes == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if ((pCodec->numChannels == 0) || (pCodec->numChannels > ADI_METIC_MAX_NUM_CHANNELS))
+    {
+        // Codec is not initialised by #adi_metic_WfsEncoderInit.
+        status = ADI_METIC_STATUS_NO_VALID_SAMPLES;
+    }
+    else
+    {
+        numFrameBytes = pCodec->numChannels * WFS_SAMPLE_NUM_BYTES;
+        numFrames = numBytes / numFrameBytes;
+        if (numFrames > WFS_CODEC_MAX_PACKET_FRAMES)
+        {
+            numFrames = WFS_CODEC_MAX_PACKET_FRAMES;
+        }
+        writer.pDst = pDst;
+        writer.maxNumBytes = dstNumBytes;
+        PutBits(&writer, numFrames, 16);
+        // Channels are coded one after another, so that each has its own predictor and parameter.
+        for (i = 0; i < pCodec->numChannels; i++)
+        {
+            EncodeChannel(&writer, &pCodec->history[i][0], pSamples + i * WFS_SAMPLE_NUM_BYTES,
+                          pCodec->numChannels, numFrames);
+        }
+        FlushBits(&writer);
+        *pNumDstBytes = writer.numBytes;
+        if (writer.isOverflow == 1)
+        {
+            status = ADI_METIC_STATUS_WFS_INSUFFICIENT_BUFFER;
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsDecoderInit(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pSrc,
+                                          uint32_t numBytes, uint32_t *pNumSrcBytes)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t i;
+
+    if ((pCodec == NULL) || (pSrc == NULL) || (pNumSrcBytes == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if ((numBytes < 4) || (pSrc[0] != WFS_CODEC_MAGIC0) || (pSrc[1] != WFS_CODEC_MAGIC1) ||
+             (pSrc[2] != WFS_CODEC_VERSION) || (pSrc[3] == 0) ||
+             (pSrc[3] > ADI_METIC_MAX_NUM_CHANNELS) || (numBytes < 4u + pSrc[3]))
+    {
+        status = ADI_METIC_STATUS_WFS_INVALID_CODEC_DATA;
+    }
+    else
+    {
+        memset(pCodec, 0, sizeof(ADI_METIC_WFS_CODEC));
+        pCodec->numChannels = pSrc[3];
+        for (i = 0; i < pCodec->numChannels; i++)
+        {
+            pCodec->order[i] = pSrc[4 + i];
+        }
+        *pNumSrcBytes = 4 + pCodec->numChannels;
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsDecode(ADI_METIC_WFS_CODEC *pCodec, uint8_t *pSrc,
+                                     uint32_t numBytes, int32_t *pDst, uint32_t maxFrames,
+                                     uint32_t *pNumSrcBytes, uint32_t *pNumFrames)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t i;
+    uint32_t numFrames;
+    WFS_BIT_READER reader = {0};
+
+    if ((pCodec == NULL) || (pSrc == NULL) || (pDst == NULL) || (pNumSrcBytes == NULL) ||
+        (pNumFrames == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        reader.pSrc = pSrc;
+        reader.maxNumBytes = numBytes;
+        numFrames = GetBits(&reader, 16);
+        if (numFrames > maxFrames)
+        {
+            status = ADI_METIC_STATUS_WFS_INSUFFICIENT_BUFFER;
+        }
+        for (i = 0; (i < pCodec->numChannels) && (status == ADI_METIC_STATUS_SUCCESS); i++)
+        {
+            if (DecodeChannel(&reader, &pCodec->history[i][0], pDst + i, pCodec->numChannels,
+                              numFrames) != 0)
+            {
+                status = ADI_METIC_STATUS_WFS_INVALID_CODEC_DATA;
+            }
+        }
+        if (reader.isOverflow == 1)
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_CODEC_DATA;
+        }
+        // Bits left in the last byte are padding.
+        *pNumSrcBytes = reader.numBytes;
+        *pNumFrames = (status == ADI_METIC_STATUS_SUCCESS) ? numFrames : 0;
+    }
+    return status;
+}
+
+void EncodeChannel(WFS_BIT_WRITER *pWriter, int32_t *pHistory, uint8_t *pSamples,
+                   uint32_t numChannels, uint32_t numFrames)
+{
+    uint32_t i;
+    uint32_t order;
+    uint32_t bestOrder = 0;
+    uint32_t k = 0;
+    uint32_t q;
+    uint32_t u;
+    uint32_t numBits;
+    int32_t sample;
+    int32_t residual;
+    int32_t history[ADI_METIC_WFS_CODEC_HISTORY];
+    uint32_t sum[WFS_CODEC_MAX_ORDER + 1] = {0};
+
+    // Sum of residuals of every predictor order selects the order.
+    memcpy(&history[0], pHistory, sizeof(history));
+    for (i = 0; i < numFrames; i++)
+    {
+        sample = ReadSample(pSamples, i * numChannels);
+        for (order = 0; order <= WFS_CODEC_MAX_ORDER; order++)
+        {
+            residual = sample - Predict(&history[0], order);
+            u = ((uint32_t)residual << 1) ^ (uint32_t)(residual >> 31);
+            // Saturates instead of wrapping for large residuals.
+            sum[order] = (sum[order] + u < sum[order]) ? UINT32_MAX : sum[order] + u;
+        }
+        UpdateHistory(&history[0], sample);
+    }
+    for (order = 1; order <= WFS_CODEC_MAX_ORDER; order++)
+    {
+        if (sum[order] < sum[bestOrder])
+        {
+            bestOrder = order;
+        }
+    }
+    // Rice parameter close to log2 of mean residual.
+    while ((k < 31) && (((uint64_t)numFrames << (k + 1)) <= sum[bestOrder]))
+    {
+        k++;
+    }
+
+    memcpy(&history[0], pHistory, sizeof(history));
+    numBits = WFS_CODEC_RICE_NUM_BITS;
+    for (i = 0; i < numFrames; i++)
+    {
+        sample = ReadSample(pSamples, i * numChannels);
+        residual = sample - Predict(&history[0], bestOrder);
+        u = ((uint32_t)residual << 1) ^ (uint32_t)(residual >> 31);
+        q = u >> k;
+        numBits += (q < WFS_CODEC_ESCAPE) ? (q + 1 + k) : (WFS_CODEC_ESCAPE + 32);
+        UpdateHistory(&history[0], sample);
+    }
+
+    if (numBits > numFrames * WFS_CODEC_SAMPLE_NUM_BITS)
+    {
+        // Noise like samples are cheaper stored as they are.
+        PutBits(pWriter, WFS_CODEC_MODE_VERBATIM, WFS_CODEC_MODE_NUM_BITS);
+        for (i = 0; i < numFrames; i++)
+        {
+            sample = ReadSample(pSamples, i * numChannels);
+            PutBits(pWriter, (uint32_t)sample & 0xFFFFFF, WFS_CODEC_SAMPLE_NUM_BITS);
+            UpdateHistory(pHistory, sample);
+        }
+    }
+    else
+    {
+        PutBits(pWriter, bestOrder, WFS_CODEC_MODE_NUM_BITS);
+        PutBits(pWriter, k, WFS_CODEC_RICE_NUM_BITS);
+        for (i = 0; i < numFrames; i++)
+        {
+            sample = ReadSample(pSamples, i * numChannels);
+            residual = sample - Predict(pHistory, bestOrder);
+            u = ((uint32_t)residual << 1) ^ (uint32_t)(residual >> 31);
+            q = u >> k;
+            if (q < WFS_CODEC_ESCAPE)
+            {
+                // Unary quotient terminated by a zero, followed by k low bits.
+                for (; q >= 16; q -= 16)
+                {
+                    PutBits(pWriter, 0xFFFF, 16);
+                }
+                PutBits(pWriter, ((1u << q) - 1) << 1, q + 1);
+                if (k > 16)
+                {
+                    PutBits(pWriter, u >> 16 & ((1u << (k - 16)) - 1), k - 16);
+                    PutBits(pWriter, u & 0xFFFF, 16);
+                }
+                else if (k > 0)
+                {
+                    PutBits(pWriter, u & ((1u << k) - 1), k);
+                }
+            }
+            else
+            {
+                PutBits(pWriter, (1u << WFS_CODEC_ESCAPE) - 1, WFS_CODEC_ESCAPE);
+                PutBits(pWriter, u >> 16, 16);
+                PutBits(pWriter, u & 0xFFFF, 16);
+            }
+            UpdateHistory(pHistory, sample);
+        }
+    }
+}
+
+int32_t DecodeChannel(WFS_BIT_READER *pReader, int32_t *pHistory, int32_t *pDst,
+                      uint32_t numChannels, uint32_t numFrames)
+{
+    int32_t status = 0;
+    uint32_t i;
+    uint32_t k = 0;
+    uint32_t q;
+    uint32_t u;
+    int32_t sample;
+    uint32_t mode = GetBits(pReader, WFS_CODEC_MODE_NUM_BITS);
+
+    if ((mode > WFS_CODEC_MAX_ORDER) && (mode != WFS_CODEC_MODE_VERBATIM))
+    {
+        status = 1;
+    }
+    else if (mode != WFS_CODEC_MODE_VERBATIM)
+    {
+        k = GetBits(pReader, WFS_CODEC_RICE_NUM_BITS);
+    }
+    for (i = 0; (i < numFrames) && (status == 0) && (pReader->isOverflow == 0); i++)
+    {
+        if (mode == WFS_CODEC_MODE_VERBATIM)
+        {
+            sample = (int32_t)(GetBits(pReader, WFS_CODEC_SAMPLE_NUM_BITS) << 8) >> 8;
+        }
+        else
+        {
+            q = GetUnary(pReader);
+            if (q == WFS_CODEC_ESCAPE)
+            {
+                u = GetBits(pReader, 16) << 16;
+                u |= GetBits(pReader, 16);
+            }
+            else if (k > 16)
+            {
+                u = (q << k) | (GetBits(pReader, k - 16) << 16);
+                u |= GetBits(pReader, 16);
+            }
+            else
+            {
+                u = (q << k) | GetBits(pReader, k);
+            }
+            sample = Predict(pHistory, mode) + (int32_t)((u >> 1) ^ (0u - (u & 1)));
+        }
+        pDst[i * numChannels] = sample;
+        UpdateHistory(pHistory, sample);
+    }
+    return status;
+}
+
+int32_t Predict(int32_t *pHistory, uint32_t order)
+{
+    int32_t prediction;
+
+    // Fixed polynomial predictors, residual of order n is the n-th difference of samples.
+    switch (order)
+    {
+    case 1:
+        prediction = pHistory[0];
+        break;
+    case 2:
+        prediction = 2 * pHistory[0] - pHistory[1];
+        break;
+    case 3:
+        prediction = 3 * (pHistory[0] - pHistory[1]) + pHistory[2];
+        break;
+    case 4:
+        prediction = 4 * (pHistory[0] + pHistory[2]) - 6 * pHistory[1] - pHistory[3];
+        break;
+    default:
+        prediction = 0;
+        break;
+    }
+    return prediction;
+}
+
+void UpdateHistory(int32_t *pHistory, int32_t sample)
+{
+    pHistory[3] = pHistory[2];
+    pHistory[2] = pHistory[1];
+    pHistory[1] = pHistory[0];
+    pHistory[0] = sample;
+}
+
+int32_t ReadSample(uint8_t *pSamples, uint32_t index)
+{
+    int32_t word;
+
+    // Channel id in the lowest byte is dropped.
+    memcpy(&word, pSamples + index * WFS_SAMPLE_NUM_BYTES, sizeof(word));
+    return word >> 8;
+}
+
+void PutBits(WFS_BIT_WRITER *pWriter, uint32_t value, uint32_t numBits)
+{
+    pWriter->acc = (pWriter->acc << numBits) | value;
+    pWriter->numBits += numBits;
+    while (pWriter->numBits >= 8)
+    {
+        pWriter->numBits -= 8;
+        if (pWriter->numBytes < pWriter->maxNumBytes)
+        {
+            pWriter->pDst[pWriter->numBytes] = (uint8_t)(pWriter->acc >> pWriter->numBits);
+            pWriter->numBytes++;
+        }
+        else
+        {
+            pWriter->isOverflow = 1;
+        }
+    }
+}
+
+void FlushBits(WFS_BIT_WRITER *pWriter)
+{
+    if (pWriter->numBits > 0)
+    {
+        PutBits(pWriter, 0, 8 - pWriter->numBits);
+    }
+}
+
+uint32_t GetBits(WFS_BIT_READER *pReader, uint32_t numBits)
+{
+    uint32_t value = 0;
+
+    if (numBits > 0)
+    {
+        while (pReader->numBits < numBits)
+        {
+            pReader->acc <<= 8;
+            if (pReader->numBytes < pReader->maxNumBytes)
+            {
+                pReader->acc |= pReader->pSrc[pReader->numBytes];
+                pReader->numBytes++;
+            }
+            else
+            {
+                pReader->isOverflow = 1;
+            }
+            pReader->numBits += 8;
+        }
+        pReader->numBits -= numBits;
+        value = (pReader->acc >> pReader->numBits) & (0xFFFFFFFFu >> (32 - numBits));
+    }
+    return value;
+}
+
+uint32_t GetUnary(WFS_BIT_READER *pReader)
+{
+    uint32_t q = 0;
+    uint32_t numPeekBits;
+    uint32_t numOnes;
+    uint32_t isDone = 0;
+
+    // Only bits held are peeked, and a byte is read once they are all ones, so that no byte after
+    // the end of the packet is read.
+    while (isDone == 0)
+    {
+        if (pReader->numBits == 0)
+        {
+            pReader->acc <<= 8;
+            if (pReader->numBytes < pReader->maxNumBytes)
+            {
+                pReader->acc |= pReader->pSrc[pReader->numBytes];
+                pReader->numBytes++;
+            }
+            else
+            {
+                pReader->isOverflow = 1;
+            }
+            pReader->numBits = 8;
+        }
+        numPeekBits = pReader->numBits;
+        if (numPeekBits > 8)
+        {
+            numPeekBits = 8;
+        }
+        if (numPeekBits > WFS_CODEC_ESCAPE - q)
+        {
+            numPeekBits = WFS_CODEC_ESCAPE - q;
+        }
+        // Peeked bits are placed at the top of a byte, zeros below them end the run of ones.
+        numOnes = leadingOnes[((pReader->acc >> (pReader->numBits - numPeekBits))
+                               << (8 - numPeekBits)) &
+                              0xFF];
+        if (numOnes >= numPeekBits)
+        {
+            q += numPeekBits;
+            pReader->numBits -= numPeekBits;
+            isDone = (q == WFS_CODEC_ESCAPE) ? 1 : 0;
+        }
+        else
+        {
+            // Terminating zero is consumed along with the ones.
+            q += numOnes;
+            pReader->numBits -= numOnes + 1;
+            isDone = 1;
+        }
+    }
+    return q;
+}
+
+/**
+ * @}
+ */
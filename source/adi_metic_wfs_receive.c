@@ -27,37 +27,74 @@
 static uint32_t GetBaudRate(uint8_t baudRateBit);
 
 /**
- * Returns next channel id enabled.
+ * Stores next enabled channel id for every channel id. Entries of disabled channels are set to
+ * #ADI_METIC_WFS_INVALID_CHANNEL_ID.
+ * @param[in]  channelSelect - configuration of channel select.
+ * @param[in]  pDst - pointer to destination table.
+ */
+static void StoreNextChannelId(uint32_t channelSelect, uint8_t *pDst);
+
+/**
+ * Returns number of channels enabled.
  * @param[in]  channelEnable - configuration of channel enable.
+ */
+static uint16_t GetNumEnabledChannels(uint32_t channelEnable);
+
+/**
+ * Returns next enabled channel id expected after given id.
+ * @param[in]  pNextChannelId - pointer to next channel id table.
  * @param[in]  channelId - channel id.
  */
+static uint32_t GetNextChannelId(uint8_t *pNextChannelId, uint32_t channelId);
 
-static int32_t GeNextChannelId(uint8_t *pChannelIdEnabledBuf, int32_t channelId,
-                               int32_t numChannelsEnabled);
+/**
+ * Returns a word with 0x80 in every byte lane where a and b are equal and 0 elsewhere.
+ * @param[in]  a - first word.
+ * @param[in]  b - second word.
+ */
+static uint32_t CompareBytes(uint32_t a, uint32_t b);
 
 /**
- * Stores the channels enabled in WFS in a buffer.
- * @param[in]  channelSelect - configuration of channel select.
- * @param[in]  pDst - pointer to destination buffer.
+ * Starts reception of the block at write index of the stream ring.
+ * @param[in]  pInfo - pointer to library data.
+ * @return 0 on success
  */
-static void StoreChannelIdEnabled(int32_t channelSelect, uint8_t *pDst);
+static int32_t ArmStreamBlock(ADI_METIC_INFO *pInfo);
 
 /**
- * Returns number of channels enabled.
- * @param[in]  channelEnable - configuration of channel enable.
+ * Handles completion of a block of the stream and starts reception of the next block if it is
+ * free. Called from UART callback.
+ * @param[in]  pInfo - pointer to library data.
  */
-static uint16_t GetNumEnabledChannels(uint32_t channelEnable);
+static void HandleStreamBlockComplete(ADI_METIC_INFO *pInfo);
+
+/**
+ * Restarts reception if it was stopped due to an overrun and a block is free again.
+ * @param[in]  pInfo - pointer to library data.
+ * @return 0 on success
+ */
+static int32_t ResumeStream(ADI_METIC_INFO *pInfo);
+
+/**
+ * Returns registered consumer of given id or NULL.
+ * @param[in]  pInfo - pointer to library data.
+ * @param[in]  consumerId - consumer id.
+ */
+static ADI_METIC_WFS_CONSUMER_INFO *GetConsumer(ADI_METIC_INFO *pInfo, uint32_t consumerId);
+
+/**
+ * Applies policy of consumers holding the stream back. Consumers holding a block got from
+ * #adi_metic_WfsGetConsumerBlock are left as they are.
+ * @param[in]  pInfo - pointer to library data.
+ */
+static void ApplyConsumerPolicy(ADI_METIC_INFO *pInfo);
 
 /**
- * Checks channels positions (every (N+4) pos) iterating through all the enabled channels.
- * @param[in]  pBuffer - pointer to input buffer.
- * @param[in]  pChannelIdEnabledBuff - pointer to buffer having channel id's.
- * @param[in]  startChannel - start channel id.
- * @param[in]  numChannelsEnabled - number of channels enabled.
- * @return 0 if all the channel ids positions are proper
+ * Releases blocks passed by the cursors of all active consumers so that they can be filled again.
+ * @param[in]  pInfo - pointer to library data.
+ * @return 0 on success
  */
-static int32_t CheckChannelPosition(int8_t *pBuffer, uint8_t *pChannelIdEnabledBuff,
-                                    int32_t startChannel, int32_t numChannelsEnabled);
+static int32_t RecycleStreamBlocks(ADI_METIC_INFO *pInfo);
 
 /*=============  C O D E  =============*/
 
@@ -83,7 +120,7 @@ ADI_METIC_STATUS adi_metic_WfsConfigureRx(ADI_METIC_HANDLE hAde, int32_t config)
         // Check if any of the channel is enabled.
         if ((pWfsRegConfig->enable == 1) && ((config & ADE9178_BITM_WFS_CONFIG_CHANNEL_EN) != 0))
         {
-            StoreChannelIdEnabled(pWfsRegConfig->channelSelect, &pWfsInfo->channelIdEnabledBuff[0]);
+            StoreNextChannelId(pWfsRegConfig->channelSelect, &pWfsInfo->nextChannelId[0]);
             baudRate = GetBaudRate(pWfsRegConfig->baudrate);
             wfsUartStatus = pInfo->meticConfig.pfSetBaudRate(pInfo->meticConfig.hUser, baudRate);
             if (wfsUartStatus != 0)
@@ -96,6 +133,96 @@ ADI_METIC_STATUS adi_metic_WfsConfigureRx(ADI_METIC_HANDLE hAde, int32_t config)
     return status;
 }
 
+ADI_METIC_STATUS adi_metic_WfsGetConfig(ADI_METIC_HANDLE hAde, int32_t *pConfig)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    if ((hAde == NULL) || (pConfig == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        *pConfig = 0;
+        memcpy(pConfig, &pInfo->wfsData.config.wfsRegConfig,
+               sizeof(ADI_METIC_WFS_ADE9178_REG_CONFIG));
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsPlanBandwidth(ADI_METIC_WFS_PLAN_CONFIG *pConfig,
+                                            ADI_METIC_WFS_PLAN *pPlan)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_ADE9178_REG_CONFIG wfsRegConfig = {0};
+    uint64_t sampleBitRate;
+    uint64_t requiredBaudRate;
+    uint64_t numFrames;
+    uint32_t numBlocks;
+    uint8_t baudrateBits = 0;
+    if ((pConfig == NULL) || (pPlan == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if ((pConfig->channelSelect == 0) || (pConfig->samplingRate == 0) ||
+             ((pConfig->channelSelect >> ADI_METIC_MAX_NUM_CHANNELS) != 0))
+    {
+        status = ADI_METIC_STATUS_WFS_DISABLED;
+    }
+    else if ((pConfig->numBlocks > ADI_METIC_WFS_MAX_STREAM_BLOCKS) || (pConfig->outputType > 3))
+    {
+        status = ADI_METIC_STATUS_WFS_INVALID_STREAM_CONFIG;
+    }
+    else
+    {
+        memset(pPlan, 0, sizeof(ADI_METIC_WFS_PLAN));
+        pPlan->numChannels = GetNumEnabledChannels(pConfig->channelSelect);
+        pPlan->frameNumBytes = pPlan->numChannels * sizeof(int32_t);
+        sampleBitRate = (uint64_t)pPlan->frameNumBytes * 8 * pConfig->samplingRate;
+        requiredBaudRate = (uint64_t)pPlan->frameNumBytes * ADI_METIC_WFS_UART_BITS_PER_BYTE *
+                           pConfig->samplingRate;
+        while ((baudrateBits < ADI_METIC_WFS_MAX_BAUDRATE_BITS) &&
+               (GetBaudRate(baudrateBits) < requiredBaudRate))
+        {
+            baudrateBits++;
+        }
+        if (GetBaudRate(baudrateBits) < requiredBaudRate)
+        {
+            status = ADI_METIC_STATUS_WFS_BANDWIDTH_EXCEEDED;
+        }
+        else
+        {
+            pPlan->sampleBitRate = (uint32_t)sampleBitRate;
+            pPlan->requiredBaudRate = (uint32_t)requiredBaudRate;
+            pPlan->baudrateBits = baudrateBits;
+            pPlan->baudRate = GetBaudRate(baudrateBits);
+            pPlan->headroom =
+                (uint32_t)((pPlan->baudRate - requiredBaudRate) * 100 / pPlan->baudRate);
+            // Buffer is rounded up to whole frames in every block, so that blocks start at the
+            // same channel.
+            numBlocks = (pConfig->numBlocks == 0) ? 1 : pConfig->numBlocks;
+            numFrames = ((uint64_t)pConfig->samplingRate * pConfig->captureTime + 999) / 1000;
+            numFrames = (numFrames + numBlocks - 1) / numBlocks * numBlocks;
+            if (numFrames * pPlan->frameNumBytes > UINT32_MAX)
+            {
+                status = ADI_METIC_STATUS_WFS_INVALID_STREAM_CONFIG;
+            }
+            else
+            {
+                pPlan->bufferNumBytes = (uint32_t)numFrames * pPlan->frameNumBytes;
+                pPlan->blockNumBytes = pPlan->bufferNumBytes / numBlocks;
+                wfsRegConfig.enable = 1;
+                wfsRegConfig.baudrate = baudrateBits;
+                wfsRegConfig.outputType = pConfig->outputType;
+                wfsRegConfig.channelSelect = pConfig->channelSelect;
+                memcpy(&pPlan->config, &wfsRegConfig, sizeof(ADI_METIC_WFS_ADE9178_REG_CONFIG));
+            }
+        }
+    }
+    return status;
+}
+
 ADI_METIC_STATUS adi_metic_WfsStartRx(ADI_METIC_HANDLE hAde, uint32_t numBytes, uint8_t *pSamples)
 {
     ADI_METIC_STATUS status = ADI_METIC_STATUS_WFS_TRANSACTION_COMPLETED;
@@ -139,59 +266,95 @@ ADI_METIC_STATUS adi_metic_FindChannelOffset(ADI_METIC_HANDLE hAde, int8_t *pBuf
                                              int32_t *pByteOffset)
 {
     ADI_METIC_STATUS status = ADI_METIC_STATUS_NO_VALID_SAMPLES;
-    ADI_METIC_WFS_CONFIG *pWfsConfig;
     ADI_METIC_WFS_INFO *pInfo;
-    uint8_t *pChannelIdEnabledBuff;
-    int32_t syncStatus;
-
-    int32_t numGoodSamples = 0;
-    int32_t requiredGoodSamples;
-    int32_t numChannelsEnabled;
-    uint32_t channelSelect;
-    int32_t numBytesSkip = 0;
-    int32_t currentPos = 0;
-    int32_t numRemainingBytes = numBytes;
+    uint32_t requiredSamples;
+    uint32_t byteOffset;
 
     if (hAde == NULL)
     {
         status = ADI_METIC_STATUS_NULL_PTR;
     }
-    else
+    else if (numBytes > 0)
     {
         pInfo = &((ADI_METIC_INFO *)hAde)->wfsData;
-        pWfsConfig = &pInfo->config;
-        pChannelIdEnabledBuff = &pInfo->channelIdEnabledBuff[0];
-        channelSelect = pWfsConfig->wfsRegConfig.channelSelect;
-        requiredGoodSamples = pWfsConfig->offsetCount;
-        numChannelsEnabled = GetNumEnabledChannels(channelSelect);
+        requiredSamples = (uint32_t)pInfo->config.offsetCount *
+                          GetNumEnabledChannels(pInfo->config.wfsRegConfig.channelSelect);
+        if (adi_metic_WfsFindSyncOffset(&pInfo->nextChannelId[0], (uint8_t *)pBuffer,
+                                        (uint32_t)numBytes, (uint32_t)channelId, requiredSamples,
+                                        &byteOffset) == 0)
+        {
+            *pByteOffset = (int32_t)byteOffset;
+            status = ADI_METIC_STATUS_SUCCESS;
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsSync(ADI_METIC_HANDLE hAde, int8_t *pSamples, int32_t numBytes,
+                                   int32_t channelId, ADI_METIC_WFS_SYNC_RESULT *pResult)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_NO_VALID_SAMPLES;
+    ADI_METIC_WFS_INFO *pInfo;
+    uint8_t *pBuffer = (uint8_t *)pSamples;
+    uint8_t *pNextChannelId;
+    uint32_t requiredSamples;
+    uint32_t byteOffset;
+    uint32_t pos;
+    uint32_t expectedId;
+    uint32_t numValidSamples = 0;
+    uint32_t numResyncs = 0;
+    uint32_t numSamples;
 
-        while (numRemainingBytes >= (numChannelsEnabled * 4))
+    if ((hAde == NULL) || (pResult == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if (numBytes > 0)
+    {
+        pInfo = &((ADI_METIC_INFO *)hAde)->wfsData;
+        pNextChannelId = &pInfo->nextChannelId[0];
+        requiredSamples = (uint32_t)pInfo->config.offsetCount *
+                          GetNumEnabledChannels(pInfo->config.wfsRegConfig.channelSelect);
+        if (adi_metic_WfsFindSyncOffset(pNextChannelId, pBuffer, (uint32_t)numBytes,
+                                        (uint32_t)channelId, requiredSamples, &byteOffset) == 0)
         {
-            syncStatus = CheckChannelPosition(&pBuffer[currentPos], pChannelIdEnabledBuff,
-                                              channelId, numChannelsEnabled);
-            if (syncStatus == 0)
+            status = ADI_METIC_STATUS_SUCCESS;
+            pResult->byteOffset = (int32_t)byteOffset;
+            pos = byteOffset;
+            expectedId = (uint32_t)channelId;
+            // Verify rest of the buffer, resynchronising locally when a byte is dropped.
+            while (pos + 4 <= (uint32_t)numBytes)
             {
-                numGoodSamples++;
-                if (numGoodSamples >= requiredGoodSamples)
+                if (pBuffer[pos] == expectedId)
+                {
+                    numValidSamples++;
+                    expectedId = GetNextChannelId(pNextChannelId, expectedId);
+                    pos += 4;
+                }
+                else if (adi_metic_WfsFindSyncOffset(pNextChannelId, &pBuffer[pos],
+                                                     (uint32_t)numBytes - pos, (uint32_t)channelId,
+                                                     requiredSamples, &byteOffset) == 0)
+                {
+                    numResyncs++;
+                    expectedId = (uint32_t)channelId;
+                    pos += byteOffset;
+                }
+                else
                 {
-                    status = ADI_METIC_STATUS_SUCCESS;
                     break;
                 }
-                numRemainingBytes -= (numChannelsEnabled * 4);
-                currentPos += (numChannelsEnabled * 4);
             }
-            else
+            numSamples = ((uint32_t)numBytes - (uint32_t)pResult->byteOffset) / 4;
+            pResult->numSamples = numSamples;
+            pResult->numValidSamples = numValidSamples;
+            pResult->numResyncs = numResyncs;
+            pResult->confidence = 0;
+            // No complete sample is left after offset if buffer ends within the first sample.
+            if (numSamples != 0)
             {
-                numRemainingBytes -= 1;
-                currentPos += 1;
-                numGoodSamples = 0;
-                numBytesSkip = currentPos;
+                pResult->confidence = (numValidSamples * 100) / numSamples;
             }
         }
-        if (numGoodSamples >= requiredGoodSamples)
-        {
-            *pByteOffset = numBytesSkip;
-        }
     }
     return status;
 }
@@ -204,6 +367,14 @@ ADI_METIC_STATUS adi_metic_WfsUartRxCallback(ADI_METIC_HANDLE hAde)
     {
         status = ADI_METIC_STATUS_NULL_PTR;
     }
+    else if (pInfo->wfsData.stream.isActive == 1)
+    {
+        // No reception is in progress while stalled.
+        if (pInfo->wfsData.stream.isStalled == 0)
+        {
+            HandleStreamBlockComplete(pInfo);
+        }
+    }
     else
     {
         pInfo->wfsData.isWfsRxComplete = 1;
@@ -212,32 +383,550 @@ ADI_METIC_STATUS adi_metic_WfsUartRxCallback(ADI_METIC_HANDLE hAde)
     return status;
 }
 
-int32_t CheckChannelPosition(int8_t *pBuffer, uint8_t *pChannelIdEnabledBuff, int32_t startChannel,
-                             int32_t numChannelsEnabled)
+ADI_METIC_STATUS adi_metic_WfsStartStream(ADI_METIC_HANDLE hAde, uint8_t *pBuffer,
+                                          uint32_t blockNumBytes, uint32_t numBlocks)
 {
-    int32_t status = 1;
-    int32_t i;
-    int32_t nextChannelIndex = 0;
-    int32_t channelId;
-    int32_t expectedChannelId = startChannel;
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_STREAM_INFO *pStream;
+    ADI_METIC_WFS_ADE9178_REG_CONFIG wfsRegConfig;
+    uint32_t i;
+    if (hAde == NULL)
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        pStream = &pInfo->wfsData.stream;
+        wfsRegConfig = pInfo->wfsData.config.wfsRegConfig;
+        if ((pBuffer == NULL) || (blockNumBytes == 0) || (numBlocks < 2) ||
+            (numBlocks > ADI_METIC_WFS_MAX_STREAM_BLOCKS))
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_STREAM_CONFIG;
+        }
+        else if ((wfsRegConfig.enable == 0) || (wfsRegConfig.channelSelect == 0))
+        {
+            status = ADI_METIC_STATUS_WFS_DISABLED;
+        }
+        else if ((pInfo->wfsData.isWfsRxComplete == 0) || (pStream->isActive == 1))
+        {
+            status = ADI_METIC_STATUS_WFS_PREV_TRANSACTION_IN_PROGRESS;
+        }
+        else
+        {
+            memset(pStream, 0, sizeof(ADI_METIC_WFS_STREAM_INFO));
+            pStream->pBuffer = pBuffer;
+            pStream->blockNumBytes = blockNumBytes;
+            pStream->numBlocks = numBlocks;
+            for (i = 0; i < ADI_METIC_WFS_MAX_CONSUMERS; i++)
+            {
+                pInfo->wfsData.consumer[i].numBlocksRead = 0;
+                pInfo->wfsData.consumer[i].maxLag = 0;
+                pInfo->wfsData.consumer[i].numSkipped = 0;
+                pInfo->wfsData.consumer[i].isHolding = 0;
+                pInfo->wfsData.consumer[i].isGapPending = 0;
+            }
+            pInfo->wfsData.isWfsRxComplete = 0;
+            pStream->isActive = 1;
+            if (ArmStreamBlock(pInfo) != 0)
+            {
+                pStream->isActive = 0;
+                pInfo->wfsData.isWfsRxComplete = 1;
+                status = ADI_METIC_STATUS_WFS_UART_COMM_ERROR;
+            }
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsStopStream(ADI_METIC_HANDLE hAde)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_STREAM_INFO *pStream;
+    if (hAde == NULL)
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        pStream = &pInfo->wfsData.stream;
+        if (pStream->isActive == 1)
+        {
+            // Callback finishes the stream after the block in progress. If reception is already
+            // stopped due to overrun, no callback will come.
+            pStream->isStopRequested = 1;
+            if (pStream->isStalled == 1)
+            {
+                pStream->isActive = 0;
+                pInfo->wfsData.isWfsRxComplete = 1;
+            }
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsGetBlock(ADI_METIC_HANDLE hAde, ADI_METIC_WFS_BLOCK *pBlock)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_STREAM_INFO *pStream;
+    uint32_t readIndex;
+    if ((hAde == NULL) || (pBlock == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pStream = &((ADI_METIC_INFO *)hAde)->wfsData.stream;
+        if (((ADI_METIC_INFO *)hAde)->wfsData.numConsumers != 0)
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_CONSUMER;
+        }
+        else if (pStream->numBlocksReceived == pStream->numBlocksReleased)
+        {
+            status = ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE;
+        }
+        else
+        {
+            readIndex = pStream->readIndex;
+            pBlock->pSamples = &pStream->pBuffer[readIndex * pStream->blockNumBytes];
+            pBlock->numBytes = pStream->blockNumBytes;
+            pBlock->sequence = pStream->blockSequence[readIndex];
+            pBlock->isGapBefore = pStream->isBlockAfterGap[readIndex];
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsReleaseBlock(ADI_METIC_HANDLE hAde)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_STREAM_INFO *pStream;
+    if (hAde == NULL)
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        pStream = &pInfo->wfsData.stream;
+        if (pInfo->wfsData.numConsumers != 0)
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_CONSUMER;
+        }
+        else if (pStream->numBlocksReceived == pStream->numBlocksReleased)
+        {
+            status = ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE;
+        }
+        else
+        {
+            pStream->readIndex++;
+            if (pStream->readIndex >= pStream->numBlocks)
+            {
+                pStream->readIndex = 0;
+            }
+            pStream->numBlocksReleased++;
+            if (ResumeStream(pInfo) != 0)
+            {
+                status = ADI_METIC_STATUS_WFS_UART_COMM_ERROR;
+            }
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsRegisterConsumer(ADI_METIC_HANDLE hAde,
+                                               ADI_METIC_WFS_CONSUMER_POLICY policy,
+                                               uint32_t *pConsumerId)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_WFS_INVALID_CONSUMER;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer;
+    uint32_t i;
+    if ((hAde == NULL) || (pConsumerId == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if (policy <= ADI_METIC_WFS_CONSUMER_DROP)
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        for (i = 0; (i < ADI_METIC_WFS_MAX_CONSUMERS) && (status != ADI_METIC_STATUS_SUCCESS); i++)
+        {
+            pConsumer = &pInfo->wfsData.consumer[i];
+            if (pConsumer->isRegistered == 0)
+            {
+                memset(pConsumer, 0, sizeof(ADI_METIC_WFS_CONSUMER_INFO));
+                pConsumer->policy = policy;
+                // Blocks already received belong to the consumers registered before.
+                pConsumer->numBlocksRead = pInfo->wfsData.stream.numBlocksReceived;
+                pConsumer->isRegistered = 1;
+                pInfo->wfsData.numConsumers++;
+                *pConsumerId = i + 1;
+                status = ADI_METIC_STATUS_SUCCESS;
+            }
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsUnregisterConsumer(ADI_METIC_HANDLE hAde, uint32_t consumerId)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer;
+    if (hAde == NULL)
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        pConsumer = GetConsumer(pInfo, consumerId);
+        if (pConsumer == NULL)
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_CONSUMER;
+        }
+        else
+        {
+            pConsumer->isRegistered = 0;
+            pInfo->wfsData.numConsumers--;
+            if (RecycleStreamBlocks(pInfo) != 0)
+            {
+                status = ADI_METIC_STATUS_WFS_UART_COMM_ERROR;
+            }
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsGetConsumerBlock(ADI_METIC_HANDLE hAde, uint32_t consumerId,
+                                               ADI_METIC_WFS_BLOCK *pBlock)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_STREAM_INFO *pStream;
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer;
+    uint32_t lag;
+    uint32_t blockIndex;
+    if ((hAde == NULL) || (pBlock == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        pStream = &pInfo->wfsData.stream;
+        pConsumer = GetConsumer(pInfo, consumerId);
+        if (pConsumer == NULL)
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_CONSUMER;
+        }
+        else
+        {
+            if (pConsumer->isHolding == 0)
+            {
+                ApplyConsumerPolicy(pInfo);
+                if (RecycleStreamBlocks(pInfo) != 0)
+                {
+                    status = ADI_METIC_STATUS_WFS_UART_COMM_ERROR;
+                }
+            }
+            lag = pStream->numBlocksReceived - pConsumer->numBlocksRead;
+            if (lag > pConsumer->maxLag)
+            {
+                pConsumer->maxLag = lag;
+            }
+            if (pConsumer->isDropped == 1)
+            {
+                status = ADI_METIC_STATUS_WFS_CONSUMER_DROPPED;
+            }
+            else if (lag == 0)
+            {
+                status = ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE;
+            }
+            else if (status == ADI_METIC_STATUS_SUCCESS)
+            {
+                // Blocks from the oldest held one to the cursor are in order in the ring.
+                blockIndex =
+                    pStream->readIndex + (pConsumer->numBlocksRead - pStream->numBlocksReleased);
+                if (blockIndex >= pStream->numBlocks)
+                {
+                    blockIndex -= pStream->numBlocks;
+                }
+                pBlock->pSamples = &pStream->pBuffer[blockIndex * pStream->blockNumBytes];
+                pBlock->numBytes = pStream->blockNumBytes;
+                pBlock->sequence = pStream->blockSequence[blockIndex];
+                pBlock->isGapBefore =
+                    pStream->isBlockAfterGap[blockIndex] | pConsumer->isGapPending;
+                pConsumer->isHolding = 1;
+            }
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsReleaseConsumerBlock(ADI_METIC_HANDLE hAde, uint32_t consumerId)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer;
+    if (hAde == NULL)
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        pConsumer = GetConsumer(pInfo, consumerId);
+        if (pConsumer == NULL)
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_CONSUMER;
+        }
+        else if (pConsumer->isDropped == 1)
+        {
+            status = ADI_METIC_STATUS_WFS_CONSUMER_DROPPED;
+        }
+        else if (pConsumer->numBlocksRead == pInfo->wfsData.stream.numBlocksReceived)
+        {
+            status = ADI_METIC_STATUS_WFS_NO_BLOCK_AVAILABLE;
+        }
+        else
+        {
+            pConsumer->numBlocksRead++;
+            pConsumer->isHolding = 0;
+            pConsumer->isGapPending = 0;
+            if (RecycleStreamBlocks(pInfo) != 0)
+            {
+                status = ADI_METIC_STATUS_WFS_UART_COMM_ERROR;
+            }
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsGetConsumerStatus(ADI_METIC_HANDLE hAde, uint32_t consumerId,
+                                                ADI_METIC_WFS_CONSUMER_STATUS *pStatus)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_INFO *pInfo;
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer;
+    uint32_t lag;
+    if ((hAde == NULL) || (pStatus == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = (ADI_METIC_INFO *)hAde;
+        pConsumer = GetConsumer(pInfo, consumerId);
+        if (pConsumer == NULL)
+        {
+            status = ADI_METIC_STATUS_WFS_INVALID_CONSUMER;
+        }
+        else
+        {
+            lag = 0;
+            if (pConsumer->isDropped == 0)
+            {
+                lag = pInfo->wfsData.stream.numBlocksReceived - pConsumer->numBlocksRead;
+            }
+            if (lag > pConsumer->maxLag)
+            {
+                pConsumer->maxLag = lag;
+            }
+            pStatus->numBlocksRead = pConsumer->numBlocksRead;
+            pStatus->lag = lag;
+            pStatus->maxLag = pConsumer->maxLag;
+            pStatus->numSkipped = pConsumer->numSkipped;
+            pStatus->isDropped = pConsumer->isDropped;
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsGetStreamStatus(ADI_METIC_HANDLE hAde,
+                                              ADI_METIC_WFS_STREAM_STATUS *pStatus)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_STREAM_INFO *pStream;
+    if ((hAde == NULL) || (pStatus == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pStream = &((ADI_METIC_INFO *)hAde)->wfsData.stream;
+        pStatus->numBlocksReceived = pStream->numBlocksReceived;
+        pStatus->numBlocksPending = pStream->numBlocksReceived - pStream->numBlocksReleased;
+        pStatus->numOverruns = pStream->numOverruns;
+        pStatus->isStreaming = pStream->isActive;
+    }
+    return status;
+}
+
+void HandleStreamBlockComplete(ADI_METIC_INFO *pInfo)
+{
+    ADI_METIC_WFS_STREAM_INFO *pStream = &pInfo->wfsData.stream;
+    uint32_t writeIndex = pStream->writeIndex;
+
+    pStream->blockSequence[writeIndex] = pStream->numBlocksReceived;
+    pStream->isBlockAfterGap[writeIndex] = pStream->isGapPending;
+    pStream->isGapPending = 0;
+    pStream->numBlocksReceived++;
 
-    // Checks all the enabled channels at positions (N+4), (N+8),...
-    for (i = 0; i < numChannelsEnabled; i++)
+    writeIndex++;
+    if (writeIndex >= pStream->numBlocks)
     {
-        channelId = pBuffer[nextChannelIndex];
-        if ((channelId != expectedChannelId))
+        writeIndex = 0;
+    }
+    pStream->writeIndex = writeIndex;
+
+    if (pStream->isStopRequested == 1)
+    {
+        pStream->isActive = 0;
+        pInfo->wfsData.isWfsRxComplete = 1;
+    }
+    else if ((pStream->numBlocksReceived - pStream->numBlocksReleased) < pStream->numBlocks)
+    {
+        if (ArmStreamBlock(pInfo) != 0)
         {
-            status = 1;
-            break;
+            pStream->isActive = 0;
+            pInfo->wfsData.isWfsRxComplete = 1;
         }
-        status = 0;
-        expectedChannelId = GeNextChannelId(pChannelIdEnabledBuff, channelId, numChannelsEnabled);
-        nextChannelIndex += 4;
     }
+    else
+    {
+        // All blocks are held by consumers. Samples are lost till a block is released.
+        pStream->numOverruns++;
+        pStream->isGapPending = 1;
+        pStream->isStalled = 1;
+    }
+}
 
+int32_t ResumeStream(ADI_METIC_INFO *pInfo)
+{
+    ADI_METIC_WFS_STREAM_INFO *pStream = &pInfo->wfsData.stream;
+    int32_t status = 0;
+
+    // No reception is in progress while stalled, so the callback cannot race with this.
+    if ((pStream->isStalled == 1) && (pStream->isActive == 1) &&
+        ((pStream->numBlocksReceived - pStream->numBlocksReleased) < pStream->numBlocks))
+    {
+        pStream->isStalled = 0;
+        status = ArmStreamBlock(pInfo);
+        if (status != 0)
+        {
+            pStream->isActive = 0;
+            pInfo->wfsData.isWfsRxComplete = 1;
+        }
+    }
     return status;
 }
 
+ADI_METIC_WFS_CONSUMER_INFO *GetConsumer(ADI_METIC_INFO *pInfo, uint32_t consumerId)
+{
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer = NULL;
+
+    if ((consumerId >= 1) && (consumerId <= ADI_METIC_WFS_MAX_CONSUMERS) &&
+        (pInfo->wfsData.consumer[consumerId - 1].isRegistered == 1))
+    {
+        pConsumer = &pInfo->wfsData.consumer[consumerId - 1];
+    }
+    return pConsumer;
+}
+
+void ApplyConsumerPolicy(ADI_METIC_INFO *pInfo)
+{
+    ADI_METIC_WFS_STREAM_INFO *pStream = &pInfo->wfsData.stream;
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer;
+    uint32_t numBlocksReleased = pStream->numBlocksReleased;
+    uint32_t numBlocksPending = pStream->numBlocksReceived - numBlocksReleased;
+    uint32_t isOldestPassed = 0;
+    uint32_t i;
+
+    for (i = 0; i < ADI_METIC_WFS_MAX_CONSUMERS; i++)
+    {
+        pConsumer = &pInfo->wfsData.consumer[i];
+        if ((pConsumer->isRegistered == 1) && (pConsumer->isDropped == 0) &&
+            (pConsumer->numBlocksRead != numBlocksReleased))
+        {
+            isOldestPassed = 1;
+        }
+    }
+    // Consumers at the oldest block hold the stream back if reception is stopped, or if the
+    // block being received is the last free one and other consumers are already ahead.
+    if ((numBlocksPending != 0) &&
+        ((pStream->isStalled == 1) ||
+         ((numBlocksPending + 1 >= pStream->numBlocks) && (isOldestPassed == 1))))
+    {
+        for (i = 0; i < ADI_METIC_WFS_MAX_CONSUMERS; i++)
+        {
+            pConsumer = &pInfo->wfsData.consumer[i];
+            if ((pConsumer->isRegistered == 1) && (pConsumer->isDropped == 0) &&
+                (pConsumer->isHolding == 0) && (pConsumer->numBlocksRead == numBlocksReleased))
+            {
+                if (pConsumer->policy == ADI_METIC_WFS_CONSUMER_SKIP)
+                {
+                    pConsumer->numBlocksRead++;
+                    pConsumer->numSkipped++;
+                    pConsumer->isGapPending = 1;
+                }
+                else if (pConsumer->policy == ADI_METIC_WFS_CONSUMER_DROP)
+                {
+                    pConsumer->isDropped = 1;
+                }
+            }
+        }
+    }
+}
+
+int32_t RecycleStreamBlocks(ADI_METIC_INFO *pInfo)
+{
+    ADI_METIC_WFS_STREAM_INFO *pStream = &pInfo->wfsData.stream;
+    ADI_METIC_WFS_CONSUMER_INFO *pConsumer;
+    uint32_t numBlocksFree = pStream->numBlocksReceived - pStream->numBlocksReleased;
+    uint32_t numBlocksPassed;
+    uint32_t i;
+
+    // Oldest block is free once passed by the slowest active consumer. Blocks are free right
+    // away if all consumers are dropped or unregistered.
+    for (i = 0; i < ADI_METIC_WFS_MAX_CONSUMERS; i++)
+    {
+        pConsumer = &pInfo->wfsData.consumer[i];
+        if ((pConsumer->isRegistered == 1) && (pConsumer->isDropped == 0))
+        {
+            numBlocksPassed = pConsumer->numBlocksRead - pStream->numBlocksReleased;
+            if (numBlocksPassed < numBlocksFree)
+            {
+                numBlocksFree = numBlocksPassed;
+            }
+        }
+    }
+    for (i = 0; i < numBlocksFree; i++)
+    {
+        pStream->readIndex++;
+        if (pStream->readIndex >= pStream->numBlocks)
+        {
+            pStream->readIndex = 0;
+        }
+    }
+    pStream->numBlocksReleased += numBlocksFree;
+
+    return ResumeStream(pInfo);
+}
+
+int32_t ArmStreamBlock(ADI_METIC_INFO *pInfo)
+{
+    ADI_METIC_WFS_STREAM_INFO *pStream = &pInfo->wfsData.stream;
+    uint8_t *pBlock = &pStream->pBuffer[pStream->writeIndex * pStream->blockNumBytes];
+
+    return pInfo->meticConfig.pfWfrmReceive(pInfo->meticConfig.hUser, pBlock,
+                                            pStream->blockNumBytes);
+}
+
 uint32_t GetBaudRate(uint8_t baudRateBit)
 {
     uint32_t baudRate;
@@ -282,50 +971,115 @@ uint16_t GetNumEnabledChannels(uint32_t channelEnable)
     return numChannelEnable;
 }
 
-void StoreChannelIdEnabled(int32_t channelSelect, uint8_t *pDst)
+void StoreNextChannelId(uint32_t channelSelect, uint8_t *pDst)
 {
-    uint8_t i = 0;
+    int32_t i;
+    int32_t firstChannel = -1;
+    int32_t prevChannel = -1;
     for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
     {
-        if ((channelSelect & (1 << i)) != 0)
+        pDst[i] = ADI_METIC_WFS_INVALID_CHANNEL_ID;
+        if ((channelSelect & (1u << i)) != 0)
         {
-            pDst[i] = i;
+            if (prevChannel >= 0)
+            {
+                pDst[prevChannel] = (uint8_t)i;
+            }
+            else
+            {
+                firstChannel = i;
+            }
+            prevChannel = i;
         }
     }
+    // Last enabled channel is followed by the first one.
+    if (prevChannel >= 0)
+    {
+        pDst[prevChannel] = (uint8_t)firstChannel;
+    }
+}
+
+uint32_t GetNextChannelId(uint8_t *pNextChannelId, uint32_t channelId)
+{
+    uint32_t nextChannelId = ADI_METIC_WFS_INVALID_CHANNEL_ID;
+    if (channelId < ADI_METIC_MAX_NUM_CHANNELS)
+    {
+        nextChannelId = pNextChannelId[channelId];
+    }
+    return nextChannelId;
 }
 
-int32_t GeNextChannelId(uint8_t *pChannelIdEnabledBuff, int32_t channelId,
-                        int32_t numChannelsEnabled)
+uint32_t CompareBytes(uint32_t a, uint32_t b)
 {
-    int32_t nextChannel = channelId;
-    int32_t pos = 0;
-    int32_t nextPos = 0;
-    int32_t numChannelsChecked = 0;
+    uint32_t diff = a ^ b;
+    // 0x80 is set in a byte lane only if the lane of diff is zero. Carries can't cross lanes.
+    uint32_t result = (diff & 0x7F7F7F7Fu) + 0x7F7F7F7Fu;
+    result = ~(result | diff | 0x7F7F7F7Fu);
+    return result;
+}
 
-    // check the next enabled channel by iterating from current channel id through all the
-    // channels(channelid - maxchannels).
+int32_t adi_metic_WfsFindSyncOffset(uint8_t *pNextChannelId, uint8_t *pBuffer, uint32_t numBytes,
+                                    uint32_t channelId, uint32_t requiredSamples,
+                                    uint32_t *pByteOffset)
+{
+    int32_t status = 1;
+    uint32_t pos;
+    uint32_t lane;
+    uint32_t word;
+    uint32_t laneBit;
+    uint32_t expected = 0;
+    uint32_t active = 0;
+    uint32_t match;
+    uint32_t start;
+    uint32_t firstId = channelId * 0x01010101u;
+    uint32_t runLength[4] = {0, 0, 0, 0};
+    uint32_t runStart[4] = {0, 0, 0, 0};
 
-    while (numChannelsChecked < numChannelsEnabled)
+    // Byte lane n of each word is the channel id byte of samples at alignment n. Words are little
+    // endian, so lane n is bits [8n+7:8n]. Masks hold 0x80 in lanes with a run in sequence, so
+    // words without any run or start of a run are skipped with two compares.
+    if (GetNextChannelId(pNextChannelId, channelId) == ADI_METIC_WFS_INVALID_CHANNEL_ID)
     {
-        nextPos = pos + 1;
-        if (pos >= numChannelsEnabled)
-        {
-            pos = 0;
-        }
-        if (nextPos >= numChannelsEnabled)
-        {
-            nextPos = 0;
-        }
-        if (pChannelIdEnabledBuff[pos] == channelId)
+        // Channel of the first sample is not enabled.
+        numBytes = 0;
+    }
+    for (pos = 0; (pos + 4 <= numBytes) && (status != 0); pos += 4)
+    {
+        memcpy(&word, &pBuffer[pos], sizeof(word));
+        match = CompareBytes(word, expected) & active;
+        start = CompareBytes(word, firstId) & ~match;
+        active = match | start;
+        if (active != 0)
         {
-            nextChannel = pChannelIdEnabledBuff[nextPos];
-            break;
+            expected = 0;
+            // Lanes are checked in address order, so the first run to complete starts earliest.
+            for (lane = 0; lane < 4; lane++)
+            {
+                laneBit = 0x80u << (8 * lane);
+                if ((active & laneBit) != 0)
+                {
+                    if ((match & laneBit) != 0)
+                    {
+                        runLength[lane]++;
+                    }
+                    else
+                    {
+                        runLength[lane] = 1;
+                        runStart[lane] = pos + lane;
+                    }
+                    if (runLength[lane] >= requiredSamples)
+                    {
+                        *pByteOffset = runStart[lane];
+                        status = 0;
+                        break;
+                    }
+                    expected |= GetNextChannelId(pNextChannelId, (word >> (8 * lane)) & 0xFF)
+                                << (8 * lane);
+                }
+            }
         }
-        pos++;
-        numChannelsChecked++;
     }
-
-    return nextChannel;
+    return status;
 }
 
 /**
@@ -0,0 +1,415 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file     adi_metic_wfs_resample.c
+ * @brief    This file contains the routines for decimating and resampling deinterleaved waveform
+ * samples to a lower rate or to a fixed number of samples per line cycle.
+ * @{
+ */
+
+/*=============  I N C L U D E S   =============*/
+
+#include "adi_metic.h"
+#include "adi_metic_status.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/** Number of bits of phase index, log2 of #ADI_METIC_WFS_RESAMPLER_NUM_PHASES */
+#define WFS_RESAMPLER_PHASE_BITS 5
+/** Number of bits of fraction between phases used to interpolate coefficients */
+#define WFS_RESAMPLER_FRACTION_BITS 16
+/** Number of taps per unit of decimation ratio */
+#define WFS_RESAMPLER_TAPS_PER_RATIO 16
+/** Cut off of filter as fraction of the lower of input and output rates */
+#define WFS_RESAMPLER_CUTOFF 0.45f
+/** Beta of Kaiser window of filter, for about 80 dB attenuation of stop band */
+#define WFS_RESAMPLER_KAISER_BETA 8.0f
+/** Number of terms of series of modified Bessel function for Kaiser window */
+#define WFS_RESAMPLER_BESSEL_NUM_TERMS 16
+/** Number of fractional bits of fixed point coefficients */
+#define WFS_RESAMPLER_COEF_BITS 30
+/** One input sample in Q32 */
+#define WFS_RESAMPLER_ONE ((uint64_t)1 << 32)
+/** Value of pi */
+#define WFS_RESAMPLER_PI 3.14159265f
+
+/**
+ * Designs coefficients of all phases of the low pass filter.
+ * @param[in]  pResampler - pointer to resampler state.
+ * @param[in]  cutoff - cut off in cycles per input sample.
+ */
+static void DesignFilter(ADI_METIC_WFS_RESAMPLER *pResampler, float cutoff);
+
+/**
+ * Returns modified Bessel function of first kind and order zero.
+ * @param[in]  x - argument.
+ */
+static float BesselI0(float x);
+
+/**
+ * Sets input samples per output sample for a line period.
+ * @param[in]  pResampler - pointer to resampler state.
+ * @param[in]  period - line period in seconds.
+ */
+static void SetSyncStep(ADI_METIC_WFS_RESAMPLER *pResampler, float period);
+
+/**
+ * Returns coefficients for the delay of an output sample. Coefficients of the two nearest phases
+ * are interpolated once per output sample and shared by all channels.
+ * @param[in]  pResampler - pointer to resampler state.
+ * @param[in]  position - delay of output sample in Q32.
+ * @return pointer to coefficients.
+ */
+static void *GetDelayCoef(ADI_METIC_WFS_RESAMPLER *pResampler, uint64_t position);
+
+/**
+ * Filters a window of fixed point samples. numTaps is a multiple of 4, four partial sums are kept
+ * so that the compiler can map the loop to multiply accumulate or SIMD instructions.
+ * @param[in]  pSrc - pointer to oldest sample of window.
+ * @param[in]  pCoef - pointer to Q30 coefficients.
+ * @param[in]  numTaps - number of taps.
+ * @return filtered sample.
+ */
+static int32_t FilterFix(int32_t *pSrc, int32_t *pCoef, uint32_t numTaps);
+
+/**
+ * Filters a window of float samples. numTaps is a multiple of 4, four partial sums are kept so
+ * that the compiler can map the loop to SIMD instructions.
+ * @param[in]  pSrc - pointer to oldest sample of window.
+ * @param[in]  pCoef - pointer to coefficients.
+ * @param[in]  numTaps - number of taps.
+ * @return filtered sample.
+ */
+static float FilterFloat(float *pSrc, float *pCoef, uint32_t numTaps);
+
+/*=============  C O D E  =============*/
+
+ADI_METIC_STATUS adi_metic_WfsResamplerInit(ADI_METIC_WFS_RESAMPLER *pResampler,
+                                            ADI_METIC_WFS_RESAMPLER_CONFIG *pConfig)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    float outputRate = 0;
+    float ratio;
+    uint32_t numTaps;
+    if ((pResampler == NULL) || (pConfig == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if ((pConfig->numChannels == 0) || (pConfig->numChannels > ADI_METIC_MAX_NUM_CHANNELS) ||
+             (pConfig->inputRate == 0) || (pConfig->format > ADI_METIC_WFS_FORMAT_SCALED))
+    {
+        status = ADI_METIC_STATUS_WFS_INVALID_RESAMPLER_CONFIG;
+    }
+    else if (pConfig->mode == ADI_METIC_WFS_RESAMPLE_RATE)
+    {
+        outputRate = (float)pConfig->outputRate;
+    }
+    else if ((pConfig->mode == ADI_METIC_WFS_RESAMPLE_SYNC) &&
+             (pConfig->nominalFrequency >= ADI_METIC_WFS_RESAMPLER_MIN_FREQUENCY) &&
+             (pConfig->nominalFrequency <= ADI_METIC_WFS_RESAMPLER_MAX_FREQUENCY))
+    {
+        outputRate = pConfig->nominalFrequency * (float)pConfig->samplesPerCycle;
+    }
+
+    if ((status == ADI_METIC_STATUS_SUCCESS) && (outputRate < 1.0f))
+    {
+        status = ADI_METIC_STATUS_WFS_INVALID_RESAMPLER_CONFIG;
+    }
+    if (status == ADI_METIC_STATUS_SUCCESS)
+    {
+        memset(pResampler, 0, sizeof(ADI_METIC_WFS_RESAMPLER));
+        pResampler->mode = pConfig->mode;
+        pResampler->format = pConfig->format;
+        pResampler->numChannels = pConfig->numChannels;
+        pResampler->inputRate = pConfig->inputRate;
+        pResampler->samplesPerCycle = pConfig->samplesPerCycle;
+        // Taps grow with decimation ratio so that the transition band stays a fixed fraction of
+        // the output rate.
+        ratio = (float)pConfig->inputRate / outputRate;
+        numTaps = WFS_RESAMPLER_TAPS_PER_RATIO * (uint32_t)ceilf(ratio);
+        if (numTaps > ADI_METIC_WFS_RESAMPLER_MAX_TAPS)
+        {
+            numTaps = ADI_METIC_WFS_RESAMPLER_MAX_TAPS;
+        }
+        pResampler->numTaps = numTaps;
+        DesignFilter(pResampler, WFS_RESAMPLER_CUTOFF * ((ratio > 1.0f) ? (1.0f / ratio) : 1.0f));
+        if (pConfig->mode == ADI_METIC_WFS_RESAMPLE_RATE)
+        {
+            pResampler->step = ((uint64_t)pConfig->inputRate << 32) / pConfig->outputRate;
+        }
+        else
+        {
+            SetSyncStep(pResampler, 1.0f / pConfig->nominalFrequency);
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsSetResamplerPeriod(ADI_METIC_WFS_RESAMPLER *pResampler,
+                                                 float period)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    if (pResampler == NULL)
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if (pResampler->mode != ADI_METIC_WFS_RESAMPLE_SYNC)
+    {
+        status = ADI_METIC_STATUS_WFS_INVALID_RESAMPLER_CONFIG;
+    }
+    else if ((period * ADI_METIC_WFS_RESAMPLER_MIN_FREQUENCY <= 1.0f) &&
+             (period * ADI_METIC_WFS_RESAMPLER_MAX_FREQUENCY >= 1.0f))
+    {
+        // Position is kept, so that output stays continuous when the period changes.
+        SetSyncStep(pResampler, period);
+    }
+    return status;
+}
+
+uint32_t adi_metic_WfsGetResampleNumFrames(ADI_METIC_WFS_RESAMPLER *pResampler,
+                                           uint32_t numFrames)
+{
+    uint32_t numOutFrames = 0;
+    uint64_t endPosition = (uint64_t)numFrames << 32;
+    // Output sample n is produced within the block if position + n * step is before its end.
+    if (endPosition > pResampler->position)
+    {
+        numOutFrames =
+            (uint32_t)((endPosition - pResampler->position + pResampler->step - 1) /
+                       pResampler->step);
+    }
+    return numOutFrames;
+}
+
+ADI_METIC_STATUS adi_metic_WfsResample(ADI_METIC_WFS_RESAMPLER *pResampler, void **ppSrc,
+                                       uint32_t numFrames, void **ppDst, uint32_t maxFrames,
+                                       uint32_t *pNumFrames)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint32_t i;
+    uint32_t ch;
+    uint32_t index;
+    uint32_t numOutFrames = 0;
+    uint32_t numTaps;
+    void *pCoef;
+    if ((pResampler == NULL) || (ppSrc == NULL) || (ppDst == NULL) || (pNumFrames == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if (adi_metic_WfsGetResampleNumFrames(pResampler, numFrames) > maxFrames)
+    {
+        status = ADI_METIC_STATUS_WFS_INSUFFICIENT_BUFFER;
+    }
+    else
+    {
+        numTaps = pResampler->numTaps;
+        for (i = 0; i < numFrames; i++)
+        {
+            // Newest sample is written at the oldest index and one window later, so that the
+            // window from the next oldest index is contiguous.
+            index = pResampler->historyIndex;
+            for (ch = 0; ch < pResampler->numChannels; ch++)
+            {
+                if (pResampler->format == ADI_METIC_WFS_FORMAT_INT32)
+                {
+                    pResampler->history.q[ch][index] = ((int32_t *)ppSrc[ch])[i];
+                    pResampler->history.q[ch][index + numTaps] = ((int32_t *)ppSrc[ch])[i];
+                }
+                else
+                {
+                    pResampler->history.f[ch][index] = ((float *)ppSrc[ch])[i];
+                    pResampler->history.f[ch][index + numTaps] = ((float *)ppSrc[ch])[i];
+                }
+            }
+            index = (index + 1 == numTaps) ? 0 : index + 1;
+            pResampler->historyIndex = index;
+
+            while (pResampler->position < WFS_RESAMPLER_ONE)
+            {
+                pCoef = GetDelayCoef(pResampler, pResampler->position);
+                for (ch = 0; ch < pResampler->numChannels; ch++)
+                {
+                    if (pResampler->format == ADI_METIC_WFS_FORMAT_INT32)
+                    {
+                        ((int32_t *)ppDst[ch])[numOutFrames] =
+                            FilterFix(&pResampler->history.q[ch][index], (int32_t *)pCoef,
+                                      numTaps);
+                    }
+                    else
+                    {
+                        ((float *)ppDst[ch])[numOutFrames] =
+                            FilterFloat(&pResampler->history.f[ch][index], (float *)pCoef,
+                                        numTaps);
+                    }
+                }
+                numOutFrames++;
+                pResampler->position += pResampler->step;
+            }
+            pResampler->position -= WFS_RESAMPLER_ONE;
+        }
+        *pNumFrames = numOutFrames;
+    }
+    return status;
+}
+
+void DesignFilter(ADI_METIC_WFS_RESAMPLER *pResampler, float cutoff)
+{
+    uint32_t phase;
+    uint32_t k;
+    uint32_t numTaps = pResampler->numTaps;
+    float halfLength = (float)numTaps / 2.0f;
+    float coef[ADI_METIC_WFS_RESAMPLER_MAX_TAPS];
+    float delay;
+    float distance;
+    float x;
+    float r;
+    float sum;
+    float i0Beta = BesselI0(WFS_RESAMPLER_KAISER_BETA);
+
+    for (phase = 0; phase <= ADI_METIC_WFS_RESAMPLER_NUM_PHASES; phase++)
+    {
+        // Phase p filters the output sample p / NUM_PHASES input samples after the centre of
+        // the window.
+        delay = (float)phase / (float)ADI_METIC_WFS_RESAMPLER_NUM_PHASES;
+        sum = 0;
+        for (k = 0; k < numTaps; k++)
+        {
+            distance = (float)k - halfLength + 1.0f - delay;
+            x = 2.0f * cutoff * distance;
+            coef[k] = 2.0f * cutoff;
+            if (x != 0)
+            {
+                coef[k] = 2.0f * cutoff * sinf(WFS_RESAMPLER_PI * x) / (WFS_RESAMPLER_PI * x);
+            }
+            r = distance / halfLength;
+            coef[k] *= (r * r < 1.0f)
+                           ? BesselI0(WFS_RESAMPLER_KAISER_BETA * sqrtf(1.0f - r * r)) / i0Beta
+                           : 0.0f;
+            sum += coef[k];
+        }
+        // Gain of every phase is normalised to 1 at DC.
+        for (k = 0; k < numTaps; k++)
+        {
+            if (pResampler->format == ADI_METIC_WFS_FORMAT_INT32)
+            {
+                pResampler->coef.q[phase][k] =
+                    (int32_t)lroundf(coef[k] / sum * (float)(1 << WFS_RESAMPLER_COEF_BITS));
+            }
+            else
+            {
+                pResampler->coef.f[phase][k] = coef[k] / sum;
+            }
+        }
+    }
+}
+
+float BesselI0(float x)
+{
+    uint32_t k;
+    float term = 1.0f;
+    float sum = 1.0f;
+    float halfX = x / 2.0f;
+    for (k = 1; k < WFS_RESAMPLER_BESSEL_NUM_TERMS; k++)
+    {
+        term *= (halfX / (float)k) * (halfX / (float)k);
+        sum += term;
+    }
+    return sum;
+}
+
+void SetSyncStep(ADI_METIC_WFS_RESAMPLER *pResampler, float period)
+{
+    float step = period * (float)pResampler->inputRate / (float)pResampler->samplesPerCycle;
+    pResampler->step = (uint64_t)(step * (float)WFS_RESAMPLER_ONE);
+}
+
+void *GetDelayCoef(ADI_METIC_WFS_RESAMPLER *pResampler, uint64_t position)
+{
+    uint32_t k;
+    uint32_t phase = (uint32_t)(position >> (32 - WFS_RESAMPLER_PHASE_BITS));
+    uint32_t fraction =
+        (uint32_t)(position >> (32 - WFS_RESAMPLER_PHASE_BITS - WFS_RESAMPLER_FRACTION_BITS)) &
+        ((1 << WFS_RESAMPLER_FRACTION_BITS) - 1);
+    float weight;
+    int32_t *pFix0;
+    int32_t *pFix1;
+    float *pFloat0;
+    float *pFloat1;
+    void *pCoef;
+
+    if (pResampler->format == ADI_METIC_WFS_FORMAT_INT32)
+    {
+        pFix0 = &pResampler->coef.q[phase][0];
+        pFix1 = &pResampler->coef.q[phase + 1][0];
+        pCoef = pFix0;
+        if (fraction != 0)
+        {
+            for (k = 0; k < pResampler->numTaps; k++)
+            {
+                pResampler->delayCoef.q[k] =
+                    pFix0[k] + (int32_t)(((int64_t)(pFix1[k] - pFix0[k]) * fraction) >>
+                                         WFS_RESAMPLER_FRACTION_BITS);
+            }
+            pCoef = &pResampler->delayCoef.q[0];
+        }
+    }
+    else
+    {
+        pFloat0 = &pResampler->coef.f[phase][0];
+        pFloat1 = &pResampler->coef.f[phase + 1][0];
+        pCoef = pFloat0;
+        if (fraction != 0)
+        {
+            weight = (float)fraction / (float)(1 << WFS_RESAMPLER_FRACTION_BITS);
+            for (k = 0; k < pResampler->numTaps; k++)
+            {
+                pResampler->delayCoef.f[k] = pFloat0[k] + (pFloat1[k] - pFloat0[k]) * weight;
+            }
+            pCoef = &pResampler->delayCoef.f[0];
+        }
+    }
+    return pCoef;
+}
+
+int32_t FilterFix(int32_t *pSrc, int32_t *pCoef, uint32_t numTaps)
+{
+    uint32_t k;
+    int64_t acc0 = 0;
+    int64_t acc1 = 0;
+    int64_t acc2 = 0;
+    int64_t acc3 = 0;
+    for (k = 0; k < numTaps; k += 4)
+    {
+        acc0 += (int64_t)pSrc[k] * pCoef[k];
+        acc1 += (int64_t)pSrc[k + 1] * pCoef[k + 1];
+        acc2 += (int64_t)pSrc[k + 2] * pCoef[k + 2];
+        acc3 += (int64_t)pSrc[k + 3] * pCoef[k + 3];
+    }
+    acc0 += acc1 + acc2 + acc3;
+    return (int32_t)((acc0 + ((int64_t)1 << (WFS_RESAMPLER_COEF_BITS - 1))) >>
+                     WFS_RESAMPLER_COEF_BITS);
+}
+
+float FilterFloat(float *pSrc, float *pCoef, uint32_t numTaps)
+{
+    uint32_t k;
+    float acc0 = 0;
+    float acc1 = 0;
+    float acc2 = 0;
+    float acc3 = 0;
+    for (k = 0; k < numTaps; k += 4)
+    {
+        acc0 += pSrc[k] * pCoef[k];
+        acc1 += pSrc[k + 1] * pCoef[k + 1];
+        acc2 += pSrc[k + 2] * pCoef[k + 2];
+        acc3 += pSrc[k + 3] * pCoef[k + 3];
+    }
+    return (acc0 + acc1) + (acc2 + acc3);
+}
+
+/**
+ * @}
+ */
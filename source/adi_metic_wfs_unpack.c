@@ -0,0 +1,625 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file     adi_metic_wfs_unpack.c
+ * @brief    This file contains the routines for reading waveform samples from any offset,
+ * deinterleaving them into an array per channel and validating the channel sequence.
+ * @{
+ */
+
+/*=============  I N C L U D E S   =============*/
+
+#include "adi_metic.h"
+#include "adi_metic_private.h"
+#include "adi_metic_status.h"
+#include <stdint.h>
+#include <string.h>
+
+/** Number of bytes in a WFS sample */
+#define WFS_SAMPLE_NUM_BYTES 4
+/** Number of frames in sequence to synchronise again after a valid frame */
+#define WFS_RESYNC_NUM_FRAMES 2
+
+/**
+ * Converts samples of a channel at every stride bytes to int32_t.
+ * @param[in]  pSrc - pointer to first sample of the channel.
+ * @param[in]  stride - number of bytes between samples of the channel.
+ * @param[in]  numFrames - number of samples to convert.
+ * @param[out]  pDst - pointer to output array.
+ */
+static void UnpackInt32(uint8_t *pSrc, uint32_t stride, uint32_t numFrames, int32_t *pDst);
+
+/**
+ * Converts samples of a channel at every stride bytes to float multiplied by scale.
+ * @param[in]  pSrc - pointer to first sample of the channel.
+ * @param[in]  stride - number of bytes between samples of the channel.
+ * @param[in]  numFrames - number of samples to convert.
+ * @param[in]  scale - scale applied to sample code.
+ * @param[out]  pDst - pointer to output array.
+ */
+static void UnpackFloat(uint8_t *pSrc, uint32_t stride, uint32_t numFrames, float scale,
+                        float *pDst);
+
+/**
+ * Sets a bit per frame if channel ids of all samples of the frame are in sequence.
+ * @param[in]  pSrc - pointer to first sample.
+ * @param[in]  pOrder - channel ids in the order expected.
+ * @param[in]  numChannels - number of channels in a frame.
+ * @param[in]  numFrames - number of frames.
+ * @param[out]  pValidMask - pointer to mask.
+ */
+static void ValidateFrames(uint8_t *pSrc, uint8_t *pOrder, uint32_t numChannels,
+                           uint32_t numFrames, uint32_t *pValidMask);
+
+/**
+ * Reads a sample from a byte address and returns 24 bit data sign extended.
+ * @param[in]  pSrc - pointer to sample.
+ */
+static int32_t ReadSample(uint8_t *pSrc);
+
+/**
+ * Checks channel ids of a frame. Valid frame is written to output after filling frames lost
+ * before it. Lost frames are not filled if they do not fit in output arrays with the valid frame,
+ * the gap is reported as a discontinuity instead. Valid frame is counted as dropped instead of
+ * valid if output arrays are full.
+ * @param[in]  pValidator - pointer to validator state.
+ * @param[in]  pFrame - pointer to first byte of frame.
+ * @param[in]  pConfig - output format and arrays.
+ * @param[out]  pQuality - quality of the block.
+ * @return 1 if frame is valid
+ */
+static uint32_t ValidateFrame(ADI_METIC_WFS_VALIDATOR *pValidator, uint8_t *pFrame,
+                              ADI_METIC_WFS_UNPACK_CONFIG *pConfig,
+                              ADI_METIC_WFS_BLOCK_QUALITY *pQuality);
+
+/**
+ * Fills frames lost between last valid frame and given frame in output.
+ * @param[in]  pValidator - pointer to validator state.
+ * @param[in]  pNextFrame - samples of the frame after the gap.
+ * @param[in]  numLostFrames - number of frames lost.
+ * @param[in]  pConfig - output format and arrays.
+ * @param[out]  pQuality - quality of the block.
+ */
+static void FillGap(ADI_METIC_WFS_VALIDATOR *pValidator, int32_t *pNextFrame,
+                    uint32_t numLostFrames, ADI_METIC_WFS_UNPACK_CONFIG *pConfig,
+                    ADI_METIC_WFS_BLOCK_QUALITY *pQuality);
+
+/**
+ * Writes samples of a frame to output arrays at index of next frame.
+ * @param[in]  pValidator - pointer to validator state.
+ * @param[in]  pFrame - samples of the frame in order of channels received.
+ * @param[in]  isValid - 1 if frame is received, 0 if filled.
+ * @param[in]  pConfig - output format and arrays.
+ * @param[out]  pQuality - quality of the block.
+ * @return 1 if frame is written, 0 if output arrays are full
+ */
+static uint32_t WriteFrame(ADI_METIC_WFS_VALIDATOR *pValidator, int32_t *pFrame, uint32_t isValid,
+                           ADI_METIC_WFS_UNPACK_CONFIG *pConfig,
+                           ADI_METIC_WFS_BLOCK_QUALITY *pQuality);
+
+/*=============  C O D E  =============*/
+
+ADI_METIC_STATUS adi_metic_WfsDeinterleave(ADI_METIC_HANDLE hAde, uint8_t *pSamples,
+                                           uint32_t numBytes, int32_t channelId,
+                                           ADI_METIC_WFS_UNPACK_CONFIG *pConfig,
+                                           uint32_t *pNumFrames)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_INFO *pInfo;
+    uint8_t order[ADI_METIC_MAX_NUM_CHANNELS];
+    uint32_t numChannels = 0;
+    uint32_t numFrames = 0;
+    uint32_t stride;
+    uint32_t i;
+    uint32_t channel;
+    void *pDst;
+
+    if ((hAde == NULL) || (pSamples == NULL) || (pConfig == NULL) || (pNumFrames == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = &((ADI_METIC_INFO *)hAde)->wfsData;
+        if ((channelId >= 0) && (channelId < ADI_METIC_MAX_NUM_CHANNELS))
+        {
+            numChannels =
+                adi_metic_WfsGetChannelOrder(&pInfo->nextChannelId[0], (uint32_t)channelId, order);
+        }
+        if (numChannels == 0)
+        {
+            status = ADI_METIC_STATUS_NO_VALID_SAMPLES;
+        }
+    }
+
+    if (status == ADI_METIC_STATUS_SUCCESS)
+    {
+        stride = numChannels * WFS_SAMPLE_NUM_BYTES;
+        numFrames = numBytes / stride;
+        if (numFrames > pConfig->maxSamples)
+        {
+            numFrames = pConfig->maxSamples;
+        }
+        // Channel major order, so that each output array is written sequentially.
+        for (i = 0; i < numChannels; i++)
+        {
+            channel = order[i];
+            pDst = pConfig->pDst[channel];
+            if (pDst != NULL)
+            {
+                if (pConfig->format == ADI_METIC_WFS_FORMAT_INT32)
+                {
+                    UnpackInt32(&pSamples[i * WFS_SAMPLE_NUM_BYTES], stride, numFrames,
+                                (int32_t *)pDst);
+                }
+                else if (pConfig->format == ADI_METIC_WFS_FORMAT_SCALED)
+                {
+                    UnpackFloat(&pSamples[i * WFS_SAMPLE_NUM_BYTES], stride, numFrames,
+                                pConfig->scale[channel], (float *)pDst);
+                }
+                else
+                {
+                    UnpackFloat(&pSamples[i * WFS_SAMPLE_NUM_BYTES], stride, numFrames, 1.0f,
+                                (float *)pDst);
+                }
+            }
+        }
+        if (pConfig->pValidMask != NULL)
+        {
+            ValidateFrames(pSamples, order, numChannels, numFrames, pConfig->pValidMask);
+        }
+        *pNumFrames = numFrames;
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsViewInit(ADI_METIC_WFS_VIEW *pView, uint8_t *pBuffer,
+                                       uint32_t bufferNumBytes, uint32_t byteOffset,
+                                       uint32_t numBytes)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+
+    if ((pView == NULL) || (pBuffer == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if ((byteOffset >= bufferNumBytes) || (numBytes > bufferNumBytes))
+    {
+        status = ADI_METIC_STATUS_NO_VALID_SAMPLES;
+    }
+    else
+    {
+        pView->pBuffer = pBuffer;
+        pView->bufferNumBytes = bufferNumBytes;
+        pView->byteOffset = byteOffset;
+        pView->numSamples = numBytes / WFS_SAMPLE_NUM_BYTES;
+    }
+    return status;
+}
+
+uint32_t adi_metic_WfsViewRead(ADI_METIC_WFS_VIEW *pView, uint32_t firstSample,
+                               uint32_t numSamples, int32_t *pDst)
+{
+    uint32_t i = 0;
+    uint32_t j;
+    uint32_t pos;
+    uint32_t numContiguous;
+    uint32_t bufferNumBytes = pView->bufferNumBytes;
+    uint8_t sample[WFS_SAMPLE_NUM_BYTES];
+
+    if (firstSample >= pView->numSamples)
+    {
+        numSamples = 0;
+    }
+    else if (numSamples > pView->numSamples - firstSample)
+    {
+        numSamples = pView->numSamples - firstSample;
+    }
+    pos = pView->byteOffset + firstSample * WFS_SAMPLE_NUM_BYTES;
+    if (pos >= bufferNumBytes)
+    {
+        pos -= bufferNumBytes;
+    }
+    while (i < numSamples)
+    {
+        numContiguous = (bufferNumBytes - pos) / WFS_SAMPLE_NUM_BYTES;
+        if (numContiguous > 0)
+        {
+            if (numContiguous > numSamples - i)
+            {
+                numContiguous = numSamples - i;
+            }
+            // memcpy handles misaligned source.
+            memcpy(&pDst[i], &pView->pBuffer[pos], numContiguous * WFS_SAMPLE_NUM_BYTES);
+            i += numContiguous;
+            pos += numContiguous * WFS_SAMPLE_NUM_BYTES;
+        }
+        else
+        {
+            // Sample is split across end and start of the buffer.
+            for (j = 0; j < WFS_SAMPLE_NUM_BYTES; j++)
+            {
+                sample[j] = pView->pBuffer[(pos + j) % bufferNumBytes];
+            }
+            memcpy(&pDst[i], &sample[0], WFS_SAMPLE_NUM_BYTES);
+            i++;
+            pos += WFS_SAMPLE_NUM_BYTES;
+        }
+        if (pos >= bufferNumBytes)
+        {
+            pos -= bufferNumBytes;
+        }
+    }
+    return numSamples;
+}
+
+ADI_METIC_STATUS adi_metic_WfsValidatorInit(ADI_METIC_HANDLE hAde,
+                                            ADI_METIC_WFS_VALIDATOR *pValidator,
+                                            int32_t channelId, ADI_METIC_WFS_GAP_FILL gapFill)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    ADI_METIC_WFS_INFO *pInfo;
+
+    if ((hAde == NULL) || (pValidator == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        pInfo = &((ADI_METIC_INFO *)hAde)->wfsData;
+        memset(pValidator, 0, sizeof(ADI_METIC_WFS_VALIDATOR));
+        pValidator->gapFill = gapFill;
+        if ((channelId >= 0) && (channelId < ADI_METIC_MAX_NUM_CHANNELS))
+        {
+            pValidator->numChannels = adi_metic_WfsGetChannelOrder(
+                &pInfo->nextChannelId[0], (uint32_t)channelId, &pValidator->order[0]);
+        }
+        if (pValidator->numChannels == 0)
+        {
+            status = ADI_METIC_STATUS_NO_VALID_SAMPLES;
+        }
+    }
+    return status;
+}
+
+ADI_METIC_STATUS adi_metic_WfsValidateBlock(ADI_METIC_HANDLE hAde,
+                                            ADI_METIC_WFS_VALIDATOR *pValidator,
+                                            ADI_METIC_WFS_BLOCK *pBlock,
+                                            ADI_METIC_WFS_UNPACK_CONFIG *pConfig,
+                                            ADI_METIC_WFS_BLOCK_QUALITY *pQuality)
+{
+    ADI_METIC_STATUS status = ADI_METIC_STATUS_SUCCESS;
+    uint8_t *pSamples;
+    uint32_t numBytes;
+    uint32_t numFrameBytes;
+    uint32_t numCopyBytes;
+    uint32_t pos = 0;
+    uint32_t byteOffset;
+    uint32_t requiredSamples;
+    ADI_METIC_WFS_INFO *pInfo;
+
+    if ((hAde == NULL) || (pValidator == NULL) || (pBlock == NULL) || (pConfig == NULL) ||
+        (pQuality == NULL))
+    {
+        status = ADI_METIC_STATUS_NULL_PTR;
+    }
+    else if (pValidator->numChannels > 0)
+    {
+        memset(pQuality, 0, sizeof(ADI_METIC_WFS_BLOCK_QUALITY));
+        pInfo = &((ADI_METIC_INFO *)hAde)->wfsData;
+        pSamples = pBlock->pSamples;
+        numBytes = pBlock->numBytes;
+        numFrameBytes = pValidator->numChannels * WFS_SAMPLE_NUM_BYTES;
+        if (pBlock->isGapBefore == 1)
+        {
+            // Number of frames lost in an overrun is unknown, synchronise again without filling.
+            pValidator->numPartialBytes = 0;
+            pValidator->isSynced = 0;
+            pValidator->hasLastFrame = 0;
+            pValidator->numSkippedBytes = 0;
+        }
+        if (pValidator->numPartialBytes > 0)
+        {
+            // Completes frame started in previous block.
+            numCopyBytes = numFrameBytes - pValidator->numPartialBytes;
+            if (numCopyBytes > numBytes)
+            {
+                numCopyBytes = numBytes;
+            }
+            memcpy(&pValidator->partialFrame[pValidator->numPartialBytes], pSamples,
+                   numCopyBytes);
+            pValidator->numPartialBytes += numCopyBytes;
+            pos = numCopyBytes;
+            if (pValidator->numPartialBytes == numFrameBytes)
+            {
+                pValidator->numPartialBytes = 0;
+                if (ValidateFrame(pValidator, &pValidator->partialFrame[0], pConfig, pQuality) ==
+                    0)
+                {
+                    pValidator->numSkippedBytes += numFrameBytes;
+                }
+            }
+        }
+        while (pos < numBytes)
+        {
+            if (pValidator->isSynced == 0)
+            {
+                // Stream was in sequence before a loss, so fewer frames are enough to lock again
+                // and less samples are discarded near the end of a block.
+                requiredSamples = (uint32_t)pInfo->config.offsetCount * pValidator->numChannels;
+                if (pValidator->hasLastFrame == 1)
+                {
+                    requiredSamples = WFS_RESYNC_NUM_FRAMES * pValidator->numChannels;
+                }
+                if (adi_metic_WfsFindSyncOffset(&pInfo->nextChannelId[0], &pSamples[pos],
+                                                numBytes - pos, pValidator->order[0],
+                                                requiredSamples, &byteOffset) == 0)
+                {
+                    pos += byteOffset;
+                    pValidator->numSkippedBytes += byteOffset;
+                    pQuality->numDiscardedBytes += byteOffset;
+                    pValidator->isSynced = 1;
+                }
+                else
+                {
+                    pValidator->numSkippedBytes += numBytes - pos;
+                    pQuality->numDiscardedBytes += numBytes - pos;
+                    pos = numBytes;
+                }
+            }
+            else if (pos + numFrameBytes <= numBytes)
+            {
+                // Invalid frame is searched again for synchronisation from the same position.
+                if (ValidateFrame(pValidator, &pSamples[pos], pConfig, pQuality) == 1)
+                {
+                    pos += numFrameBytes;
+                }
+            }
+            else
+            {
+                pValidator->numPartialBytes = numBytes - pos;
+                memcpy(&pValidator->partialFrame[0], &pSamples[pos], numBytes - pos);
+                pos = numBytes;
+            }
+        }
+        if ((pQuality->numValidFrames + pQuality->numLostFrames) > 0)
+        {
+            pQuality->quality = (pQuality->numValidFrames * 100) /
+                                (pQuality->numValidFrames + pQuality->numLostFrames);
+        }
+    }
+    return status;
+}
+
+uint32_t adi_metic_WfsGetChannelOrder(uint8_t *pNextChannelId, uint32_t channelId,
+                                      uint8_t *pOrder)
+{
+    uint32_t numChannels = 0;
+    uint32_t channel = channelId;
+
+    if (pNextChannelId[channelId] != ADI_METIC_WFS_INVALID_CHANNEL_ID)
+    {
+        do
+        {
+            pOrder[numChannels] = (uint8_t)channel;
+            numChannels++;
+            channel = pNextChannelId[channel];
+        } while ((channel != channelId) && (numChannels < ADI_METIC_MAX_NUM_CHANNELS));
+    }
+    return numChannels;
+}
+
+void UnpackInt32(uint8_t *pSrc, uint32_t stride, uint32_t numFrames, int32_t *pDst)
+{
+    uint32_t i = 0;
+
+    // Four samples per iteration keeps the loads back to back.
+    for (; i + 4 <= numFrames; i += 4)
+    {
+        pDst[i] = ReadSample(pSrc);
+        pDst[i + 1] = ReadSample(pSrc + stride);
+        pDst[i + 2] = ReadSample(pSrc + 2 * stride);
+        pDst[i + 3] = ReadSample(pSrc + 3 * stride);
+        pSrc += 4 * stride;
+    }
+    for (; i < numFrames; i++)
+    {
+        pDst[i] = ReadSample(pSrc);
+        pSrc += stride;
+    }
+}
+
+void UnpackFloat(uint8_t *pSrc, uint32_t stride, uint32_t numFrames, float scale, float *pDst)
+{
+    uint32_t i = 0;
+
+    for (; i + 4 <= numFrames; i += 4)
+    {
+        pDst[i] = (float)ReadSample(pSrc) * scale;
+        pDst[i + 1] = (float)ReadSample(pSrc + stride) * scale;
+        pDst[i + 2] = (float)ReadSample(pSrc + 2 * stride) * scale;
+        pDst[i + 3] = (float)ReadSample(pSrc + 3 * stride) * scale;
+        pSrc += 4 * stride;
+    }
+    for (; i < numFrames; i++)
+    {
+        pDst[i] = (float)ReadSample(pSrc) * scale;
+        pSrc += stride;
+    }
+}
+
+void ValidateFrames(uint8_t *pSrc, uint8_t *pOrder, uint32_t numChannels, uint32_t numFrames,
+                    uint32_t *pValidMask)
+{
+    uint32_t frame;
+    uint32_t i;
+    uint32_t isValid;
+
+    memset(pValidMask, 0, ((numFrames + 31) / 32) * sizeof(uint32_t));
+    for (frame = 0; frame < numFrames; frame++)
+    {
+        isValid = 1;
+        for (i = 0; i < numChannels; i++)
+        {
+            if (pSrc[i * WFS_SAMPLE_NUM_BYTES] != pOrder[i])
+            {
+                isValid = 0;
+                break;
+            }
+        }
+        pValidMask[frame / 32] |= isValid << (frame % 32);
+        pSrc += numChannels * WFS_SAMPLE_NUM_BYTES;
+    }
+}
+
+uint32_t ValidateFrame(ADI_METIC_WFS_VALIDATOR *pValidator, uint8_t *pFrame,
+                       ADI_METIC_WFS_UNPACK_CONFIG *pConfig, ADI_METIC_WFS_BLOCK_QUALITY *pQuality)
+{
+    uint32_t isValid = 1;
+    uint32_t i;
+    uint32_t numLostFrames;
+    uint32_t numFrameBytes = pValidator->numChannels * WFS_SAMPLE_NUM_BYTES;
+    int32_t frame[ADI_METIC_MAX_NUM_CHANNELS];
+
+    for (i = 0; i < pValidator->numChannels; i++)
+    {
+        if (pFrame[i * WFS_SAMPLE_NUM_BYTES] != pValidator->order[i])
+        {
+            isValid = 0;
+            pValidator->isSynced = 0;
+            break;
+        }
+        frame[i] = ReadSample(&pFrame[i * WFS_SAMPLE_NUM_BYTES]);
+    }
+    if (isValid == 1)
+    {
+        if ((pValidator->numSkippedBytes > 0) && (pValidator->hasLastFrame == 1))
+        {
+            // A dropped byte skips one frame less a byte, so nearest number of frames is taken.
+            numLostFrames = (pValidator->numSkippedBytes + numFrameBytes / 2) / numFrameBytes;
+            pValidator->numLostFrames += numLostFrames;
+            pValidator->numResyncs++;
+            pQuality->numLostFrames += numLostFrames;
+            pQuality->numResyncs++;
+            if (pQuality->numFrames + numLostFrames + 1 > pConfig->maxSamples)
+            {
+                pQuality->numDiscontinuities++;
+                pQuality->discontinuityFrame = pQuality->numFrames;
+            }
+            else if (pValidator->gapFill != ADI_METIC_WFS_GAP_FILL_NONE)
+            {
+                FillGap(pValidator, &frame[0], numLostFrames, pConfig, pQuality);
+            }
+        }
+        pValidator->numSkippedBytes = 0;
+        if (WriteFrame(pValidator, &frame[0], 1, pConfig, pQuality) == 1)
+        {
+            pValidator->numValidFrames++;
+            pQuality->numValidFrames++;
+        }
+        else
+        {
+            pQuality->numDroppedFrames++;
+        }
+        memcpy(&pValidator->lastFrame[0], &frame[0], pValidator->numChannels * sizeof(int32_t));
+        pValidator->hasLastFrame = 1;
+    }
+    return isValid;
+}
+
+void FillGap(ADI_METIC_WFS_VALIDATOR *pValidator, int32_t *pNextFrame, uint32_t numLostFrames,
+             ADI_METIC_WFS_UNPACK_CONFIG *pConfig, ADI_METIC_WFS_BLOCK_QUALITY *pQuality)
+{
+    uint32_t i;
+    uint32_t k;
+    int64_t delta;
+    int32_t frame[ADI_METIC_MAX_NUM_CHANNELS];
+
+    for (k = 1; k <= numLostFrames; k++)
+    {
+        for (i = 0; i < pValidator->numChannels; i++)
+        {
+            if (pValidator->gapFill == ADI_METIC_WFS_GAP_FILL_HOLD)
+            {
+                frame[i] = pValidator->lastFrame[i];
+            }
+            else if (pValidator->gapFill == ADI_METIC_WFS_GAP_FILL_LINEAR)
+            {
+                delta = (int64_t)pNextFrame[i] - pValidator->lastFrame[i];
+                frame[i] = pValidator->lastFrame[i] +
+                           (int32_t)((delta * (int64_t)k) / (int64_t)(numLostFrames + 1));
+            }
+            else
+            {
+                frame[i] = 0;
+            }
+        }
+        if (WriteFrame(pValidator, &frame[0], 0, pConfig, pQuality) == 0)
+        {
+            break;
+        }
+        pQuality->numFilledFrames++;
+    }
+}
+
+uint32_t WriteFrame(ADI_METIC_WFS_VALIDATOR *pValidator, int32_t *pFrame, uint32_t isValid,
+                    ADI_METIC_WFS_UNPACK_CONFIG *pConfig, ADI_METIC_WFS_BLOCK_QUALITY *pQuality)
+{
+    uint32_t isWritten = 0;
+    uint32_t i;
+    uint32_t channel;
+    uint32_t index = pQuality->numFrames;
+    void *pDst;
+
+    if (index < pConfig->maxSamples)
+    {
+        for (i = 0; i < pValidator->numChannels; i++)
+        {
+            channel = pValidator->order[i];
+            pDst = pConfig->pDst[channel];
+            if (pDst != NULL)
+            {
+                if (pConfig->format == ADI_METIC_WFS_FORMAT_INT32)
+                {
+                    ((int32_t *)pDst)[index] = pFrame[i];
+                }
+                else if (pConfig->format == ADI_METIC_WFS_FORMAT_SCALED)
+                {
+                    ((float *)pDst)[index] = (float)pFrame[i] * pConfig->scale[channel];
+                }
+                else
+                {
+                    ((float *)pDst)[index] = (float)pFrame[i];
+                }
+            }
+        }
+        if (pConfig->pValidMask != NULL)
+        {
+            if (isValid == 1)
+            {
+                pConfig->pValidMask[index / 32] |= (1u << (index % 32));
+            }
+            else
+            {
+                pConfig->pValidMask[index / 32] &= ~(1u << (index % 32));
+            }
+        }
+        pQuality->numFrames++;
+        isWritten = 1;
+    }
+    return isWritten;
+}
+
+int32_t ReadSample(uint8_t *pSrc)
+{
+    int32_t sample;
+    // Sample is data[31:8] | channel_id[7:0] in little endian order.
+    memcpy(&sample, pSrc, sizeof(sample));
+    return sample >> 8;
+}
+
+/**
+ * @}
+ */
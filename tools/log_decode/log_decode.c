@@ -0,0 +1,209 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        log_decode.c
+ * @brief       Host tool to format messages sent by "setlog deferred" of the evaluation firmware.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "deferred_log_table.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/** Maximum number of characters in a line of input */
+#define MAX_LINE_NUM_CHARS 4096
+/** Position of number of arguments in header word of a message */
+#define NUM_ARGS_POS 12
+/** Position of sequence number in header word of a message */
+#define SEQUENCE_POS 16
+/** Maximum number of arguments of a message */
+#define MAX_NUM_ARGS 2
+
+/**
+ * Message of the table
+ */
+typedef struct
+{
+    /** Level of message */
+    const char *pLevel;
+    /** Format of message */
+    const char *pFormat;
+} LOG_MESSAGE;
+
+/** Expands an entry of #DEFERRED_LOG_TABLE into its level and format */
+#define DEFERRED_LOG_ENTRY(id, level, format) {#level, format},
+/** Messages in order of ids */
+static const LOG_MESSAGE messages[] = {DEFERRED_LOG_TABLE};
+#undef DEFERRED_LOG_ENTRY
+
+/**
+ * Decodes base64 text up to first character outside the alphabet.
+ * @param[in]  pText - pointer to text.
+ * @param[out]  pDst - pointer to output.
+ * @param[in]  maxNumBytes - size of output.
+ * @return number of bytes decoded.
+ */
+static uint32_t DecodeBase64(char *pText, uint8_t *pDst, uint32_t maxNumBytes);
+
+/**
+ * Returns value of a base64 character.
+ * @param[in]  c - character.
+ * @return value from 0 to 63, -1 if character is outside the alphabet.
+ */
+static int32_t GetBase64Value(char c);
+
+/**
+ * Reads a 32 bit word little endian.
+ * @param[in]  pSrc - pointer to word.
+ * @return word
+ */
+static uint32_t ReadWord(uint8_t *pSrc);
+
+/*=============  C O D E  =============*/
+
+int main(int argc, char *argv[])
+{
+    int status = 0;
+    uint32_t i;
+    uint32_t offset;
+    uint32_t numBytes;
+    uint32_t header;
+    uint32_t id;
+    uint32_t numArgs;
+    uint32_t sequence;
+    uint32_t nextSequence = 0;
+    uint32_t numMessages = 0;
+    uint32_t numDropped = 0;
+    uint32_t numInvalid = 0;
+    uint32_t args[MAX_NUM_ARGS];
+    uint32_t numIds = sizeof(messages) / sizeof(messages[0]);
+    char *pText;
+    FILE *pFile = stdin;
+    static char line[MAX_LINE_NUM_CHARS];
+    static uint8_t data[MAX_LINE_NUM_CHARS];
+
+    if (argc > 1)
+    {
+        pFile = fopen(argv[1], "r");
+        if (pFile == NULL)
+        {
+            fprintf(stderr, "Cannot open %s\n", argv[1]);
+            status = 1;
+        }
+    }
+    // Each line has whole messages. Other lines, like command echo, are ignored.
+    while ((status == 0) && (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        if ((pText = strstr(line, "L:")) != NULL)
+        {
+            numBytes = DecodeBase64(pText + 2, data, sizeof(data));
+            offset = 0;
+            while (offset + 4 <= numBytes)
+            {
+                header = ReadWord(&data[offset]);
+                id = header & ((1u << NUM_ARGS_POS) - 1);
+                numArgs = (header >> NUM_ARGS_POS) & 0xF;
+                sequence = header >> SEQUENCE_POS;
+                memset(args, 0, sizeof(args));
+                for (i = 0; (i < numArgs) && (i < MAX_NUM_ARGS); i++)
+                {
+                    args[i] = (offset + 8 + 4 * i <= numBytes) ? ReadWord(&data[offset + 4 + 4 * i])
+                                                               : 0;
+                }
+                // Sequence counts dropped messages too
+                if (numMessages > 0)
+                {
+                    numDropped += (sequence - nextSequence) & 0xFFFF;
+                }
+                nextSequence = sequence + 1;
+                if ((id < numIds) && (numArgs <= MAX_NUM_ARGS))
+                {
+                    printf("%s: ", messages[id].pLevel);
+                    printf(messages[id].pFormat, args[0], args[1]);
+                    printf("\n");
+                }
+                else
+                {
+                    printf("Unknown message id %u, table of a different build?\n", id);
+                    numInvalid++;
+                }
+                numMessages++;
+                offset += 4 * (numArgs + 1);
+            }
+        }
+    }
+    if (status == 0)
+    {
+        fprintf(stderr, "%u messages, %u dropped, %u unknown\n", numMessages, numDropped,
+                numInvalid);
+    }
+    if ((pFile != NULL) && (pFile != stdin))
+    {
+        fclose(pFile);
+    }
+    return status;
+}
+
+uint32_t ReadWord(uint8_t *pSrc)
+{
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) | ((uint32_t)pSrc[2] << 16) |
+           ((uint32_t)pSrc[3] << 24);
+}
+
+uint32_t DecodeBase64(char *pText, uint8_t *pDst, uint32_t maxNumBytes)
+{
+    uint32_t numBytes = 0;
+    uint32_t value = 0;
+    uint32_t numBits = 0;
+    int32_t digit;
+
+    while (((digit = GetBase64Value(*pText)) >= 0) && (numBytes < maxNumBytes))
+    {
+        value = (value << 6) | (uint32_t)digit;
+        numBits += 6;
+        if (numBits >= 8)
+        {
+            numBits -= 8;
+            pDst[numBytes] = (uint8_t)(value >> numBits);
+            numBytes++;
+        }
+        pText++;
+    }
+    return numBytes;
+}
+
+int32_t GetBase64Value(char c)
+{
+    int32_t value = -1;
+
+    if ((c >= 'A') && (c <= 'Z'))
+    {
+        value = c - 'A';
+    }
+    else if ((c >= 'a') && (c <= 'z'))
+    {
+        value = c - 'a' + 26;
+    }
+    else if ((c >= '0') && (c <= '9'))
+    {
+        value = c - '0' + 52;
+    }
+    else if (c == '+')
+    {
+        value = 62;
+    }
+    else if (c == '/')
+    {
+        value = 63;
+    }
+    return value;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,323 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        output_decode.c
+ * @brief       Host tool to decode frames of metrology outputs displayed by the "setformat"
+ * modes of the evaluation firmware into comma separated values.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_metic.h"
+#include "adi_metic_status.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/** Maximum number of characters in a line of input */
+#define MAX_LINE_NUM_CHARS 4096
+/** Number of bytes of stream kept while looking for frames */
+#define MAX_STREAM_NUM_BYTES (MAX_LINE_NUM_CHARS + ADI_METIC_OUTPUT_FRAME_MAX_NUM_BYTES)
+/** Number of fields of a frame */
+#define NUM_FIELDS 17
+/** Offset of values in a frame, after sync, length, format, IRQ0 count, timestamp and field
+ * mask */
+#define VALUE_OFFSET 16
+/** Field of energy, with low and high registers in fixed format */
+#define ENERGY_FIELD_MASK                                                                          \
+    (ADI_METIC_OUTPUT_FIELD_WATTHR_POS | ADI_METIC_OUTPUT_FIELD_WATTHR_NEG |                       \
+     ADI_METIC_OUTPUT_FIELD_WATTHR_SIGNED | ADI_METIC_OUTPUT_FIELD_VAHR)
+
+/**
+ * Names of values of a field
+ */
+typedef struct
+{
+    /** Number of values */
+    uint32_t numValues;
+    /** Names of values */
+    const char *pName[ADI_METIC_MAX_NUM_CHANNELS];
+} FIELD_NAMES;
+
+/** Names of channels of RMS fields */
+#define RMS_NAMES(suffix)                                                                          \
+    {ADI_METIC_MAX_NUM_CHANNELS,                                                                   \
+     {"AV" suffix, "AI" suffix, "BV" suffix, "BI" suffix, "CV" suffix, "CI" suffix,                \
+      "AUX0" suffix, "AUX1" suffix, "AUX2" suffix, "AUX3" suffix, "AUX4" suffix, "AUX5" suffix}}
+/** Names of phases of power and energy fields */
+#define PHASE_NAMES(suffix)                                                                        \
+    {ADI_METIC_MAX_NUM_POWER_CHANNELS, {"A" suffix, "B" suffix, "C" suffix}}
+
+/** Names in order of bits of #ADI_METIC_OUTPUT_FIELD, as registers of the ADE9178 */
+static const FIELD_NAMES fieldNames[NUM_FIELDS] = {
+    RMS_NAMES("RMS"),
+    RMS_NAMES("RMS_HALF"),
+    RMS_NAMES("RMS_ONE"),
+    RMS_NAMES("DIP_HALF"),
+    RMS_NAMES("DIP_ONE"),
+    RMS_NAMES("SWELL_HALF"),
+    RMS_NAMES("SWELL_ONE"),
+    PHASE_NAMES("WATT"),
+    PHASE_NAMES("VA"),
+    PHASE_NAMES("PF"),
+    PHASE_NAMES("WATTHR_POS"),
+    PHASE_NAMES("WATTHR_NEG"),
+    PHASE_NAMES("WATTHR"),
+    PHASE_NAMES("VAHR"),
+    {9,
+     {"ANGL_AV_BV", "ANGL_BV_CV", "ANGL_AV_CV", "ANGL_AV_AI", "ANGL_BV_BI", "ANGL_CV_CI",
+      "ANGL_AI_BI", "ANGL_BI_CI", "ANGL_AI_CI"}},
+    {4, {"APERIOD", "BPERIOD", "CPERIOD", "COM_PERIOD"}},
+    {5, {"STATUS0", "STATUS1", "STATUS2", "STATUS3", "ERROR_STATUS"}}};
+
+/**
+ * Decodes base64 text up to first character outside the alphabet.
+ * @param[in]  pText - pointer to text.
+ * @param[out]  pDst - pointer to output.
+ * @param[in]  maxNumBytes - size of output.
+ * @return number of bytes decoded.
+ */
+static uint32_t DecodeBase64(char *pText, uint8_t *pDst, uint32_t maxNumBytes);
+
+/**
+ * Returns value of a base64 character.
+ * @param[in]  c - character.
+ * @return value from 0 to 63, -1 if character is outside the alphabet.
+ */
+static int32_t GetBase64Value(char c);
+
+/**
+ * Reads a 32 bit word little endian.
+ * @param[in]  pSrc - pointer to word.
+ * @return word
+ */
+static uint32_t ReadWord(uint8_t *pSrc);
+
+/**
+ * Prints a row of header names for fields present.
+ * @param[in]  fieldMask - fields present.
+ */
+static void PrintHeader(uint32_t fieldMask);
+
+/**
+ * Prints a row of values of a frame.
+ * @param[in]  pFrame - pointer to header of frame.
+ * @param[in]  pSrc - pointer to frame.
+ */
+static void PrintValues(ADI_METIC_OUTPUT_FRAME *pFrame, uint8_t *pSrc);
+
+/*=============  C O D E  =============*/
+
+int main(int argc, char *argv[])
+{
+    int status = 0;
+    uint32_t numBytes = 0;
+    uint32_t numSrcBytes;
+    uint32_t offset;
+    uint32_t lastFieldMask = 0;
+    uint32_t lastIrqCount = 0;
+    uint32_t numFrames = 0;
+    uint32_t numCrcErrors = 0;
+    uint32_t numDiscardedBytes = 0;
+    uint32_t numMissedCycles = 0;
+    char *pText;
+    FILE *pFile = stdin;
+    ADI_METIC_STATUS frameStatus;
+    ADI_METIC_OUTPUT_FRAME frame;
+    static ADI_METIC_OUTPUT output;
+    static ADI_METIC_OUTPUT_FIX outputFix;
+    static char line[MAX_LINE_NUM_CHARS];
+    static uint8_t stream[MAX_STREAM_NUM_BYTES];
+
+    if (argc > 1)
+    {
+        pFile = fopen(argv[1], "r");
+        if (pFile == NULL)
+        {
+            fprintf(stderr, "Cannot open %s\n", argv[1]);
+            status = 1;
+        }
+    }
+    // Lines of a frame are joined into a stream. Other lines, like command echo, are ignored.
+    while ((status == 0) && (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        if ((pText = strstr(line, "F:")) != NULL)
+        {
+            numBytes += DecodeBase64(pText + 2, &stream[numBytes], sizeof(stream) - numBytes);
+            offset = 0;
+            frameStatus = ADI_METIC_STATUS_SUCCESS;
+            while ((offset < numBytes) &&
+                   (frameStatus != ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER))
+            {
+                frameStatus = adi_metic_DecodeOutputFrame(&stream[offset], numBytes - offset,
+                                                          &frame, &output, &outputFix,
+                                                          &numSrcBytes);
+                if (frameStatus == ADI_METIC_STATUS_SUCCESS)
+                {
+                    if ((numFrames > 0) && (frame.irqCount > lastIrqCount + 1))
+                    {
+                        numMissedCycles += frame.irqCount - lastIrqCount - 1;
+                    }
+                    if ((numFrames == 0) || (frame.fieldMask != lastFieldMask))
+                    {
+                        PrintHeader(frame.fieldMask);
+                        lastFieldMask = frame.fieldMask;
+                    }
+                    PrintValues(&frame, &stream[offset]);
+                    lastIrqCount = frame.irqCount;
+                    numFrames++;
+                    offset += numSrcBytes;
+                }
+                else if (frameStatus != ADI_METIC_STATUS_OUTPUT_FRAME_INSUFFICIENT_BUFFER)
+                {
+                    // Resynchronise on next sync byte
+                    if (frameStatus == ADI_METIC_STATUS_FRAME_CRC_ERROR)
+                    {
+                        numCrcErrors++;
+                    }
+                    numDiscardedBytes++;
+                    offset++;
+                }
+            }
+            numBytes -= offset;
+            memmove(&stream[0], &stream[offset], numBytes);
+        }
+    }
+    if (status == 0)
+    {
+        fprintf(stderr, "%u frames, %u missed cycles, %u CRC errors, %u discarded bytes\n",
+                numFrames, numMissedCycles, numCrcErrors, numDiscardedBytes);
+    }
+    if ((pFile != NULL) && (pFile != stdin))
+    {
+        fclose(pFile);
+    }
+    return status;
+}
+
+void PrintHeader(uint32_t fieldMask)
+{
+    uint32_t i;
+    uint32_t j;
+
+    printf("irq_count,time_us");
+    for (i = 0; i < NUM_FIELDS; i++)
+    {
+        if ((fieldMask & (1u << i)) != 0)
+        {
+            for (j = 0; j < fieldNames[i].numValues; j++)
+            {
+                printf(",%s", fieldNames[i].pName[j]);
+            }
+        }
+    }
+    printf("\n");
+}
+
+void PrintValues(ADI_METIC_OUTPUT_FRAME *pFrame, uint8_t *pSrc)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t word;
+    int64_t energy;
+    float value;
+    uint8_t *pValue = pSrc + VALUE_OFFSET;
+
+    printf("%u,%u", pFrame->irqCount, pFrame->timestamp);
+    for (i = 0; i < NUM_FIELDS; i++)
+    {
+        if ((pFrame->fieldMask & (1u << i)) != 0)
+        {
+            for (j = 0; j < fieldNames[i].numValues; j++)
+            {
+                word = ReadWord(pValue);
+                pValue += 4;
+                if ((1u << i) == ADI_METIC_OUTPUT_FIELD_STATUS)
+                {
+                    printf(",0x%08X", word);
+                }
+                else if (pFrame->format == ADI_METIC_OUTPUT_FRAME_FLOAT)
+                {
+                    memcpy(&value, &word, sizeof(value));
+                    printf(",%.7g", value);
+                }
+                else if (((1u << i) & ENERGY_FIELD_MASK) != 0)
+                {
+                    // Low register followed by high register, combined as in
+                    // adi_metic_ConvertEnergy
+                    energy = ((int64_t)(int32_t)ReadWord(pValue) << ADI_METIC_ENERGY_HI_POS) |
+                             (int64_t)(int32_t)word;
+                    pValue += 4;
+                    printf(",%lld", (long long)energy);
+                }
+                else
+                {
+                    printf(",%d", (int)(int32_t)word);
+                }
+            }
+        }
+    }
+    printf("\n");
+}
+
+uint32_t ReadWord(uint8_t *pSrc)
+{
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) | ((uint32_t)pSrc[2] << 16) |
+           ((uint32_t)pSrc[3] << 24);
+}
+
+uint32_t DecodeBase64(char *pText, uint8_t *pDst, uint32_t maxNumBytes)
+{
+    uint32_t numBytes = 0;
+    uint32_t value = 0;
+    uint32_t numBits = 0;
+    int32_t digit;
+
+    while (((digit = GetBase64Value(*pText)) >= 0) && (numBytes < maxNumBytes))
+    {
+        value = (value << 6) | (uint32_t)digit;
+        numBits += 6;
+        if (numBits >= 8)
+        {
+            numBits -= 8;
+            pDst[numBytes] = (uint8_t)(value >> numBits);
+            numBytes++;
+        }
+        pText++;
+    }
+    return numBytes;
+}
+
+int32_t GetBase64Value(char c)
+{
+    int32_t value = -1;
+
+    if ((c >= 'A') && (c <= 'Z'))
+    {
+        value = c - 'A';
+    }
+    else if ((c >= 'a') && (c <= 'z'))
+    {
+        value = c - 'a' + 26;
+    }
+    else if ((c >= '0') && (c <= '9'))
+    {
+        value = c - '0' + 52;
+    }
+    else if (c == '+')
+    {
+        value = 62;
+    }
+    else if (c == '/')
+    {
+        value = 63;
+    }
+    return value;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,550 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        wfs_capture.c
+ * @brief       Writer and memory mapped reader of binary capture files of waveform samples.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "wfs_capture.h"
+#include "adi_metic.h"
+#include "adi_metic_status.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** Number of bytes in a WFS sample */
+#define WFS_SAMPLE_NUM_BYTES 4
+/** Alignment of records in file */
+#define WFS_CAPTURE_ALIGN 8
+/** Size of buffer of file stream of writer */
+#define WFS_CAPTURE_WRITE_BUFFER_NUM_BYTES (1024 * 1024)
+/** Number of index entries allocated at a time */
+#define WFS_CAPTURE_INDEX_GROWTH 1024
+
+/**
+ * Adds an entry to a growing seek index.
+ * @param[in]  ppIndex - pointer to index, reallocated when full.
+ * @param[in]  pMaxBlocks - pointer to number of entries allocated.
+ * @param[in]  numBlocks - number of entries in use.
+ * @param[in]  firstFrame - first frame of block.
+ * @param[in]  offset - offset of block.
+ * @return 0 on success
+ */
+static int32_t AddIndexEntry(WFS_CAPTURE_INDEX_ENTRY **ppIndex, uint64_t *pMaxBlocks,
+                             uint64_t numBlocks, uint64_t firstFrame, uint64_t offset);
+
+/**
+ * Uses seek index of trailer if valid, else rebuilds it by scanning block headers.
+ * @param[in]  pReader - pointer to reader.
+ * @return 0 on success
+ */
+static int32_t LoadIndex(WFS_CAPTURE_READER *pReader);
+
+/**
+ * Checks that a block header at an offset and its payload lie in the mapped file.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  offset - offset of block.
+ * @return 1 if block is valid
+ */
+static int32_t IsBlockValid(WFS_CAPTURE_READER *pReader, uint64_t offset);
+
+/**
+ * Checks that entries of seek index point to aligned block headers in the mapped file, in
+ * order of offset and frame. Headers themselves are checked when blocks are read.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  pIndex - pointer to index.
+ * @param[in]  numBlocks - number of entries.
+ * @return 1 if index is valid
+ */
+static int32_t IsIndexValid(WFS_CAPTURE_READER *pReader, const WFS_CAPTURE_INDEX_ENTRY *pIndex,
+                            uint64_t numBlocks);
+
+/**
+ * Returns number of bytes of payload rounded up to alignment of records.
+ * @param[in]  numBytes - number of bytes.
+ */
+static uint64_t GetPaddedSize(uint64_t numBytes);
+
+/**
+ * Initialises codec state for a block, prediction history cleared.
+ * @param[in]  pHeader - pointer to file header.
+ * @param[out]  pCodec - pointer to codec state.
+ */
+static void InitBlockCodec(const WFS_CAPTURE_FILE_HEADER *pHeader, ADI_METIC_WFS_CODEC *pCodec);
+
+/*=============  C O D E  =============*/
+
+int32_t WfsCaptureCreate(WFS_CAPTURE_WRITER *pWriter, const char *pPath,
+                         WFS_CAPTURE_CONFIG *pConfig)
+{
+    int32_t status = 0;
+    WFS_CAPTURE_FILE_HEADER *pHeader = &pWriter->header;
+
+    memset(pWriter, 0, sizeof(WFS_CAPTURE_WRITER));
+    if ((pConfig->numChannels == 0) || (pConfig->numChannels > ADI_METIC_MAX_NUM_CHANNELS) ||
+        (pConfig->payloadType > WFS_CAPTURE_PAYLOAD_COMPRESSED))
+    {
+        status = 1;
+    }
+    if (status == 0)
+    {
+        pHeader->magic = WFS_CAPTURE_FILE_MAGIC;
+        pHeader->version = WFS_CAPTURE_VERSION;
+        pHeader->headerNumBytes = sizeof(WFS_CAPTURE_FILE_HEADER);
+        memcpy(&pHeader->wfsConfig, &pConfig->wfsRegConfig, sizeof(pHeader->wfsConfig));
+        pHeader->samplingRate = pConfig->samplingRate;
+        pHeader->timestamp = pConfig->timestamp;
+        pHeader->payloadType = pConfig->payloadType;
+        pHeader->numChannels = pConfig->numChannels;
+        memcpy(&pHeader->order[0], &pConfig->order[0], pConfig->numChannels);
+        if (pConfig->payloadType == WFS_CAPTURE_PAYLOAD_COMPRESSED)
+        {
+            pWriter->pPayload =
+                malloc(ADI_METIC_WFS_CODEC_PACKET_MAX_NUM_BYTES(WFS_CAPTURE_PACKET_NUM_FRAMES,
+                                                                pConfig->numChannels) *
+                       (WFS_CAPTURE_MAX_BLOCK_FRAMES / WFS_CAPTURE_PACKET_NUM_FRAMES));
+            status = (pWriter->pPayload == NULL) ? 1 : 0;
+        }
+    }
+    if (status == 0)
+    {
+        pWriter->pFile = fopen(pPath, "wb");
+        status = (pWriter->pFile == NULL) ? 1 : 0;
+    }
+    if (status == 0)
+    {
+        // Blocks are small compared to a soak capture, a large stream buffer keeps writes long.
+        setvbuf(pWriter->pFile, NULL, _IOFBF, WFS_CAPTURE_WRITE_BUFFER_NUM_BYTES);
+        if (fwrite(pHeader, sizeof(WFS_CAPTURE_FILE_HEADER), 1, pWriter->pFile) != 1)
+        {
+            status = 1;
+        }
+        pWriter->offset = sizeof(WFS_CAPTURE_FILE_HEADER);
+    }
+    return status;
+}
+
+int32_t WfsCaptureWriteBlock(WFS_CAPTURE_WRITER *pWriter, uint8_t *pSamples, uint32_t numFrames,
+                             uint32_t flags)
+{
+    int32_t status = 0;
+    uint32_t i;
+    uint32_t numPacketFrames;
+    uint32_t numPacketBytes;
+    uint32_t frameNumBytes = pWriter->header.numChannels * WFS_SAMPLE_NUM_BYTES;
+    uint32_t maxPacketNumBytes;
+    uint32_t paddingNumBytes;
+    uint8_t *pPayload = pSamples;
+    uint8_t padding[WFS_CAPTURE_ALIGN] = {0};
+    ADI_METIC_WFS_CODEC codec;
+    WFS_CAPTURE_BLOCK_HEADER block = {0};
+
+    if ((numFrames == 0) || (numFrames > WFS_CAPTURE_MAX_BLOCK_FRAMES))
+    {
+        status = 1;
+    }
+    else if (pWriter->header.payloadType == WFS_CAPTURE_PAYLOAD_COMPRESSED)
+    {
+        pPayload = pWriter->pPayload;
+        maxPacketNumBytes = ADI_METIC_WFS_CODEC_PACKET_MAX_NUM_BYTES(
+            WFS_CAPTURE_PACKET_NUM_FRAMES, pWriter->header.numChannels);
+        InitBlockCodec(&pWriter->header, &codec);
+        for (i = 0; (i < numFrames) && (status == 0); i += numPacketFrames)
+        {
+            numPacketFrames = numFrames - i;
+            if (numPacketFrames > WFS_CAPTURE_PACKET_NUM_FRAMES)
+            {
+                numPacketFrames = WFS_CAPTURE_PACKET_NUM_FRAMES;
+            }
+            if (adi_metic_WfsEncode(&codec, pSamples + i * frameNumBytes,
+                                    numPacketFrames * frameNumBytes,
+                                    pPayload + block.payloadNumBytes, maxPacketNumBytes,
+                                    &numPacketBytes) != ADI_METIC_STATUS_SUCCESS)
+            {
+                status = 1;
+            }
+            block.payloadNumBytes += numPacketBytes;
+        }
+    }
+    else
+    {
+        block.payloadNumBytes = numFrames * frameNumBytes;
+    }
+
+    if (status == 0)
+    {
+        block.magic = WFS_CAPTURE_BLOCK_MAGIC;
+        block.firstFrame = pWriter->numFrames;
+        block.numFrames = numFrames;
+        block.flags = flags;
+        status = AddIndexEntry(&pWriter->pIndex, &pWriter->maxBlocks, pWriter->numBlocks,
+                               pWriter->numFrames, pWriter->offset);
+    }
+    if (status == 0)
+    {
+        paddingNumBytes = GetPaddedSize(block.payloadNumBytes) - block.payloadNumBytes;
+        if ((fwrite(&block, sizeof(block), 1, pWriter->pFile) != 1) ||
+            (fwrite(pPayload, 1, block.payloadNumBytes, pWriter->pFile) != block.payloadNumBytes) ||
+            (fwrite(padding, 1, paddingNumBytes, pWriter->pFile) != paddingNumBytes))
+        {
+            status = 1;
+        }
+        pWriter->numBlocks++;
+        pWriter->numFrames += numFrames;
+        pWriter->offset += sizeof(block) + GetPaddedSize(block.payloadNumBytes);
+    }
+    return status;
+}
+
+int32_t WfsCaptureClose(WFS_CAPTURE_WRITER *pWriter)
+{
+    int32_t status = 0;
+    WFS_CAPTURE_TRAILER trailer = {0};
+
+    if (pWriter->pFile != NULL)
+    {
+        trailer.indexOffset = pWriter->offset;
+        trailer.numBlocks = pWriter->numBlocks;
+        trailer.numFrames = pWriter->numFrames;
+        trailer.magic = WFS_CAPTURE_TRAILER_MAGIC;
+        if ((fwrite(pWriter->pIndex, sizeof(WFS_CAPTURE_INDEX_ENTRY), pWriter->numBlocks,
+                    pWriter->pFile) != pWriter->numBlocks) ||
+            (fwrite(&trailer, sizeof(trailer), 1, pWriter->pFile) != 1))
+        {
+            status = 1;
+        }
+        if (fclose(pWriter->pFile) != 0)
+        {
+            status = 1;
+        }
+    }
+    free(pWriter->pIndex);
+    free(pWriter->pPayload);
+    memset(pWriter, 0, sizeof(WFS_CAPTURE_WRITER));
+    return status;
+}
+
+int32_t WfsCaptureOpen(WFS_CAPTURE_READER *pReader, const char *pPath)
+{
+    int32_t status = 0;
+    int fd;
+    void *pData = MAP_FAILED;
+    struct stat fileStat;
+
+    memset(pReader, 0, sizeof(WFS_CAPTURE_READER));
+    fd = open(pPath, O_RDONLY);
+    if (fd < 0)
+    {
+        status = 1;
+    }
+    else
+    {
+        if ((fstat(fd, &fileStat) == 0) &&
+            ((uint64_t)fileStat.st_size >= sizeof(WFS_CAPTURE_FILE_HEADER)))
+        {
+            pData = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        // Mapping stays valid after the descriptor is closed.
+        close(fd);
+        if (pData == MAP_FAILED)
+        {
+            status = 1;
+        }
+    }
+    if (status == 0)
+    {
+        // Blocks are mostly read front to back, read ahead lets page faults stream from disk.
+        madvise(pData, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+        pReader->pData = pData;
+        pReader->numBytes = (uint64_t)fileStat.st_size;
+        pReader->pHeader = (const WFS_CAPTURE_FILE_HEADER *)pData;
+        if ((pReader->pHeader->magic != WFS_CAPTURE_FILE_MAGIC) ||
+            (pReader->pHeader->version != WFS_CAPTURE_VERSION) ||
+            (pReader->pHeader->headerNumBytes < sizeof(WFS_CAPTURE_FILE_HEADER)) ||
+            (pReader->pHeader->headerNumBytes % WFS_CAPTURE_ALIGN != 0) ||
+            (pReader->pHeader->numChannels == 0) ||
+            (pReader->pHeader->numChannels > ADI_METIC_MAX_NUM_CHANNELS))
+        {
+            status = 1;
+        }
+    }
+    if (status == 0)
+    {
+        status = LoadIndex(pReader);
+    }
+    if ((status != 0) && (pData != MAP_FAILED))
+    {
+        WfsCaptureUnmap(pReader);
+    }
+    return status;
+}
+
+int32_t WfsCaptureGetBlock(WFS_CAPTURE_READER *pReader, uint64_t index, WFS_CAPTURE_BLOCK *pBlock)
+{
+    int32_t status = 0;
+
+    // Offsets of a seek index and header fields are not trusted, the file may be damaged.
+    if ((index < pReader->numBlocks) && (IsBlockValid(pReader, pReader->pIndex[index].offset) == 1))
+    {
+        pBlock->pHeader =
+            (const WFS_CAPTURE_BLOCK_HEADER *)(pReader->pData + pReader->pIndex[index].offset);
+        pBlock->pPayload = (const uint8_t *)(pBlock->pHeader + 1);
+    }
+    else
+    {
+        status = 1;
+    }
+    return status;
+}
+
+int32_t WfsCaptureFindFrame(WFS_CAPTURE_READER *pReader, uint64_t frame, uint64_t *pIndex)
+{
+    int32_t status = 1;
+    uint64_t low = 0;
+    uint64_t high = pReader->numBlocks;
+    uint64_t mid;
+    WFS_CAPTURE_BLOCK block;
+
+    // Last block starting at or before the frame.
+    while (high - low > 1)
+    {
+        mid = low + (high - low) / 2;
+        if (pReader->pIndex[mid].firstFrame <= frame)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if (WfsCaptureGetBlock(pReader, low, &block) == 0)
+    {
+        if ((frame >= block.pHeader->firstFrame) &&
+            (frame < block.pHeader->firstFrame + block.pHeader->numFrames))
+        {
+            *pIndex = low;
+            status = 0;
+        }
+    }
+    return status;
+}
+
+int32_t WfsCaptureDecodeBlock(WFS_CAPTURE_READER *pReader, WFS_CAPTURE_BLOCK *pBlock,
+                              int32_t *pDst)
+{
+    int32_t status = 0;
+    uint32_t i;
+    uint32_t numSrcBytes;
+    uint32_t numPacketFrames;
+    uint32_t offset = 0;
+    uint32_t numChannels = pReader->pHeader->numChannels;
+    uint32_t numSamples = pBlock->pHeader->numFrames * numChannels;
+    int32_t word;
+    ADI_METIC_WFS_CODEC codec;
+
+    if (pBlock->pHeader->numFrames > WFS_CAPTURE_MAX_BLOCK_FRAMES)
+    {
+        status = 1;
+    }
+    else if (pReader->pHeader->payloadType == WFS_CAPTURE_PAYLOAD_COMPRESSED)
+    {
+        InitBlockCodec(pReader->pHeader, &codec);
+        for (i = 0; (i < pBlock->pHeader->numFrames) && (status == 0); i += numPacketFrames)
+        {
+            if (adi_metic_WfsDecode(&codec, (uint8_t *)pBlock->pPayload + offset,
+                                    pBlock->pHeader->payloadNumBytes - offset,
+                                    pDst + i * numChannels, pBlock->pHeader->numFrames - i,
+                                    &numSrcBytes, &numPacketFrames) != ADI_METIC_STATUS_SUCCESS)
+            {
+                status = 1;
+            }
+            else if (numPacketFrames == 0)
+            {
+                status = 1;
+            }
+            offset += numSrcBytes;
+        }
+    }
+    else if (pBlock->pHeader->payloadNumBytes < numSamples * WFS_SAMPLE_NUM_BYTES)
+    {
+        status = 1;
+    }
+    else
+    {
+        for (i = 0; i < numSamples; i++)
+        {
+            memcpy(&word, pBlock->pPayload + i * WFS_SAMPLE_NUM_BYTES, sizeof(word));
+            pDst[i] = word >> 8;
+        }
+    }
+    return status;
+}
+
+void WfsCaptureUnmap(WFS_CAPTURE_READER *pReader)
+{
+    if (pReader->pData != NULL)
+    {
+        munmap((void *)pReader->pData, (size_t)pReader->numBytes);
+    }
+    free(pReader->pScannedIndex);
+    memset(pReader, 0, sizeof(WFS_CAPTURE_READER));
+}
+
+int32_t LoadIndex(WFS_CAPTURE_READER *pReader)
+{
+    int32_t status = 0;
+    uint64_t offset = pReader->pHeader->headerNumBytes;
+    uint64_t maxBlocks = 0;
+    const WFS_CAPTURE_TRAILER *pTrailer = NULL;
+    const WFS_CAPTURE_BLOCK_HEADER *pBlock;
+
+    if (pReader->numBytes >= offset + sizeof(WFS_CAPTURE_TRAILER))
+    {
+        pTrailer = (const WFS_CAPTURE_TRAILER *)(pReader->pData + pReader->numBytes -
+                                                  sizeof(WFS_CAPTURE_TRAILER));
+        if ((pTrailer->magic != WFS_CAPTURE_TRAILER_MAGIC) ||
+            (pTrailer->numBlocks >
+             (pReader->numBytes - offset) / sizeof(WFS_CAPTURE_INDEX_ENTRY)) ||
+            (pTrailer->indexOffset < offset) || (pTrailer->indexOffset > pReader->numBytes) ||
+            (pTrailer->indexOffset % WFS_CAPTURE_ALIGN != 0) ||
+            (pTrailer->indexOffset + pTrailer->numBlocks * sizeof(WFS_CAPTURE_INDEX_ENTRY) +
+                 sizeof(WFS_CAPTURE_TRAILER) !=
+             pReader->numBytes))
+        {
+            pTrailer = NULL;
+        }
+    }
+    if ((pTrailer != NULL) &&
+        (IsIndexValid(pReader,
+                      (const WFS_CAPTURE_INDEX_ENTRY *)(pReader->pData + pTrailer->indexOffset),
+                      pTrailer->numBlocks) == 0))
+    {
+        // Blocks are scanned as if the capture was not closed.
+        pTrailer = NULL;
+    }
+    if (pTrailer != NULL)
+    {
+        pReader->pIndex = (const WFS_CAPTURE_INDEX_ENTRY *)(pReader->pData + pTrailer->indexOffset);
+        pReader->numBlocks = pTrailer->numBlocks;
+        pReader->numFrames = pTrailer->numFrames;
+    }
+    else
+    {
+        // Capture was not closed, blocks written completely are kept.
+        while ((status == 0) && (offset + sizeof(WFS_CAPTURE_BLOCK_HEADER) <= pReader->numBytes))
+        {
+            pBlock = (const WFS_CAPTURE_BLOCK_HEADER *)(pReader->pData + offset);
+            if (IsBlockValid(pReader, offset) == 1)
+            {
+                status = AddIndexEntry(&pReader->pScannedIndex, &maxBlocks, pReader->numBlocks,
+                                       pBlock->firstFrame, offset);
+                pReader->numBlocks++;
+                pReader->numFrames = pBlock->firstFrame + pBlock->numFrames;
+                offset +=
+                    sizeof(WFS_CAPTURE_BLOCK_HEADER) + GetPaddedSize(pBlock->payloadNumBytes);
+            }
+            else
+            {
+                offset = pReader->numBytes;
+            }
+        }
+        pReader->pIndex = pReader->pScannedIndex;
+    }
+    return status;
+}
+
+int32_t AddIndexEntry(WFS_CAPTURE_INDEX_ENTRY **ppIndex, uint64_t *pMaxBlocks,
+                      uint64_t numBlocks, uint64_t firstFrame, uint64_t offset)
+{
+    int32_t status = 0;
+    WFS_CAPTURE_INDEX_ENTRY *pIndex = *ppIndex;
+
+    if (numBlocks >= *pMaxBlocks)
+    {
+        pIndex = realloc(pIndex, (size_t)(*pMaxBlocks + WFS_CAPTURE_INDEX_GROWTH) *
+                                     sizeof(WFS_CAPTURE_INDEX_ENTRY));
+        if (pIndex == NULL)
+        {
+            status = 1;
+        }
+        else
+        {
+            *ppIndex = pIndex;
+            *pMaxBlocks += WFS_CAPTURE_INDEX_GROWTH;
+        }
+    }
+    if (status == 0)
+    {
+        pIndex[numBlocks].firstFrame = firstFrame;
+        pIndex[numBlocks].offset = offset;
+    }
+    return status;
+}
+
+int32_t IsBlockValid(WFS_CAPTURE_READER *pReader, uint64_t offset)
+{
+    int32_t isValid = 0;
+    uint64_t maxPayloadNumBytes;
+    const WFS_CAPTURE_BLOCK_HEADER *pBlock;
+
+    if ((offset >= pReader->pHeader->headerNumBytes) && (offset % WFS_CAPTURE_ALIGN == 0) &&
+        (offset <= pReader->numBytes - sizeof(WFS_CAPTURE_BLOCK_HEADER)))
+    {
+        pBlock = (const WFS_CAPTURE_BLOCK_HEADER *)(pReader->pData + offset);
+        maxPayloadNumBytes = pReader->numBytes - offset - sizeof(WFS_CAPTURE_BLOCK_HEADER);
+        if ((pBlock->magic == WFS_CAPTURE_BLOCK_MAGIC) &&
+            (pBlock->payloadNumBytes <= maxPayloadNumBytes) &&
+            (pBlock->numFrames <= WFS_CAPTURE_MAX_BLOCK_FRAMES))
+        {
+            isValid = 1;
+        }
+    }
+    return isValid;
+}
+
+int32_t IsIndexValid(WFS_CAPTURE_READER *pReader, const WFS_CAPTURE_INDEX_ENTRY *pIndex,
+                     uint64_t numBlocks)
+{
+    int32_t isValid = 1;
+    uint64_t i;
+
+    for (i = 0; (i < numBlocks) && (isValid == 1); i++)
+    {
+        if ((pIndex[i].offset < pReader->pHeader->headerNumBytes) ||
+            (pIndex[i].offset % WFS_CAPTURE_ALIGN != 0) ||
+            (pIndex[i].offset > pReader->numBytes - sizeof(WFS_CAPTURE_BLOCK_HEADER)) ||
+            ((i > 0) && ((pIndex[i].offset <= pIndex[i - 1].offset) ||
+                         (pIndex[i].firstFrame < pIndex[i - 1].firstFrame))))
+        {
+            isValid = 0;
+        }
+    }
+    return isValid;
+}
+
+uint64_t GetPaddedSize(uint64_t numBytes)
+{
+    return (numBytes + WFS_CAPTURE_ALIGN - 1) & ~(uint64_t)(WFS_CAPTURE_ALIGN - 1);
+}
+
+void InitBlockCodec(const WFS_CAPTURE_FILE_HEADER *pHeader, ADI_METIC_WFS_CODEC *pCodec)
+{
+    memset(pCodec, 0, sizeof(ADI_METIC_WFS_CODEC));
+    pCodec->numChannels = pHeader->numChannels;
+    memcpy(&pCodec->order[0], &pHeader->order[0], pHeader->numChannels);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,290 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        wfs_capture.h
+ * @brief       Binary capture file of waveform samples for host analysis, with a writer and a
+ * memory mapped reader.
+ *
+ * A capture file is laid out as below. All fields are little endian and every record starts at a
+ * multiple of 8 bytes, so that the reader accesses records in place in the mapped file.
+ *
+ *      WFS_CAPTURE_FILE_HEADER
+ *      WFS_CAPTURE_BLOCK_HEADER, payload, padding to 8 bytes     (repeated per block)
+ *      WFS_CAPTURE_INDEX_ENTRY                                   (one per block)
+ *      WFS_CAPTURE_TRAILER
+ *
+ * Payload of a raw block is WFS words of whole frames, synchronised to the first channel of
+ * WFS_CAPTURE_FILE_HEADER.order. Payload of a compressed block is packets of
+ * #adi_metic_WfsEncode with prediction history cleared at the start of the block, so that every
+ * block decodes on its own. A file without trailer, for example of a capture interrupted before
+ * #WfsCaptureClose, is read by scanning block headers.
+ * @{
+ */
+
+#ifndef __WFS_CAPTURE_H__
+#define __WFS_CAPTURE_H__
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_metic.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Magic of file header */
+#define WFS_CAPTURE_FILE_MAGIC 0x43465741u
+/** Magic of block header */
+#define WFS_CAPTURE_BLOCK_MAGIC 0x4B4C4241u
+/** Magic of trailer */
+#define WFS_CAPTURE_TRAILER_MAGIC 0x58444941u
+/** Version of capture file format */
+#define WFS_CAPTURE_VERSION 1
+/** Payload of blocks is WFS words */
+#define WFS_CAPTURE_PAYLOAD_RAW 0
+/** Payload of blocks is compressed with #adi_metic_WfsEncode */
+#define WFS_CAPTURE_PAYLOAD_COMPRESSED 1
+/** Block flag set if frames were lost before the block */
+#define WFS_CAPTURE_BLOCK_FLAG_GAP_BEFORE 0x1u
+/** Number of frames in a packet of a compressed block */
+#define WFS_CAPTURE_PACKET_NUM_FRAMES 256
+/** Maximum number of frames in a block */
+#define WFS_CAPTURE_MAX_BLOCK_FRAMES 65536
+
+/**
+ * Header at the start of a capture file.
+ */
+typedef struct
+{
+    /** #WFS_CAPTURE_FILE_MAGIC */
+    uint32_t magic;
+    /** #WFS_CAPTURE_VERSION */
+    uint16_t version;
+    /** Size of this header in bytes */
+    uint16_t headerNumBytes;
+    /** WFS_CONFIG register, same bits as ADI_METIC_WFS_ADE9178_REG_CONFIG */
+    uint32_t wfsConfig;
+    /** Sampling rate of a channel in Hz */
+    uint32_t samplingRate;
+    /** Start time of capture in microseconds since 1970 */
+    uint64_t timestamp;
+    /** #WFS_CAPTURE_PAYLOAD_RAW or #WFS_CAPTURE_PAYLOAD_COMPRESSED */
+    uint8_t payloadType;
+    /** Number of channels in a frame */
+    uint8_t numChannels;
+    /** Channel ids in the order of samples of a frame */
+    uint8_t order[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Reserved */
+    uint8_t reserved[2];
+
+} WFS_CAPTURE_FILE_HEADER;
+
+/**
+ * Header before payload of a block.
+ */
+typedef struct
+{
+    /** #WFS_CAPTURE_BLOCK_MAGIC */
+    uint32_t magic;
+    /** Number of bytes of payload, without padding */
+    uint32_t payloadNumBytes;
+    /** Index of first frame of the block from start of capture */
+    uint64_t firstFrame;
+    /** Number of frames in the block */
+    uint32_t numFrames;
+    /** Flags of block, #WFS_CAPTURE_BLOCK_FLAG_GAP_BEFORE */
+    uint32_t flags;
+
+} WFS_CAPTURE_BLOCK_HEADER;
+
+/**
+ * Entry of seek index.
+ */
+typedef struct
+{
+    /** Index of first frame of the block */
+    uint64_t firstFrame;
+    /** Offset of block header from start of file */
+    uint64_t offset;
+
+} WFS_CAPTURE_INDEX_ENTRY;
+
+/**
+ * Trailer at the end of a capture file.
+ */
+typedef struct
+{
+    /** Offset of first index entry from start of file */
+    uint64_t indexOffset;
+    /** Number of blocks */
+    uint64_t numBlocks;
+    /** Total number of frames */
+    uint64_t numFrames;
+    /** #WFS_CAPTURE_TRAILER_MAGIC */
+    uint32_t magic;
+    /** Reserved */
+    uint32_t reserved;
+
+} WFS_CAPTURE_TRAILER;
+
+/**
+ * Configuration of a capture file.
+ */
+typedef struct
+{
+    /** WFS_CONFIG register */
+    ADI_METIC_WFS_ADE9178_REG_CONFIG wfsRegConfig;
+    /** Sampling rate of a channel in Hz */
+    uint32_t samplingRate;
+    /** Start time of capture in microseconds since 1970 */
+    uint64_t timestamp;
+    /** #WFS_CAPTURE_PAYLOAD_RAW or #WFS_CAPTURE_PAYLOAD_COMPRESSED */
+    uint8_t payloadType;
+    /** Number of channels in a frame */
+    uint8_t numChannels;
+    /** Channel ids in the order of samples of a frame */
+    uint8_t order[ADI_METIC_MAX_NUM_CHANNELS];
+
+} WFS_CAPTURE_CONFIG;
+
+/**
+ * Writer of a capture file.
+ */
+typedef struct
+{
+    /** File written */
+    FILE *pFile;
+    /** Header of the file */
+    WFS_CAPTURE_FILE_HEADER header;
+    /** Offset of next block */
+    uint64_t offset;
+    /** Index of next frame */
+    uint64_t numFrames;
+    /** Seek index */
+    WFS_CAPTURE_INDEX_ENTRY *pIndex;
+    /** Number of blocks written */
+    uint64_t numBlocks;
+    /** Number of entries allocated in seek index */
+    uint64_t maxBlocks;
+    /** Compressed payload of a block */
+    uint8_t *pPayload;
+
+} WFS_CAPTURE_WRITER;
+
+/**
+ * Block of a capture file read in place.
+ */
+typedef struct
+{
+    /** Pointer to block header in the mapped file */
+    const WFS_CAPTURE_BLOCK_HEADER *pHeader;
+    /** Pointer to payload in the mapped file */
+    const uint8_t *pPayload;
+
+} WFS_CAPTURE_BLOCK;
+
+/**
+ * Memory mapped reader of a capture file.
+ */
+typedef struct
+{
+    /** Start of mapped file */
+    const uint8_t *pData;
+    /** Size of file in bytes */
+    uint64_t numBytes;
+    /** Pointer to header in the mapped file */
+    const WFS_CAPTURE_FILE_HEADER *pHeader;
+    /** Seek index, in the mapped file or rebuilt by scanning blocks */
+    const WFS_CAPTURE_INDEX_ENTRY *pIndex;
+    /** Seek index rebuilt by scanning, NULL if the file has a trailer */
+    WFS_CAPTURE_INDEX_ENTRY *pScannedIndex;
+    /** Number of blocks */
+    uint64_t numBlocks;
+    /** Total number of frames */
+    uint64_t numFrames;
+
+} WFS_CAPTURE_READER;
+
+/**
+ * @brief Creates a capture file and writes its header.
+ * @param[in]  pWriter - pointer to writer.
+ * @param[in]  pPath - path of file.
+ * @param[in]  pConfig - configuration of capture.
+ * @return 0 on success
+ */
+int32_t WfsCaptureCreate(WFS_CAPTURE_WRITER *pWriter, const char *pPath,
+                         WFS_CAPTURE_CONFIG *pConfig);
+
+/**
+ * @brief Writes a block of synchronised WFS words, compressed if configured.
+ * @param[in]  pWriter - pointer to writer.
+ * @param[in]  pSamples - pointer to WFS words of whole frames.
+ * @param[in]  numFrames - number of frames, at most #WFS_CAPTURE_MAX_BLOCK_FRAMES.
+ * @param[in]  flags - flags of block.
+ * @return 0 on success
+ */
+int32_t WfsCaptureWriteBlock(WFS_CAPTURE_WRITER *pWriter, uint8_t *pSamples, uint32_t numFrames,
+                             uint32_t flags);
+
+/**
+ * @brief Writes seek index and trailer and closes the file.
+ * @param[in]  pWriter - pointer to writer.
+ * @return 0 on success
+ */
+int32_t WfsCaptureClose(WFS_CAPTURE_WRITER *pWriter);
+
+/**
+ * @brief Maps a capture file for reading.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  pPath - path of file.
+ * @return 0 on success
+ */
+int32_t WfsCaptureOpen(WFS_CAPTURE_READER *pReader, const char *pPath);
+
+/**
+ * @brief Gets a block in place in the mapped file, without copying.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  index - index of block.
+ * @param[out]  pBlock - block.
+ * @return 0 on success, 1 if index is out of range or block does not fit in the file
+ */
+int32_t WfsCaptureGetBlock(WFS_CAPTURE_READER *pReader, uint64_t index, WFS_CAPTURE_BLOCK *pBlock);
+
+/**
+ * @brief Finds block having a frame with binary search of seek index.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  frame - index of frame from start of capture.
+ * @param[out]  pIndex - index of block.
+ * @return 0 on success
+ */
+int32_t WfsCaptureFindFrame(WFS_CAPTURE_READER *pReader, uint64_t frame, uint64_t *pIndex);
+
+/**
+ * @brief Decodes samples of a block to 24 bit codes, frame by frame.
+ * @param[in]  pReader - pointer to reader.
+ * @param[in]  pBlock - block.
+ * @param[out]  pDst - samples, numChannels * numFrames of block.
+ * @return 0 on success
+ */
+int32_t WfsCaptureDecodeBlock(WFS_CAPTURE_READER *pReader, WFS_CAPTURE_BLOCK *pBlock,
+                              int32_t *pDst);
+
+/**
+ * @brief Unmaps the file.
+ * @param[in]  pReader - pointer to reader.
+ */
+void WfsCaptureUnmap(WFS_CAPTURE_READER *pReader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WFS_CAPTURE_H__ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,540 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        wfs_capture_tool.c
+ * @brief       Host tool to import waveform samples into capture files, inspect them and export
+ * ranges of frames as comma separated values.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "wfs_capture.h"
+#include "adi_metic.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+/** Maximum number of characters in a line of input */
+#define MAX_LINE_NUM_CHARS 4096
+/** Number of frames in a block of imported samples, one second */
+#define IMPORT_BLOCK_NUM_FRAMES ADI_METIC_SAMPLING_RATE
+/** WF_SRC of WFS_CONFIG for ADC samples */
+#define IMPORT_WF_SRC_ADC_SAMPLES 0
+/** Number of channels of self test samples */
+#define SELF_TEST_NUM_CHANNELS 3
+/** Number of frames of self test samples of a signal */
+#define SELF_TEST_NUM_FRAMES 4000
+/** Number of signals of self test */
+#define SELF_TEST_NUM_SIGNALS 5
+
+/** Names of channels by channel id */
+static const char *channelName[] = {"AV",   "AI",   "BV",   "BI",   "CV",   "CI",
+                                    "AUX0", "AUX1", "AUX2", "AUX3", "AUX4", "AUX5"};
+
+/**
+ * Imports comma separated samples, as displayed by displaywfrm or decoded by wfs_decode, into a
+ * capture file.
+ * @param[in]  pInPath - path of input, "-" for standard input.
+ * @param[in]  pOutPath - path of capture file.
+ * @param[in]  payloadType - payload of blocks.
+ * @return 0 on success
+ */
+static int32_t Import(const char *pInPath, const char *pOutPath, uint8_t payloadType);
+
+/**
+ * Displays header of a capture file and reads all samples, reporting read rate.
+ * @param[in]  pPath - path of capture file.
+ * @return 0 on success
+ */
+static int32_t Info(const char *pPath);
+
+/**
+ * Exports frames of a capture file as comma separated values.
+ * @param[in]  pPath - path of capture file.
+ * @param[in]  firstFrame - first frame to export.
+ * @param[in]  numFrames - number of frames to export.
+ * @return 0 on success
+ */
+static int32_t Export(const char *pPath, uint64_t firstFrame, uint64_t numFrames);
+
+/**
+ * Compresses synthetic signals, mostly of low entropy, into chained packets of varying lengths
+ * and decompresses them in order, checking samples and the number of bytes of every packet.
+ * @return 0 if all signals are decompressed as compressed
+ */
+static int32_t SelfTest(void);
+
+/**
+ * Gets a sample of a self test signal.
+ * @param[in]  signal - signal, 0 to #SELF_TEST_NUM_SIGNALS - 1.
+ * @param[in]  frame - frame of sample.
+ * @param[in]  channel - channel of sample.
+ * @return 24 bit sample
+ */
+static int32_t GetSelfTestSample(uint32_t signal, uint32_t frame, uint32_t channel);
+
+/**
+ * Parses channel names of a line into channel ids.
+ * @param[in]  pLine - line of names separated by commas.
+ * @param[out]  pOrder - channel ids.
+ * @return number of channels, 0 if line is not a list of channel names
+ */
+static uint32_t ParseChannelNames(char *pLine, uint8_t *pOrder);
+
+/**
+ * Returns time in seconds from a monotonic clock.
+ */
+static double GetTime(void);
+
+/*=============  C O D E  =============*/
+
+int main(int argc, char *argv[])
+{
+    int32_t status = 1;
+
+    if ((argc == 4) && (strcmp(argv[1], "import") == 0))
+    {
+        status = Import(argv[2], argv[3], WFS_CAPTURE_PAYLOAD_RAW);
+    }
+    else if ((argc == 5) && (strcmp(argv[1], "import") == 0) &&
+             (strcmp(argv[4], "compressed") == 0))
+    {
+        status = Import(argv[2], argv[3], WFS_CAPTURE_PAYLOAD_COMPRESSED);
+    }
+    else if ((argc == 3) && (strcmp(argv[1], "info") == 0))
+    {
+        status = Info(argv[2]);
+    }
+    else if ((argc == 5) && (strcmp(argv[1], "export") == 0))
+    {
+        status = Export(argv[2], strtoull(argv[3], NULL, 0), strtoull(argv[4], NULL, 0));
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "selftest") == 0))
+    {
+        status = SelfTest();
+    }
+    else
+    {
+        fprintf(stderr, "Usage:\n"
+                        "  wfs_capture import <csv|-> <capture> [compressed]\n"
+                        "  wfs_capture info <capture>\n"
+                        "  wfs_capture export <capture> <first_frame> <num_frames>\n"
+                        "  wfs_capture selftest\n");
+    }
+    return (int)status;
+}
+
+int32_t Import(const char *pInPath, const char *pOutPath, uint8_t payloadType)
+{
+    int32_t status = 0;
+    uint32_t i;
+    uint32_t numFrames = 0;
+    uint32_t numValues;
+    uint32_t word;
+    int32_t sample;
+    char *pText;
+    char *pEnd;
+    FILE *pFile = stdin;
+    struct timeval now;
+    WFS_CAPTURE_CONFIG config = {0};
+    WFS_CAPTURE_WRITER writer = {0};
+    static char line[MAX_LINE_NUM_CHARS];
+    static uint32_t words[IMPORT_BLOCK_NUM_FRAMES * ADI_METIC_MAX_NUM_CHANNELS];
+
+    if (strcmp(pInPath, "-") != 0)
+    {
+        pFile = fopen(pInPath, "r");
+        status = (pFile == NULL) ? 1 : 0;
+    }
+    // Samples follow the line of channel names.
+    while ((status == 0) && (config.numChannels == 0) &&
+           (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        config.numChannels = (uint8_t)ParseChannelNames(line, &config.order[0]);
+    }
+    if ((status == 0) && (config.numChannels > 0))
+    {
+        gettimeofday(&now, NULL);
+        config.wfsRegConfig.enable = 1;
+        config.wfsRegConfig.outputType = IMPORT_WF_SRC_ADC_SAMPLES;
+        for (i = 0; i < config.numChannels; i++)
+        {
+            config.wfsRegConfig.channelSelect |= 1u << config.order[i];
+        }
+        config.samplingRate = ADI_METIC_SAMPLING_RATE;
+        config.timestamp = (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_usec;
+        config.payloadType = payloadType;
+        status = WfsCaptureCreate(&writer, pOutPath, &config);
+    }
+    else
+    {
+        fprintf(stderr, "No line of channel names in input\n");
+        status = 1;
+    }
+    while ((status == 0) && (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        pText = line;
+        pEnd = line + 1;
+        numValues = 0;
+        while ((numValues < config.numChannels) && (pEnd != pText))
+        {
+            sample = (int32_t)strtol(pText, &pEnd, 10);
+            if ((pEnd != pText) && (*pEnd == ','))
+            {
+                // Samples are stored as WFS words, so that raw blocks read like a WFS buffer.
+                word = ((uint32_t)sample << 8) | config.order[numValues];
+                words[numFrames * config.numChannels + numValues] = word;
+                numValues++;
+                pText = pEnd + 1;
+                pEnd = pText + 1;
+            }
+            else
+            {
+                pEnd = pText;
+            }
+        }
+        if (numValues == config.numChannels)
+        {
+            numFrames++;
+        }
+        if (numFrames == IMPORT_BLOCK_NUM_FRAMES)
+        {
+            status = WfsCaptureWriteBlock(&writer, (uint8_t *)&words[0], numFrames, 0);
+            numFrames = 0;
+        }
+    }
+    if ((status == 0) && (numFrames > 0))
+    {
+        status = WfsCaptureWriteBlock(&writer, (uint8_t *)&words[0], numFrames, 0);
+    }
+    if (WfsCaptureClose(&writer) != 0)
+    {
+        status = 1;
+    }
+    if ((pFile != NULL) && (pFile != stdin))
+    {
+        fclose(pFile);
+    }
+    return status;
+}
+
+int32_t Info(const char *pPath)
+{
+    int32_t status;
+    uint64_t i;
+    uint64_t numBlocks;
+    uint64_t numGaps = 0;
+    int64_t checksum = 0;
+    uint32_t j;
+    double startTime;
+    double elapsedTime;
+    WFS_CAPTURE_READER reader;
+    WFS_CAPTURE_BLOCK block;
+    const WFS_CAPTURE_FILE_HEADER *pHeader;
+    int32_t *pSamples;
+
+    status = WfsCaptureOpen(&reader, pPath);
+    if (status == 0)
+    {
+        pHeader = reader.pHeader;
+        printf("version        = %u\n", (unsigned)pHeader->version);
+        printf("wfs_config     = 0x%08" PRIx32 "\n", pHeader->wfsConfig);
+        printf("sampling_rate  = %" PRIu32 " Hz\n", pHeader->samplingRate);
+        printf("timestamp      = %" PRIu64 " us\n", pHeader->timestamp);
+        printf("payload        = %s\n",
+               (pHeader->payloadType == WFS_CAPTURE_PAYLOAD_COMPRESSED) ? "compressed" : "raw");
+        printf("channels       = ");
+        for (i = 0; i < pHeader->numChannels; i++)
+        {
+            printf("%s,", channelName[pHeader->order[i] % ADI_METIC_MAX_NUM_CHANNELS]);
+        }
+        printf("\nblocks         = %" PRIu64 "%s\n", reader.numBlocks,
+               (reader.pScannedIndex != NULL) ? " (no index, scanned)" : "");
+        printf("frames         = %" PRIu64 "\n", reader.numFrames);
+
+        pSamples = malloc(WFS_CAPTURE_MAX_BLOCK_FRAMES * ADI_METIC_MAX_NUM_CHANNELS *
+                          sizeof(int32_t));
+        status = (pSamples == NULL) ? 1 : 0;
+        numBlocks = reader.numBlocks;
+        startTime = GetTime();
+        for (i = 0; (i < numBlocks) && (status == 0); i++)
+        {
+            status = WfsCaptureGetBlock(&reader, i, &block);
+            if (status == 0)
+            {
+                status = WfsCaptureDecodeBlock(&reader, &block, pSamples);
+            }
+            if (status == 0)
+            {
+                numGaps += (block.pHeader->flags & WFS_CAPTURE_BLOCK_FLAG_GAP_BEFORE) ? 1 : 0;
+                // Sum keeps the decode from being optimised away and checks content.
+                for (j = 0; j < block.pHeader->numFrames * pHeader->numChannels; j++)
+                {
+                    checksum += pSamples[j];
+                }
+            }
+        }
+        elapsedTime = GetTime() - startTime;
+        if (status == 0)
+        {
+            printf("gaps           = %" PRIu64 "\n", numGaps);
+            printf("checksum       = %" PRId64 "\n", checksum);
+            printf("read           = %.1f MB/s, %.1f Mframes/s\n",
+                   (double)reader.numBytes / 1e6 / elapsedTime,
+                   (double)reader.numFrames / 1e6 / elapsedTime);
+        }
+        else
+        {
+            fprintf(stderr, "Invalid block %" PRIu64 "\n", i - 1);
+        }
+        free(pSamples);
+        WfsCaptureUnmap(&reader);
+    }
+    else
+    {
+        fprintf(stderr, "Cannot open capture %s\n", pPath);
+    }
+    return status;
+}
+
+int32_t Export(const char *pPath, uint64_t firstFrame, uint64_t numFrames)
+{
+    int32_t status;
+    int32_t openStatus;
+    uint64_t index = 0;
+    uint64_t frame;
+    uint64_t blockFrame;
+    uint32_t j;
+    uint32_t numChannels;
+    WFS_CAPTURE_READER reader;
+    WFS_CAPTURE_BLOCK block;
+    int32_t *pSamples = NULL;
+
+    openStatus = WfsCaptureOpen(&reader, pPath);
+    status = openStatus;
+    if (status == 0)
+    {
+        numChannels = reader.pHeader->numChannels;
+        for (j = 0; j < numChannels; j++)
+        {
+            printf("%s,", channelName[reader.pHeader->order[j] % ADI_METIC_MAX_NUM_CHANNELS]);
+        }
+        printf("\n");
+        pSamples = malloc(WFS_CAPTURE_MAX_BLOCK_FRAMES * ADI_METIC_MAX_NUM_CHANNELS *
+                          sizeof(int32_t));
+        status = (pSamples == NULL) ? 1 : 0;
+    }
+    if (status == 0)
+    {
+        // Seek index gives the first block, later blocks follow in order.
+        status = WfsCaptureFindFrame(&reader, firstFrame, &index);
+    }
+    frame = firstFrame;
+    while ((status == 0) && (frame < firstFrame + numFrames) && (index < reader.numBlocks))
+    {
+        status = WfsCaptureGetBlock(&reader, index, &block);
+        if (status == 0)
+        {
+            status = WfsCaptureDecodeBlock(&reader, &block, pSamples);
+        }
+        for (blockFrame = frame - block.pHeader->firstFrame;
+             (status == 0) && (blockFrame < block.pHeader->numFrames) &&
+             (frame < firstFrame + numFrames);
+             blockFrame++)
+        {
+            for (j = 0; j < numChannels; j++)
+            {
+                printf("%d,", (int)pSamples[blockFrame * numChannels + j]);
+            }
+            printf("\n");
+            frame++;
+        }
+        index++;
+    }
+    free(pSamples);
+    if (openStatus == 0)
+    {
+        WfsCaptureUnmap(&reader);
+    }
+    return status;
+}
+
+int32_t SelfTest(void)
+{
+    int32_t status = 0;
+    int32_t signalStatus;
+    uint32_t signal;
+    uint32_t i;
+    uint32_t j;
+    uint32_t numFrames;
+    uint32_t numPackets;
+    uint32_t numPacketFrames;
+    uint32_t numPacketBytes;
+    uint32_t numDstBytes;
+    uint32_t numSrcBytes;
+    uint32_t numDecodedFrames;
+    uint32_t frameNumBytes = SELF_TEST_NUM_CHANNELS * sizeof(uint32_t);
+    uint32_t packetNumBytes[SELF_TEST_NUM_FRAMES];
+    uint32_t word;
+    ADI_METIC_WFS_CODEC encoder = {0};
+    ADI_METIC_WFS_CODEC decoder;
+    static uint32_t words[SELF_TEST_NUM_FRAMES * SELF_TEST_NUM_CHANNELS];
+    static int32_t decoded[SELF_TEST_NUM_FRAMES * SELF_TEST_NUM_CHANNELS];
+    static uint8_t packets[ADI_METIC_WFS_CODEC_PACKET_MAX_NUM_BYTES(SELF_TEST_NUM_FRAMES,
+                                                                    SELF_TEST_NUM_CHANNELS) *
+                           2];
+    static const char *signalName[SELF_TEST_NUM_SIGNALS] = {"zero", "constant", "noise of 1 code",
+                                                            "sine of 3 codes", "full scale noise"};
+
+    encoder.numChannels = SELF_TEST_NUM_CHANNELS;
+    for (i = 0; i < SELF_TEST_NUM_CHANNELS; i++)
+    {
+        encoder.order[i] = (uint8_t)i;
+    }
+    for (signal = 0; signal < SELF_TEST_NUM_SIGNALS; signal++)
+    {
+        signalStatus = 0;
+        for (i = 0; i < SELF_TEST_NUM_FRAMES; i++)
+        {
+            for (j = 0; j < SELF_TEST_NUM_CHANNELS; j++)
+            {
+                word = ((uint32_t)GetSelfTestSample(signal, i, j) << 8) | j;
+                words[i * SELF_TEST_NUM_CHANNELS + j] = word;
+            }
+        }
+        // Packets of varying lengths end at every bit position of their last byte.
+        memset(&encoder.history[0][0], 0, sizeof(encoder.history));
+        numDstBytes = 0;
+        numPackets = 0;
+        numPacketFrames = 1;
+        for (i = 0; (i < SELF_TEST_NUM_FRAMES) && (signalStatus == 0); i += numPacketFrames)
+        {
+            numPacketFrames = numPackets % 37 + 1;
+            if (numPacketFrames > SELF_TEST_NUM_FRAMES - i)
+            {
+                numPacketFrames = SELF_TEST_NUM_FRAMES - i;
+            }
+            if (adi_metic_WfsEncode(&encoder, (uint8_t *)&words[i * SELF_TEST_NUM_CHANNELS],
+                                    numPacketFrames * frameNumBytes, &packets[numDstBytes],
+                                    sizeof(packets) - numDstBytes,
+                                    &numPacketBytes) != ADI_METIC_STATUS_SUCCESS)
+            {
+                signalStatus = 1;
+            }
+            packetNumBytes[numPackets] = numPacketBytes;
+            numDstBytes += numPacketBytes;
+            numPackets++;
+        }
+        // Packets are decoded from the rest of the buffer, as chained packets of a block are.
+        decoder = encoder;
+        memset(&decoder.history[0][0], 0, sizeof(decoder.history));
+        numSrcBytes = 0;
+        numFrames = 0;
+        for (i = 0; (i < numPackets) && (signalStatus == 0); i++)
+        {
+            if ((adi_metic_WfsDecode(&decoder, &packets[numSrcBytes], numDstBytes - numSrcBytes,
+                                     &decoded[numFrames * SELF_TEST_NUM_CHANNELS],
+                                     SELF_TEST_NUM_FRAMES - numFrames, &numPacketBytes,
+                                     &numDecodedFrames) != ADI_METIC_STATUS_SUCCESS) ||
+                (numPacketBytes != packetNumBytes[i]))
+            {
+                fprintf(stderr, "%s: packet %u of %u not decoded\n", signalName[signal],
+                        (unsigned)i, (unsigned)numPackets);
+                signalStatus = 1;
+            }
+            numSrcBytes += numPacketBytes;
+            numFrames += numDecodedFrames;
+        }
+        for (i = 0; (i < numFrames * SELF_TEST_NUM_CHANNELS) && (signalStatus == 0); i++)
+        {
+            if (decoded[i] != (int32_t)words[i] >> 8)
+            {
+                fprintf(stderr, "%s: sample %u differs\n", signalName[signal], (unsigned)i);
+                signalStatus = 1;
+            }
+        }
+        if ((signalStatus == 0) && (numFrames != SELF_TEST_NUM_FRAMES))
+        {
+            signalStatus = 1;
+        }
+        printf("%-18s: %s, %u packets, %.2f bits per sample\n", signalName[signal],
+               (signalStatus == 0) ? "pass" : "fail", (unsigned)numPackets,
+               (double)numDstBytes * 8.0 / (SELF_TEST_NUM_FRAMES * SELF_TEST_NUM_CHANNELS));
+        status |= signalStatus;
+    }
+    return status;
+}
+
+int32_t GetSelfTestSample(uint32_t signal, uint32_t frame, uint32_t channel)
+{
+    int32_t sample;
+    uint32_t random = (frame * SELF_TEST_NUM_CHANNELS + channel) * 2654435761u;
+    static const int32_t sine[16] = {0, 1, 2, 3, 3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1};
+
+    switch (signal)
+    {
+    case 0:
+        sample = 0;
+        break;
+    case 1:
+        sample = -1000 * (int32_t)(channel + 1);
+        break;
+    case 2:
+        sample = (int32_t)((random >> 16) % 3) - 1;
+        break;
+    case 3:
+        sample = sine[(frame + channel * 4) % 16];
+        break;
+    default:
+        sample = (int32_t)(random << 8) >> 8;
+        break;
+    }
+    return sample;
+}
+
+uint32_t ParseChannelNames(char *pLine, uint8_t *pOrder)
+{
+    uint32_t numChannels = 0;
+    uint32_t id;
+    uint32_t isValid = 1;
+    char *pName = strtok(pLine, ",\r\n");
+
+    while ((pName != NULL) && (isValid == 1))
+    {
+        id = 0;
+        while ((id < ADI_METIC_MAX_NUM_CHANNELS) && (strcmp(pName, channelName[id]) != 0))
+        {
+            id++;
+        }
+        if ((id == ADI_METIC_MAX_NUM_CHANNELS) || (numChannels == ADI_METIC_MAX_NUM_CHANNELS))
+        {
+            isValid = 0;
+        }
+        else
+        {
+            pOrder[numChannels] = (uint8_t)id;
+            numChannels++;
+            pName = strtok(NULL, ",\r\n");
+        }
+    }
+    return (isValid == 1) ? numChannels : 0;
+}
+
+double GetTime(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,333 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        wfs_decode.c
+ * @brief       Host tool to decode waveform samples displayed by "displaywfrm compressed" or
+ * dumped by "dumpwfrm" into comma separated values.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_metic.h"
+#include "adi_metic_status.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/** Maximum number of characters in a line of input */
+#define MAX_LINE_NUM_CHARS 4096
+/** Maximum number of frames in a packet */
+#define MAX_PACKET_NUM_FRAMES 1024
+/** Marker sent by dumpwfrm before binary data */
+#define DUMP_MARKER "WFSD"
+/** Number of bytes of marker */
+#define DUMP_MARKER_NUM_BYTES 4
+/** Maximum number of bytes searched for marker after a D: line */
+#define DUMP_MARKER_MAX_OFFSET 16
+/** Number of bytes of a raw sample */
+#define RAW_SAMPLE_NUM_BYTES 4
+
+/**
+ * Decodes base64 text up to first character outside the alphabet.
+ * @param[in]  pText - pointer to text.
+ * @param[out]  pDst - pointer to output.
+ * @param[in]  maxNumBytes - size of output.
+ * @return number of bytes decoded.
+ */
+static uint32_t DecodeBase64(char *pText, uint8_t *pDst, uint32_t maxNumBytes);
+
+/**
+ * Decodes binary data of dumpwfrm following a D: line.
+ * @param[in]  pLine - D: line.
+ * @param[in]  pFile - input, positioned after the line.
+ * @return 0 on success, 1 if dump is invalid or truncated.
+ */
+static int DecodeDump(char *pLine, FILE *pFile);
+
+/**
+ * Finds marker of binary data.
+ * @param[in]  pFile - input.
+ * @return 0 if found, 1 otherwise.
+ */
+static int FindDumpMarker(FILE *pFile);
+
+/**
+ * Prints frames of samples.
+ * @param[in]  pFrames - samples, frame after frame.
+ * @param[in]  numFrames - number of frames.
+ * @param[in]  numChannels - number of channels of a frame.
+ */
+static void PrintFrames(int32_t *pFrames, uint32_t numFrames, uint32_t numChannels);
+
+/**
+ * Returns value of a base64 character.
+ * @param[in]  c - character.
+ * @return value from 0 to 63, -1 if character is outside the alphabet.
+ */
+static int32_t GetBase64Value(char c);
+
+/** Names of channels in order of channel id */
+static const char *channelName[] = {"AV",   "AI",   "BV",   "BI",   "CV",   "CI",
+                                    "AUX0", "AUX1", "AUX2", "AUX3", "AUX4", "AUX5"};
+
+/*=============  C O D E  =============*/
+
+int main(int argc, char *argv[])
+{
+    int status = 0;
+    uint32_t i;
+    uint32_t numBytes;
+    uint32_t numSrcBytes;
+    uint32_t numFrames;
+    uint32_t isHeaderValid = 0;
+    char *pText;
+    FILE *pFile = stdin;
+    ADI_METIC_STATUS codecStatus;
+    ADI_METIC_WFS_CODEC codec;
+    static char line[MAX_LINE_NUM_CHARS];
+    static uint8_t data[MAX_LINE_NUM_CHARS];
+    static int32_t frames[MAX_PACKET_NUM_FRAMES * ADI_METIC_MAX_NUM_CHANNELS];
+
+    if (argc > 1)
+    {
+        // Binary data of dumps follows text lines.
+        pFile = fopen(argv[1], "rb");
+        if (pFile == NULL)
+        {
+            fprintf(stderr, "Cannot open %s\n", argv[1]);
+            status = 1;
+        }
+    }
+    // Lines other than header and packets, like command echo, are ignored.
+    while ((status == 0) && (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        if ((pText = strstr(line, "H:")) != NULL)
+        {
+            numBytes = DecodeBase64(pText + 2, data, sizeof(data));
+            codecStatus = adi_metic_WfsDecoderInit(&codec, data, numBytes, &numSrcBytes);
+            isHeaderValid = (codecStatus == ADI_METIC_STATUS_SUCCESS) ? 1 : 0;
+            for (i = 0; (i < codec.numChannels) && (isHeaderValid == 1); i++)
+            {
+                printf("%s,", channelName[codec.order[i] % ADI_METIC_MAX_NUM_CHANNELS]);
+            }
+            printf("\n");
+        }
+        else if (((pText = strstr(line, "P:")) != NULL) && (isHeaderValid == 1))
+        {
+            numBytes = DecodeBase64(pText + 2, data, sizeof(data));
+            codecStatus = adi_metic_WfsDecode(&codec, data, numBytes, frames,
+                                              MAX_PACKET_NUM_FRAMES, &numSrcBytes, &numFrames);
+            if (codecStatus != ADI_METIC_STATUS_SUCCESS)
+            {
+                fprintf(stderr, "Invalid packet, status %d\n", (int)codecStatus);
+                status = 1;
+            }
+            PrintFrames(frames, numFrames, codec.numChannels);
+        }
+        else if ((pText = strstr(line, "D:")) != NULL)
+        {
+            status = DecodeDump(pText, pFile);
+        }
+    }
+    if ((pFile != NULL) && (pFile != stdin))
+    {
+        fclose(pFile);
+    }
+    return status;
+}
+
+int DecodeDump(char *pLine, FILE *pFile)
+{
+    int status = 0;
+    uint32_t i;
+    uint32_t numChannels = 0;
+    uint32_t numFrames = 0;
+    uint32_t numDecodedFrames;
+    uint32_t numSrcBytes;
+    uint32_t numBytes = 1;
+    uint32_t isHeaderValid = 0;
+    char format[16] = "";
+    uint8_t length[2];
+    ADI_METIC_STATUS codecStatus;
+    ADI_METIC_WFS_CODEC codec;
+    static uint8_t data[MAX_LINE_NUM_CHARS];
+    static int32_t frames[MAX_PACKET_NUM_FRAMES * ADI_METIC_MAX_NUM_CHANNELS];
+
+    if ((sscanf(pLine, "D:%15[a-z],%u,%u", format, &numChannels, &numFrames) != 3) ||
+        (numChannels == 0) || (numChannels > ADI_METIC_MAX_NUM_CHANNELS) ||
+        (FindDumpMarker(pFile) != 0))
+    {
+        fprintf(stderr, "Invalid dump %s", pLine);
+        status = 1;
+    }
+    else if (strcmp(format, "raw") == 0)
+    {
+        // Samples are little endian words with the 24 bit code in the upper bytes.
+        for (i = 0; i < numChannels; i++)
+        {
+            printf("%s,", channelName[i]);
+        }
+        printf("\n");
+        for (i = 0; (i < numFrames) && (status == 0); i++)
+        {
+            if (fread(data, RAW_SAMPLE_NUM_BYTES, numChannels, pFile) != numChannels)
+            {
+                fprintf(stderr, "Dump ends after %u of %u frames\n", i, numFrames);
+                status = 1;
+            }
+            for (numSrcBytes = 0; (numSrcBytes < numChannels) && (status == 0); numSrcBytes++)
+            {
+                frames[numSrcBytes] =
+                    (int32_t)((uint32_t)data[numSrcBytes * 4] |
+                              ((uint32_t)data[numSrcBytes * 4 + 1] << 8) |
+                              ((uint32_t)data[numSrcBytes * 4 + 2] << 16) |
+                              ((uint32_t)data[numSrcBytes * 4 + 3] << 24)) >>
+                    8;
+            }
+            if (status == 0)
+            {
+                PrintFrames(frames, 1, numChannels);
+            }
+        }
+    }
+    else
+    {
+        // Packets preceded by their length, codec header first and a length of 0 last.
+        while ((status == 0) && (numBytes > 0))
+        {
+            numBytes = 0;
+            if (fread(length, 1, 2, pFile) == 2)
+            {
+                numBytes = (uint32_t)length[0] | ((uint32_t)length[1] << 8);
+            }
+            else
+            {
+                status = 1;
+            }
+            if ((status == 0) && (numBytes > 0) &&
+                ((numBytes > sizeof(data)) || (fread(data, 1, numBytes, pFile) != numBytes)))
+            {
+                status = 1;
+            }
+            if ((status == 0) && (numBytes > 0) && (isHeaderValid == 0))
+            {
+                codecStatus = adi_metic_WfsDecoderInit(&codec, data, numBytes, &numSrcBytes);
+                status = (codecStatus == ADI_METIC_STATUS_SUCCESS) ? 0 : 1;
+                isHeaderValid = 1;
+                for (i = 0; (i < codec.numChannels) && (status == 0); i++)
+                {
+                    printf("%s,", channelName[codec.order[i] % ADI_METIC_MAX_NUM_CHANNELS]);
+                }
+                printf("\n");
+            }
+            else if ((status == 0) && (numBytes > 0))
+            {
+                codecStatus = adi_metic_WfsDecode(&codec, data, numBytes, frames,
+                                                  MAX_PACKET_NUM_FRAMES, &numSrcBytes,
+                                                  &numDecodedFrames);
+                status = (codecStatus == ADI_METIC_STATUS_SUCCESS) ? 0 : 1;
+                if (status == 0)
+                {
+                    PrintFrames(frames, numDecodedFrames, codec.numChannels);
+                }
+            }
+        }
+        if (status != 0)
+        {
+            fprintf(stderr, "Invalid or truncated compressed dump\n");
+        }
+    }
+    return status;
+}
+
+int FindDumpMarker(FILE *pFile)
+{
+    int status = 1;
+    int c;
+    uint32_t i = 0;
+    uint32_t numMatched = 0;
+
+    // End of the D: line may be followed by a carriage return before the marker.
+    while ((status != 0) && (i < DUMP_MARKER_MAX_OFFSET + DUMP_MARKER_NUM_BYTES) &&
+           ((c = fgetc(pFile)) != EOF))
+    {
+        numMatched = (c == DUMP_MARKER[numMatched]) ? numMatched + 1 : (c == DUMP_MARKER[0]);
+        if (numMatched == DUMP_MARKER_NUM_BYTES)
+        {
+            status = 0;
+        }
+        i++;
+    }
+    return status;
+}
+
+void PrintFrames(int32_t *pFrames, uint32_t numFrames, uint32_t numChannels)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < numFrames; i++)
+    {
+        for (j = 0; j < numChannels; j++)
+        {
+            printf("%d,", (int)pFrames[i * numChannels + j]);
+        }
+        printf("\n");
+    }
+}
+
+uint32_t DecodeBase64(char *pText, uint8_t *pDst, uint32_t maxNumBytes)
+{
+    uint32_t numBytes = 0;
+    uint32_t value = 0;
+    uint32_t numBits = 0;
+    int32_t digit;
+
+    while (((digit = GetBase64Value(*pText)) >= 0) && (numBytes < maxNumBytes))
+    {
+        value = (value << 6) | (uint32_t)digit;
+        numBits += 6;
+        if (numBits >= 8)
+        {
+            numBits -= 8;
+            pDst[numBytes] = (uint8_t)(value >> numBits);
+            numBytes++;
+        }
+        pText++;
+    }
+    return numBytes;
+}
+
+int32_t GetBase64Value(char c)
+{
+    int32_t value = -1;
+
+    if ((c >= 'A') && (c <= 'Z'))
+    {
+        value = c - 'A';
+    }
+    else if ((c >= 'a') && (c <= 'z'))
+    {
+        value = c - 'a' + 26;
+    }
+    else if ((c >= '0') && (c <= '9'))
+    {
+        value = c - '0' + 52;
+    }
+    else if (c == '+')
+    {
+        value = 62;
+    }
+    else if (c == '/')
+    {
+        value = 63;
+    }
+    return value;
+}
+
+/**
+ * @}
+ */
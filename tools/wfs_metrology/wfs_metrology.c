@@ -0,0 +1,871 @@
+/******************************************************************************
+ Copyright (c) 2025  Analog Devices Inc.
+******************************************************************************/
+
+/**
+ * @file        wfs_metrology.c
+ * @brief       Host tool computing RMS, active and apparent power, power factor and period from
+ * ADC samples of a capture file, and comparing them with output registers read concurrently.
+ *
+ * Samples are reduced once into sums over segments of #METRO_SEGMENT_NUM_FRAMES frames. The inner
+ * loop is a multiply and accumulate in double over the channels of a frame, which the compiler
+ * vectorises and which is exact for the sums of a segment. Values of a register row are then
+ * computed from the segments of the window ending at the time of the row.
+ * @{
+ */
+
+/*============= I N C L U D E S =============*/
+
+#include "adi_metic.h"
+#include "wfs_capture.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** Maximum number of characters in a line of register input */
+#define MAX_LINE_NUM_CHARS 4096
+/** Number of frames in a segment, 4 ms */
+#define METRO_SEGMENT_NUM_FRAMES 16
+/** Number of segments kept, longest window is 10 s */
+#define METRO_MAX_WINDOW_SEGMENTS 2500
+/** Default window of a register row in msec, 10 cycles at 50 Hz */
+#define METRO_DEFAULT_WINDOW_MS 200
+/** Default ADC code of the peak of a full scale input */
+#define METRO_DEFAULT_FS_CODE 8388608.0
+/** Software values below this fraction of full scale are not compared in percent of reading */
+#define METRO_MIN_LEVEL 0.001
+/** Hysteresis of zero crossings in fraction of full scale */
+#define METRO_CROSSING_HYSTERESIS 0.01
+/** Number of quantities compared */
+#define METRO_NUM_QUANTITIES 25
+
+/**
+ * Kind of a quantity, selecting the register conversion and the software computation.
+ */
+typedef enum
+{
+    /** Filtered RMS of a channel, converted with #adi_metic_ConvertRms */
+    METRO_KIND_RMS,
+    /** Total active power of a phase, converted with #adi_metic_ConvertPower */
+    METRO_KIND_WATT,
+    /** Total apparent power of a phase, converted with #adi_metic_ConvertPower */
+    METRO_KIND_VA,
+    /** Power factor of a phase, converted with #adi_metic_ConvertPowerFactor */
+    METRO_KIND_PF,
+    /** Line period of a phase or combined, converted with #adi_metic_ConvertPeriod */
+    METRO_KIND_PERIOD
+
+} METRO_KIND;
+
+/**
+ * Quantity compared, named as the register holding it.
+ */
+typedef struct
+{
+    /** Register name */
+    const char *pName;
+    /** Kind of quantity */
+    METRO_KIND kind;
+    /** Channel id for RMS, phase 0 to 2 for power and period, 3 for combined period */
+    uint32_t index;
+
+} METRO_QUANTITY;
+
+/**
+ * Sums of a segment of frames. Sums are exact, so that windows of any length add up without
+ * rounding.
+ */
+typedef struct
+{
+    /** Sum of samples by position in frame */
+    int64_t sum[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Sum of squares of samples by position in frame */
+    int64_t sumSquares[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Sum of products of voltage and current samples by phase */
+    int64_t sumProducts[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+    /** Number of rising zero crossings of phase voltage */
+    uint32_t numCrossings[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+    /** Frame of first rising zero crossing, interpolated */
+    double firstCrossing[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+    /** Frame of last rising zero crossing, interpolated */
+    double lastCrossing[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+
+} METRO_SEGMENT;
+
+/**
+ * Deviation statistics of a quantity.
+ */
+typedef struct
+{
+    /** Number of rows compared */
+    uint64_t count;
+    /** Mean of deviation */
+    double mean;
+    /** Sum of squared differences from mean, Welford's method */
+    double m2;
+    /** Minimum deviation */
+    double min;
+    /** Maximum deviation */
+    double max;
+
+} METRO_STATS;
+
+/**
+ * State of a comparison.
+ */
+typedef struct
+{
+    /** Capture file */
+    WFS_CAPTURE_READER reader;
+    /** Position in frame by channel id, -1 if not captured */
+    int32_t position[ADI_METIC_MAX_NUM_CHANNELS];
+    /** Number of channels in a frame */
+    uint32_t numChannels;
+    /** ADC code of the peak of a full scale input */
+    double fsCode;
+    /** Number of segments in a window */
+    uint32_t windowNumSegments;
+    /** Segments, indexed by segment number modulo #METRO_MAX_WINDOW_SEGMENTS */
+    METRO_SEGMENT *pSegments;
+    /** Number of segments completed */
+    uint64_t numSegments;
+    /** Frames of a segment not completed at the end of a block */
+    int32_t carry[METRO_SEGMENT_NUM_FRAMES * ADI_METIC_MAX_NUM_CHANNELS];
+    /** Number of frames in carry */
+    uint32_t numCarryFrames;
+    /** Last sample of phase voltages by phase */
+    int32_t lastVoltage[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+    /** Set to 1 when phase voltage went below hysteresis since the last crossing */
+    uint32_t isBelow[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+    /** Column of register input by quantity, -1 if not present */
+    int32_t column[METRO_NUM_QUANTITIES];
+    /** Deviation statistics by quantity */
+    METRO_STATS stats[METRO_NUM_QUANTITIES];
+    /** Number of register rows read */
+    uint64_t numRows;
+    /** Number of register rows with a window inside the capture */
+    uint64_t numRowsCompared;
+    /** First frame of first block after a gap, UINT64_MAX if capture has no gap. Number of frames
+     * lost is unknown, so frames from here on have no known time */
+    uint64_t gapFrame;
+    /** First segment after a gap, UINT64_MAX if capture has no gap */
+    uint64_t gapSegment;
+    /** Number of register rows not compared as their window is after a gap */
+    uint64_t numRowsAfterGap;
+
+} METRO_INFO;
+
+/** Quantities compared, by register name */
+static const METRO_QUANTITY quantity[METRO_NUM_QUANTITIES] = {
+    {"AVRMS", METRO_KIND_RMS, 0},         {"AIRMS", METRO_KIND_RMS, 1},
+    {"BVRMS", METRO_KIND_RMS, 2},         {"BIRMS", METRO_KIND_RMS, 3},
+    {"CVRMS", METRO_KIND_RMS, 4},         {"CIRMS", METRO_KIND_RMS, 5},
+    {"AUX0RMS", METRO_KIND_RMS, 6},       {"AUX1RMS", METRO_KIND_RMS, 7},
+    {"AUX2RMS", METRO_KIND_RMS, 8},       {"AUX3RMS", METRO_KIND_RMS, 9},
+    {"AUX4RMS", METRO_KIND_RMS, 10},      {"AUX5RMS", METRO_KIND_RMS, 11},
+    {"AWATT", METRO_KIND_WATT, 0},        {"BWATT", METRO_KIND_WATT, 1},
+    {"CWATT", METRO_KIND_WATT, 2},        {"AVA", METRO_KIND_VA, 0},
+    {"BVA", METRO_KIND_VA, 1},            {"CVA", METRO_KIND_VA, 2},
+    {"APF", METRO_KIND_PF, 0},            {"BPF", METRO_KIND_PF, 1},
+    {"CPF", METRO_KIND_PF, 2},            {"APERIOD", METRO_KIND_PERIOD, 0},
+    {"BPERIOD", METRO_KIND_PERIOD, 1},    {"CPERIOD", METRO_KIND_PERIOD, 2},
+    {"COM_PERIOD", METRO_KIND_PERIOD, 3}};
+
+/**
+ * Reads, decodes and reduces a block of the capture. Time base of frames ends at the first block
+ * after a gap.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  index - index of block.
+ * @param[in]  pSamples - buffer of #WFS_CAPTURE_MAX_BLOCK_FRAMES frames.
+ * @return 0 on success
+ */
+static int32_t AddBlock(METRO_INFO *pInfo, uint64_t index, int32_t *pSamples);
+
+/**
+ * Reduces decoded frames of a block into segments.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  pSamples - frames of samples, in order of capture.
+ * @param[in]  firstFrame - index of first frame from start of capture.
+ * @param[in]  numFrames - number of frames.
+ */
+static void AddFrames(METRO_INFO *pInfo, int32_t *pSamples, uint64_t firstFrame,
+                      uint32_t numFrames);
+
+/**
+ * Reduces a segment of frames into sums and zero crossings.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  pSamples - #METRO_SEGMENT_NUM_FRAMES frames of samples.
+ * @param[in]  firstFrame - index of first frame from start of capture.
+ */
+static void AddSegment(METRO_INFO *pInfo, int32_t *pSamples, uint64_t firstFrame);
+
+/**
+ * Finds rising zero crossings of phase voltages in a segment.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  pSamples - frames of samples of the segment.
+ * @param[in]  firstFrame - index of first frame of the segment.
+ * @param[out]  pSegment - segment.
+ */
+static void FindCrossings(METRO_INFO *pInfo, int32_t *pSamples, uint64_t firstFrame,
+                          METRO_SEGMENT *pSegment);
+
+/**
+ * Computes software values of all quantities over a window of segments.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  lastSegment - last segment of window.
+ * @param[out]  pValue - values by quantity, NAN if not computed.
+ */
+static void ComputeWindow(METRO_INFO *pInfo, uint64_t lastSegment, double *pValue);
+
+/**
+ * Converts a register code of a quantity with the MetIC service conversion.
+ * @param[in]  pQuantity - quantity.
+ * @param[in]  code - register code.
+ * @return converted value
+ */
+static double ConvertRegister(const METRO_QUANTITY *pQuantity, int32_t code);
+
+/**
+ * Compares a register row with software values of its window.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  pCodes - register codes by column.
+ * @param[in]  numColumns - number of columns.
+ * @param[in]  pValue - software values by quantity.
+ */
+static void CompareRow(METRO_INFO *pInfo, int32_t *pCodes, uint32_t numColumns, double *pValue);
+
+/**
+ * Adds a deviation to statistics.
+ * @param[in]  pStats - pointer to statistics.
+ * @param[in]  deviation - deviation.
+ */
+static void AddDeviation(METRO_STATS *pStats, double deviation);
+
+/**
+ * Parses the header of register input into columns of quantities.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  pLine - header line, time_us followed by register names.
+ * @return number of columns after time_us
+ */
+static uint32_t ParseHeader(METRO_INFO *pInfo, char *pLine);
+
+/**
+ * Compares capture with register input.
+ * @param[in]  pInfo - pointer to state.
+ * @param[in]  pFile - register input.
+ * @return 0 on success
+ */
+static int32_t Compare(METRO_INFO *pInfo, FILE *pFile);
+
+/**
+ * Displays deviation statistics of quantities present in register input.
+ * @param[in]  pInfo - pointer to state.
+ */
+static void DisplayStats(METRO_INFO *pInfo);
+
+/**
+ * Returns time in seconds from a monotonic clock.
+ */
+static double GetTime(void);
+
+/*=============  C O D E  =============*/
+
+int main(int argc, char *argv[])
+{
+    int32_t status = 1;
+    uint32_t i;
+    uint32_t windowMs = METRO_DEFAULT_WINDOW_MS;
+    FILE *pFile = NULL;
+    double startTime;
+    double elapsedTime;
+    static METRO_INFO info;
+
+    info.fsCode = METRO_DEFAULT_FS_CODE;
+    info.gapFrame = UINT64_MAX;
+    info.gapSegment = UINT64_MAX;
+    if ((argc >= 3) && (argc <= 5))
+    {
+        if (argc >= 4)
+        {
+            windowMs = (uint32_t)strtoul(argv[3], NULL, 0);
+        }
+        if (argc == 5)
+        {
+            info.fsCode = strtod(argv[4], NULL);
+        }
+        info.windowNumSegments =
+            windowMs * ADI_METIC_SAMPLING_RATE / 1000 / METRO_SEGMENT_NUM_FRAMES;
+        status = ((info.windowNumSegments == 0) ||
+                  (info.windowNumSegments > METRO_MAX_WINDOW_SEGMENTS) || (info.fsCode <= 0))
+                     ? 1
+                     : 0;
+        if (status == 1)
+        {
+            fprintf(stderr, "Window is 4 ms to 10 s and full scale code is positive\n");
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Usage:\n"
+                        "  wfs_metrology <capture> <registers.csv|-> [window_ms] [fs_code]\n");
+    }
+    if (status == 0)
+    {
+        status = WfsCaptureOpen(&info.reader, argv[1]);
+        if (status != 0)
+        {
+            fprintf(stderr, "Cannot open capture %s\n", argv[1]);
+        }
+    }
+    if (status == 0)
+    {
+        pFile = stdin;
+        if (strcmp(argv[2], "-") != 0)
+        {
+            pFile = fopen(argv[2], "r");
+        }
+        status = (pFile == NULL) ? 1 : 0;
+        if (status != 0)
+        {
+            fprintf(stderr, "Cannot open registers %s\n", argv[2]);
+        }
+    }
+    if (status == 0)
+    {
+        info.numChannels = info.reader.pHeader->numChannels;
+        for (i = 0; i < ADI_METIC_MAX_NUM_CHANNELS; i++)
+        {
+            info.position[i] = -1;
+        }
+        for (i = 0; i < info.numChannels; i++)
+        {
+            info.position[info.reader.pHeader->order[i] % ADI_METIC_MAX_NUM_CHANNELS] = (int32_t)i;
+        }
+        info.pSegments = calloc(METRO_MAX_WINDOW_SEGMENTS, sizeof(METRO_SEGMENT));
+        status = (info.pSegments == NULL) ? 1 : 0;
+    }
+    if (status == 0)
+    {
+        startTime = GetTime();
+        status = Compare(&info, pFile);
+        elapsedTime = GetTime() - startTime;
+        printf("frames         = %" PRIu64 "\n", info.reader.numFrames);
+        printf("rows           = %" PRIu64 " compared of %" PRIu64 "\n", info.numRowsCompared,
+               info.numRows);
+        printf("window         = %u ms\n",
+               info.windowNumSegments * METRO_SEGMENT_NUM_FRAMES * 1000 / ADI_METIC_SAMPLING_RATE);
+        printf("processed      = %.1f Mframes/s, %.1f hours of capture per minute\n",
+               (double)info.reader.numFrames / 1e6 / elapsedTime,
+               (double)info.reader.numFrames / ADI_METIC_SAMPLING_RATE / 3600.0 / elapsedTime *
+                   60.0);
+        if (info.gapFrame != UINT64_MAX)
+        {
+            printf("gap            = before frame %" PRIu64 ", %" PRIu64
+                   " rows after it not compared\n",
+                   info.gapFrame, info.numRowsAfterGap);
+        }
+        DisplayStats(&info);
+    }
+    if ((pFile != NULL) && (pFile != stdin))
+    {
+        fclose(pFile);
+    }
+    free(info.pSegments);
+    if (info.reader.pData != NULL)
+    {
+        WfsCaptureUnmap(&info.reader);
+    }
+    return (int)status;
+}
+
+int32_t Compare(METRO_INFO *pInfo, FILE *pFile)
+{
+    int32_t status = 0;
+    uint64_t index = 0;
+    uint64_t rowTime;
+    uint64_t lastSegment = 0;
+    uint32_t numColumns = 0;
+    uint32_t numValues;
+    uint32_t isRowReady;
+    char *pText;
+    char *pEnd;
+    double value[METRO_NUM_QUANTITIES];
+    uint64_t startTime = pInfo->reader.pHeader->timestamp;
+    static char line[MAX_LINE_NUM_CHARS];
+    static int32_t codes[MAX_LINE_NUM_CHARS / 2];
+    int32_t *pSamples =
+        malloc(WFS_CAPTURE_MAX_BLOCK_FRAMES * ADI_METIC_MAX_NUM_CHANNELS * sizeof(int32_t));
+
+    status = (pSamples == NULL) ? 1 : 0;
+    if ((status == 0) && (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        numColumns = ParseHeader(pInfo, line);
+    }
+    if (numColumns == 0)
+    {
+        fprintf(stderr, "No header of time_us and register names in registers\n");
+        status = 1;
+    }
+    while ((status == 0) && (fgets(line, sizeof(line), pFile) != NULL))
+    {
+        // Rows are in order of time, frames are reduced up to the end of the window of a row.
+        pText = line;
+        rowTime = strtoull(pText, &pEnd, 10);
+        numValues = 0;
+        while ((numValues < numColumns) && (*pEnd == ','))
+        {
+            pText = pEnd + 1;
+            codes[numValues] = (int32_t)strtol(pText, &pEnd, 0);
+            numValues++;
+        }
+        isRowReady = 0;
+        if ((numValues == numColumns) && (rowTime > startTime))
+        {
+            pInfo->numRows++;
+            lastSegment = (rowTime - startTime) * ADI_METIC_SAMPLING_RATE / 1000000u /
+                          METRO_SEGMENT_NUM_FRAMES;
+            isRowReady = (lastSegment >= pInfo->windowNumSegments) ? 1 : 0;
+        }
+        while ((status == 0) && (isRowReady == 1) && (pInfo->numSegments <= lastSegment) &&
+               (index < pInfo->reader.numBlocks))
+        {
+            status = AddBlock(pInfo, index, pSamples);
+            index++;
+        }
+        // Segments from the gap on are not at the time of the row, as frames lost are not
+        // counted.
+        if ((status == 0) && (isRowReady == 1) && (lastSegment >= pInfo->gapSegment))
+        {
+            pInfo->numRowsAfterGap++;
+        }
+        // Window is complete and still held in segments.
+        else if ((status == 0) && (isRowReady == 1) && (pInfo->numSegments > lastSegment) &&
+                 (pInfo->numSegments - lastSegment <=
+                  METRO_MAX_WINDOW_SEGMENTS - pInfo->windowNumSegments))
+        {
+            ComputeWindow(pInfo, lastSegment, &value[0]);
+            CompareRow(pInfo, &codes[0], numColumns, &value[0]);
+            pInfo->numRowsCompared++;
+        }
+    }
+    // Remaining frames are reduced, so that the processing rate covers the whole capture.
+    while ((status == 0) && (index < pInfo->reader.numBlocks))
+    {
+        status = AddBlock(pInfo, index, pSamples);
+        index++;
+    }
+    free(pSamples);
+    return status;
+}
+
+int32_t AddBlock(METRO_INFO *pInfo, uint64_t index, int32_t *pSamples)
+{
+    int32_t status;
+    WFS_CAPTURE_BLOCK block;
+
+    status = WfsCaptureGetBlock(&pInfo->reader, index, &block);
+    if (status == 0)
+    {
+        status = WfsCaptureDecodeBlock(&pInfo->reader, &block, pSamples);
+    }
+    if ((status == 0) && ((block.pHeader->flags & WFS_CAPTURE_BLOCK_FLAG_GAP_BEFORE) != 0) &&
+        (pInfo->gapFrame == UINT64_MAX))
+    {
+        // Frames of a segment before the gap are dropped, so that no segment spans the gap.
+        pInfo->numCarryFrames = 0;
+        pInfo->gapFrame = block.pHeader->firstFrame;
+        pInfo->gapSegment = pInfo->numSegments;
+    }
+    if (status == 0)
+    {
+        AddFrames(pInfo, pSamples, block.pHeader->firstFrame, block.pHeader->numFrames);
+    }
+    return status;
+}
+
+void AddFrames(METRO_INFO *pInfo, int32_t *pSamples, uint64_t firstFrame, uint32_t numFrames)
+{
+    uint32_t i = 0;
+    uint32_t numChannels = pInfo->numChannels;
+    uint32_t numCopied;
+
+    // Blocks need not hold whole segments. Frames left at the end of a block are completed with
+    // frames of the next block.
+    if (pInfo->numCarryFrames > 0)
+    {
+        numCopied = METRO_SEGMENT_NUM_FRAMES - pInfo->numCarryFrames;
+        numCopied = (numCopied < numFrames) ? numCopied : numFrames;
+        memcpy(&pInfo->carry[pInfo->numCarryFrames * numChannels], pSamples,
+               numCopied * numChannels * sizeof(int32_t));
+        pInfo->numCarryFrames += numCopied;
+        i = numCopied;
+        if (pInfo->numCarryFrames == METRO_SEGMENT_NUM_FRAMES)
+        {
+            AddSegment(pInfo, &pInfo->carry[0], firstFrame + i - METRO_SEGMENT_NUM_FRAMES);
+            pInfo->numCarryFrames = 0;
+        }
+    }
+    for (; i + METRO_SEGMENT_NUM_FRAMES <= numFrames; i += METRO_SEGMENT_NUM_FRAMES)
+    {
+        AddSegment(pInfo, &pSamples[i * numChannels], firstFrame + i);
+    }
+    if (i < numFrames)
+    {
+        memcpy(&pInfo->carry[0], &pSamples[i * numChannels],
+               (numFrames - i) * numChannels * sizeof(int32_t));
+        pInfo->numCarryFrames = numFrames - i;
+    }
+}
+
+void AddSegment(METRO_INFO *pInfo, int32_t *pSamples, uint64_t firstFrame)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t phase;
+    uint32_t numChannels = pInfo->numChannels;
+    int32_t positionV;
+    int32_t positionI;
+    int64_t sumProducts;
+    int32_t *pFrame;
+    double sum[ADI_METIC_MAX_NUM_CHANNELS] = {0};
+    double sumSquares[ADI_METIC_MAX_NUM_CHANNELS] = {0};
+    METRO_SEGMENT *pSegment = &pInfo->pSegments[pInfo->numSegments % METRO_MAX_WINDOW_SEGMENTS];
+
+    // Squares of 24 bit samples and their sum over a segment stay below 2^53, so double sums
+    // are exact.
+    for (i = 0; i < METRO_SEGMENT_NUM_FRAMES; i++)
+    {
+        pFrame = &pSamples[i * numChannels];
+        for (j = 0; j < numChannels; j++)
+        {
+            sum[j] += (double)pFrame[j];
+            sumSquares[j] += (double)pFrame[j] * (double)pFrame[j];
+        }
+    }
+    for (j = 0; j < ADI_METIC_MAX_NUM_CHANNELS; j++)
+    {
+        pSegment->sum[j] = (int64_t)sum[j];
+        pSegment->sumSquares[j] = (int64_t)sumSquares[j];
+    }
+    for (phase = 0; phase < ADI_METIC_MAX_NUM_POWER_CHANNELS; phase++)
+    {
+        positionV = pInfo->position[2 * phase];
+        positionI = pInfo->position[2 * phase + 1];
+        sumProducts = 0;
+        for (i = 0; (i < METRO_SEGMENT_NUM_FRAMES) && (positionV >= 0) && (positionI >= 0); i++)
+        {
+            pFrame = &pSamples[i * numChannels];
+            sumProducts += (int64_t)pFrame[positionV] * pFrame[positionI];
+        }
+        pSegment->sumProducts[phase] = sumProducts;
+    }
+    FindCrossings(pInfo, pSamples, firstFrame, pSegment);
+    pInfo->numSegments++;
+}
+
+void FindCrossings(METRO_INFO *pInfo, int32_t *pSamples, uint64_t firstFrame,
+                   METRO_SEGMENT *pSegment)
+{
+    uint32_t i;
+    uint32_t phase;
+    int32_t position;
+    int32_t sample;
+    int32_t lastSample;
+    double crossing;
+    int32_t hysteresis = (int32_t)(pInfo->fsCode * METRO_CROSSING_HYSTERESIS);
+
+    for (phase = 0; phase < ADI_METIC_MAX_NUM_POWER_CHANNELS; phase++)
+    {
+        position = pInfo->position[2 * phase];
+        pSegment->numCrossings[phase] = 0;
+        lastSample = pInfo->lastVoltage[phase];
+        for (i = 0; (i < METRO_SEGMENT_NUM_FRAMES) && (position >= 0); i++)
+        {
+            sample = pSamples[i * pInfo->numChannels + (uint32_t)position];
+            if (sample < -hysteresis)
+            {
+                pInfo->isBelow[phase] = 1;
+            }
+            else if ((sample >= 0) && (lastSample < 0) && (pInfo->isBelow[phase] == 1))
+            {
+                // Crossing is interpolated between the samples around zero.
+                crossing = (double)(firstFrame + i) - 1.0 +
+                           (double)(-lastSample) / (double)(sample - lastSample);
+                if (pSegment->numCrossings[phase] == 0)
+                {
+                    pSegment->firstCrossing[phase] = crossing;
+                }
+                pSegment->lastCrossing[phase] = crossing;
+                pSegment->numCrossings[phase]++;
+                pInfo->isBelow[phase] = 0;
+            }
+            lastSample = sample;
+        }
+        pInfo->lastVoltage[phase] = lastSample;
+    }
+}
+
+void ComputeWindow(METRO_INFO *pInfo, uint64_t lastSegment, double *pValue)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t phase;
+    uint32_t numPeriods = 0;
+    int32_t positionV;
+    int32_t positionI;
+    int64_t sum[ADI_METIC_MAX_NUM_CHANNELS] = {0};
+    int64_t sumSquares[ADI_METIC_MAX_NUM_CHANNELS] = {0};
+    int64_t sumProducts[ADI_METIC_MAX_NUM_POWER_CHANNELS] = {0};
+    uint32_t numCrossings[ADI_METIC_MAX_NUM_POWER_CHANNELS] = {0};
+    double firstCrossing[ADI_METIC_MAX_NUM_POWER_CHANNELS] = {0};
+    double lastCrossing[ADI_METIC_MAX_NUM_POWER_CHANNELS] = {0};
+    double rms[ADI_METIC_MAX_NUM_CHANNELS];
+    double mean[ADI_METIC_MAX_NUM_CHANNELS];
+    double period[ADI_METIC_MAX_NUM_POWER_CHANNELS];
+    double numFrames = (double)(pInfo->windowNumSegments * METRO_SEGMENT_NUM_FRAMES);
+    // Full scale input is a sine of peak fsCode, so full scale RMS is fsCode / sqrt(2).
+    double fsRms = pInfo->fsCode / sqrt(2.0);
+    double comPeriod = 0;
+    double power;
+    double variance;
+    METRO_SEGMENT *pSegment;
+
+    for (i = 0; i < pInfo->windowNumSegments; i++)
+    {
+        pSegment = &pInfo->pSegments[(lastSegment - i) % METRO_MAX_WINDOW_SEGMENTS];
+        for (j = 0; j < ADI_METIC_MAX_NUM_CHANNELS; j++)
+        {
+            sum[j] += pSegment->sum[j];
+            sumSquares[j] += pSegment->sumSquares[j];
+        }
+        // Segments are visited from the last, so the first crossing is updated on the way.
+        for (phase = 0; phase < ADI_METIC_MAX_NUM_POWER_CHANNELS; phase++)
+        {
+            sumProducts[phase] += pSegment->sumProducts[phase];
+            if (pSegment->numCrossings[phase] > 0)
+            {
+                if (numCrossings[phase] == 0)
+                {
+                    lastCrossing[phase] = pSegment->lastCrossing[phase];
+                }
+                firstCrossing[phase] = pSegment->firstCrossing[phase];
+                numCrossings[phase] += pSegment->numCrossings[phase];
+            }
+        }
+    }
+    for (i = 0; i < METRO_NUM_QUANTITIES; i++)
+    {
+        pValue[i] = NAN;
+    }
+    for (j = 0; j < ADI_METIC_MAX_NUM_CHANNELS; j++)
+    {
+        // DC is removed as by the high pass filter of the datapath.
+        mean[j] = (double)sum[j] / numFrames;
+        variance = (double)sumSquares[j] / numFrames - mean[j] * mean[j];
+        rms[j] = sqrt((variance > 0) ? variance : 0) / fsRms;
+    }
+    for (i = 0; i < METRO_NUM_QUANTITIES; i++)
+    {
+        phase = quantity[i].index;
+        if (quantity[i].kind == METRO_KIND_RMS)
+        {
+            if (pInfo->position[phase] >= 0)
+            {
+                pValue[i] = rms[pInfo->position[phase]];
+            }
+        }
+        else if (quantity[i].kind == METRO_KIND_PERIOD)
+        {
+            if ((phase < ADI_METIC_MAX_NUM_POWER_CHANNELS) && (numCrossings[phase] > 1))
+            {
+                period[phase] = (lastCrossing[phase] - firstCrossing[phase]) /
+                                (double)(numCrossings[phase] - 1) / ADI_METIC_SAMPLING_RATE;
+                pValue[i] = period[phase];
+                comPeriod += period[phase];
+                numPeriods++;
+            }
+            else if ((phase == ADI_METIC_MAX_NUM_POWER_CHANNELS) && (numPeriods > 0))
+            {
+                // Combined period is the mean of phases with crossings.
+                pValue[i] = comPeriod / numPeriods;
+            }
+        }
+        else
+        {
+            positionV = pInfo->position[2 * phase];
+            positionI = pInfo->position[2 * phase + 1];
+            if ((positionV >= 0) && (positionI >= 0))
+            {
+                power = ((double)sumProducts[phase] / numFrames -
+                         mean[positionV] * mean[positionI]) /
+                        (fsRms * fsRms);
+                if (quantity[i].kind == METRO_KIND_WATT)
+                {
+                    pValue[i] = power;
+                }
+                else if (quantity[i].kind == METRO_KIND_VA)
+                {
+                    pValue[i] = rms[positionV] * rms[positionI];
+                }
+                else if (rms[positionV] * rms[positionI] > 0)
+                {
+                    pValue[i] = power / (rms[positionV] * rms[positionI]);
+                }
+            }
+        }
+    }
+}
+
+double ConvertRegister(const METRO_QUANTITY *pQuantity, int32_t code)
+{
+    double value = 0;
+    float pf;
+    ADI_METIC_RMS_OUTPUT_FIX rmsFix = {0};
+    ADI_METIC_RMS_OUTPUT rms;
+    ADI_METIC_POWER_OUTPUT_FIX powerFix = {0};
+    ADI_METIC_POWER_OUTPUT power;
+    ADI_METIC_PERIOD_OUTPUT_FIX periodFix = {0};
+    ADI_METIC_PERIOD_OUTPUT period;
+
+    // Conversions are those of the firmware, so that differences are of the values only.
+    if (pQuantity->kind == METRO_KIND_RMS)
+    {
+        rmsFix.filteredRms = code;
+        adi_metic_ConvertRms(&rmsFix, 1, &rms);
+        value = rms.filteredRms;
+    }
+    else if (pQuantity->kind == METRO_KIND_WATT)
+    {
+        powerFix.activePower = code;
+        adi_metic_ConvertPower(&powerFix, 1, &power);
+        value = power.activePower;
+    }
+    else if (pQuantity->kind == METRO_KIND_VA)
+    {
+        powerFix.apparentPower = code;
+        adi_metic_ConvertPower(&powerFix, 2, &power);
+        value = power.apparentPower;
+    }
+    else if (pQuantity->kind == METRO_KIND_PF)
+    {
+        adi_metic_ConvertPowerFactor(&code, 1, &pf);
+        value = pf;
+    }
+    else
+    {
+        periodFix.aPeriod = code;
+        adi_metic_ConvertPeriod(&periodFix, 1, &period);
+        value = period.aPeriod;
+    }
+    return value;
+}
+
+void CompareRow(METRO_INFO *pInfo, int32_t *pCodes, uint32_t numColumns, double *pValue)
+{
+    uint32_t i;
+    int32_t column;
+    double registerValue;
+
+    for (i = 0; i < METRO_NUM_QUANTITIES; i++)
+    {
+        column = pInfo->column[i];
+        if ((column >= 0) && ((uint32_t)column < numColumns) && (isnan(pValue[i]) == 0))
+        {
+            registerValue = ConvertRegister(&quantity[i], pCodes[column]);
+            if (quantity[i].kind == METRO_KIND_PF)
+            {
+                // Power factor is compared as a difference, as it is near zero for some loads.
+                AddDeviation(&pInfo->stats[i], registerValue - pValue[i]);
+            }
+            else if (fabs(pValue[i]) >= METRO_MIN_LEVEL)
+            {
+                AddDeviation(&pInfo->stats[i],
+                             (registerValue - pValue[i]) / fabs(pValue[i]) * 100.0);
+            }
+        }
+    }
+}
+
+void AddDeviation(METRO_STATS *pStats, double deviation)
+{
+    double delta;
+
+    if (pStats->count == 0)
+    {
+        pStats->min = deviation;
+        pStats->max = deviation;
+    }
+    pStats->min = (deviation < pStats->min) ? deviation : pStats->min;
+    pStats->max = (deviation > pStats->max) ? deviation : pStats->max;
+    pStats->count++;
+    delta = deviation - pStats->mean;
+    pStats->mean += delta / (double)pStats->count;
+    pStats->m2 += delta * (deviation - pStats->mean);
+}
+
+uint32_t ParseHeader(METRO_INFO *pInfo, char *pLine)
+{
+    uint32_t numColumns = 0;
+    uint32_t i;
+    char *pName = strtok(pLine, ",\r\n");
+
+    for (i = 0; i < METRO_NUM_QUANTITIES; i++)
+    {
+        pInfo->column[i] = -1;
+    }
+    if ((pName != NULL) && (strcmp(pName, "time_us") == 0))
+    {
+        pName = strtok(NULL, ",\r\n");
+        while (pName != NULL)
+        {
+            // Columns of other registers are read and ignored.
+            for (i = 0; i < METRO_NUM_QUANTITIES; i++)
+            {
+                if (strcmp(pName, quantity[i].pName) == 0)
+                {
+                    pInfo->column[i] = (int32_t)numColumns;
+                }
+            }
+            numColumns++;
+            pName = strtok(NULL, ",\r\n");
+        }
+    }
+    return numColumns;
+}
+
+void DisplayStats(METRO_INFO *pInfo)
+{
+    uint32_t i;
+    METRO_STATS *pStats;
+
+    printf("\n%-12s %-10s %10s %12s %12s %12s %12s\n", "register", "deviation", "rows", "mean",
+           "std", "min", "max");
+    for (i = 0; i < METRO_NUM_QUANTITIES; i++)
+    {
+        pStats = &pInfo->stats[i];
+        if (pInfo->column[i] >= 0)
+        {
+            printf("%-12s %-10s %10" PRIu64 " %12.5f %12.5f %12.5f %12.5f\n", quantity[i].pName,
+                   (quantity[i].kind == METRO_KIND_PF) ? "difference" : "% reading",
+                   pStats->count, pStats->mean,
+                   (pStats->count > 1) ? sqrt(pStats->m2 / (double)(pStats->count - 1)) : 0.0,
+                   pStats->min, pStats->max);
+        }
+    }
+}
+
+double GetTime(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+/**
+ * @}
+ */